@@ -1,30 +1,52 @@
 ﻿#include "Application.h"
-
-Application::Application(int width, int height, const std::string& title)
+#include "Renderer/MeshCodec.h"
+#include "Renderer/AssetLoader.h"
+#include "Core/JobSystem.h"
+#include "Core/MemoryTracker.h"
+#include "Renderer/GpuResourceRegistry.h"
+#include "Scene/GltfImporter.h"
+#include <algorithm>
+
+Application::Application(int width, int height, const std::string& title, const LaunchOptions& launchOptions)
+    : options(launchOptions), startupBegin(std::chrono::steady_clock::now())
 {
-    // Initialize the window and OpenGL context
-    window = std::make_unique<Window>(width, height, "Solar System");
+    // Startup runs as a task graph: decoding and mesh generation proceed on the
+    // workers while the window, context and renderer are created on this thread
+    InitGraph startup(startupBegin);
+    Task<void> assetLoad = LoadSceneAssets();
 
-    // Initialize the GLFW window, OpenGL context and GLAD inside Window::Initialize()
-    if (!window->Initialize()) {
-        throw std::runtime_error("Failed to initialize Window.");
-    }
+    startup.Add("Context", InitGraph::Affinity::MainThread, [&] {
+        // Initialize the window and OpenGL context (hidden for headless runs)
+        window = std::make_unique<Window>(width, height, "Solar System", !options.headless);
+
+        // Initialize the GLFW window, OpenGL context and GLAD inside Window::Initialize()
+        if (!window->Initialize()) {
+            throw std::runtime_error("Failed to initialize Window.");
+        }
 
-    glfwMakeContextCurrent(window->GetNativeHandle());
+        glfwMakeContextCurrent(window->GetNativeHandle());
 
-    // Register window with input system
-    Input::Initialize(window->GetNativeHandle());
+        // Register window with input system
+        Input::Initialize(window->GetNativeHandle());
 
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-        throw std::runtime_error("Failed to initialize GLAD.");
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+            throw std::runtime_error("Failed to initialize GLAD.");
+    });
 
     // Initialize systems
-    renderer = std::make_unique<Renderer>();
-    cameraManager = std::make_unique<CameraManager>();
-    cameraController = std::make_unique<CameraController>(*cameraManager->CreateMainCamera(width, height));
+    startup.Add("Renderer", InitGraph::Affinity::MainThread, [&] {
+        renderer = std::make_unique<Renderer>();
+        renderer->Initialize();
+        cameraManager = std::make_unique<CameraManager>();
+        cameraController = std::make_unique<CameraController>(*cameraManager->CreateMainCamera(width, height));
+    }, { "Context" });
 
     // Initialize the scene
-    InitScene();
+    InitScene(startup, assetLoad);
+    startup.Add("Metrics", InitGraph::Affinity::Worker, [&] { StartMetrics(); });
+
+    startup.Run();
+    startup.PrintTimeline();
 
     std::cout << "[Application] Initialized successfully.\n";
 
@@ -33,41 +55,42 @@ Application::Application(int width, int height, const std::string& title)
 
 Application::~Application()
 {
+    // Release GPU resources (shader, stream ring, pooled mesh buffers) while the GL context still exists
+    domeTarget.reset();
+    renderer.reset();
+    GeometryPool::Shutdown();
+    JobSystem::Shutdown();
     glfwTerminate();
 }
 
-void Application::InitScene()
+Task<void> Application::LoadSceneAssets()
 {
-    // 3D sphere meshes
-    sun.mesh = std::make_unique<Mesh>(Mesh::CreateSphere(2.0f, 360, 180));
-    earth.mesh = std::make_unique<Mesh>(Mesh::CreateSphere(1.0f, 360, 180));
-    moon.mesh = std::make_unique<Mesh>(Mesh::CreateSphere(0.5f, 360, 180));
-    
-    // ====== Load textures ======
-
-    //Load earth textures
-    auto earthDiffuse = std::make_shared<Texture>();
-    auto earthSpecular = std::make_shared<Texture>();
-
-    if (earthDiffuse->LoadFromFile("assets/textures/2k_earth_daymap.jpg")) {
-        loadedTexture.push_back(earthDiffuse);
-    }
-    if (earthSpecular->LoadFromFile("assets/textures/2k_earth_specular_map.tif")) {
-        loadedTexture.push_back(earthSpecular);
-    }
-
-    // Load Sun texture
-    auto sunDiffuse = std::make_shared<Texture>();
-
-    if (sunDiffuse->LoadFromFile("assets/textures/2k_sun.jpg")) {
-        loadedTexture.push_back(sunDiffuse);
-    }
+    // Every load starts here and runs concurrently; each co_await resumes on the GL thread
 
-    // Load Moon texture
-    auto moonDiffuse = std::make_shared<Texture>();
+    // 3D sphere meshes
+    auto sunSphere = Assets::GenerateMesh(MeshDesc::Sphere(2.0f, 360, 180));
+    auto earthSphere = Assets::GenerateMesh(MeshDesc::Sphere(1.0f, 360, 180));
+    auto moonSphere = Assets::GenerateMesh(MeshDesc::Sphere(0.5f, 360, 180));
 
-    if (moonDiffuse->LoadFromFile("assets/textures/2k_moon.jpg")) {
-        loadedTexture.push_back(moonDiffuse);
+    // ====== Load textures ======
+    auto earthDayLoad = Assets::LoadTexture("assets/textures/2k_earth_daymap.jpg");
+    auto earthSpecularLoad = Assets::LoadTexture("assets/textures/2k_earth_specular_map.tif");
+    auto sunLoad = Assets::LoadTexture("assets/textures/2k_sun.jpg");
+    auto moonLoad = Assets::LoadTexture("assets/textures/2k_moon.jpg");
+
+    sun.mesh = co_await sunSphere;
+    earth.mesh = co_await earthSphere;
+    moon.mesh = co_await moonSphere;
+
+    std::shared_ptr<Texture> earthDiffuse = co_await earthDayLoad;
+    std::shared_ptr<Texture> earthSpecular = co_await earthSpecularLoad;
+    std::shared_ptr<Texture> sunDiffuse = co_await sunLoad;
+    std::shared_ptr<Texture> moonDiffuse = co_await moonLoad;
+
+    for (const std::shared_ptr<Texture>& texture : { earthDiffuse, earthSpecular, sunDiffuse, moonDiffuse }) {
+        if (texture) {
+            loadedTexture.push_back(texture);
+        }
     }
 
     // ====== Create Material ======
@@ -93,22 +116,115 @@ void Application::InitScene()
     earth.material = earthMaterial;
     sun.material = sunMaterial;
     moon.material = moonMaterial;
+}
+
+void Application::InitScene(InitGraph& startup, Task<void>& assetLoad)
+{
+    using Affinity = InitGraph::Affinity;
 
-    // Transform setup - place objects in front of camera (negative Z direction from camera at +Z)
-    // Camera at (0, 0, 15) looking at negative Z, so objects should be at Z < 15
-    sun.transform.SetPosition(glm::vec3(0.0f, 0.0f, 0.0f));
-    earth.transform.SetPosition(glm::vec3(6.0f, 0.0f, 0.0f));
-    moon.transform.SetPosition(glm::vec3(8.0f, 0.0f, 0.0f));
+    // Decoding and generation are already running; the uploads wait for the context and the
+    // renderer's GL state, declared here rather than relying on main-thread tasks running in order
+    startup.Add("Assets", Affinity::MainThread, [&assetLoad] { SyncWait(assetLoad); }, { "Context", "Renderer" });
 
-    sun.renderLayer = earth.renderLayer = moon.renderLayer = 0;
-    
-    std::cout << "[InitScene] Created 3 spheres (sun, earth, moon)\n";
-    std::cout << "[InitScene] Sun at (0, 0, 0), Earth at (6, 0, 0), Moon at (8, 0, 0)\n";
+    // Imported model: parsing and conversion fan out over the workers, the upload needs the context.
+    // Its load time shows up in the startup timeline and in the importer's own breakdown.
+    if (!options.modelPath.empty())
+    {
+        startup.Add("Model", Affinity::MainThread, [this] {
+            ImportedModel model;
+            if (!GltfImporter::Load(options.modelPath, model))
+                return;
+            loadedTexture.insert(loadedTexture.end(), model.textures.begin(), model.textures.end());
+
+            modelParts.resize(model.parts.size());
+            for (size_t i = 0; i < model.parts.size(); ++i)
+            {
+                modelParts[i].mesh = std::move(model.parts[i].mesh);
+                modelParts[i].material = std::move(model.parts[i].material);
+                modelParts[i].transform.SetPosition(glm::vec3(0.0f, 4.0f, 0.0f));
+            }
+
+#ifdef CELESTIAL_MESH_CODEC_BENCHMARK
+            // Mesh codec on real assets: all parts back to back (indices stay part-relative)
+            std::vector<Vertex> vertices;
+            std::vector<unsigned int> indices;
+            for (const RenderObject& part : modelParts)
+            {
+                vertices.insert(vertices.end(), part.mesh->GetVertices().begin(), part.mesh->GetVertices().end());
+                indices.insert(indices.end(), part.mesh->GetIndices().begin(), part.mesh->GetIndices().end());
+            }
+            MeshCodec::Report report = MeshCodec::Measure(vertices, indices);
+            std::cout << "[MeshCodec] " << options.modelPath << ": " << report.rawBytes << " -> "
+                      << report.encodedBytes << " bytes (" << report.Ratio() * 100.0 << "%), decode "
+                      << report.vertexDecodeGBps << " GB/s vertices, " << report.indexDecodeGBps << " GB/s indices\n";
+#endif
+        }, { "Context", "Renderer" });
+    }
+
+    // Orbits live in the simulation; Update() copies its state into the transforms
+    startup.Add("Simulation.Init", Affinity::Worker, [this] { simulation.AddSolarSystem(); });
+
+    // Transforms and state sources once the assets and the simulation are ready
+    startup.Add("Scene", Affinity::MainThread, [this] {
+        // Transform setup - place objects in front of camera (negative Z direction from camera at +Z)
+        // Camera at (0, 0, 15) looking at negative Z, so objects should be at Z < 15
+        SyncTransforms();
+
+        // Viewer of a simulation server: state arrives over the socket instead
+        if (!options.stateHost.empty())
+            stateClient = std::make_unique<StateClient>(options.stateHost, static_cast<std::uint16_t>(options.statePort),
+                options.viewRate, options.interestRadius, cameraManager->GetActive().GetPosition());
+
+        if (!options.exportName.empty())
+        {
+            stateExport = std::make_unique<SharedStateExport>(options.exportName, 64);
+            stateExport->Publish(simulation);
+        }
+
+        sun.renderLayer = earth.renderLayer = moon.renderLayer = 0;
+
+        // Cluster ids: index in this list, identical in every process
+        replicatedTransforms = { &sun.transform, &earth.transform, &moon.transform };
+
+#ifdef CELESTIAL_MESH_CODEC_BENCHMARK
+        // Mesh codec: compression ratio and decode speed over the sphere LODs
+        const unsigned int lods[][2] = { {45, 22}, {90, 45}, {180, 90}, {360, 180} };
+        for (const auto& lod : lods)
+        {
+            Mesh sphere = Mesh::CreateSphere(1.0f, lod[0], lod[1]);
+            MeshCodec::Report report = MeshCodec::Measure(sphere.GetVertices(), sphere.GetIndices());
+            std::cout << "[MeshCodec] Sphere " << lod[0] << "x" << lod[1] << ": " << report.rawBytes << " -> "
+                      << report.encodedBytes << " bytes (" << report.Ratio() * 100.0 << "%), decode "
+                      << report.vertexDecodeGBps << " GB/s vertices, " << report.indexDecodeGBps << " GB/s indices\n";
+        }
+#endif
+
+        std::cout << "[InitScene] Created 3 spheres (sun, earth, moon)\n";
+        std::cout << "[InitScene] Sun at (0, 0, 0), Earth at (6, 0, 0), Moon at (8, 0, 0)\n";
+    }, { "Renderer", "Assets", "Simulation.Init" });
 }
 
 void Application::ProcessInput(float dt)
 {
-    cameraController->Update(dt);
+    cameraMoving = cameraController->Update(dt);
+
+    // P toggles the simulation; a paused scene with a still camera stops rendering
+    bool pauseKeyDown = Input::IsKeyPressed(GLFW_KEY_P);
+    if (pauseKeyDown && !pauseKeyWasDown) {
+        simulationPaused = !simulationPaused;
+        std::cout << "[Application] Simulation " << (simulationPaused ? "paused" : "resumed") << "\n";
+    }
+    pauseKeyWasDown = pauseKeyDown;
+
+    // V toggles side-by-side stereo on the main camera
+    bool stereoKeyDown = Input::IsKeyPressed(GLFW_KEY_V);
+    if (stereoKeyDown && !stereoKeyWasDown) {
+        stereoEnabled = !stereoEnabled;
+        cameraManager->SetStereo("MainCamera", stereoEnabled ? StereoMode::SideBySide : StereoMode::Mono);
+        framePacer.RequestFrame();
+    }
+    stereoKeyWasDown = stereoKeyDown;
+
     // Global escape condition
     if (Input::IsKeyPressed(GLFW_KEY_ESCAPE)) {
         running = false;
@@ -117,27 +233,100 @@ void Application::ProcessInput(float dt)
 
 void Application::Update(float dt)
 {
-    // Simple orbital motion for Earth & Moon
-    static float angle = 0.0f;
-    angle += dt * 20.0f; // degrees per second
+    if (stateClient)
+    {
+        // The server steps the simulation; this process only draws it
+        if (!stateClient->Poll(cameraManager->GetActive().GetPosition()))
+        {
+            std::cerr << "[Application] Simulation server disconnected\n";
+            running = false;
+        }
+        simulationTime = stateClient->GetTime();
+        SyncTransforms();
+        return;
+    }
 
-    float radians = glm::radians(angle);
+    if (simulationPaused)
+        return;
 
-    earth.transform.SetPosition(glm::vec3(6.0f * cos(radians), 0.0f, 6.0f * sin(radians)));
-    moon.transform.SetPosition(earth.transform.GetPosition() + 
-        glm::vec3(2.0f * cos(3 * radians), 0.0f, 2.0f * sin(3 * radians)));
+    double stepStart = glfwGetTime();
+    simulation.Step(dt);
+    if (metrics.stepSeconds)
+        metrics.stepSeconds->Observe(glfwGetTime() - stepStart);
+    simulationTime = simulation.GetTime();
+    SyncTransforms();
 
-    static float earthRotation = 0.0f;
-    earthRotation += dt * 30.0f;  // 30 degrees per second
-    earth.transform.SetRotationEuler(glm::vec3(0.0f, earthRotation, 0.0f));
+    // External tools read the new state without ever blocking this thread
+    if (stateExport)
+        stateExport->Publish(simulation);
+}
+
+void Application::SyncTransforms()
+{
+    RenderObject* bodies[] = { &sun, &earth, &moon };
+    for (size_t i = 0; i < std::size(bodies); ++i)
+    {
+        glm::dvec3 position;
+        double spin;
+        if (stateClient)
+        {
+            // Bodies outside the interest radius keep their last received state
+            if (!stateClient->IsTracked(i))
+                continue;
+            position = stateClient->GetPosition(i);
+            spin = stateClient->GetSpin(i);
+        }
+        else
+        {
+            position = simulation.GetPosition(i);
+            spin = simulation.GetField(Simulation::Spin)[i];
+        }
+        bodies[i]->transform.SetPosition(glm::vec3(position));
+        bodies[i]->transform.SetRotationEuler(glm::vec3(0.0f, static_cast<float>(spin), 0.0f));
+    }
 }
 
 void Application::Render()
 {
+    double frameStart = glfwGetTime();
+
     // Add objects to renderer each frame
     renderer->AddRenderObject(sun);
     renderer->AddRenderObject(earth);
     renderer->AddRenderObject(moon);
+    for (const RenderObject& part : modelParts)
+        renderer->AddRenderObject(part);
+
+    // Orbit paths and Earth's axes (compiled out in release builds). Submitted here
+    // rather than in Update() so iterations that skip rendering queue nothing.
+    const glm::vec3 orbitNormal(0.0f, 1.0f, 0.0f);
+    DebugDraw::Circle(glm::vec3(0.0f), orbitNormal, 6.0f, glm::vec3(0.3f, 0.5f, 1.0f), 64);
+    DebugDraw::Circle(earth.transform.GetPosition(), orbitNormal, 2.0f, glm::vec3(0.6f, 0.6f, 0.6f));
+    DebugDraw::Axes(earth.transform.GetModelMatrix(), 1.5f);
+
+    // Body names; larger bodies win when labels overlap
+    renderer->AddLabel({ sun.transform.GetPosition(), "Sun", 2.0f, glm::vec3(1.0f, 0.85f, 0.5f) });
+    renderer->AddLabel({ earth.transform.GetPosition(), "Earth", 1.0f, glm::vec3(0.6f, 0.8f, 1.0f) });
+    renderer->AddLabel({ moon.transform.GetPosition(), "Moon", 0.5f, glm::vec3(0.85f, 0.85f, 0.85f) });
+
+    // Cluster master: replicate the state this frame is drawn from before drawing it
+    if (clusterMaster)
+    {
+        const Camera& camera = cameraManager->GetActive();
+        clusterFrame.frameIndex = frameIndex;
+        clusterFrame.simulationTime = simulationTime;
+        clusterFrame.cameraPosition = camera.GetPosition();
+        clusterFrame.cameraYaw = camera.GetYaw();
+        clusterFrame.cameraPitch = camera.GetPitch();
+        clusterFrame.transforms.resize(replicatedTransforms.size());
+        for (size_t i = 0; i < replicatedTransforms.size(); ++i)
+        {
+            const Transform& transform = *replicatedTransforms[i];
+            clusterFrame.transforms[i] = { static_cast<std::uint32_t>(i), transform.GetPosition(),
+                transform.GetRotation(), transform.GetScale() };
+        }
+        clusterMaster->Broadcast(clusterFrame);
+    }
 
     // Render from all active cameras
     auto activeCameras = cameraManager->GetActiveCameras();
@@ -146,32 +335,263 @@ void Application::Render()
     // Clear object list
     renderer->ResetSceneObjects();
 
-    // Swap buffers
-    window->SwapBuffers();
+    // Swap barrier: every display presents this frame together, once all have finished drawing it
+    if (clusterMaster || clusterNode)
+    {
+        glFinish();
+        if (clusterMaster)
+            clusterMaster->SwapBarrier(frameIndex);
+        else if (!clusterNode->SwapBarrier(frameIndex))
+            running = false;
+    }
+    frameIndex++;
+
+    // Swap buffers (a hidden window has nothing to present)
+    if (!options.headless)
+        window->SwapBuffers();
+
+    if (!firstFrameShown)
+    {
+        firstFrameShown = true;
+        std::cout << "[Application] Time to first frame: "
+                  << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count() << " ms\n";
+    }
+
+    if (metrics.frames)
+    {
+        const RenderStats& stats = renderer->GetStats();
+        metrics.frameSeconds->Observe(glfwGetTime() - frameStart);
+        metrics.frames->Add();
+        metrics.drawCallsTotal->Add(stats.drawCalls);
+        metrics.drawCalls->Set(stats.drawCalls);
+        metrics.scenePasses->Set(stats.scenePasses);
+        metrics.clustersTested->Set(stats.clustersTested);
+        metrics.clustersDrawn->Set(stats.clustersDrawn);
+        metrics.triangles->Set(static_cast<double>(stats.trianglesSubmitted));
+    }
+}
+
+void Application::StartMetrics()
+{
+    if (options.metricsPort <= 0)
+        return;
+
+    MetricsRegistry& registry = MetricsRegistry::Get();
+    metrics.frameSeconds = &registry.AddHistogram("celestial_frame_seconds", "Time to build, submit and present a frame.",
+        { 0.002, 0.004, 0.008, 0.0125, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25 });
+    metrics.stepSeconds = &registry.AddHistogram("celestial_simulation_step_seconds", "Time of one simulation step.",
+        { 1e-6, 4e-6, 1.6e-5, 6.4e-5, 2.56e-4, 1.024e-3, 4.096e-3 });
+    metrics.frames = &registry.AddCounter("celestial_frames", "Frames rendered.");
+    metrics.drawCallsTotal = &registry.AddCounter("celestial_draw_calls", "Draw calls issued.");
+    metrics.drawCalls = &registry.AddGauge("celestial_frame_draw_calls", "Draw calls in the last frame.");
+    metrics.scenePasses = &registry.AddGauge("celestial_frame_scene_passes", "Scene passes in the last frame.");
+    metrics.clustersTested = &registry.AddGauge("celestial_frame_clusters_tested", "Mesh clusters tested by culling in the last frame.");
+    metrics.clustersDrawn = &registry.AddGauge("celestial_frame_clusters_drawn", "Mesh clusters that survived culling in the last frame.");
+    metrics.triangles = &registry.AddGauge("celestial_frame_triangles", "Triangles submitted in the last frame.");
+    registry.AddCallback("celestial_textures_resident", "Textures on the GPU.",
+        [] { return static_cast<double>(GpuResourceRegistry::Get().GetCount(GpuResourceRegistry::Category::Texture)); });
+    registry.AddCallback("celestial_texture_resident_bytes", "Estimated GPU memory of loaded textures, mipmaps included.",
+        [] { return static_cast<double>(GpuResourceRegistry::Get().GetBytes(GpuResourceRegistry::Category::Texture)); });
+    registry.AddCallback("celestial_gpu_buffer_bytes", "GPU memory of vertex, index, storage and streaming buffers.",
+        [] { return static_cast<double>(GpuResourceRegistry::Get().GetBytes(GpuResourceRegistry::Category::Buffer)); });
+    registry.AddCallback("celestial_gpu_render_target_bytes", "GPU memory of framebuffer attachments and cached render targets.",
+        [] { return static_cast<double>(GpuResourceRegistry::Get().GetBytes(GpuResourceRegistry::Category::RenderTarget)); });
+    registry.AddCallback("celestial_gpu_available_bytes", "Free video memory reported by the driver (0 without NVX/ATI queries).",
+        [] { return static_cast<double>(GpuResourceRegistry::Get().GetDriverMemory().availableBytes); });
+
+    metricsServer = std::make_unique<MetricsServer>(static_cast<std::uint16_t>(options.metricsPort));
 }
 
 void Application::Run()
 {
-    float lastTime = static_cast<float>(glfwGetTime());
+    double lastTime = glfwGetTime();
 
     //Input::Initialize(window.GetNativeHandle());
-    renderer->Initialize();
 
+    // Dome master replaces the main camera's perspective output; faces match its density at the zenith
+    if (options.domeSize > 0)
+    {
+        DomeTarget::Settings domeSettings;
+        domeSettings.outputSize = options.domeSize;
+        domeSettings.faceSize = std::max(options.domeSize / 2, 1);
+        domeSettings.fieldOfView = options.domeFieldOfView;
+        domeTarget = std::make_unique<DomeTarget>(domeSettings);
+        cameraManager->SetDome("MainCamera", domeTarget.get());
+    }
+
+    StartCluster();
+    if (clusterNode)
+    {
+        RunClusterNode();
+        return;
+    }
+
+    if (options.headless)
+    {
+        RunHeadless();
+        return;
+    }
+
+    // Requests from other threads (e.g. finished loads) wake the blocked loop
+    framePacer.SetWakeFunction(&Window::Wake);
+    MainThreadQueue::Get().SetWakeFunction(&Window::Wake);
+
+    auto WindowState = [this]() {
+        if (window->IsMinimized())
+            return FramePacer::WindowState::Minimized;
+        return window->IsFocused() ? FramePacer::WindowState::Focused : FramePacer::WindowState::Unfocused;
+    };
 
     // --- 3. Main loop ---
     while (running && !window->ShouldClose())
     {
-        float currentTime = static_cast<float>(glfwGetTime());
-        float deltaTime = currentTime - lastTime;
+        // Poll when a frame is due, otherwise sleep until an event (or the throttle deadline)
+        double waitStart = glfwGetTime();
+        double timeout = framePacer.GetWaitTimeout(waitStart, WindowState());
+        if (timeout > 0.0)
+            window->WaitEvents(timeout);
+        else
+            window->PollEvents();
+
+        double currentTime = glfwGetTime();
+        double waited = timeout > 0.0 ? currentTime - waitStart : 0.0;
+        // After a long sleep a raw dt would teleport the camera, so its step is capped. The
+        // orbits are a function of time and take the full interval: simulation time keeps
+        // pace with real time across minimized and throttled stretches.
+        float elapsed = static_cast<float>(currentTime - lastTime);
+        float deltaTime = std::min(elapsed, MaxFrameDelta);
         lastTime = currentTime;
 
-        glfwPollEvents();
+        if (window->ConsumeDamage() || Input::ConsumeActivity())
+            framePacer.RequestFrame();
+
+        // GL-thread steps of asynchronous loads (uploads); new resources need a frame
+        if (MainThreadQueue::Get().RunPending() > 0)
+            framePacer.RequestFrame();
 
+        MemoryTracker::Get().BeginFrame();
         ProcessInput(deltaTime);
+        Update(elapsed);
+
+        // Animate while orbits advance or the camera is in motion (held keys send no events);
+        // a cluster master keeps its nodes fed every frame
+        framePacer.SetContinuous(!simulationPaused || cameraMoving || clusterMaster);
+
+        if (framePacer.BeginFrame(currentTime, WindowState(), waited))
+            Render();
+
+        // Work spread over several frames (sky refresh) keeps the loop drawing until done
+        if (renderer->HasPendingWork())
+            framePacer.RequestFrame();
+        MemoryTracker::Get().EndFrame();
+    }
+
+    // --- 4. Shutdown ---
+    if (clusterMaster)
+        clusterMaster->Shutdown();
+
+    const FramePacer::Stats& pacing = framePacer.GetStats();
+    std::cout << "[Application] Rendered " << pacing.framesRendered << " frames in " << pacing.iterations
+              << " loop iterations, idle " << pacing.idleSeconds << " s\n";
+    GpuResourceRegistry::Get().PrintReport();
+    std::cout << "[Application] Shutting down cleanly\n";
+}
+
+void Application::RunHeadless()
+{
+    // Fixed time step and no pacing: every iteration renders, timed until the GPU is done
+    const float deltaTime = 1.0f / 60.0f;
+    double firstFrameSeconds = 0.0;
+    double totalSeconds = 0.0;
+    double slowestSeconds = 0.0;
+    int frames = 0;
+
+    for (; frames < options.frameCount && running; ++frames)
+    {
+        window->PollEvents();
+        MainThreadQueue::Get().RunPending();
+        MemoryTracker::Get().BeginFrame();
         Update(deltaTime);
+
+        double start = glfwGetTime();
         Render();
+        glFinish();
+        double seconds = glfwGetTime() - start;
+        MemoryTracker::Get().EndFrame();
+
+        // The first frame also fills the sky cubemap and warms up the driver
+        if (frames == 0)
+        {
+            firstFrameSeconds = seconds;
+            continue;
+        }
+        totalSeconds += seconds;
+        slowestSeconds = std::max(slowestSeconds, seconds);
     }
 
-    // --- 4. Shutdown ---
+    double average = frames > 1 ? totalSeconds / (frames - 1) : firstFrameSeconds;
+    std::cout << "[Application] Headless: " << frames << " frames, first " << firstFrameSeconds * 1000.0
+              << " ms, then average " << average * 1000.0 << " ms (" << (average > 0.0 ? 1.0 / average : 0.0)
+              << " FPS), slowest " << slowestSeconds * 1000.0 << " ms\n";
+    GpuResourceRegistry::Get().PrintReport();
+
+    if (!options.capturePath.empty())
+    {
+        if (!domeTarget)
+            std::cerr << "[Application] --capture needs --dome, nothing written\n";
+        else if (!domeTarget->SaveImage(options.capturePath))
+            throw std::runtime_error("Failed to write " + options.capturePath);
+    }
+    if (clusterMaster)
+        clusterMaster->Shutdown();
+    std::cout << "[Application] Shutting down cleanly\n";
+}
+
+void Application::StartCluster()
+{
+    if (options.clusterNodes > 0)
+    {
+        clusterMaster = std::make_unique<ClusterMaster>(static_cast<std::uint16_t>(options.clusterPort), options.clusterNodes);
+    }
+    else if (!options.clusterHost.empty())
+    {
+        clusterNode = std::make_unique<ClusterNode>(options.clusterHost, static_cast<std::uint16_t>(options.clusterPort));
+
+        // This window shows one tile; the camera keeps the whole wall's aspect ratio
+        glm::ivec2 size = window->GetSize();
+        float wallAspect = (static_cast<float>(size.x) / options.tile.z) / (static_cast<float>(size.y) / options.tile.w);
+        cameraManager->GetActive().SetTile(options.tile, wallAspect);
+    }
+}
+
+void Application::RunClusterNode()
+{
+    // Paced by the master: each received frame is drawn once, then held at the swap barrier
+    while (running && !window->ShouldClose())
+    {
+        window->PollEvents();
+        if (Input::IsKeyPressed(GLFW_KEY_ESCAPE))
+            break;
+
+        if (!clusterNode->Receive(clusterFrame))
+            break;
+
+        frameIndex = clusterFrame.frameIndex;
+        simulationTime = clusterFrame.simulationTime;
+        cameraManager->GetActive().SetPose(clusterFrame.cameraPosition, clusterFrame.cameraYaw, clusterFrame.cameraPitch);
+        for (const ClusterTransform& replicated : clusterFrame.transforms)
+        {
+            if (replicated.id >= replicatedTransforms.size())
+                continue;
+            Transform& transform = *replicatedTransforms[replicated.id];
+            transform.SetPosition(replicated.position);
+            transform.SetRotation(replicated.rotation);
+            transform.SetScale(replicated.scale);
+        }
+
+        Render();
+    }
+
+    std::cout << "[Application] Render node stopped after frame " << frameIndex << "\n";
     std::cout << "[Application] Shutting down cleanly\n";
 }
@@ -12,11 +12,21 @@ Renderer, and (eventually) Scene and GameObjects.
 */
 #pragma once
 #define GLM_ENABLE_EXPERIMENTAL
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
 #include "Core/Window.h"
+#include "Core/FramePacer.h"
+#include "Core/ClusterSync.h"
+#include "Core/Metrics.h"
+#include "Core/InitGraph.h"
+#include "Core/Async.h"
+#include "Simulation/Simulation.h"
+#include "Simulation/SharedStateExport.h"
+#include "Simulation/StateClient.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/DomeTarget.h"
 #include "Renderer/Texture.h"
 #include "Core/Input.h"
 #include "Renderer/Mesh.h"
@@ -26,6 +36,45 @@ Renderer, and (eventually) Scene and GameObjects.
 #include "Scene/CameraController.h"
 #include <iostream>
 
+/**
+ * @struct LaunchOptions
+ * @brief Command-line switches, parsed in Main.cpp.
+ */
+struct LaunchOptions
+{
+    bool headless = false;          ///< Hidden window, fixed time step, exits after frameCount frames
+    int frameCount = 300;           ///< Frames rendered by a headless run
+    int domeSize = 0;               ///< Dome-master resolution for the main camera; 0 = perspective output
+    float domeFieldOfView = 180.0f; ///< Fisheye angle in degrees
+    std::string capturePath;        ///< Dome master written here when a headless run ends
+
+    int clusterNodes = 0;           ///< Cluster master: render nodes to wait for (0 = not a master)
+    std::string clusterHost;        ///< Cluster render node: master address (empty = not a node)
+    int clusterPort = 7600;
+    glm::vec4 tile = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f); ///< This display's part of the wall (x, y, width, height in [0, 1])
+
+    std::string exportName;         ///< Shared-memory segment for external readers (empty = no export)
+
+    bool serveState = false;        ///< Run as a windowless simulation server for viewer processes
+    std::string stateHost;          ///< Viewer: simulation server address (empty = simulate locally)
+    int statePort = 7700;
+    float viewRate = 30.0f;         ///< Viewer: snapshots per second requested from the server
+    float interestRadius = 100.0f;  ///< Viewer: bodies farther than this from the camera are not sent
+
+    int metricsPort = 0;            ///< Serve Prometheus metrics on this loopback port (0 = off)
+
+    std::string profilePath;        ///< Chrome trace of the profiling scopes, written when the app exits (empty = off)
+    bool perfCounters = false;      ///< Profiling scopes also read hardware counters (Linux perf_event_open)
+
+    std::string memoryReport;       ///< Per-subsystem memory report (JSON), written when the app exits (empty = off)
+    bool memoryDebug = false;       ///< Log allocations made in the frame loop once it has warmed up
+
+    bool threadAffinity = true;     ///< Pin the workers along the CPU topology and the main thread to a performance core
+    int jobScalingBodies = 0;       ///< Run the worker scaling benchmark on this many N-body bodies and exit (0 = off)
+    std::string isa;                ///< Cap the SIMD kernels at this level: scalar, sse4, avx2 or avx512 (empty = best supported)
+    std::string modelPath;          ///< glTF/GLB model imported at startup and drawn with the bodies (empty = none)
+};
+
 /**
  * @class Application
  * @brief Manages engine lifecycle and main execution loop.
@@ -43,18 +92,67 @@ private:
     std::unique_ptr<CameraManager> cameraManager; ///< Stores and switches between cameras
     std::unique_ptr<CameraController> cameraController; ///< Controls the active camera (owned externally)
     std::vector<std::shared_ptr<Texture>> loadedTexture; ///< Keeps the loaded texture in memory for entire application life cycle
+    std::unique_ptr<DomeTarget> domeTarget; ///< Fisheye output of the main camera (dome mode only)
+    LaunchOptions options;
+
+    // Cluster mode: the master replicates these transforms (index = id) and the camera to the nodes
+    std::unique_ptr<ClusterMaster> clusterMaster;
+    std::unique_ptr<ClusterNode> clusterNode;
+    std::vector<Transform*> replicatedTransforms;
+    ClusterFrame clusterFrame;      ///< Reused: built by the master, received by a node
+    std::uint64_t frameIndex = 0;
+    double simulationTime = 0.0;    ///< Seconds of simulated (unpaused) time
+
+    Simulation simulation;          ///< Body state; sun, earth and moon are bodies 0, 1 and 2
+    std::unique_ptr<SharedStateExport> stateExport; ///< Publishes the body state (--export-state only)
+    std::unique_ptr<StateClient> stateClient;       ///< Viewer mode: body state streamed from a server
+
+    // Live metrics (--metrics-port only): updated here, formatted on the server's thread
+    struct FrameMetrics
+    {
+        MetricHistogram* frameSeconds = nullptr;
+        MetricHistogram* stepSeconds = nullptr;
+        MetricCounter* frames = nullptr;
+        MetricCounter* drawCallsTotal = nullptr;
+        MetricGauge* drawCalls = nullptr;
+        MetricGauge* scenePasses = nullptr;
+        MetricGauge* clustersTested = nullptr;
+        MetricGauge* clustersDrawn = nullptr;
+        MetricGauge* triangles = nullptr;
+    };
+    std::unique_ptr<MetricsServer> metricsServer;
+    FrameMetrics metrics;
     
     // Planet objects
     RenderObject sun;
     RenderObject earth;
     RenderObject moon;
+    std::vector<RenderObject> modelParts; ///< Parts of the --model import, placed above the sun
+
+    FramePacer framePacer;  ///< Renders only when something changed, throttles in the background
 
     bool running = true;    ///< Loop condition
+    bool simulationPaused = false;  ///< Orbits frozen (toggled with P)
+    bool pauseKeyWasDown = false;   ///< Edge detection for the pause key
+    bool stereoEnabled = false;     ///< Main camera in side-by-side stereo (toggled with V)
+    bool stereoKeyWasDown = false;  ///< Edge detection for the stereo key
+    bool cameraMoving = false;      ///< Camera changed during the last update
+
+    static constexpr float MaxFrameDelta = 0.1f;   ///< Caps the camera's dt after the loop slept
+
+    std::chrono::steady_clock::time_point startupBegin; ///< Origin of the startup timeline
+    bool firstFrameShown = false;   ///< Time to first frame already logged
 
-    void InitScene();
+    Task<void> LoadSceneAssets();   ///< Meshes, textures and materials of the bodies
+    void InitScene(InitGraph& startup, Task<void>& assetLoad); ///< Declares the scene's startup tasks
     void ProcessInput(float dt); ///< Handle global input
     void Update(float dt);
+    void SyncTransforms(); ///< Copies body positions and spins from the simulation or the server
     void Render();       
+    void RunHeadless();  ///< Fixed-step loop for CI: renders options.frameCount frames and reports timing
+    void RunClusterNode(); ///< Render-node loop: draws each frame received from the master
+    void StartCluster();   ///< Connects master and nodes as requested by the options
+    void StartMetrics();   ///< Registers the engine metrics and starts serving them
 
 public:
     /**
@@ -62,8 +160,9 @@ public:
      * @param width Window width in pixels.
      * @param height Window height in pixels.
      * @param title Title for the window.
+     * @param options Headless and dome-master switches.
      */
-    Application(int width, int height, const std::string& title);
+    Application(int width, int height, const std::string& title, const LaunchOptions& options = LaunchOptions());
     ~Application();
 
     /// Runs the main application loop (blocking until exit).
@@ -0,0 +1,245 @@
+/**
+ * @file Async.h
+ * @brief C++20 coroutine tasks that hop between the JobSystem workers and the GL thread.
+ *
+ * A Task<T> starts running as soon as it is called and runs until its first
+ * suspension, so several loads started one after the other proceed
+ * concurrently; co_await on a task then suspends the caller until the
+ * result is there, without blocking a thread. Inside a task:
+ *
+ * @code
+ * co_await ResumeOnWorker{};      // continue on a JobSystem worker (no GL calls)
+ * co_await ResumeOnMainThread{};  // continue on the GL thread, at its next MainThreadQueue drain
+ * @endcode
+ *
+ * The GL thread drains MainThreadQueue once per frame, or blocks in
+ * SyncWait() during startup. A Task destroyed before it has finished is
+ * detached: its frame frees itself when the coroutine completes.
+ */
+#pragma once
+#include <Core/JobSystem.h>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * @class MainThreadQueue
+ * @brief Coroutines waiting to be resumed on the thread that owns the GL context.
+ */
+class MainThreadQueue
+{
+public:
+	using WakeFunction = void(*)();
+
+private:
+	std::mutex mutex;
+	std::condition_variable posted;
+	std::vector<std::coroutine_handle<>> pending;
+	std::atomic<WakeFunction> wake{ nullptr };
+
+public:
+	static MainThreadQueue& Get();
+
+	/// Called by Post() so a main loop blocked in the OS event queue notices new work.
+	void SetWakeFunction(WakeFunction function) { wake.store(function, std::memory_order_release); }
+
+	/// Queues a coroutine for the GL thread. Thread-safe.
+	void Post(std::coroutine_handle<> handle);
+
+	/// Resumes everything posted so far (GL thread). @return Coroutines resumed.
+	size_t RunPending();
+
+	/// Resumes posted coroutines as they arrive until done() is true (GL thread, blocking).
+	void RunUntil(const std::function<bool()>& done);
+};
+
+/// Awaitable: continues the coroutine on a JobSystem worker.
+struct ResumeOnWorker
+{
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> handle) const { JobSystem::Get().Submit([handle] { handle.resume(); }); }
+	void await_resume() const noexcept {}
+};
+
+/// Awaitable: continues the coroutine on the GL thread.
+struct ResumeOnMainThread
+{
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> handle) const { MainThreadQueue::Get().Post(handle); }
+	void await_resume() const noexcept {}
+};
+
+namespace AsyncDetail
+{
+	// Promise state: nullptr while running, the awaiting coroutine's address, or one of these markers
+	inline char DoneMarker;
+	inline char DetachedMarker;
+
+	struct PromiseBase
+	{
+		std::atomic<void*> state{ nullptr };
+		std::exception_ptr error;
+
+		struct FinalAwaiter
+		{
+			bool await_ready() const noexcept { return false; }
+
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+			{
+				void* previous = handle.promise().state.exchange(&DoneMarker, std::memory_order_acq_rel);
+				if (previous == &DetachedMarker)
+				{
+					// Nobody will read the result
+					handle.destroy();
+					return std::noop_coroutine();
+				}
+				if (previous)
+					return std::coroutine_handle<>::from_address(previous);
+				return std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept {}
+		};
+
+		std::suspend_never initial_suspend() const noexcept { return {}; }
+		FinalAwaiter final_suspend() const noexcept { return {}; }
+		void unhandled_exception() noexcept { error = std::current_exception(); }
+
+		void Rethrow() const
+		{
+			if (error)
+				std::rethrow_exception(error);
+		}
+	};
+
+	template<typename T>
+	struct TaskPromise : PromiseBase
+	{
+		std::optional<T> value;
+
+		template<typename U>
+		void return_value(U&& result) { value.emplace(std::forward<U>(result)); }
+
+		T TakeResult()
+		{
+			Rethrow();
+			return std::move(*value);
+		}
+	};
+
+	template<>
+	struct TaskPromise<void> : PromiseBase
+	{
+		void return_void() const noexcept {}
+		void TakeResult() const { Rethrow(); }
+	};
+}
+
+/**
+ * @class Task
+ * @brief Eagerly started coroutine producing a T; awaited at most once.
+ *
+ * Exceptions thrown inside the task are rethrown from co_await (or SyncWait).
+ */
+template<typename T = void>
+class Task
+{
+public:
+	struct promise_type : AsyncDetail::TaskPromise<T>
+	{
+		Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+	};
+
+private:
+	std::coroutine_handle<promise_type> handle;
+
+	explicit Task(std::coroutine_handle<promise_type> coroutine) : handle(coroutine) {}
+
+public:
+	Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+	Task& operator=(Task&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			handle = std::exchange(other.handle, nullptr);
+		}
+		return *this;
+	}
+
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	~Task() { Release(); }
+
+	/// True once the coroutine has returned or thrown.
+	bool IsReady() const noexcept { return handle.promise().state.load(std::memory_order_acquire) == &AsyncDetail::DoneMarker; }
+
+	/// Result of a finished task; rethrows its exception.
+	T Result() { return handle.promise().TakeResult(); }
+
+	bool await_ready() const noexcept { return IsReady(); }
+
+	bool await_suspend(std::coroutine_handle<> awaiting) const noexcept
+	{
+		// Fails when the task finished in between: the awaiting coroutine then simply continues
+		void* expected = nullptr;
+		return handle.promise().state.compare_exchange_strong(expected, awaiting.address(),
+			std::memory_order_acq_rel, std::memory_order_acquire);
+	}
+
+	T await_resume() { return Result(); }
+
+private:
+	void Release()
+	{
+		if (!handle)
+			return;
+		void* previous = handle.promise().state.exchange(&AsyncDetail::DetachedMarker, std::memory_order_acq_rel);
+		if (previous == &AsyncDetail::DoneMarker)
+			handle.destroy();
+		handle = nullptr;	// Still running: FinalAwaiter destroys the frame
+	}
+};
+
+namespace AsyncDetail
+{
+	// Waits for the task without taking its result, then signals from the GL thread
+	template<typename T>
+	struct ReadyAwaiter
+	{
+		Task<T>& task;
+		bool await_ready() const noexcept { return task.await_ready(); }
+		bool await_suspend(std::coroutine_handle<> awaiting) const noexcept { return task.await_suspend(awaiting); }
+		void await_resume() const noexcept {}
+	};
+
+	template<typename T>
+	Task<void> SignalOnMainThread(Task<T>& task, bool& finished)
+	{
+		co_await ReadyAwaiter<T>{ task };
+		co_await ResumeOnMainThread{};
+		finished = true;
+	}
+}
+
+/**
+ * @brief Blocks the GL thread until the task has finished, resuming its GL-thread steps meanwhile.
+ *
+ * For code outside a coroutine (startup, tools). Must not be called from a worker.
+ */
+template<typename T>
+T SyncWait(Task<T>& task)
+{
+	bool finished = false;
+	Task<void> signal = AsyncDetail::SignalOnMainThread(task, finished);
+	MainThreadQueue::Get().RunUntil([&finished] { return finished; });
+	return task.Result();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file ClusterSync.h
+ * @brief Frame-locked state replication from a master process to render nodes.
+ *
+ * The master runs the simulation. Every frame it sends each node one Frame
+ * message: frame index, simulation time, camera pose and only the transforms
+ * that changed since the previous frame. A node applies it, draws its own
+ * tile of the display wall, then reports Ready. Once every node has reported,
+ * the master sends Swap and all processes present the same frame together
+ * (the swap barrier).
+ *
+ * Links are TCP: the barrier needs reliable, ordered delivery anyway, and the
+ * messages are a few hundred bytes. All processes run the same build, so
+ * records travel in native byte order.
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <Core/Socket.h>
+
+/// One replicated transform; id is the object's index in the application's replicated list.
+struct ClusterTransform
+{
+	std::uint32_t id;
+	glm::vec3 position;
+	glm::quat rotation;
+	glm::vec3 scale;
+};
+
+/// State of one frame, as sent by the master.
+struct ClusterFrame
+{
+	std::uint64_t frameIndex = 0;
+	double simulationTime = 0.0;
+	glm::vec3 cameraPosition = glm::vec3(0.0f);
+	float cameraYaw = 0.0f;
+	float cameraPitch = 0.0f;
+	std::vector<ClusterTransform> transforms;	///< Master: all objects; nodes receive the changed ones
+};
+
+/**
+ * @class ClusterMaster
+ * @brief Accepts the render nodes, broadcasts frame deltas and runs the swap barrier.
+ */
+class ClusterMaster
+{
+public:
+	struct Stats
+	{
+		std::uint64_t framesSent = 0;
+		size_t bytesSent = 0;				///< Frame payloads over all nodes
+		size_t transformsSent = 0;			///< Changed transforms, counted once per frame
+		double lastBarrierSeconds = 0.0;	///< Master time spent waiting for the slowest node
+		double maxBarrierSeconds = 0.0;
+	};
+
+private:
+	TcpSocket listener;
+	std::vector<TcpSocket> nodes;
+	std::vector<ClusterTransform> lastSent;	///< Indexed by id; what every node currently holds
+	std::vector<bool> hasSent;
+	std::vector<unsigned char> sendBuffer;	///< Reused message buffer
+	double barrierTimeoutSeconds;
+	Stats stats;
+
+	void DropNode(size_t index, const char* reason);
+
+public:
+	/**
+	 * @brief Waits for nodeCount render nodes to connect; throws if they do not all arrive in time.
+	 * @param barrierTimeoutSeconds A node that has not reported Ready this long into a swap barrier is dropped.
+	 */
+	ClusterMaster(std::uint16_t port, int nodeCount, double connectTimeoutSeconds = 30.0, double barrierTimeoutSeconds = 10.0);
+	~ClusterMaster();
+
+	ClusterMaster(const ClusterMaster&) = delete;
+	ClusterMaster& operator=(const ClusterMaster&) = delete;
+
+	/// Sends the frame; transforms identical to what the nodes already hold are left out.
+	void Broadcast(const ClusterFrame& frame);
+
+	/**
+	 * @brief Waits until every node has drawn frameIndex, then releases them all.
+	 * Nodes that disconnected or stalled past the barrier timeout are dropped so the rest keep running.
+	 */
+	void SwapBarrier(std::uint64_t frameIndex);
+
+	/// Tells the nodes to exit. Called by the destructor if not done before.
+	void Shutdown();
+
+	size_t GetNodeCount() const { return nodes.size(); }
+	const Stats& GetStats() const { return stats; }
+};
+
+/**
+ * @class ClusterNode
+ * @brief Receives frames from the master and takes part in the swap barrier.
+ */
+class ClusterNode
+{
+private:
+	TcpSocket connection;
+	std::vector<unsigned char> receiveBuffer;
+
+public:
+	/// Connects to the master, retrying until the timeout; throws if it cannot.
+	ClusterNode(const std::string& host, std::uint16_t port, double connectTimeoutSeconds = 30.0);
+
+	/**
+	 * @brief Blocks until the next frame arrives.
+	 * @return False when the master shut down or the connection was lost.
+	 */
+	bool Receive(ClusterFrame& frame);
+
+	/// Reports frameIndex as drawn and blocks until the master releases it. @return False if disconnected.
+	bool SwapBarrier(std::uint64_t frameIndex);
+};
@@ -0,0 +1,79 @@
+/**
+ * @file CpuFeatures.h
+ * @brief Instruction set detection (cpuid) and the level SIMD kernels dispatch on.
+ *
+ * One binary runs on everything from SSE4 machines to AVX-512 workstations:
+ * hot kernels are compiled once per instruction set level (see
+ * CELESTIAL_TARGET) and the best level the CPU and OS support is picked at
+ * startup. The level can be forced lower for testing, with --isa NAME or
+ * the CELESTIAL_ISA environment variable (scalar, sse4, avx2, avx512).
+ *
+ * Only the N-body force sum has per-level variants so far. The other
+ * candidates stay scalar:
+ *  - Transform composition is cached per object behind a dirty flag, so it
+ *    runs only for objects that moved. The records sit interleaved inside
+ *    RenderObject; gathering them into lanes costs more than the ~50 flops
+ *    per matrix.
+ *  - Mesh::GenerateSphere runs once per mesh on a worker, overlapped with
+ *    context creation. Its time goes to libm sin/cos.
+ *  - Cluster culling (Frustum::IntersectsSphere and the normal-cone test in
+ *    Renderer::CullObject) measured ~14 ns per cluster, ~45 us a frame for
+ *    the three 360x180 spheres. MeshCluster is AoS and kept clusters are
+ *    merged into indirect commands in order. A wide kernel would need a
+ *    transpose per batch to save a few tens of microseconds.
+ *  - There is no Kepler solver: orbits are circular and evaluated in closed
+ *    form (Simulation::Evaluate).
+ *  - There is no CPU mip filtering: Texture::Upload calls glGenerateMipmap.
+ */
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define CELESTIAL_X86 1
+#endif
+
+// Lets one function use instructions above the file's baseline (GCC/Clang; MSVC allows intrinsics anywhere)
+#if defined(CELESTIAL_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CELESTIAL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CELESTIAL_TARGET(isa)
+#endif
+
+enum class IsaLevel
+{
+	Scalar,		///< Portable C++
+	Sse4,		///< SSE4.2 (and POPCNT)
+	Avx2,		///< AVX2 with FMA3
+	Avx512,		///< AVX-512 F, DQ, BW and VL
+	Count
+};
+
+class CpuFeatures
+{
+private:
+	IsaLevel supported = IsaLevel::Scalar;
+	IsaLevel active = IsaLevel::Scalar;
+	bool forced = false;
+
+	CpuFeatures();
+
+public:
+	/// Detected once; honours CELESTIAL_ISA.
+	static CpuFeatures& Get();
+
+	/// Highest level both the CPU and the OS (saved register state) support.
+	IsaLevel GetSupported() const { return supported; }
+
+	/// Level the kernels use: the supported one unless forced lower.
+	IsaLevel GetActive() const { return active; }
+
+	/// Caps the active level for testing; levels above GetSupported() are clamped with a warning.
+	void Force(IsaLevel level);
+
+	/// Logs the supported and active levels.
+	void Print() const;
+
+	static const char* GetName(IsaLevel level);
+
+	/// "scalar", "sse4", "avx2" or "avx512". @return False for unknown names.
+	static bool Parse(const char* name, IsaLevel& level);
+};
@@ -0,0 +1,70 @@
+/**
+ * @file CpuTopology.h
+ * @brief Logical processors with their physical core, L3 cache domain and core type.
+ *
+ * Detected once from the OS (GetLogicalProcessorInformationEx on Windows,
+ * sysfs on Linux; one core per hardware thread elsewhere). Used to place
+ * the JobSystem workers and to keep the main (render and simulation)
+ * thread on a performance core of hybrid CPUs.
+ */
+#pragma once
+#include <vector>
+
+class CpuTopology
+{
+public:
+	struct LogicalProcessor
+	{
+		unsigned int id = 0;				///< OS processor number (Windows: group * 64 + index)
+		unsigned int core = 0;				///< Physical core, dense from 0
+		unsigned int l3Domain = 0;			///< Processors sharing one L3 cache, dense from 0
+		unsigned int efficiencyClass = 0;	///< 0 = slowest core type; equal for all cores of non-hybrid CPUs
+		unsigned int smtIndex = 0;			///< 0 for the first hardware thread of its core
+	};
+
+private:
+	std::vector<LogicalProcessor> processors;	///< Sorted by id
+	unsigned int coreCount = 0;
+	unsigned int l3DomainCount = 0;
+	unsigned int topEfficiencyClass = 0;
+	unsigned int reservedCore = 0;	///< Performance core kept for the main thread
+
+public:
+	/**
+	 * @brief Builds the topology from raw processor records.
+	 *
+	 * core, l3Domain and efficiencyClass may be arbitrary keys (e.g. OS ids);
+	 * they are renumbered densely, and smtIndex is recomputed.
+	 */
+	explicit CpuTopology(std::vector<LogicalProcessor> processors);
+
+	/// Topology of this machine, detected on first use.
+	static const CpuTopology& Get();
+
+	static CpuTopology Detect();
+
+	const std::vector<LogicalProcessor>& GetProcessors() const { return processors; }
+	unsigned int GetCoreCount() const { return coreCount; }
+	unsigned int GetL3DomainCount() const { return l3DomainCount; }
+	bool IsHybrid() const { return topEfficiencyClass > 0; }
+	bool IsPerformanceCore(const LogicalProcessor& processor) const { return processor.efficiencyClass == topEfficiencyClass; }
+
+	/// Hardware threads of the performance core reserved for the main thread.
+	std::vector<unsigned int> GetMainThreadProcessors() const;
+
+	/**
+	 * @brief Processors in the order workers should be placed on them.
+	 *
+	 * First one thread per performance core, then one per efficiency core,
+	 * then the remaining SMT siblings, and the main thread's core last.
+	 * Within each group processors are ordered by L3 domain, so consecutive
+	 * workers share a cache.
+	 */
+	std::vector<LogicalProcessor> GetWorkerOrder() const;
+
+	/// Logs cores, hardware threads, L3 domains and core types.
+	void Print() const;
+
+	/// Restricts the calling thread to the given processors. @return False if the OS refused (or is unsupported).
+	static bool PinCurrentThread(const std::vector<unsigned int>& processorIds);
+};
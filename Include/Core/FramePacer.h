@@ -0,0 +1,77 @@
+/**
+ * @file FramePacer.h
+ * @brief Decides when the main loop renders and how long it may sleep.
+ *
+ * A frame is drawn only when something visible changed:
+ *  - continuous mode is on (simulation running, camera moving), or
+ *  - a frame was requested (input, window damage, a resource finished loading).
+ * Otherwise the loop blocks in Window::WaitEvents() until the next event.
+ *
+ * Unfocused windows are capped to a low frame rate and minimized windows
+ * never render; the loop only wakes periodically so simulation time keeps
+ * advancing. No GLFW calls: the caller owns event waiting.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+class FramePacer
+{
+public:
+	enum class WindowState { Focused, Unfocused, Minimized };
+
+	struct Settings
+	{
+		bool onDemand = true;				///< False renders every iteration (legacy behaviour)
+		double unfocusedFrameRate = 10.0;	///< Frame cap while unfocused, 0 disables the cap
+		double minimizedWakeInterval = 0.25;	///< Seconds between wake-ups while minimized
+		double idleWakeInterval = 1.0;		///< Longest single block while idle
+	};
+
+	struct Stats
+	{
+		size_t iterations = 0;		///< Main loop iterations
+		size_t framesRendered = 0;
+		double idleSeconds = 0.0;	///< Time spent blocked waiting for events
+	};
+
+	using WakeFunction = void(*)();
+
+private:
+	Settings settings;
+	Stats stats;
+	std::atomic<bool> frameRequested{ true };	///< First frame is always drawn
+	bool continuous = false;
+	double lastFrameTime = -1.0e9;
+	WakeFunction wake = nullptr;
+
+	bool WantsFrame() const { return !settings.onDemand || continuous || frameRequested.load(std::memory_order_acquire); }
+
+public:
+	void SetSettings(const Settings& newSettings) { settings = newSettings; }
+	const Settings& GetSettings() const { return settings; }
+
+	/// Called by RequestFrame() so a blocked loop notices requests from other threads.
+	void SetWakeFunction(WakeFunction function) { wake = function; }
+
+	/// Asks for one more frame. Thread-safe; wakes the loop if it is blocked.
+	void RequestFrame();
+
+	/// Keeps rendering every iteration while true (animation, held keys).
+	void SetContinuous(bool enabled) { continuous = enabled; }
+	bool IsContinuous() const { return continuous; }
+
+	/**
+	 * @brief How long the loop may block before its next iteration.
+	 * @return 0 to poll without blocking, otherwise a timeout in seconds.
+	 */
+	double GetWaitTimeout(double now, WindowState state) const;
+
+	/**
+	 * @brief Decides whether to render this iteration and consumes the request if so.
+	 * @param waitedSeconds Time the loop just spent blocked (for the stats).
+	 */
+	bool BeginFrame(double now, WindowState state, double waitedSeconds);
+
+	const Stats& GetStats() const { return stats; }
+};
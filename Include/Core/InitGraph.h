@@ -0,0 +1,86 @@
+/**
+ * @file InitGraph.h
+ * @brief Startup work as named tasks with dependencies, run concurrently and recorded as a timeline.
+ *
+ * Each task either needs the main thread (window, GL context, anything that
+ * issues GL calls) or may run on a JobSystem worker (file decoding, mesh
+ * generation, simulation setup). Run() starts every task as soon as its
+ * dependencies have finished: worker tasks are queued on the JobSystem,
+ * main-thread tasks run on the calling thread in between. CPU work with no
+ * GL dependency therefore overlaps window and context creation.
+ *
+ * Every task's start and end are recorded relative to a caller-chosen
+ * origin (usually process startup), and PrintTimeline() reports them with
+ * the achieved overlap and the critical path.
+ */
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+class InitGraph
+{
+public:
+	enum class Affinity
+	{
+		MainThread,		///< Runs on the thread calling Run() (GL context owner)
+		Worker			///< Runs on a JobSystem worker; must not touch GL
+	};
+
+	struct TaskRecord
+	{
+		const char* name;
+		Affinity affinity;
+		double start;	///< Seconds since the origin
+		double end;
+	};
+
+private:
+	struct Task
+	{
+		const char* name;
+		Affinity affinity;
+		std::function<void()> work;
+		std::vector<std::string> dependencies;
+		std::vector<size_t> dependents;
+		size_t pendingDependencies = 0;
+		double start = 0.0;
+		double end = 0.0;
+		size_t criticalPredecessor = static_cast<size_t>(-1);	///< Dependency that finished last
+	};
+
+	std::chrono::steady_clock::time_point origin;
+	std::vector<Task> tasks;
+	double runStart = 0.0;
+	double runEnd = 0.0;
+	bool finished = false;
+
+	double Now() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - origin).count(); }
+	void Link();
+
+public:
+	/// @param origin Time zero of the timeline (e.g. the start of main()).
+	explicit InitGraph(std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now());
+
+	/**
+	 * @brief Declares a task; dependencies may be declared before or after it.
+	 * @param name String literal, unique in the graph (also used as a profiler scope).
+	 */
+	void Add(const char* name, Affinity affinity, std::function<void()> work, std::vector<std::string> dependencies = {});
+
+	/**
+	 * @brief Runs every task once, respecting dependencies; blocks until all are done.
+	 *
+	 * Throws std::runtime_error for unknown dependencies or cycles. If a task
+	 * throws, no further tasks are started and the first exception is rethrown
+	 * once the tasks already running have finished.
+	 */
+	void Run();
+
+	/// Tasks in start order (valid after Run()).
+	std::vector<TaskRecord> GetTimeline() const;
+
+	/// Logs each task's start and duration, the overlap achieved and the critical path.
+	void PrintTimeline() const;
+};
@@ -32,6 +32,7 @@ private:
 	static std::unordered_map<int, bool> keyStates;	///< Map of key → pressed/released
 	static glm::dvec2 mousePos;	///< Current mouse position in window coords
 	static glm::dvec2 mouseDelta; ///< Change in mouse position since last frame
+	static bool activity;	///< Set by any key or cursor event, cleared by ConsumeActivity()
 
 public:
 	/**
@@ -53,6 +54,9 @@ public:
 	/// @return Mouse movement delta since last frame.
 	static glm::dvec2 GetMouseDelta();
 
+	/// @return True if any key or cursor event arrived since the last call.
+	static bool ConsumeActivity();
+
 	// ---------- GLFW Callback Hooks ----------
 
 	/**
@@ -0,0 +1,93 @@
+/**
+@file JobSystem.h
+@brief Small pool of worker threads for CPU-side parallel work.
+
+Used for work that splits into independent items (e.g. converting the
+primitives of an imported model). Jobs must not touch the GL context; only
+the main thread owns it.
+
+Workers can be pinned along the CpuTopology: one per performance core
+first, grouped by L3 cache domain. Each domain has its own queue, which
+its workers serve before the shared queue and before stealing from other
+domains, so related jobs submitted to one domain share a cache.
+*/
+#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class JobSystem
+ * @brief FIFO job queues drained by a fixed set of worker threads.
+ */
+class JobSystem
+{
+private:
+	std::vector<std::thread> workers;
+	std::vector<unsigned int> workerDomains;	///< L3 domain of each worker (all 0 when not pinned)
+	std::vector<unsigned int> domainWorkers;	///< Workers per domain
+	std::deque<std::function<void()>> queue;	///< Any worker
+	std::vector<std::deque<std::function<void()>>> domainQueues;	///< Workers of one domain first
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	bool stopping = false;
+	bool pinned = false;						///< Pinning requested (and more than one hardware thread)
+	std::vector<char> workerPinned;				///< Result of each worker's pin attempt
+	unsigned int pinsReported = 0;
+	std::condition_variable pinReported;
+
+	static JobSystem* instance;
+
+	void WorkerLoop(unsigned int index, unsigned int processorId);
+
+	/// Own domain, then shared, then other domains. Called with the lock held.
+	bool PopJob(unsigned int domain, std::function<void()>& job);
+
+public:
+	/**
+	 * @param threadCount Number of workers; 0 = one less than the hardware threads (at least 1).
+	 * @param pinWorkers Pins each worker to one hardware thread in CpuTopology::GetWorkerOrder().
+	 */
+	explicit JobSystem(unsigned int threadCount = 0, bool pinWorkers = true);
+
+	/// Finishes the queued jobs, then joins the workers.
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// @return The engine-wide job system, created on first use.
+	static JobSystem& Get();
+
+	/// Replaces the engine-wide job system (after finishing its jobs). Call from the main thread.
+	static void Configure(unsigned int threadCount, bool pinWorkers);
+
+	/// Joins the engine-wide workers. Call before exit.
+	static void Shutdown();
+
+	/// Queues a job for any worker (fire and forget).
+	void Submit(std::function<void()> job);
+
+	/// Queues a job preferably run by a worker of the given L3 domain.
+	void SubmitToDomain(unsigned int domain, std::function<void()> job);
+
+	/**
+	* @brief Runs body(i) for i in [0, count) on the workers and the calling thread.
+	*
+	* Blocks until every item has finished. Items are handed out one at a time,
+	* so uneven item costs balance out. With several L3 domains the range is
+	* split into one contiguous block per domain (neighbouring items usually
+	* touch neighbouring data); a domain that runs dry steals from the others.
+	* The first exception thrown by an item is rethrown here after all items are done.
+	*/
+	void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+	unsigned int GetWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+	unsigned int GetDomainCount() const { return static_cast<unsigned int>(domainQueues.size()); }
+	/// True if every worker was actually pinned.
+	bool IsPinned() const { return pinned && std::count(workerPinned.begin(), workerPinned.end(), 1) == static_cast<std::ptrdiff_t>(workers.size()); }
+};
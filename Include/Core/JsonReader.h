@@ -0,0 +1,50 @@
+/**
+@file JsonReader.h
+@brief Streaming (SAX) JSON parser.
+
+The reader walks the text once and reports every token to a JsonHandler;
+no document tree is built. Strings without escapes are passed as views into
+the source text, so parsing allocates only for escaped strings.
+*/
+#pragma once
+#include <string>
+#include <string_view>
+
+/**
+ * @class JsonHandler
+ * @brief Receives parse events. Returning false from any event aborts parsing.
+ *
+ * String views are only valid for the duration of the call.
+ */
+class JsonHandler
+{
+public:
+	virtual ~JsonHandler() = default;
+
+	virtual bool StartObject() = 0;
+	virtual bool EndObject() = 0;
+	virtual bool StartArray() = 0;
+	virtual bool EndArray() = 0;
+	virtual bool Key(std::string_view key) = 0;
+	virtual bool String(std::string_view value) = 0;
+	virtual bool Number(double value) = 0;
+	virtual bool Bool(bool value) = 0;
+	virtual bool Null() = 0;
+};
+
+/**
+ * @class JsonReader
+ * @brief Parses RFC 8259 JSON text into JsonHandler events.
+ */
+class JsonReader
+{
+public:
+	static constexpr int MaxDepth = 256;	///< Nesting limit (guards the recursion)
+
+	/**
+	* @brief Parses `text` completely.
+	* @param error Receives a message with the byte offset on failure (optional).
+	* @return True if the text is valid JSON and the handler accepted every event.
+	*/
+	static bool Parse(std::string_view text, JsonHandler& handler, std::string* error = nullptr);
+};
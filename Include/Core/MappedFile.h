@@ -0,0 +1,51 @@
+/**
+@file MappedFile.h
+@brief Read-only memory mapping of a whole file.
+
+Large binary assets (GLB buffers, cooked meshes) are read straight from the
+page cache instead of being copied into a heap buffer first. Parsers work on
+the returned pointer directly; the mapping lives as long as the object.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Owns a read-only view of a file (CreateFileMapping on Windows, mmap elsewhere).
+ */
+class MappedFile
+{
+private:
+	const uint8_t* data_ = nullptr;	///< Start of the mapped view
+	size_t size_ = 0;				///< File size in bytes
+#ifdef _WIN32
+	void* file_ = nullptr;			///< HANDLE of the open file
+	void* mapping_ = nullptr;		///< HANDLE of the file mapping object
+#else
+	int fd_ = -1;
+#endif
+
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	/**
+	* @brief Maps the file at `path`, replacing any previous mapping.
+	* @return True on success; failures are logged. Empty files map to a null view.
+	*/
+	bool Open(const std::string& path);
+
+	/// Unmaps the file (pointers obtained from GetData() become invalid).
+	void Close();
+
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+	bool IsOpen() const { return data_ != nullptr; }
+};
@@ -0,0 +1,193 @@
+/**
+ * @file MemoryTracker.h
+ * @brief Heap accounting per subsystem tag: live bytes, peaks, counts and per-frame allocations.
+ *
+ * Memory is attributed to a MemoryTag in two ways:
+ *  - Containers declared with TrackedAllocator (e.g. TrackedVector) always
+ *    record under their tag, whatever thread allocates.
+ *  - Builds with CELESTIAL_TRACK_ALLOCATIONS defined also replace the global
+ *    operator new/delete; those allocations go to the calling thread's
+ *    current tag, set with MemoryTagScope (General otherwise).
+ *
+ * Each block carries a small header with its size and tag, so frees are
+ * charged back to the tag that allocated them. The frame loop brackets
+ * every iteration with BeginFrame()/EndFrame(); in debug mode, frames past
+ * the warm-up are expected to allocate nothing and any allocation is
+ * reported with its size and tag. WriteReport() exports everything as JSON.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+enum class MemoryTag : std::uint8_t
+{
+	General,
+	Mesh,
+	Texture,
+	Shader,
+	Scene,
+	Renderer,
+	Simulation,
+	Network,
+	Count
+};
+
+class MemoryTracker
+{
+public:
+	/// Snapshot of one tag's counters.
+	struct TagStats
+	{
+		std::int64_t currentBytes = 0;
+		std::int64_t peakBytes = 0;
+		std::int64_t liveAllocations = 0;
+		std::uint64_t totalAllocations = 0;
+		std::uint64_t totalBytes = 0;
+		std::uint64_t lastFrameAllocations = 0;	///< During the last completed frame
+		std::uint64_t lastFrameBytes = 0;
+		std::uint64_t maxFrameAllocations = 0;
+	};
+
+	static constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+	static constexpr size_t MaxReportedFrames = 16;	///< Steady-state offenders logged; later ones are only counted
+
+private:
+	struct Counters
+	{
+		std::atomic<std::int64_t> currentBytes{ 0 };
+		std::atomic<std::int64_t> peakBytes{ 0 };
+		std::atomic<std::int64_t> liveAllocations{ 0 };
+		std::atomic<std::uint64_t> totalAllocations{ 0 };
+		std::atomic<std::uint64_t> totalBytes{ 0 };
+		std::atomic<std::uint64_t> frameAllocations{ 0 };
+		std::atomic<std::uint64_t> frameBytes{ 0 };
+		std::atomic<std::uint64_t> lastFrameAllocations{ 0 };
+		std::atomic<std::uint64_t> lastFrameBytes{ 0 };
+		std::atomic<std::uint64_t> maxFrameAllocations{ 0 };
+	};
+
+	Counters counters[TagCount];
+
+	std::atomic<std::uint64_t> frameIndex{ 0 };
+	std::atomic<bool> debugMode{ false };
+	std::atomic<bool> steadyState{ false };		///< Inside a frame past the warm-up, debug mode only
+	std::uint64_t warmupFrames = 120;
+
+	// Steady-state offenders of the current frame (the first one is kept for the log)
+	std::atomic<std::uint64_t> flaggedInFrame{ 0 };
+	std::atomic<std::uint64_t> firstFlaggedSize{ 0 };
+	std::atomic<int> firstFlaggedTag{ -1 };
+	std::uint64_t flaggedFrames = 0;
+	std::uint64_t flaggedAllocations = 0;
+
+	void OnAllocate(MemoryTag tag, size_t size);
+	void OnFree(MemoryTag tag, size_t size);
+
+public:
+	constexpr MemoryTracker() = default;
+
+	static MemoryTracker& Get();
+
+	/**
+	 * @brief Allocates size bytes charged to tag; throws std::bad_alloc on failure.
+	 * @param alignment Power of two; smaller than the platform default is raised to it.
+	 */
+	static void* Allocate(size_t size, size_t alignment, MemoryTag tag);
+
+	/// Like Allocate but returns nullptr on failure.
+	static void* TryAllocate(size_t size, size_t alignment, MemoryTag tag) noexcept;
+
+	/// Releases a block from Allocate(); nullptr is ignored.
+	static void Free(void* pointer) noexcept;
+
+	/// Charges memory from a foreign allocator (e.g. FreeImage's malloc) to tag; pair with RemoveExternal.
+	void AddExternal(MemoryTag tag, size_t size) { OnAllocate(tag, size); }
+	void RemoveExternal(MemoryTag tag, size_t size) { OnFree(tag, size); }
+
+	/// Tag that global operator new charges on this thread.
+	static MemoryTag GetCurrentTag();
+
+	static const char* GetTagName(MemoryTag tag);
+
+	/// True when this build replaces the global operator new.
+	static constexpr bool IsGlobalHookEnabled()
+	{
+#ifdef CELESTIAL_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief Flags allocations made during frames after the warm-up.
+	 * @param warmupFrames Frames allowed to allocate while caches and pools fill.
+	 */
+	void SetDebugMode(bool enabled, std::uint64_t warmupFrames = 120);
+
+	void BeginFrame();
+	/// Closes the frame's counters and, in debug mode, logs steady-state allocations.
+	void EndFrame();
+
+	TagStats GetStats(MemoryTag tag) const;
+	std::uint64_t GetFrameIndex() const { return frameIndex.load(std::memory_order_relaxed); }
+
+	std::string ToJson() const;
+	/// @return False if the file could not be written.
+	bool WriteReport(const std::string& path) const;
+};
+
+/**
+ * @class MemoryTagScope
+ * @brief Charges this thread's global operator new allocations to a tag until the scope ends.
+ */
+class MemoryTagScope
+{
+private:
+	MemoryTag previous;
+
+public:
+	explicit MemoryTagScope(MemoryTag tag);
+	~MemoryTagScope();
+
+	MemoryTagScope(const MemoryTagScope&) = delete;
+	MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+};
+
+/**
+ * @brief Standard allocator charging its memory to a fixed tag.
+ */
+template <typename T, MemoryTag Tag>
+class TrackedAllocator
+{
+public:
+	using value_type = T;
+
+	template <typename U>
+	struct rebind { using other = TrackedAllocator<U, Tag>; };
+
+	TrackedAllocator() noexcept = default;
+	template <typename U>
+	TrackedAllocator(const TrackedAllocator<U, Tag>&) noexcept {}
+
+	T* allocate(size_t count)
+	{
+		if (count > static_cast<size_t>(-1) / sizeof(T))
+			throw std::bad_array_new_length();
+		return static_cast<T*>(MemoryTracker::Allocate(count * sizeof(T), alignof(T), Tag));
+	}
+
+	void deallocate(T* pointer, size_t) noexcept { MemoryTracker::Free(pointer); }
+
+	template <typename U>
+	bool operator==(const TrackedAllocator<U, Tag>&) const noexcept { return true; }
+	template <typename U>
+	bool operator!=(const TrackedAllocator<U, Tag>&) const noexcept { return false; }
+};
+
+template <typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
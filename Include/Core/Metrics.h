@@ -0,0 +1,138 @@
+/**
+ * @file Metrics.h
+ * @brief Lock-free counters, gauges and histograms, served in Prometheus text format.
+ *
+ * Metrics are registered once at startup; the registry hands back a
+ * reference that the owning thread updates with relaxed atomic operations.
+ * MetricsServer formats them on its own thread, so a scrape never blocks
+ * (or is blocked by) the render loop. The registry's mutex only guards
+ * registration and the list walk during a scrape.
+ *
+ * Callback metrics are evaluated on the scrape thread and must only read
+ * thread-safe state (atomics, OS queries).
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Core/Socket.h>
+
+/// Monotonic count; exposed with a _total suffix.
+class MetricCounter
+{
+private:
+	std::atomic<std::uint64_t> value{ 0 };
+
+public:
+	void Add(std::uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+	std::uint64_t Get() const { return value.load(std::memory_order_relaxed); }
+};
+
+/// Last value set.
+class MetricGauge
+{
+private:
+	std::atomic<double> value{ 0.0 };
+
+public:
+	void Set(double newValue) { value.store(newValue, std::memory_order_relaxed); }
+	double Get() const { return value.load(std::memory_order_relaxed); }
+};
+
+/// Distribution over fixed bucket upper bounds (cumulative when exported).
+class MetricHistogram
+{
+private:
+	std::vector<double> bounds;
+	std::unique_ptr<std::atomic<std::uint64_t>[]> buckets;	///< bounds.size() + 1, last = above every bound
+	std::atomic<std::uint64_t> count{ 0 };
+	std::atomic<double> sum{ 0.0 };
+
+public:
+	explicit MetricHistogram(std::vector<double> upperBounds);
+
+	void Observe(double value);
+
+	const std::vector<double>& GetBounds() const { return bounds; }
+	std::uint64_t GetBucket(size_t index) const { return buckets[index].load(std::memory_order_relaxed); }
+	std::uint64_t GetCount() const { return count.load(std::memory_order_relaxed); }
+	double GetSum() const { return sum.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief Owns every metric of the process. Names follow Prometheus rules (snake_case, unit suffix).
+ */
+class MetricsRegistry
+{
+private:
+	enum class Kind { Counter, Gauge, Histogram, Callback };
+
+	struct Entry
+	{
+		std::string name;
+		std::string help;
+		Kind kind;
+		std::unique_ptr<MetricCounter> counter;
+		std::unique_ptr<MetricGauge> gauge;
+		std::unique_ptr<MetricHistogram> histogram;
+		std::function<double()> callback;
+	};
+
+	mutable std::mutex mutex;
+	std::deque<Entry> entries;
+
+	Entry& Add(const std::string& name, const std::string& help, Kind kind);
+
+public:
+	/// Registers the process metrics (resident memory).
+	MetricsRegistry();
+
+	/// @return The process-wide registry.
+	static MetricsRegistry& Get();
+
+	MetricCounter& AddCounter(const std::string& name, const std::string& help);
+	MetricGauge& AddGauge(const std::string& name, const std::string& help);
+	MetricHistogram& AddHistogram(const std::string& name, const std::string& help, std::vector<double> upperBounds);
+
+	/// Gauge read on the scrape thread.
+	void AddCallback(const std::string& name, const std::string& help, std::function<double()> read);
+
+	/// Every metric in the Prometheus text exposition format (version 0.0.4).
+	std::string Format() const;
+};
+
+/**
+ * @class MetricsServer
+ * @brief Answers GET /metrics on a loopback HTTP port from a background thread.
+ */
+class MetricsServer
+{
+private:
+	const MetricsRegistry& registry;
+	TcpSocket listener;
+	std::thread thread;
+	std::atomic<bool> stopping{ false };
+	std::atomic<std::uint64_t> scrapes{ 0 };
+
+	void ServeLoop();
+	void Serve(const TcpSocket& connection);
+
+public:
+	/// Listens on 127.0.0.1:port and starts the serving thread. Throws if the port is unavailable.
+	MetricsServer(std::uint16_t port, const MetricsRegistry& registry = MetricsRegistry::Get());
+
+	/// Stops and joins the serving thread.
+	~MetricsServer();
+
+	MetricsServer(const MetricsServer&) = delete;
+	MetricsServer& operator=(const MetricsServer&) = delete;
+
+	std::uint64_t GetScrapeCount() const { return scrapes.load(std::memory_order_relaxed); }
+};
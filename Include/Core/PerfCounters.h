@@ -0,0 +1,53 @@
+/**
+ * @file PerfCounters.h
+ * @brief Per-thread hardware performance counters (Linux perf_event_open).
+ *
+ * Opens one counter group for the calling thread: CPU cycles (group
+ * leader), retired instructions, last-level cache misses and branch
+ * misses, user mode only. Reading the group is one syscall and the values
+ * are consistent with each other. Counters the CPU or the kernel does not
+ * offer (VMs, perf_event_paranoid) are left out and reported as missing.
+ *
+ * Other platforms compile to a stub that never opens.
+ */
+#pragma once
+#include <cstdint>
+
+class PerfCounters
+{
+public:
+	enum Event
+	{
+		Cycles,
+		Instructions,
+		CacheMisses,
+		BranchMisses,
+		EventCount
+	};
+
+	struct Values
+	{
+		std::uint64_t counts[EventCount] = {};
+	};
+
+private:
+	int descriptors[EventCount];
+	int groupSlot[EventCount];	///< Position in the group read, -1 = not counted
+	int groupSize = 0;
+
+public:
+	/// Opens the counters for the calling thread; check IsOpen(). Never throws.
+	PerfCounters();
+	~PerfCounters();
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	bool IsOpen() const { return groupSize > 0; }
+	bool Has(Event event) const { return groupSlot[event] >= 0; }
+
+	/// Current counts since the group was opened (missing events read 0). @return False on failure.
+	bool Read(Values& values) const;
+
+	static const char* GetName(Event event);
+};
@@ -0,0 +1,54 @@
+/**
+ * @file Socket.h
+ * @brief Minimal blocking TCP socket over Winsock or BSD sockets.
+ *
+ * Only what the engine's local links need: listen/accept with a timeout,
+ * connect with retries (the other process may not be up yet), and
+ * send/receive of whole buffers. Nagle's algorithm is disabled on every
+ * connection since messages are small and latency-bound.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class TcpSocket
+{
+private:
+	std::intptr_t handle = -1;	///< SOCKET on Windows, file descriptor elsewhere
+
+	explicit TcpSocket(std::intptr_t nativeHandle) : handle(nativeHandle) {}
+
+public:
+	TcpSocket() = default;
+	~TcpSocket();
+
+	TcpSocket(TcpSocket&& other) noexcept;
+	TcpSocket& operator=(TcpSocket&& other) noexcept;
+	TcpSocket(const TcpSocket&) = delete;
+	TcpSocket& operator=(const TcpSocket&) = delete;
+
+	/// Listens on a port, on every interface or loopback only. Throws on failure.
+	static TcpSocket Listen(std::uint16_t port, bool loopbackOnly);
+
+	/// Connects, retrying until the timeout expires. @return An invalid socket on failure.
+	static TcpSocket Connect(const std::string& host, std::uint16_t port, double timeoutSeconds);
+
+	/// Waits for an incoming connection. @return An invalid socket on timeout.
+	TcpSocket Accept(double timeoutSeconds) const;
+
+	/// True if data (or a closed connection) can be read within the timeout; 0 polls.
+	bool WaitReadable(double timeoutSeconds) const;
+
+	/// Sends the whole buffer. @return False if the connection failed.
+	bool SendAll(const void* data, size_t size) const;
+
+	/// Receives exactly size bytes. @return False if the connection closed or failed.
+	bool ReceiveAll(void* data, size_t size) const;
+
+	/// Receives whatever is available, up to size bytes. @return Bytes read, 0 when closed, -1 on error.
+	std::ptrdiff_t ReceiveSome(void* data, size_t size) const;
+
+	bool IsValid() const { return handle != -1; }
+	void Close();
+};
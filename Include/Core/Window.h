@@ -31,6 +31,14 @@ private:
 	int width_;						///< Width in pixels
 	int height_;					///< Height in pixels
 	std::string title_;				///< Window title string
+	bool damaged_ = true;			///< Contents need redrawing (resize, expose, focus change)
+	bool visible_ = true;			///< False creates a hidden window (headless runs)
+
+	// GLFW window-state callbacks; the Window is found through the user pointer
+	static void FramebufferSizeCallback(GLFWwindow* window, int width, int height);
+	static void RefreshCallback(GLFWwindow* window);
+	static void FocusCallback(GLFWwindow* window, int focused);
+	static void IconifyCallback(GLFWwindow* window, int iconified);
 
 public:
 /**
@@ -38,8 +46,9 @@ public:
  * @param w Width of the window in pixels.
  * @param h Height of the window in pixels.
  * @param title Title bar text.
+ * @param visible False keeps the window hidden; the context still works (offscreen rendering).
  */
-	Window(int w, int h, const std::string& title);
+	Window(int w, int h, const std::string& title, bool visible = true);
 
 	/// Releses GLFW resources when the window is deplyed .
 	~Window();
@@ -54,12 +63,27 @@ public:
 	/// Polls for input and window events (non-blocking).
 	void PollEvents() const;
 
+	/// Blocks until an event arrives or the timeout (seconds) expires.
+	void WaitEvents(double timeoutSeconds) const;
+
+	/// Wakes a thread blocked in WaitEvents(). Safe to call from any thread.
+	static void Wake();
+
 	/// Swaps front/back buffers to present the rendered frame.
 	void SwapBuffers() const;
 
 	/// Checks if the window should close
 	bool ShouldClose() const;
 
+	/// True while the window has input focus.
+	bool IsFocused() const;
+
+	/// True while the window is minimized (nothing can be presented).
+	bool IsMinimized() const;
+
+	/// Returns whether the window was resized, exposed or changed focus since the last call.
+	bool ConsumeDamage();
+
 	/// Gets the current window size as a glm::ivec2.
 	glm::ivec2 GetSize() const;
 
@@ -0,0 +1,53 @@
+/**
+ * @file AssetLoader.h
+ * @brief Awaitable asset loads: CPU work on the job system, GL upload on the GL thread.
+ *
+ * Each call starts immediately and returns a Task; start several, then
+ * co_await them to load in parallel:
+ *
+ * @code
+ * Task<void> Load()
+ * {
+ *     auto day = Assets::LoadTexture("assets/textures/2k_earth_daymap.jpg");
+ *     auto sphere = Assets::GenerateMesh(MeshDesc::Sphere(1.0f, 360, 180));
+ *     std::shared_ptr<Texture> texture = co_await day;	// resumes on the GL thread
+ *     std::unique_ptr<Mesh> mesh = co_await sphere;
+ * }
+ * @endcode
+ *
+ * Both loads finish on the GL thread, so code after co_await may use GL.
+ */
+#pragma once
+#include <Core/Async.h>
+#include <Renderer/Mesh.h>
+#include <Renderer/Texture.h>
+#include <memory>
+#include <string>
+
+/**
+ * @struct MeshDesc
+ * @brief Parameters of a generated mesh.
+ */
+struct MeshDesc
+{
+	enum class Shape { Sphere };
+
+	Shape shape = Shape::Sphere;
+	float radius = 1.0f;
+	unsigned int sectors = 36;	///< Longitude divisions
+	unsigned int stacks = 18;	///< Latitude divisions
+
+	static MeshDesc Sphere(float radius, unsigned int sectors, unsigned int stacks)
+	{
+		return MeshDesc{ Shape::Sphere, radius, sectors, stacks };
+	}
+};
+
+namespace Assets
+{
+	/// Decodes the file on a worker and uploads it on the GL thread; nullptr if either step fails.
+	Task<std::shared_ptr<Texture>> LoadTexture(std::string path);
+
+	/// Generates the geometry on a worker and adds it to the GeometryPool on the GL thread.
+	Task<std::unique_ptr<Mesh>> GenerateMesh(MeshDesc desc);
+}
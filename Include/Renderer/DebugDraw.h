@@ -0,0 +1,134 @@
+/**
+ * @file DebugDraw.h
+ * @brief Batched immediate-mode lines, points and wire shapes for debugging.
+ *
+ * Any thread may call the DebugDraw functions at any time during a frame
+ * (orbits from the simulation, bounds from culling, job results...). Each
+ * thread writes into its own single-producer ring, so submitting never takes
+ * a lock and never touches GL. Once per frame the renderer drains every ring
+ * into one StreamBuffer allocation and draws it with one glDrawArrays per
+ * primitive type, in every camera pass.
+ *
+ * Submissions are one-shot: a shape is drawn in the frame that collects it
+ * and must be submitted again to stay visible.
+ *
+ * Compiled out unless CELESTIAL_DEBUG_DRAW is non-zero (defaults to on when
+ * NDEBUG is not defined). When disabled, every function is an empty inline
+ * and calls cost nothing.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <glm/glm.hpp>
+
+#ifndef CELESTIAL_DEBUG_DRAW
+#ifdef NDEBUG
+#define CELESTIAL_DEBUG_DRAW 0
+#else
+#define CELESTIAL_DEBUG_DRAW 1
+#endif
+#endif
+
+class StreamBuffer;
+class Shader;
+
+class DebugDraw
+{
+public:
+	/**
+	 * @struct Stats
+	 * @brief Counters of the last collected frame.
+	 */
+	struct Stats
+	{
+		size_t points = 0;		///< Point vertices drawn
+		size_t lineVertices = 0;	///< Line vertices drawn (two per segment)
+		size_t dropped = 0;		///< Vertices lost to full rings, the per-frame cap or a full StreamBuffer, cumulative
+		size_t threads = 0;		///< Threads that have submitted at least once
+	};
+
+#if CELESTIAL_DEBUG_DRAW
+	/// Interleaved vertex in the debug vertex buffer (16 bytes)
+	struct Vertex
+	{
+		glm::vec3 position;
+		uint32_t color;		///< RGBA8, read as normalized unsigned bytes
+	};
+
+	static constexpr size_t RingVertices = 64 * 1024;		///< Per thread and primitive type (power of two)
+	static constexpr size_t MaxFrameVertices = 64 * 1024;	///< Cap on what one frame uploads (1 MB)
+	static constexpr unsigned int MaxSegments = 64;		///< Upper bound for circle/sphere tessellation
+
+	// ---- Submission (any thread) ----
+
+	static void Point(const glm::vec3& position, const glm::vec3& color);
+	static void Line(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color);
+
+	/// Polyline through `count` points; `closed` joins the last point back to the first.
+	static void Polyline(const glm::vec3* points, size_t count, const glm::vec3& color, bool closed = false);
+
+	/// Circle in the plane orthogonal to `normal` (orbits, rings).
+	static void Circle(const glm::vec3& center, const glm::vec3& normal, float radius, const glm::vec3& color,
+		unsigned int segments = 48);
+
+	/// Wire sphere drawn as three orthogonal great circles.
+	static void Sphere(const glm::vec3& center, float radius, const glm::vec3& color, unsigned int segments = 24);
+
+	/// Axis-aligned wire box.
+	static void Box(const glm::vec3& min, const glm::vec3& max, const glm::vec3& color);
+
+	/// Oriented wire box: the [-1, 1] cube transformed by `transform`.
+	static void Box(const glm::mat4& transform, const glm::vec3& color);
+
+	/// RGB axis tripod of a transform, `size` units long.
+	static void Axes(const glm::mat4& transform, float size = 1.0f);
+
+	/// Wire frustum of a camera, given its projection * view matrix.
+	static void ViewFrustum(const glm::mat4& viewProjection, const glm::vec3& color);
+
+	// ---- Rendering (GL thread) ----
+
+	DebugDraw();
+	~DebugDraw();
+
+	DebugDraw(const DebugDraw&) = delete;
+	DebugDraw& operator=(const DebugDraw&) = delete;
+
+	/**
+	 * @brief Drains every thread's rings into one StreamBuffer allocation.
+	 * Call once per frame, before the camera passes.
+	 */
+	void Collect(StreamBuffer& streamBuffer);
+
+	/// Draws what Collect() gathered with the camera block currently bound (UBO binding 0).
+	void Render() const;
+
+	const Stats& GetStats() const { return stats; }
+
+private:
+	std::unique_ptr<Shader> shader;
+	unsigned int vao = 0;
+	unsigned int buffer = 0;	///< StreamBuffer GL name of this frame's vertices
+	size_t offset = 0;			///< Byte offset of this frame's vertices in that buffer
+	Stats stats;
+
+#else
+	static void Point(const glm::vec3&, const glm::vec3&) {}
+	static void Line(const glm::vec3&, const glm::vec3&, const glm::vec3&) {}
+	static void Polyline(const glm::vec3*, size_t, const glm::vec3&, bool = false) {}
+	static void Circle(const glm::vec3&, const glm::vec3&, float, const glm::vec3&, unsigned int = 48) {}
+	static void Sphere(const glm::vec3&, float, const glm::vec3&, unsigned int = 24) {}
+	static void Box(const glm::vec3&, const glm::vec3&, const glm::vec3&) {}
+	static void Box(const glm::mat4&, const glm::vec3&) {}
+	static void Axes(const glm::mat4&, float = 1.0f) {}
+	static void ViewFrustum(const glm::mat4&, const glm::vec3&) {}
+
+	void Collect(StreamBuffer&) {}
+	void Render() const {}
+	const Stats& GetStats() const { return stats; }
+
+private:
+	Stats stats;
+#endif
+};
@@ -0,0 +1,78 @@
+/**
+ * @file DomeTarget.h
+ * @brief Fisheye dome-master output, rendered through a camera-aligned cubemap.
+ *
+ * The scene is drawn into the faces of a cubemap oriented with the camera
+ * (forward is the -Z face), in one layered pass when multi-view is active.
+ * Only faces whose 90 degree frustum reaches into the dome are rendered: five
+ * for a 180 degree hemisphere, one for a narrow dome, all six past about
+ * 250.5 (where the dome reaches the corners of the back face).
+ *
+ * A single full-screen pass then warps the cubemap to an equidistant
+ * (angular) fisheye: the distance from the image centre is proportional to
+ * the angle from the camera's forward axis, the zenith of the dome.
+ */
+#pragma once
+#include <memory>
+#include <string>
+#include <glm/glm.hpp>
+#include <Renderer/GpuResourceRegistry.h>
+
+class Shader;
+
+class DomeTarget
+{
+public:
+	struct Settings
+	{
+		int outputSize = 4096;			///< Dome-master width and height in pixels
+		int faceSize = 2048;			///< Cube face resolution (about the master's density at the zenith)
+		float fieldOfView = 180.0f;		///< Full angle covered by the fisheye circle, in degrees
+	};
+
+private:
+	Settings settings;
+	std::unique_ptr<Shader> warpShader;	///< Cubemap to fisheye
+	unsigned int colorCubemap = 0;		///< RGBA8, faces in camera space
+	unsigned int depthCubemap = 0;		///< DEPTH_COMPONENT32F
+	unsigned int layeredFramebuffer = 0;
+	unsigned int faceFramebuffers[6] = { 0, 0, 0, 0, 0, 0 };
+	unsigned int outputTexture = 0;		///< RGBA8 dome master
+	unsigned int outputFramebuffer = 0;
+	unsigned int warpVao = 0;			///< Empty VAO for the attribute-less full-screen triangle
+	GpuResourceRegistry::Handle records[3] = {};	///< Color cubemap, depth cubemap, output
+
+	int activeFaces[6] = { 0, 0, 0, 0, 0, 0 };	///< GL face indices that reach into the dome
+	int activeFaceCount = 0;
+
+public:
+	/// Requires a current GL context; throws if a framebuffer is incomplete.
+	DomeTarget();
+	explicit DomeTarget(const Settings& settings);
+	~DomeTarget();
+
+	DomeTarget(const DomeTarget&) = delete;
+	DomeTarget& operator=(const DomeTarget&) = delete;
+
+	/// View matrix of a cube face (GL face order) for a camera's view matrix.
+	static glm::mat4 GetFaceView(int face, const glm::mat4& cameraView);
+
+	/// 90 degree square projection shared by all faces.
+	static glm::mat4 GetFaceProjection(float nearPlane, float farPlane);
+
+	/// Warps the rendered faces into the dome master. Changes the framebuffer binding and viewport.
+	void Resolve() const;
+
+	/// Copies the dome master, scaled to fit and centred, into a viewport of a framebuffer.
+	void Present(unsigned int framebuffer, const glm::ivec4& viewport) const;
+
+	/// Reads the dome master back and writes it as an image (format from the extension).
+	bool SaveImage(const std::string& path) const;
+
+	const Settings& GetSettings() const { return settings; }
+	const int* GetActiveFaces() const { return activeFaces; }
+	int GetActiveFaceCount() const { return activeFaceCount; }
+	unsigned int GetLayeredFramebuffer() const { return layeredFramebuffer; }
+	unsigned int GetFaceFramebuffer(int face) const { return faceFramebuffers[face]; }
+	unsigned int GetOutputTexture() const { return outputTexture; }
+};
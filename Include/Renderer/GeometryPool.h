@@ -0,0 +1,151 @@
+/**
+ * @file GeometryPool.h
+ * @brief Sub-allocates mesh vertex/index data out of a few large GPU buffers.
+ *
+ * Instead of one VAO/VBO/EBO per Mesh, geometry lives in pages. A page is an
+ * immutable vertex buffer + index buffer pair (glBufferStorage) with a single
+ * VAO, and OffsetAllocator carves vertex and index ranges out of it. A Mesh
+ * only keeps a Handle and draws through a GeometryView
+ * (vao, firstIndex, indexCount, baseVertex).
+ *
+ * Every mesh in a page shares the page's VAO, so consecutive draws from the
+ * same page need no VAO switch and can later be merged into multi-draws.
+ *
+ * Defragmentation:
+ *  - Free() leaves holes; when a page's free space is split up, the page is
+ *    compacted into fresh buffers with glCopyBufferSubData.
+ *  - The copy runs on the GPU timeline (no read-back, no CPU stall) and the
+ *    old buffers are released once GL is done with them.
+ *  - Handles stay valid: views are resolved through the handle table.
+ */
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Renderer/OffsetAllocator.h>
+#include <Renderer/GpuResourceRegistry.h>
+
+struct Vertex;
+
+/**
+ * @struct GeometryView
+ * @brief Where a mesh lives inside the pool: everything needed to draw it.
+ */
+struct GeometryView
+{
+	unsigned int vao = 0;		///< Page VAO (shared by all meshes in the page)
+	unsigned int firstIndex = 0;	///< Offset into the page index buffer, in indices
+	unsigned int indexCount = 0;	///< Number of indices to draw
+	int baseVertex = 0;			///< Added to every index (mesh indices are 0-based)
+	unsigned int page = 0;		///< Page index, equal pages share buffers
+};
+
+class GeometryPool
+{
+public:
+	using Handle = uint32_t;
+	static constexpr Handle InvalidHandle = 0xffffffff;
+
+	/**
+	 * @struct Stats
+	 * @brief Pool occupancy, for diagnostics.
+	 */
+	struct Stats
+	{
+		size_t pages = 0;
+		size_t allocations = 0;
+		size_t capacityBytes = 0;	///< Total GPU bytes reserved by all pages
+		size_t usedBytes = 0;		///< Bytes referenced by live allocations
+		size_t defragmentations = 0;	///< Number of page compactions so far
+	};
+
+	static constexpr uint32_t DefaultPageVertices = 512 * 1024;	///< 28 MB with the current Vertex layout
+	static constexpr uint32_t DefaultPageIndices = 2 * 1024 * 1024;	///< 8 MB
+	static constexpr uint32_t MaxAllocationsPerPage = 16 * 1024;	///< Allocator node budget per page
+
+private:
+	struct Page
+	{
+		unsigned int vao = 0;
+		unsigned int vbo = 0;
+		unsigned int ebo = 0;
+		uint32_t vertexCapacity;
+		uint32_t indexCapacity;
+		OffsetAllocator vertexAllocator;
+		OffsetAllocator indexAllocator;
+		uint32_t liveAllocations = 0;
+		bool needsFragmentationCheck = false;	///< Set by Free(), cleared by DefragmentIfNeeded()
+		GpuResourceRegistry::Handle vertexRecord = GpuResourceRegistry::InvalidHandle;
+		GpuResourceRegistry::Handle indexRecord = GpuResourceRegistry::InvalidHandle;
+
+		Page(uint32_t vertices, uint32_t indices)
+			: vertexCapacity(vertices), indexCapacity(indices),
+			  vertexAllocator(vertices, MaxAllocationsPerPage), indexAllocator(indices, MaxAllocationsPerPage) {}
+	};
+
+	struct Entry
+	{
+		uint32_t page = 0;
+		OffsetAllocator::Allocation vertexAlloc;
+		OffsetAllocator::Allocation indexAlloc;
+		uint32_t vertexCount = 0;
+		uint32_t indexCount = 0;
+		bool live = false;
+	};
+
+	std::vector<std::unique_ptr<Page>> pages;
+	std::vector<Entry> entries;		///< Indexed by Handle
+	std::vector<Handle> freeEntries;	///< Recycled handle slots
+	size_t defragmentations = 0;
+
+	static GeometryPool* instance;
+
+	Page& CreatePage(uint32_t minVertices, uint32_t minIndices);
+	void CreateBuffers(Page& page, unsigned int& vbo, unsigned int& ebo) const;
+	void BindPageBuffers(const Page& page) const;
+
+public:
+	GeometryPool() = default;
+	~GeometryPool();
+
+	GeometryPool(const GeometryPool&) = delete;
+	GeometryPool& operator=(const GeometryPool&) = delete;
+
+	/**
+	 * @brief Returns the engine-wide pool, creating it on first use.
+	 * Requires a current GL context.
+	 */
+	static GeometryPool& Get();
+
+	/// @return The pool if it exists, nullptr after Shutdown() (safe in destructors).
+	static GeometryPool* Instance() { return instance; }
+
+	/// Releases all GPU pages. Must run before the GL context is destroyed.
+	static void Shutdown();
+
+	/**
+	 * @brief Uploads geometry into the first page with room for it.
+	 * @return A handle, or InvalidHandle if the data is empty.
+	 */
+	Handle Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+	/// Releases the ranges owned by a handle. Unknown handles are ignored.
+	void Free(Handle handle);
+
+	/// @return Draw parameters for a handle (indexCount == 0 if invalid).
+	GeometryView GetView(Handle handle) const;
+
+	/**
+	 * @brief Compacts at most one page whose free space is fragmented.
+	 * @param threshold Fragmentation (1 - largestFree / totalFree) that triggers compaction.
+	 * @return True if a page was compacted.
+	 *
+	 * Cheap to call every frame: only pages that saw a Free() are inspected.
+	 */
+	bool DefragmentIfNeeded(float threshold = 0.5f);
+
+	/// Compacts one page, moving all its live ranges to the front of new buffers.
+	void Defragment(uint32_t pageIndex);
+
+	Stats GetStats() const;
+};
@@ -0,0 +1,132 @@
+/**
+ * @file GpuResourceRegistry.h
+ * @brief Record of every GL buffer, texture and render-target attachment with its size.
+ *
+ * Owners register a GL object when they allocate its storage and unregister
+ * it before deleting it. Each record keeps the byte size, the internal
+ * format (textures), a readable owner and the last frame it was used, so
+ * budget and eviction policies can rank resources by size and recency.
+ *
+ * Totals per category are atomics and may be read from any thread (the
+ * metrics server). Everything else, including registration, Touch() and
+ * the driver queries, belongs to the GL thread.
+ *
+ * Where the driver exposes GL_NVX_gpu_memory_info or GL_ATI_meminfo, the
+ * dedicated and currently available video memory are sampled periodically
+ * next to the engine's own accounting.
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class GpuResourceRegistry
+{
+public:
+	enum class Category
+	{
+		Buffer,			///< Vertex, index, storage and streaming buffers
+		Texture,		///< Sampled images loaded from assets
+		RenderTarget,	///< Framebuffer attachments and render-to-texture caches
+		Count
+	};
+
+	using Handle = std::uint32_t;
+	static constexpr Handle InvalidHandle = 0;
+
+	struct Resource
+	{
+		Handle handle = InvalidHandle;
+		Category category = Category::Buffer;
+		unsigned int glName = 0;
+		size_t bytes = 0;
+		unsigned int internalFormat = 0;	///< 0 for buffers
+		std::string owner;
+		std::uint64_t lastUsedFrame = 0;
+	};
+
+	/// Video memory as reported by the driver, in bytes; zero when no query extension exists.
+	struct DriverMemory
+	{
+		const char* source = "none";		///< "NVX_gpu_memory_info", "ATI_meminfo" or "none"
+		size_t dedicatedBytes = 0;			///< NVX only
+		size_t availableBytes = 0;			///< Currently free (ATI: free texture memory)
+		size_t evictedBytes = 0;			///< NVX only, since context creation
+		std::uint64_t evictionCount = 0;	///< NVX only
+	};
+
+	static constexpr std::uint64_t DriverQueryInterval = 60;	///< Frames between driver memory samples
+
+private:
+	enum class DriverQuery { None, Nvx, Ati };
+
+	std::vector<Resource> slots;		///< Index = handle - 1; free slots have handle == InvalidHandle
+	std::vector<Handle> freeHandles;
+	std::uint64_t frameIndex = 0;
+
+	std::atomic<size_t> categoryBytes[static_cast<size_t>(Category::Count)] = {};
+	std::atomic<size_t> categoryCounts[static_cast<size_t>(Category::Count)] = {};
+
+	DriverQuery driverQuery = DriverQuery::None;
+	std::atomic<size_t> driverDedicatedBytes{ 0 };
+	std::atomic<size_t> driverAvailableBytes{ 0 };
+	std::atomic<size_t> driverEvictedBytes{ 0 };
+	std::atomic<std::uint64_t> driverEvictionCount{ 0 };
+
+	void SampleDriverMemory();
+
+public:
+	static GpuResourceRegistry& Get();
+
+	/// Picks the driver memory query; call once with a current context.
+	void Initialize();
+
+	/**
+	 * @brief Records a GL object whose storage was just allocated.
+	 * @param internalFormat Texture internal format, 0 for buffers.
+	 * @return Handle for Touch/Resize/Unregister.
+	 */
+	Handle Register(Category category, unsigned int glName, size_t bytes, unsigned int internalFormat, std::string owner);
+
+	/// Forgets the record and resets handle; InvalidHandle is ignored.
+	void Unregister(Handle& handle);
+
+	/// New storage size for a resized object (e.g. a grown buffer recreated under the same owner).
+	void Resize(Handle handle, unsigned int glName, size_t bytes);
+
+	/// Marks the resource as used by the current frame.
+	void Touch(Handle handle)
+	{
+		if (handle != InvalidHandle)
+			slots[handle - 1].lastUsedFrame = frameIndex;
+	}
+
+	/// Advances the frame counter and periodically samples driver memory.
+	void BeginFrame();
+
+	size_t GetBytes(Category category) const { return categoryBytes[static_cast<size_t>(category)].load(std::memory_order_relaxed); }
+	size_t GetCount(Category category) const { return categoryCounts[static_cast<size_t>(category)].load(std::memory_order_relaxed); }
+	size_t GetTotalBytes() const;
+
+	/// Last sample of driver-reported video memory; safe from any thread.
+	DriverMemory GetDriverMemory() const;
+
+	/// Live records, largest first (input for budget and eviction policies).
+	std::vector<Resource> GetResources() const;
+
+	std::uint64_t GetFrameIndex() const { return frameIndex; }
+
+	/// Logs totals per category, driver memory and the largest resources.
+	void PrintReport(size_t largest = 8) const;
+
+	static const char* GetCategoryName(Category category);
+	static const char* GetFormatName(unsigned int internalFormat);
+
+	/// Bytes per texel of the internal formats the engine allocates; 4 for unknown formats.
+	static size_t BytesPerTexel(unsigned int internalFormat);
+
+	/// Storage of a full mip chain whose level 0 is levelBytes (about a third more).
+	static size_t WithMipChain(size_t levelBytes) { return levelBytes * 4 / 3; }
+};
@@ -0,0 +1,50 @@
+/**
+ * @file LabelRenderer.h
+ * @brief Draws decluttered body labels as SDF glyph instances.
+ *
+ * Per camera pass: LabelLayout projects and declutters the frame's label
+ * candidates, then one instance per visible glyph is written into the
+ * StreamBuffer and every label is drawn with a single instanced call
+ * (4-vertex strip, quad corners derived from gl_VertexID).
+ */
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <Renderer/SdfFont.h>
+#include <Scene/LabelLayout.h>
+
+class Shader;
+class StreamBuffer;
+
+class LabelRenderer
+{
+private:
+	SdfFont font;
+	LabelLayout layout;
+	std::unique_ptr<Shader> shader;
+	unsigned int vao = 0;
+	size_t glyphsDrawn = 0;		///< Instances in the last Render()
+
+public:
+	static constexpr size_t MaxGlyphs = 32 * 1024;	///< Per pass, 1 MB of instance data
+
+	/// Requires a current GL context (uploads the atlas, compiles the shader).
+	LabelRenderer();
+	~LabelRenderer();
+
+	LabelRenderer(const LabelRenderer&) = delete;
+	LabelRenderer& operator=(const LabelRenderer&) = delete;
+
+	/**
+	 * @brief Lays out and draws the labels for one view.
+	 * Drawn on top of the scene (no depth test), alpha blended.
+	 * @param viewportSize Size of the current viewport in pixels.
+	 */
+	void Render(const std::vector<LabelCandidate>& labels, const glm::mat4& viewProjection,
+		const glm::vec2& viewportSize, StreamBuffer& streamBuffer);
+
+	LabelLayout& GetLayout() { return layout; }
+	const SdfFont& GetFont() const { return font; }
+	size_t GetGlyphsDrawn() const { return glyphsDrawn; }
+};
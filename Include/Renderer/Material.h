@@ -26,11 +26,16 @@ struct MaterialProperties {
 
 class Material {
 private:
+	friend class MaterialTable;
+
 	MaterialProperties properties;
 
 	// Dynamic storage for textures
 	std::map<Render::TextureType, Texture*> textures;
 
+	int tableSlot = -1;		// Index into the MaterialTable SSBO (-1 = not registered yet)
+	bool dirty = true;		// Set by the setters, cleared once the MaterialTable re-uploads the slot
+
 public:
 	Material();
 	~Material() = default;
@@ -46,12 +51,15 @@ public:
 	// Teture setters
 	void SetTexture(Render::TextureType type, Texture* texture);
 
-	// Apply material to shader (binds textures and sets uniforms)
+	// Bind material textures. Colors and shininess live in the MaterialTable
+	// and are indexed in the shader via the draw's base instance.
 	void Apply(Shader& shader) const;
 
 	// Getters
-	MaterialProperties& getProperties() { return properties; }
+	MaterialProperties& getProperties() { dirty = true; return properties; }	// Mutable access, assume a write
 	const MaterialProperties& GetProperties() const { return properties; }
+	int GetTableSlot() const { return tableSlot; }
+	bool IsDirty() const { return dirty; }
 
 	// Check if specific texture type exists
 	bool HasTexture(Render::TextureType type) const;
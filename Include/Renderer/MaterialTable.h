@@ -0,0 +1,85 @@
+/**
+ * @file MaterialTable.h
+ * @brief GPU-resident table of material parameters.
+ *
+ * Every registered Material owns one slot in a shader storage buffer. The
+ * fragment shader reads its colors/shininess from `materials[MaterialIndex]`,
+ * where the index is forwarded from the draw call's base instance.
+ *
+ * Only slots whose Material is dirty are re-uploaded, so in steady state the
+ * per-draw material cost is zero uniform calls.
+ */
+#pragma once
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Renderer/Material.h>
+#include <Renderer/GpuResourceRegistry.h>
+
+/**
+ * @struct GpuMaterial
+ * @brief std430 layout of one material record (must match basic.frag).
+ */
+struct GpuMaterial
+{
+	glm::vec4 ambient;		///< rgb = ambient color
+	glm::vec4 diffuse;		///< rgb = diffuse color
+	glm::vec4 specular;		///< rgb = specular color, w = shininess
+	glm::vec4 emissive;		///< rgb = emissive color
+	glm::ivec4 textureFlags;	///< x = diffuse map, y = specular map, z = normal map, w = emissive map
+};
+
+/**
+ * @class MaterialTable
+ * @brief Owns the material SSBO and assigns table slots to materials.
+ *
+ * Usage:
+ * @code
+ * table.Register(material);	// once, assigns material->GetTableSlot()
+ * table.Upload();			// once per frame, re-sends dirty slots only
+ * table.Bind();
+ * mesh.Draw(material->GetTableSlot());
+ * @endcode
+ *
+ * The table keeps a shared reference to every registered material so slots
+ * stay valid for the lifetime of the renderer.
+ */
+class MaterialTable
+{
+private:
+	unsigned int ssbo = 0;		///< Shader storage buffer holding GpuMaterial records
+	size_t capacity = 0;		///< Number of records the buffer can hold
+	GpuResourceRegistry::Handle record = GpuResourceRegistry::InvalidHandle;
+	std::vector<std::shared_ptr<Material>> materials;	///< Indexed by table slot
+
+	void Grow(size_t minCapacity);
+	static GpuMaterial Pack(const Material& material);
+
+public:
+	static constexpr unsigned int BindingPoint = 2;	///< layout(binding = 2) in basic.frag
+
+	MaterialTable() = default;
+	~MaterialTable();
+
+	MaterialTable(const MaterialTable&) = delete;
+	MaterialTable& operator=(const MaterialTable&) = delete;
+
+	/**
+	 * @brief Assigns a slot to the material if it does not have one yet.
+	 * @return The material's table slot.
+	 */
+	unsigned int Register(const std::shared_ptr<Material>& material);
+
+	/**
+	 * @brief Uploads every dirty material and clears its dirty flag.
+	 *
+	 * Consecutive dirty slots are coalesced into a single glBufferSubData.
+	 * @return Number of material records uploaded.
+	 */
+	size_t Upload();
+
+	/// Binds the table to its SSBO binding point.
+	void Bind() const;
+
+	size_t GetCount() const { return materials.size(); }
+};
@@ -1,17 +1,17 @@
 //Mesh header template
 /**
 * @file Mesh.h
-* @Brief Declaration of the Mesh class for managing vertex data and OpenGL buffers.
+* @Brief Declaration of the Mesh class for managing vertex data and its GPU range.
 * 
 * A mesh represents a collection of vertices (and optionally indices)
-* stored on the GPU. It abstructs VAO/VBO  setup and provides 
-* a reusable interface for rendering geometry in the engine.
+* stored on the GPU. Geometry is sub-allocated from the shared GeometryPool,
+* so a Mesh is a lightweight (page, offset, count) view rather than a set of
+* GL objects of its own.
 * 
 * 
 * A Mesh encapsulates:
-*   - Vertex Buffer Object (VBO)
-*   - Element Buffer Object (EBO)
-*   - Vertex Array Object (VAO)
+*   - CPU copy of its vertices and indices
+*   - Handle to its vertex/index ranges inside a GeometryPool page
 *   - Draw call parameters (vertex/index count)
 * 
 * Future extensions:
@@ -27,6 +27,7 @@
 #include <vector>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <Renderer/GeometryPool.h>
 
 /**
  * @struct Vertex
@@ -45,11 +46,48 @@ struct Vertex {
 	glm::vec3 tangent;    
 };
 
+/**
+ * @struct MeshCluster
+ * @brief A run of at most Mesh::ClusterTriangles triangles with bounds and a normal cone.
+ *
+ * All fields are in object space. Every triangle of the cluster faces away
+ * from a camera at position c when dot(normalize(coneApex - c), coneAxis) >= coneCutoff,
+ * so the whole run can be skipped.
+ */
+struct MeshCluster {
+	glm::vec3 center;		///< Bounding sphere center
+	float radius;			///< Bounding sphere radius
+	glm::vec3 coneApex;
+	glm::vec3 coneAxis;		///< Average facing direction
+	float coneCutoff;		///< sin of the cone half-angle; 1 = never back-facing
+	unsigned int firstIndex;	///< Offset into the mesh's index list
+	unsigned int indexCount;
+};
+
+/**
+ * @struct MeshData
+ * @brief CPU-side geometry produced by a generator, not yet uploaded.
+ *
+ * Generators that return MeshData touch no GL state, so they can run on a
+ * JobSystem worker; the Mesh is then built from it on the GL thread.
+ */
+struct MeshData {
+	std::vector<Vertex> vertices;
+	std::vector<unsigned int> indices;
+	std::vector<unsigned int> clusterBreaks;	///< See Mesh::BuildClusters
+
+	// Filled by Mesh::BuildClusters; otherwise the Mesh constructor computes them
+	bool clustered = false;
+	std::vector<MeshCluster> clusters;
+	glm::vec3 boundsCenter = glm::vec3(0.0f);
+	float boundsRadius = 0.0f;
+};
+
 /**
  * @class Mesh
- * @brief Encapsulates an OpenGL mesh with VAO/VBO state.
+ * @brief Encapsulates a mesh stored in the shared GeometryPool.
  *
- * A Mesh manages its own GPU buffers (VAO, VBO, EBO if added)
+ * A Mesh owns a range of the pool's vertex and index buffers
  * and exposes a simple `Draw()` method. It is designed to be reusable
  * with any Shader object and does not own rendering logic itself.
  *
@@ -67,21 +105,41 @@ struct Vertex {
 
 class Mesh {
 private:
-	unsigned int VAO = 0; ///< Vertex Array Object (encapsulates buffer state)
-	unsigned int VBO = 0; ///< Vertex buffer Object (encapsulates vertex data)
-	unsigned int EBO = 0; ///< Element Buffer Object
+	GeometryPool::Handle geometry = GeometryPool::InvalidHandle; ///< Range inside the GeometryPool
 
 	std::vector<Vertex> vertices;
 	std::vector<unsigned int> indices;
 
+	std::vector<MeshCluster> clusters;	///< Empty for small meshes (drawn whole)
+	glm::vec3 boundsCenter = glm::vec3(0.0f);	///< Object-space bounding sphere of the whole mesh
+	float boundsRadius = 0.0f;
+
 public:
+	static constexpr unsigned int ClusterTriangles = 128;		///< Max triangles per cluster
+	static constexpr unsigned int MinClusteredTriangles = 1024;	///< Smaller meshes are not clustered
+
 	/**
 	 * @brief Constructs a Mesh from a given set of vertices.
 	 *
 	 * @param vertices A vector of Vertex structs containing position and color data.
+	 *        Taken by value: pass rvalues to hand large buffers over without a copy.
 	 */
 	Mesh() = default;
-	Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+	Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices,
+		const std::vector<unsigned int>& clusterBreaks = {});
+
+	/** @brief Uploads generated geometry (GL thread); the data is moved from. */
+	explicit Mesh(MeshData data);
+
+	/**
+	 * @brief Splits the index list into clusters and computes their bounds and cones.
+	 *
+	 * Touches no GL state: call it on the worker that produced the data so
+	 * the GL thread only uploads. A cluster starts at each of data.clusterBreaks
+	 * (index offsets, e.g. generator tile boundaries, sorted ascending) and
+	 * also ends after ClusterTriangles.
+	 */
+	static void BuildClusters(MeshData& data);
 
 	// Move constructor and assignment (for proper OpenGL resource management)
 	Mesh(Mesh&& other) noexcept;
@@ -95,7 +153,7 @@ public:
 	void Initialize();
 
 	/**
-	* @brief Releases GPU resources (VAO, VBO).
+	* @brief Returns the mesh's ranges to the GeometryPool.
 	*/
 	~Mesh();
 
@@ -103,15 +161,35 @@ public:
 	 * @brief Draws the mesh to the currently bound framebuffer.
 	 *
 	 * Assumes that an appropriate Shader is already bound before calling.
-	 * Currently uses glDrawArrays with 3 vertices (for a triangle).
+	 * Issues a single-instance indexed draw whose base instance is visible to
+	 * shaders as gl_BaseInstance (used to index the per-draw DrawData array).
 	 *
-	 * Future version will:
-	 * - Support glDrawElements (indexed rendering)
-	 * - Support variable primitive types (triangles, lines, points)
+	 * @param baseInstance Per-draw index forwarded to the shader.
 	 */
 
-	void Draw() const;
+	void Draw(unsigned int baseInstance = 0) const;
+
+	/** @brief Current location of the mesh in the pool (may move on defragmentation). */
+	GeometryView GetView() const;
+
+	/** @brief CPU copy of the vertices (e.g. for cooking). */
+	const std::vector<Vertex>& GetVertices() const { return vertices; }
+
+	/** @brief CPU copy of the indices (e.g. for cooking). */
+	const std::vector<unsigned int>& GetIndices() const { return indices; }
+
+	/** @brief Culling clusters; their index ranges are relative to GetView().firstIndex. */
+	const std::vector<MeshCluster>& GetClusters() const { return clusters; }
+
+	/** @brief Object-space bounding sphere center of the whole mesh. */
+	glm::vec3 GetBoundsCenter() const { return boundsCenter; }
+
+	/** @brief Object-space bounding sphere radius of the whole mesh. */
+	float GetBoundsRadius() const { return boundsRadius; }
 
 	// Utility generators
 	static Mesh CreateSphere(float radius, unsigned int sectors, unsigned int stacks);
+
+	/** @brief Sphere geometry only; safe to call from any thread. */
+	static MeshData GenerateSphere(float radius, unsigned int sectors, unsigned int stacks);
 };
@@ -0,0 +1,66 @@
+/**
+ * @file MeshCodec.h
+ * @brief Compact encoding of mesh vertex and index buffers.
+ *
+ * Index stream:
+ *  - Each index is predicted by the same corner of the previous triangle
+ *    (idx[i - 3]); the difference is zigzag-mapped and written as a varint.
+ *  - Neighbouring triangles share or step through nearby vertices, so most
+ *    indices cost one byte instead of four.
+ *
+ * Vertex stream (byte planes):
+ *  - Vertices are processed in blocks of 16. Every byte position of the
+ *    vertex (a "channel") is delta-coded against the same byte of the
+ *    previous vertex and zigzag-mapped.
+ *  - Each channel of a block is stored with 0, 2, 4 or 8 bits per value
+ *    (2-bit mode in the block header). Exponent and high mantissa bytes
+ *    of smoothly varying floats mostly need 0-2 bits.
+ *  - Decoding is SSE2: bit unpacking, zigzag and the 16-lane prefix sum run
+ *    on whole registers, and channels are transposed back to interleaved
+ *    vertices four bytes at a time, directly into the destination
+ *    (which may be a mapped upload buffer).
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Vertex;
+
+class MeshCodec
+{
+public:
+	static constexpr size_t BlockVertices = 16;		///< Vertices per encoded block
+	static constexpr size_t MaxVertexStride = 256;	///< Stride must be a multiple of 4 up to this
+
+	/**
+	 * @struct Report
+	 * @brief Compression ratio and decode throughput for one mesh.
+	 */
+	struct Report
+	{
+		size_t rawBytes = 0;			///< Vertex + index bytes as uploaded
+		size_t encodedBytes = 0;
+		double vertexDecodeGBps = 0.0;	///< Decoded (raw) bytes per second
+		double indexDecodeGBps = 0.0;
+
+		double Ratio() const { return rawBytes ? static_cast<double>(encodedBytes) / rawBytes : 0.0; }
+	};
+
+	/// @return Encoded vertex stream. Stride must be a multiple of 4, at most MaxVertexStride.
+	static std::vector<uint8_t> EncodeVertexBuffer(const void* vertices, size_t count, size_t stride);
+
+	/**
+	 * @brief Decodes a vertex stream into `destination` (count * stride bytes).
+	 * @return False if the stream is truncated, malformed or longer than count vertices.
+	 */
+	static bool DecodeVertexBuffer(void* destination, size_t count, size_t stride, const uint8_t* data, size_t size);
+
+	static std::vector<uint8_t> EncodeIndexBuffer(const unsigned int* indices, size_t count);
+
+	/// @return False if the stream is truncated, malformed or longer than count indices.
+	static bool DecodeIndexBuffer(unsigned int* destination, size_t count, const uint8_t* data, size_t size);
+
+	/// Encodes a mesh, checks the round trip and times decoding (best of several runs).
+	static Report Measure(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+};
@@ -0,0 +1,101 @@
+/**
+ * @file OffsetAllocator.h
+ * @brief TLSF-style (two-level segregated fit) range allocator.
+ *
+ * The allocator hands out [offset, offset + size) ranges inside a fixed-size
+ * address space. It never touches the memory itself, which makes it suitable
+ * for sub-allocating GPU buffers: offsets are in caller-defined units
+ * (vertices, indices, bytes...).
+ *
+ * Free ranges are kept in 256 size bins addressed by a tiny 5.3 float
+ * (5 bit exponent, 3 bit mantissa). Two bitmasks (top bins / leaf bins) let
+ * Allocate() find a fitting bin with two bit scans, so both Allocate() and
+ * Free() are O(1). Adjacent free ranges are merged on Free().
+ */
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class OffsetAllocator
+{
+public:
+	static constexpr uint32_t NoSpace = 0xffffffff;
+
+	/**
+	 * @struct Allocation
+	 * @brief Result of Allocate(); pass it back to Free().
+	 */
+	struct Allocation
+	{
+		uint32_t offset = NoSpace;	///< Start of the range (NoSpace on failure)
+		uint32_t metadata = NoSpace;	///< Internal node index
+
+		bool IsValid() const { return offset != NoSpace; }
+	};
+
+	/**
+	 * @struct StorageReport
+	 * @brief Free space summary, used to decide when to defragment.
+	 */
+	struct StorageReport
+	{
+		uint32_t totalFreeSpace = 0;
+		uint32_t largestFreeRegion = 0;
+	};
+
+private:
+	static constexpr uint32_t NumTopBins = 32;
+	static constexpr uint32_t BinsPerLeaf = 8;
+	static constexpr uint32_t TopBinsIndexShift = 3;
+	static constexpr uint32_t LeafBinsIndexMask = 0x7;
+	static constexpr uint32_t NumLeafBins = NumTopBins * BinsPerLeaf;
+	static constexpr uint32_t Unused = 0xffffffff;
+
+	struct Node
+	{
+		uint32_t dataOffset = 0;
+		uint32_t dataSize = 0;
+		uint32_t binListPrev = Unused;
+		uint32_t binListNext = Unused;
+		uint32_t neighborPrev = Unused;
+		uint32_t neighborNext = Unused;
+		bool used = false;
+	};
+
+	uint32_t size;				///< Total address space
+	uint32_t maxAllocs;			///< Node pool capacity
+	uint32_t freeStorage = 0;	///< Sum of all free ranges
+
+	uint32_t usedBinsTop = 0;				///< Bit per top bin that has any free node
+	uint8_t usedBins[NumTopBins] = {};		///< Bit per leaf bin inside each top bin
+	uint32_t binIndices[NumLeafBins];		///< Head of each bin's free list
+
+	std::vector<Node> nodes;
+	std::vector<uint32_t> freeNodes;	///< Stack of unused node indices
+	uint32_t freeOffset = 0;			///< Top of the freeNodes stack
+
+	uint32_t InsertNodeIntoBin(uint32_t dataSize, uint32_t dataOffset);
+	void RemoveNodeFromBin(uint32_t nodeIndex);
+
+public:
+	/**
+	 * @param size Size of the managed range, in caller units.
+	 * @param maxAllocs Maximum number of live allocations plus free regions.
+	 */
+	OffsetAllocator(uint32_t size, uint32_t maxAllocs = 128 * 1024);
+
+	/// Forgets every allocation and makes the whole range free again.
+	void Reset();
+
+	/// @return A range of at least `size` units, or an invalid Allocation if full.
+	Allocation Allocate(uint32_t size);
+
+	/// Returns a range to the allocator and merges it with free neighbors.
+	void Free(Allocation allocation);
+
+	/// @return Size of the range owned by `allocation`.
+	uint32_t AllocationSize(Allocation allocation) const;
+
+	StorageReport GetStorageReport() const;
+	uint32_t GetSize() const { return size; }
+};
@@ -15,8 +15,14 @@
 #include <Scene/Transform.h>
 #include <Renderer/Mesh.h>
 #include <Renderer/Material.h>
+#include <Renderer/MaterialTable.h>
+#include <Renderer/StreamBuffer.h>
+#include <Renderer/DebugDraw.h>
+#include <Renderer/LabelRenderer.h>
+#include <Renderer/SkyCache.h>
 #include <glm/glm.hpp>
 #include <Scene/CameraManager.h>
+#include <Scene/Frustum.h>
 
 /**
  * @struct RenderObject
@@ -31,6 +37,32 @@ struct RenderObject
 	int renderLayer = 0;
 };
 
+/**
+ * @struct RenderStats
+ * @brief Counters for the last rendered frame.
+ */
+struct RenderStats
+{
+	unsigned int drawCalls = 0;
+	unsigned int scenePasses = 0;		///< Object passes; cameras merged into a multi-view pass count once
+	double sceneCpuSeconds = 0.0;		///< CPU time of culling and submission over all passes
+	unsigned int clustersTested = 0;	///< Mesh clusters considered by culling, over all cameras
+	unsigned int clustersDrawn = 0;		///< Clusters that survived frustum + back-face cone culling
+	size_t trianglesSubmitted = 0;
+	size_t streamedBytes = 0;		///< Bytes written into the StreamBuffer this frame
+	double streamWriteSeconds = 0.0;	///< CPU time spent writing them
+	unsigned int domeFaces = 0;		///< Cube faces rendered for dome cameras
+	size_t labelsPlaced = 0;		///< Labels kept after decluttering, summed over labelPasses
+	double labelSeconds = 0.0;		///< CPU time of label layout, summed over labelPasses
+	unsigned int labelPasses = 0;		///< Views that laid out labels (each considers every candidate)
+
+	/// Upload throughput of this frame's streamed data, in GB/s
+	double StreamThroughputGBps() const
+	{
+		return streamWriteSeconds > 0.0 ? streamedBytes / streamWriteSeconds / 1e9 : 0.0;
+	}
+};
+
  /**
   * @class Renderer
   * @brief High-level rendering fa�ade that issues draw calls using Mesh and Shader objects.
@@ -77,8 +109,111 @@ class Renderer
 {
 private:
 	std::unique_ptr<Shader> shader;		///< Active shader program
+	std::unique_ptr<Shader> multiViewShader;	///< basic.vert variant that draws all views of a pass per instance
 	std::vector<const RenderObject*> sceneObjects;	///< Pointers to objects to render this frame
+	MaterialTable materialTable;		///< GPU table of material parameters (one slot per Material)
+	std::shared_ptr<Material> defaultMaterial;	///< Used for objects without a material
+	std::unique_ptr<StreamBuffer> streamBuffer;	///< Per-frame draw/camera data, persistently mapped
+	std::unique_ptr<DebugDraw> debugDraw;		///< Batches DebugDraw submissions (no-op in release)
+	std::unique_ptr<LabelRenderer> labelRenderer;	///< Decluttered SDF body labels
+	std::vector<LabelCandidate> labels;		///< Label candidates for this frame
+	std::unique_ptr<SkyCache> skyCache;		///< Star background, cached in a cubemap
+	RenderStats stats;
+
+	static constexpr size_t StreamBufferSize = 8 * 1024 * 1024;	///< Several frames of per-draw data
+
+	bool multiViewSupported = false;	///< ARB_shader_viewport_layer_array is available
+	bool multiViewEnabled = true;
+	unsigned int maxViewsPerPass = 1;	///< min(MaxViewsPerPass, GL_MAX_VIEWPORTS) when supported
+	std::vector<Frustum> viewFrustums;	///< Reused per pass, one per view
+	std::vector<glm::vec3> viewPositions;
+
+	/// One view of a scene pass: a mono camera or one eye of a stereo camera
+	struct PassView
+	{
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::vec3 position;
+		glm::ivec4 viewport;
+		unsigned int framebuffer;	///< Where this view is drawn (an eye or face framebuffer for layered targets)
+		int layer;					///< Texture layer in a layered pass (eye, or cube face)
+		int renderLayer;
+		const Camera* camera;
+		int eye;					///< 0 = left, 1 = right, -1 = mono
+	};
+
+	std::vector<PassView> viewGroup;	///< Views merged into the current pass
+
+	/// Layout consumed by glMultiDrawElementsIndirect
+	struct IndirectCommand
+	{
+		unsigned int count;
+		unsigned int instanceCount;
+		unsigned int firstIndex;
+		int baseVertex;
+		unsigned int baseInstance;
+	};
+
+	/// One object's share of a camera pass: a range of commands in indirectCommands
+	struct ObjectDraw
+	{
+		const Material* material;
+		unsigned int vao;
+		size_t firstCommand;
+		size_t commandCount;
+	};
+
+	std::vector<IndirectCommand> indirectCommands;	///< Reused per camera pass
+	std::vector<ObjectDraw> objectDraws;			///< Reused per camera pass
+
+	/// Writes one DrawData record per scene object and binds the array (SSBO binding 1).
+	void UploadDrawData();
+
+	/// Writes the camera block for one pass and binds it (UBO binding 0).
+	void UploadCameraData(const PassView& view);
+
+	/// Writes view-projections and positions of every view in a pass and binds them (UBO binding 3).
+	void UploadViewArray(const PassView* views, size_t viewCount);
+
+	/// Expands a camera into its views (two for stereo). @return Number of views written.
+	size_t BuildPassViews(const CameraRenderData& camData, PassView out[2]) const;
+
+	/// Draws both eyes of a layered stereo camera into its StereoTarget.
+	void DrawLayeredStereo(const CameraRenderData& camData, const PassView eyes[2]);
+
+	/// Draws the dome's cube faces (one layered pass when possible) and warps them to the fisheye.
+	void DrawDome(const CameraRenderData& camData);
+
+	/// Clears one camera's viewport only (the scissor keeps other views intact).
+	void ClearViewport(const glm::ivec4& viewport, const glm::vec4& color);
+
+	/**
+	 * @brief Draws the scene for one or more views sharing a framebuffer and layer.
+	 *
+	 * With several views every object is submitted once: each indirect command is
+	 * instanced once per view and the multi-view shader routes instance i to
+	 * viewport i (or view i's layer when layeredFramebuffer is set). Objects and clusters
+	 * are kept if any view can see them; a stereo pair is culled once against
+	 * the union of both eye frusta.
+	 */
+	void DrawViews(const PassView* views, size_t viewCount, unsigned int layeredFramebuffer = 0);
+
+	/// True if the camera can join the current view group (same target, no overlap, room left).
+	bool CanJoinViewGroup(const PassView& view) const;
+
+	/**
+	 * @brief Appends indirect commands for the parts of an object visible from the pass's views.
+	 *
+	 * Clusters outside every frustum or whose normal cone faces away from every
+	 * camera are dropped; adjacent survivors are merged into one command, which
+	 * is instanced once per view.
+	 * @return Number of commands appended (0 if the object is not visible).
+	 */
+	size_t CullObject(const RenderObject& obj, unsigned int objectIndex, const Frustum* frustums, size_t frustumCount,
+		const glm::vec3* cameraPositions, size_t positionCount, unsigned int instanceCount);
 public:
+	static constexpr unsigned int MaxViewsPerPass = 16;	///< Must match MAX_VIEWS in basic_multiview.vert
+
 	Renderer();
 	~Renderer();
 
@@ -114,20 +249,42 @@ public:
 	void RenderFrame(const std::vector<CameraRenderData>& cameras);
 
 	/**
-	 * @brief Draws the scene from the perspective of a given camera.
-	 * @param camera The active camera to render with.
+	 * @brief Merges cameras that share a framebuffer and layer into single passes.
+	 * Only takes effect when ARB_shader_viewport_layer_array is supported;
+	 * overlapping viewports (e.g. an inset minimap) always get their own pass.
 	 */
-	void DrawScene(const CameraRenderData& camData, int layer);
+	void SetMultiViewEnabled(bool enabled) { multiViewEnabled = enabled; }
+	bool IsMultiViewActive() const { return multiViewEnabled && multiViewSupported; }
 
 
 	/**
 	 * @brief Adds a renderable mesh to the scene.
 	 * Ownership is simple; this is a temporary per-frame list.
 	 * Takes a const reference to avoid copying the mesh.
+	 * The object's material is registered in the MaterialTable on first sight.
 	 */
 	void AddRenderObject(const RenderObject& object);
 
-	/** Clears the list of render objects after each frame. */
+	/**
+	 * @brief Queues a screen-space label for this frame.
+	 * The text must stay valid until RenderFrame() returns; overlapping
+	 * labels are dropped per camera, lowest priority first.
+	 */
+	void AddLabel(const LabelCandidate& label);
+
+	/** Clears the list of render objects (and labels) after each frame. */
 	void ResetSceneObjects();
 
+	/** @brief Ring allocator for transient GPU data (valid after Initialize()). */
+	StreamBuffer* GetStreamBuffer() const { return streamBuffer.get(); }
+
+	/**
+	 * @brief True while a rendered frame is needed to finish background work
+	 * (e.g. a sky refresh in progress), even if nothing else changed.
+	 */
+	bool HasPendingWork() const { return skyCache && skyCache->IsRefreshing(); }
+
+	/** @brief Counters of the last frame rendered by RenderFrame(). */
+	const RenderStats& GetStats() const { return stats; }
+
 };
\ No newline at end of file
@@ -0,0 +1,79 @@
+/**
+ * @file SdfFont.h
+ * @brief Signed-distance-field glyph atlas for scalable screen text.
+ *
+ * Each atlas texel stores the distance to the nearest glyph edge, remapped so
+ * that 0.5 is the outline, larger values are inside and smaller values are
+ * outside. The fragment shader thresholds at 0.5 with a screen-space
+ * derivative, so one small atlas renders crisp text at any pixel size and
+ * gives outlines/halos for free.
+ *
+ * The built-in face is generated at startup from a compact 5x7 bitmap font:
+ * every lit pixel becomes a round stroke node, and neighbouring nodes are
+ * joined by capsules. The distance field of that stroke set is exact, so the
+ * atlas needs no font files and no offline tooling.
+ */
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Renderer/GpuResourceRegistry.h>
+
+/**
+ * @struct SdfGlyph
+ * @brief Placement of one glyph quad, in em units (1 em = the font's cap height).
+ */
+struct SdfGlyph
+{
+	glm::vec2 uvMin = glm::vec2(0.0f);	///< Atlas rectangle (normalized)
+	glm::vec2 uvMax = glm::vec2(0.0f);
+	glm::vec2 offset = glm::vec2(0.0f);	///< Quad bottom-left relative to the pen, baseline at y = 0
+	glm::vec2 size = glm::vec2(0.0f);	///< Quad size
+	float advance = 0.0f;				///< Pen advance after this glyph
+	bool visible = false;				///< False for blanks (space): advance only, no quad
+};
+
+class SdfFont
+{
+public:
+	static constexpr int FirstChar = 32;	///< ' '
+	static constexpr int LastChar = 126;	///< '~'
+
+private:
+	std::vector<SdfGlyph> glyphs;		///< FirstChar..LastChar
+	std::vector<uint8_t> atlas;		///< R8 distance field, row 0 at the bottom (GL order)
+	int atlasWidth = 0;
+	int atlasHeight = 0;
+	float distanceRange = 0.0f;		///< Em distance covered by 0..1 in the atlas, for shader AA
+	unsigned int texture = 0;
+	GpuResourceRegistry::Handle record = GpuResourceRegistry::InvalidHandle;
+
+	void BuildBuiltinFace();
+
+public:
+	/// Builds the built-in face on the CPU. Call Upload() once a GL context exists.
+	SdfFont();
+	~SdfFont();
+
+	SdfFont(const SdfFont&) = delete;
+	SdfFont& operator=(const SdfFont&) = delete;
+
+	/// Creates the GL_R8 atlas texture (linear filtering, clamped).
+	void Upload();
+
+	/// Binds the atlas to a texture unit and marks it used this frame.
+	void Bind(unsigned int unit) const;
+
+	/// Glyph for a character; unknown characters map to '?'.
+	const SdfGlyph& GetGlyph(char c) const;
+
+	/// Width and height of a single line of text, in pixels at `pixelSize` pixels per em.
+	glm::vec2 Measure(std::string_view text, float pixelSize) const;
+
+	unsigned int GetTexture() const { return texture; }
+	int GetAtlasWidth() const { return atlasWidth; }
+	int GetAtlasHeight() const { return atlasHeight; }
+	float GetDistanceRange() const { return distanceRange; }
+	const std::vector<uint8_t>& GetAtlas() const { return atlas; }
+};
@@ -42,6 +42,7 @@ public:
 	void SetBool(const std::string& name, bool value) const;
 	void SetInt(const std::string& name, int value) const;
 	void SetFloat(const std::string& name, float value) const;
+	void SetVec2(const std::string& name, const glm::vec2& value) const;
 	void SetVec3(const std::string& name, const glm::vec3& value) const;
 	void SetVec4(const std::string& name, const glm::vec4& value) const;
 	void SetMat3(const std::string& name, const glm::mat3& value) const;
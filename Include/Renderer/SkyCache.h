@@ -0,0 +1,86 @@
+/**
+ * @file SkyCache.h
+ * @brief Far-background layers cached in a cubemap around the camera.
+ *
+ * At solar-system scales the star field barely changes when the camera
+ * translates, so it is rendered once into a cubemap at the camera position
+ * and each pass only samples that cubemap (one full-screen triangle at the
+ * far plane).
+ *
+ * Once the camera has moved far enough that the nearest star would shift
+ * by more than a fraction of a cubemap texel, a refresh starts from the new
+ * position. It renders one face per frame into a second cubemap and swaps
+ * the two when all six faces are done, so a half-updated sky is never shown.
+ */
+#pragma once
+#include <memory>
+#include <glm/glm.hpp>
+#include <Scene/StarCatalog.h>
+#include <Renderer/GpuResourceRegistry.h>
+
+class Shader;
+
+class SkyCache
+{
+public:
+	struct Settings
+	{
+		int faceSize = 1024;			///< Cubemap face resolution in texels
+		float parallaxTexels = 0.5f;	///< Refresh once the nearest star moves this many texels
+		float pointScale = 1.0f;		///< Star sprite size multiplier
+	};
+
+	struct Stats
+	{
+		size_t facesRendered = 0;
+		size_t refreshes = 0;		///< Completed cubemap swaps
+		double lastFaceSeconds = 0.0;	///< CPU time to submit the last face
+	};
+
+private:
+	Settings settings;
+	Stats stats;
+	StarCatalog catalog;
+
+	std::unique_ptr<Shader> starShader;	///< Draws the catalog into a cube face
+	std::unique_ptr<Shader> skyShader;	///< Samples the cubemap behind the scene
+	unsigned int cubemaps[2] = { 0, 0 };	///< [front] is sampled, the other is being refreshed
+	int front = 0;
+	unsigned int framebuffer = 0;
+	unsigned int starVao = 0;
+	unsigned int starBuffer = 0;
+	unsigned int skyVao = 0;			///< Empty VAO for the attribute-less full-screen triangle
+	GpuResourceRegistry::Handle records[3] = {};	///< Both cubemaps, star buffer
+
+	bool valid = false;					///< Front cubemap holds a complete sky
+	int nextFace = -1;					///< Face being refreshed, -1 when idle
+	glm::vec3 frontOrigin = glm::vec3(0.0f);	///< Capture position of the front cubemap
+	glm::vec3 backOrigin = glm::vec3(0.0f);		///< Capture position of the refresh in progress
+	float refreshDistance = 0.0f;		///< Camera travel that triggers a refresh
+
+	void RenderFace(unsigned int cubemap, int face, const glm::vec3& origin);
+
+public:
+	/// Requires a current GL context; generates and uploads the star catalog.
+	SkyCache();
+	explicit SkyCache(const Settings& settings);
+	~SkyCache();
+
+	SkyCache(const SkyCache&) = delete;
+	SkyCache& operator=(const SkyCache&) = delete;
+
+	/**
+	 * @brief Starts or continues a refresh for the given camera position.
+	 * Renders at most one face, except on the first call which fills all six.
+	 * Changes the framebuffer binding and viewport; call before the camera passes.
+	 */
+	void Update(const glm::vec3& cameraPosition);
+
+	/// Draws the cached sky into the current pass (uses the camera block at binding 0).
+	void Draw() const;
+
+	/// True while faces are still being refreshed (the loop must keep rendering).
+	bool IsRefreshing() const { return nextFace >= 0; }
+
+	const Stats& GetStats() const { return stats; }
+};
@@ -0,0 +1,42 @@
+/**
+ * @file StereoTarget.h
+ * @brief Two-layer render target holding both eyes of a stereo camera.
+ *
+ * Color and depth are 2-layer texture arrays. The layered framebuffer has
+ * every layer attached, so a single pass can route each eye to its layer
+ * with gl_Layer. The per-eye framebuffers attach one layer each, for passes
+ * that draw a single eye (overlays, or the fallback without multi-view).
+ * The color array is the output handed to the VR or projection pipeline.
+ */
+#pragma once
+#include <Renderer/GpuResourceRegistry.h>
+
+class StereoTarget
+{
+private:
+	int width = 0;
+	int height = 0;
+	unsigned int colorArray = 0;		///< GL_TEXTURE_2D_ARRAY, RGBA8, layer 0 = left eye
+	unsigned int depthArray = 0;		///< GL_TEXTURE_2D_ARRAY, DEPTH_COMPONENT32F
+	unsigned int layeredFramebuffer = 0;
+	unsigned int eyeFramebuffers[2] = { 0, 0 };
+	GpuResourceRegistry::Handle colorRecord = GpuResourceRegistry::InvalidHandle;
+	GpuResourceRegistry::Handle depthRecord = GpuResourceRegistry::InvalidHandle;
+
+public:
+	/// Requires a current GL context; throws if the framebuffer is incomplete.
+	StereoTarget(int width, int height);
+	~StereoTarget();
+
+	StereoTarget(const StereoTarget&) = delete;
+	StereoTarget& operator=(const StereoTarget&) = delete;
+
+	/// Marks both arrays used this frame (call when the target is rendered to).
+	void Touch() const;
+
+	int GetWidth() const { return width; }
+	int GetHeight() const { return height; }
+	unsigned int GetColorTexture() const { return colorArray; }
+	unsigned int GetLayeredFramebuffer() const { return layeredFramebuffer; }
+	unsigned int GetEyeFramebuffer(int eye) const { return eyeFramebuffers[eye]; }
+};
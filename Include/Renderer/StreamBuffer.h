@@ -0,0 +1,103 @@
+/**
+ * @file StreamBuffer.h
+ * @brief Persistently mapped ring buffer for per-frame GPU data.
+ *
+ * One GL buffer is created with immutable storage and mapped once with
+ * MAP_PERSISTENT | MAP_COHERENT. Allocate() returns a CPU pointer straight
+ * into that mapping plus the matching buffer offset, so callers write
+ * transforms, camera blocks, instance data... directly into GPU-visible
+ * memory with no staging copy and no glBufferSubData.
+ *
+ * Synchronization:
+ *  - EndFrame() places a fence after the frame's commands and records which
+ *    part of the ring the frame used.
+ *  - Before the write head wraps onto a region that is still fenced,
+ *    Allocate() waits for that fence (normally already signaled, as the
+ *    ring holds several frames).
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <Renderer/GpuResourceRegistry.h>
+
+class StreamBuffer
+{
+public:
+	/**
+	 * @struct Allocation
+	 * @brief A sub-range of the ring, valid until the end of the current frame.
+	 */
+	struct Allocation
+	{
+		void* data = nullptr;		///< Write pointer into the persistent mapping
+		size_t offset = 0;			///< Byte offset inside the GL buffer (for glBindBufferRange)
+		size_t size = 0;			///< Requested size in bytes
+		unsigned int buffer = 0;	///< GL buffer name
+
+		bool IsValid() const { return data != nullptr; }
+	};
+
+	/**
+	 * @struct Stats
+	 * @brief Streaming counters (reset by EndFrame, totals are cumulative).
+	 */
+	struct Stats
+	{
+		size_t frameBytes = 0;		///< Bytes handed out since the last EndFrame()
+		size_t frameAllocations = 0;
+		uint64_t totalBytes = 0;
+		uint64_t fenceWaits = 0;	///< Times Allocate() had to block on the GPU
+		double fenceWaitSeconds = 0.0;
+	};
+
+private:
+	struct FencedRegion
+	{
+		void* fence = nullptr;	///< GLsync, stored opaque to keep glad out of this header
+		size_t begin = 0;
+		size_t end = 0;
+	};
+
+	unsigned int buffer = 0;
+	GpuResourceRegistry::Handle record = GpuResourceRegistry::InvalidHandle;
+	uint8_t* mapped = nullptr;
+	size_t capacity = 0;
+	size_t head = 0;			///< Next free byte
+	size_t regionBegin = 0;		///< Start of the not-yet-fenced region
+	std::deque<FencedRegion> inFlight;	///< Oldest first, in ring order
+	size_t uniformAlignment = 256;
+	size_t storageAlignment = 256;
+	Stats stats;
+
+	void CloseRegion();
+	void WaitUntil(size_t end);		///< Retires the regions between the head and end
+
+public:
+	/// @param capacity Ring size in bytes. Should hold at least three frames of data.
+	explicit StreamBuffer(size_t capacity);
+	~StreamBuffer();
+
+	StreamBuffer(const StreamBuffer&) = delete;
+	StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+	/**
+	 * @brief Reserves `size` bytes aligned to `alignment` (power of two).
+	 * @return An invalid Allocation if the request is larger than the ring.
+	 */
+	Allocation Allocate(size_t size, size_t alignment = 16);
+
+	/// Fences everything allocated this frame. Call once after the frame's draws.
+	void EndFrame();
+
+	unsigned int GetBuffer() const { return buffer; }
+	size_t GetCapacity() const { return capacity; }
+
+	/// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, use for glBindBufferRange on uniform blocks
+	size_t GetUniformAlignment() const { return uniformAlignment; }
+
+	/// GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, use for glBindBufferRange on SSBOs
+	size_t GetStorageAlignment() const { return storageAlignment; }
+
+	const Stats& GetStats() const { return stats; }
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <FreeImage.h>
+#include "Renderer/GpuResourceRegistry.h"
 /**
 @file Texture.h
 @brief This is wrapper stb_image.h header to load an image as use as a textre.
@@ -19,6 +20,13 @@ private:
 	int width, height;	// Image dimensions
 	int channels;		// Number of color channels (3=RGB, 4=RGB)
 	std::string path;	// File path (for debugging)
+	GpuResourceRegistry::Handle record = GpuResourceRegistry::InvalidHandle;	// GPU memory accounting
+	FIBITMAP* decoded = nullptr;	// 32-bit image waiting for Upload()
+	size_t decodedBytes = 0;
+
+	// Converts a freshly loaded image to RGBA and keeps it for Upload()
+	bool StoreDecoded(FIBITMAP* bitmap);
+	void ReleaseDecoded();
 
 public:
 	Texture();
@@ -28,9 +36,21 @@ public:
 	Texture(const Texture&) = delete;
 	Texture& operator=(const Texture&) = delete;
 
-	// Load texture from file
+	// Load texture from file (DecodeFromFile + Upload)
 	bool LoadFromFile(const std::string& filePath);
 
+	// Load texture from an encoded image in memory (PNG, JPEG... e.g. embedded in a GLB)
+	// name is only used for logging
+	bool LoadFromMemory(const unsigned char* data, size_t size, const std::string& name);
+
+	// Decode only: no GL calls, so these may run on a worker thread.
+	// Upload() must follow on the GL thread.
+	bool DecodeFromFile(const std::string& filePath);
+	bool DecodeFromMemory(const unsigned char* data, size_t size, const std::string& name);
+
+	// Creates the GL texture with mipmaps from the decoded image and frees it (GL thread)
+	bool Upload();
+
 	// Bind texture to a texture unit for rendering
 	void Bind(unsigned int unit = 0) const;
 	void Unbind() const;
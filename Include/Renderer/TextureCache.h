@@ -0,0 +1,39 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <Renderer/Texture.h>
+/**
+@file TextureCache.h
+@brief Deduplicates texture loads by key (file path, or "<file>#<image>" for embedded images).
+
+The cache only holds weak references: a texture is destroyed as soon as the
+last material/model using it releases it, and the next request reloads it.
+Must be used from the thread that owns the GL context.
+*/
+
+class TextureCache
+{
+private:
+	std::unordered_map<std::string, std::weak_ptr<Texture>> entries;
+	size_t hits = 0;	// Requests served from the cache
+	size_t loads = 0;	// Requests that had to decode an image
+
+	TextureCache() = default;
+
+public:
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	// Engine-wide cache
+	static TextureCache& Get();
+
+	// Returns the texture for a file, loading it on first use; nullptr if loading fails
+	std::shared_ptr<Texture> Load(const std::string& filePath);
+
+	// Same for an encoded image in memory, identified by a caller-chosen key
+	std::shared_ptr<Texture> LoadFromMemory(const std::string& key, const unsigned char* data, size_t size);
+
+	size_t GetHits() const { return hits; }
+	size_t GetLoads() const { return loads; }
+};
@@ -36,6 +36,7 @@ private:
     float aspectRatio;    ///< Aspect ratio (width / height of viewport)
     float nearPlane;      ///< Near clipping plane distance
     float farPlane;       ///< Far clipping plane distance
+    glm::vec4 tile = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);   ///< Projected part of the full frustum (x, y, width, height in [0, 1])
 
     /**
      * @brief Recalculates the orientation vectors (front, right, up)
@@ -62,6 +63,28 @@ public:
     //@return Projection Matrix: transform camera space -> clip space
     glm::mat4 GetProjectionMatrix() const;
 
+    /**
+     * @brief Restricts the projection to one tile of a larger display wall.
+     * @param newTile Tile rectangle in [0, 1] of the whole wall, from the bottom-left corner.
+     * @param wallAspect Aspect ratio of the whole wall; the fov spans the wall's height.
+     *
+     * The projection becomes the matching off-axis sub-frustum, so tiles drawn
+     * by different processes line up into one continuous image.
+     */
+    void SetTile(const glm::vec4& newTile, float wallAspect);
+
+    /**
+     * @brief View and off-axis projection of one stereo eye.
+     * @param eyeOffset Signed offset along the right vector (negative for the left eye).
+     * @param convergence Distance of the zero-parallax plane (the physical screen).
+     * @param aspect Aspect ratio of the eye's viewport.
+     *
+     * Both eyes look along the same axis; their frusta are sheared so they
+     * coincide on the convergence plane, which avoids the vertical parallax
+     * of toed-in cameras.
+     */
+    void GetEyeMatrices(float eyeOffset, float convergence, float aspect, glm::mat4& view, glm::mat4& projection) const;
+
     /**
      * @brief Moves the camera by a delta vector in world space.
      * @param delta Translation vector (world-space units).
@@ -77,6 +100,15 @@ public:
      */
     void Rotate(float yawDelta, float pitchDelta);
 
+    /// Places the camera directly (e.g. from replicated state); pitch is clamped like Rotate().
+    void SetPose(const glm::vec3& newPosition, float newYaw, float newPitch);
+
+    /// @return Yaw in degrees
+    float GetYaw() const { return yaw; }
+
+    /// @return Pitch in degrees
+    float GetPitch() const { return pitch; }
+
     //@return Currentn position
     glm::vec3 GetPosition() const { return position; }
 
@@ -88,4 +120,16 @@ public:
 
     /// @return Upward vector
     glm::vec3 GetUp() const { return up; }
+
+    /// @return Vertical field of view in degrees
+    float GetFov() const { return fov; }
+
+    /// @return Aspect ratio used by GetProjectionMatrix()
+    float GetAspectRatio() const { return aspectRatio; }
+
+    /// @return Near clipping plane distance
+    float GetNearPlane() const { return nearPlane; }
+
+    /// @return Far clipping plane distance
+    float GetFarPlane() const { return farPlane; }
 };
\ No newline at end of file
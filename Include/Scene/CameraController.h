@@ -36,6 +36,8 @@ public:
      * Behavior:
      * - WASD: Move camera forward/back/left/right
      * - Mouse: Rotate yaw/pitch for looking around
+     *
+     * @return True if the camera moved or turned this update.
      */
-    void Update(float deltaTime);
+    bool Update(float deltaTime);
 };
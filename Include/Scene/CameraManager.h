@@ -10,6 +10,11 @@
  *
  * The Renderer will query all active cameras each frame
  * and perform one render pass per camera.
+ *
+ * A camera can also be stereo: the Renderer then derives two eye views from
+ * it and draws both in one pass, either side by side in its viewport or into
+ * the two layers of a StereoTarget. A dome camera instead renders a cubemap
+ * around itself and warps it into a fisheye dome master (DomeTarget).
  */
 
 #pragma once
@@ -21,6 +26,20 @@
 #include <glm/glm.hpp>
 #include <Scene/Camera.h>
 
+class StereoTarget;
+class DomeTarget;
+
+/**
+ * @enum StereoMode
+ * @brief How a camera's output is split between the eyes.
+ */
+enum class StereoMode
+{
+    Mono,           ///< Single view
+    SideBySide,     ///< Left eye in the left half of the viewport, right eye in the right half
+    Layered         ///< Eyes rendered into layers 0 and 1 of a StereoTarget
+};
+
 /**
 * @struct CameraRenderData
 * @brief Describes how a camera should render in a given frame.
@@ -34,6 +53,13 @@ struct CameraRenderData
     glm::ivec4 viewport;   ///< (x, y, width, height)
     unsigned int framebuffer = 0; ///< 0 = default framebuffer (screen)
     int renderLayer = 0;   ///< Optional: restrict rendering to specific layer(s)
+
+    StereoMode stereo = StereoMode::Mono;
+    float eyeSeparation = 0.065f;   ///< Distance between the eyes, in world units
+    float convergence = 10.0f;      ///< Distance of the zero-parallax plane, in world units
+    const StereoTarget* stereoTarget = nullptr;   ///< Layered mode output (owned externally)
+
+    const DomeTarget* domeTarget = nullptr;   ///< Fisheye output, shown fitted in the viewport; overrides stereo (owned externally)
 };
 
 /**
@@ -100,6 +126,19 @@ public:
 
     Camera* GetMainCamera() const { return mainCamera; }
 
+    /**
+     * @brief Switches a camera between mono and stereo output.
+     * @param target Required for StereoMode::Layered; its size replaces the viewport.
+     */
+    void SetStereo(const std::string& name, StereoMode mode, float eyeSeparation = 0.065f,
+        float convergence = 10.0f, const StereoTarget* target = nullptr);
+
+    /**
+     * @brief Switches a camera to fisheye dome-master output.
+     * @param target Cubemap and dome master to render into, or nullptr for regular output.
+     */
+    void SetDome(const std::string& name, const DomeTarget* target);
+
     /**
     * @brief Sets whether a camera is active for rendering.
     */
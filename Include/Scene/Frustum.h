@@ -0,0 +1,40 @@
+/**
+ * @file Frustum.h
+ * @brief View frustum as six world-space planes, for visibility tests.
+ *
+ * Planes are extracted directly from a view-projection matrix
+ * (Gribb/Hartmann): each plane is a sum or difference of the matrix's
+ * fourth row with one of the other rows. Normals point into the frustum,
+ * so a point is inside when dot(plane.xyz, p) + plane.w >= 0 for all planes.
+ */
+#pragma once
+#include <glm/glm.hpp>
+
+class Frustum
+{
+private:
+    glm::vec4 planes[6];    ///< left, right, bottom, top, near, far (xyz = unit normal, w = distance)
+
+public:
+    Frustum() = default;
+
+    /// @param viewProjection projection * view, as uploaded to the shaders
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    /// Re-extracts the planes from a new view-projection matrix.
+    void Update(const glm::mat4& viewProjection);
+
+    /**
+     * @brief Conservative single frustum enclosing both eyes of a stereo pair.
+     *
+     * Each side takes an eye's plane when it already encloses all sixteen
+     * corners (top, bottom, near and far coincide for sideways-offset eyes).
+     * Off-axis eyes cross at the convergence plane, so their left and right
+     * planes do not; those sides use the plane through the eyes' outermost
+     * near edge and far corner instead. One test then replaces two.
+     */
+    static Frustum StereoUnion(const glm::mat4& leftViewProjection, const glm::mat4& rightViewProjection);
+
+    /// @return False only if the sphere lies completely outside one of the planes.
+    bool IntersectsSphere(const glm::vec3& center, float radius) const;
+};
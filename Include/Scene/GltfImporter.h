@@ -0,0 +1,70 @@
+/**
+ * @file GltfImporter.h
+ * @brief Loads glTF 2.0 models (.gltf with external/embedded buffers, or binary .glb).
+ *
+ * Pipeline:
+ *  - The file (and any external .bin buffers) is memory-mapped; the GLB
+ *    binary chunk is read in place, never copied.
+ *  - The JSON part is parsed in a single pass with the SAX JsonReader,
+ *    filling only the fields the engine uses.
+ *  - Every (node instance, primitive) pair is converted into the engine
+ *    Vertex layout on the JobSystem, with the node transform baked in,
+ *    and split into culling clusters there as well.
+ *  - Meshes are then uploaded and materials created on the calling thread
+ *    (which must own the GL context); images go through TextureCache, so
+ *    textures shared between materials or models are loaded once.
+ *
+ * Supported: triangle primitives; POSITION, NORMAL, TEXCOORD_0, TANGENT and
+ * COLOR_0 attributes in float or normalized integer formats; base color,
+ * normal and emissive textures. Missing normals are generated. Sparse
+ * accessors, skins, morph targets and animations are ignored.
+ */
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <Renderer/Mesh.h>
+#include <Renderer/Material.h>
+#include <Renderer/Texture.h>
+
+/**
+ * @struct ImportedModel
+ * @brief Result of an import: ready-to-draw parts plus the resources they reference.
+ */
+struct ImportedModel
+{
+	struct Part
+	{
+		std::string name;					///< Node name (or mesh name) and primitive index
+		std::unique_ptr<Mesh> mesh;			///< Geometry in model space (node transforms applied)
+		std::shared_ptr<Material> material;	///< nullptr = renderer default material
+	};
+
+	std::vector<Part> parts;
+	std::vector<std::shared_ptr<Material>> materials;	///< Indexed like the glTF materials
+	std::vector<std::shared_ptr<Texture>> textures;		///< Keeps the materials' textures alive
+};
+
+class GltfImporter
+{
+public:
+	/**
+	 * @struct Stats
+	 * @brief Timing breakdown of one import.
+	 */
+	struct Stats
+	{
+		double parseSeconds = 0.0;		///< Mapping + JSON
+		double convertSeconds = 0.0;	///< Parallel accessor conversion
+		double uploadSeconds = 0.0;		///< Mesh upload, materials and textures
+		size_t vertices = 0;
+		size_t indices = 0;
+	};
+
+	/**
+	 * @brief Imports a .gltf or .glb file.
+	 * @return False (with a logged reason) if the file cannot be read or is not valid glTF 2.0.
+	 *         Individual broken primitives are skipped with a warning.
+	 */
+	static bool Load(const std::string& path, ImportedModel& model, Stats* stats = nullptr);
+};
@@ -0,0 +1,109 @@
+/**
+ * @file LabelLayout.h
+ * @brief Projects body labels to the screen and removes overlapping ones.
+ *
+ * Every frame and camera, each candidate's world position (normally
+ * SceneNode::GetWorldPosition()) is projected and its text box measured.
+ * Candidates are then placed greedily in priority order: a label is kept only
+ * if its box does not overlap a box already placed. Placed boxes are binned
+ * into a uniform screen-space grid, so each test only looks at the few labels
+ * in the cells the new box covers.
+ *
+ * Projection and measuring run on the JobSystem in chunks; the greedy pass
+ * is inherently ordered and runs on the calling thread. No GL calls.
+ */
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+
+class SdfFont;
+
+/**
+ * @struct LabelCandidate
+ * @brief A label that may be shown this frame.
+ */
+struct LabelCandidate
+{
+	glm::vec3 worldPosition = glm::vec3(0.0f);	///< Anchor in world space
+	std::string_view text;					///< Must stay valid until the frame is rendered
+	float priority = 0.0f;					///< Higher is placed first (brightness, apparent size)
+	glm::vec3 color = glm::vec3(1.0f);
+};
+
+/**
+ * @struct PlacedLabel
+ * @brief A label that survived decluttering.
+ */
+struct PlacedLabel
+{
+	uint32_t candidate = 0;				///< Index into the candidate list
+	glm::vec2 origin = glm::vec2(0.0f);	///< Pen position of the first glyph (baseline, viewport pixels, y up)
+};
+
+class LabelLayout
+{
+public:
+	struct Settings
+	{
+		float pixelSize = 14.0f;		///< Text height in pixels (1 em)
+		glm::vec2 anchorOffset = glm::vec2(8.0f, -7.0f);	///< Pen origin relative to the projected anchor
+		float margin = 2.0f;			///< Extra clearance kept around each label
+		float cellSize = 24.0f;			///< Declutter grid cell, in pixels (about one label height works best)
+		size_t maxLabels = 2048;		///< Stop placing once this many labels are shown
+	};
+
+	struct Stats
+	{
+		size_t candidates = 0;
+		size_t visible = 0;		///< In front of the camera and on screen
+		size_t placed = 0;		///< Kept after decluttering
+		double seconds = 0.0;	///< Wall time of the last Run()
+	};
+
+	static constexpr size_t ChunkSize = 1024;	///< Candidates per projection job
+
+private:
+	struct Box
+	{
+		float x0, y0, x1, y1;	///< Screen rectangle including the margin
+		float priority;
+		uint32_t candidate;
+		glm::vec2 origin;
+	};
+
+	struct GridNode
+	{
+		uint32_t box;	///< Index into placedBoxes
+		int32_t next;	///< Next node in the same cell, -1 terminates
+	};
+
+	Settings settings;
+	Stats stats;
+	std::vector<std::vector<Box>> chunkBoxes;	///< Per-job projection output
+	std::vector<Box> boxes;			///< All visible candidates, in candidate order
+	std::vector<uint64_t> sortKeys;	///< (inverted priority << 32) | box index, sorted ascending
+	std::vector<uint64_t> sortScratch;
+	std::vector<Box> placedBoxes;
+	std::vector<int32_t> cellHeads;	///< First GridNode of each cell, -1 if empty
+	std::vector<GridNode> nodes;
+	std::vector<PlacedLabel> placed;
+
+	bool Overlaps(const Box& box, int cx0, int cy0, int cx1, int cy1, int columns) const;
+
+public:
+	void SetSettings(const Settings& newSettings) { settings = newSettings; }
+	const Settings& GetSettings() const { return settings; }
+
+	/**
+	 * @brief Projects, sorts and declutters the candidates for one view.
+	 * @param viewportSize Viewport width and height in pixels.
+	 * @return The placed labels, highest priority first (valid until the next Run()).
+	 */
+	const std::vector<PlacedLabel>& Run(const std::vector<LabelCandidate>& candidates,
+		const glm::mat4& viewProjection, const glm::vec2& viewportSize, const SdfFont& font);
+
+	const std::vector<PlacedLabel>& GetPlaced() const { return placed; }
+	const Stats& GetStats() const { return stats; }
+};
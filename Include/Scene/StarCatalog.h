@@ -0,0 +1,56 @@
+/**
+ * @file StarCatalog.h
+ * @brief Background star positions, magnitudes and colors.
+ *
+ * The tree ships no star data, so the catalog is generated procedurally
+ * from a seed: stars are spread over a spherical shell far outside the
+ * planetary system, denser along a galactic band, with the magnitude
+ * distribution of a real sky (many faint stars, few bright ones).
+ * No GL calls; SkyCache uploads and draws it.
+ */
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @struct Star
+ * @brief One catalog entry, laid out as uploaded to the GPU (20 bytes).
+ */
+struct Star
+{
+	glm::vec3 position;		///< World space
+	float magnitude;		///< Apparent magnitude, smaller is brighter
+	uint32_t color;			///< RGBA8
+};
+
+class StarCatalog
+{
+public:
+	struct Settings
+	{
+		size_t count = 100000;
+		uint32_t seed = 1977;
+		float minDistance = 2000.0f;	///< Nearest star, in world units
+		float maxDistance = 20000.0f;
+		float brightestMagnitude = -1.5f;
+		float faintestMagnitude = 8.0f;
+		float bandFraction = 0.6f;		///< Share of stars concentrated near the galactic plane
+		float bandWidth = 0.15f;		///< Band thickness (sine of the galactic latitude)
+	};
+
+private:
+	std::vector<Star> stars;
+	float minDistance = 0.0f;
+	float maxDistance = 0.0f;
+
+public:
+	/// Generates the catalog (deterministic for a given seed).
+	void Generate(const Settings& settings);
+
+	const std::vector<Star>& GetStars() const { return stars; }
+
+	/// Distance of the nearest star; bounds the parallax of a camera move.
+	float GetMinDistance() const { return minDistance; }
+	float GetMaxDistance() const { return maxDistance; }
+};
@@ -0,0 +1,33 @@
+/**
+ * @file NBodyKernels.h
+ * @brief Pairwise gravity summation compiled for each IsaLevel.
+ *
+ * All variants compute the same sums; the SIMD ones add in a different
+ * order (and with FMA from AVX2 up), so results agree to rounding, not
+ * bit for bit. Pairs at zero distance (a body with itself, or coincident
+ * bodies without softening) contribute nothing.
+ */
+#pragma once
+#include <Core/CpuFeatures.h>
+#include <cstddef>
+
+namespace NBodyKernels
+{
+	struct ForceInput
+	{
+		const double* positionX;
+		const double* positionY;
+		const double* positionZ;
+		const double* mass;
+		size_t bodyCount;
+		double softening2;				///< Squared Plummer length
+		double gravitationalConstant;
+	};
+
+	/// Writes the accelerations of bodies [begin, end) from all bodies into accelerationX/Y/Z[i].
+	using ForceFunction = void(*)(const ForceInput& input, size_t begin, size_t end,
+		double* accelerationX, double* accelerationY, double* accelerationZ);
+
+	/// Best variant at or below level.
+	ForceFunction GetForceFunction(IsaLevel level);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file NBodySystem.h
+ * @brief Direct-summation gravitational N-body integrator over SoA arrays.
+ *
+ * Each body's position, velocity and mass live in one contiguous array
+ * per field, so callers (and the Python bindings) can read or write the
+ * state in place between steps. Integration is kick-drift-kick leapfrog
+ * with Plummer softening; accelerations are summed pairwise in O(N^2),
+ * split across the JobSystem workers once the system is large enough.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Core/MemoryTracker.h>
+
+class NBodySystem
+{
+public:
+	struct Settings
+	{
+		double gravitationalConstant = 1.0;
+		double softening = 1e-3;		///< Plummer length; keeps close encounters finite
+	};
+
+	enum Field
+	{
+		PositionX, PositionY, PositionZ,
+		VelocityX, VelocityY, VelocityZ,
+		Mass,
+		FieldCount
+	};
+
+	static constexpr size_t ParallelThreshold = 256;	///< Fewer bodies are stepped on the calling thread
+	static constexpr size_t BodiesPerJob = 64;
+
+private:
+	Settings settings;
+	TrackedVector<double, MemoryTag::Simulation> fields[FieldCount];
+	TrackedVector<double, MemoryTag::Simulation> acceleration[3];
+	bool accelerationValid = false;	///< False after bodies were added or the state was written
+	double time = 0.0;
+	std::uint64_t stepIndex = 0;
+
+	void ComputeAccelerations(bool allowParallel);
+	void AccumulateRange(size_t begin, size_t end);
+
+public:
+	NBodySystem();
+	explicit NBodySystem(const Settings& settings);
+
+	/// @return Index of the new body.
+	size_t AddBody(const glm::dvec3& position, const glm::dvec3& velocity, double mass);
+
+	/// Appends count bodies at rest at the origin with zero mass, to be filled in place.
+	void AddBodies(size_t count);
+
+	/**
+	 * @brief Advances count leapfrog steps of dt.
+	 * @param allowParallel False keeps all work on the calling thread (e.g. when
+	 * many systems are already being stepped in parallel).
+	 */
+	void Step(double dt, size_t count = 1, bool allowParallel = true);
+
+	/// Call after writing positions or masses through GetField().
+	void InvalidateAccelerations() { accelerationValid = false; }
+
+	/// Kinetic plus potential energy (softened), for checking integration error.
+	double ComputeEnergy() const;
+
+	size_t GetBodyCount() const { return fields[Mass].size(); }
+	double* GetField(Field field) { return fields[field].data(); }
+	const double* GetField(Field field) const { return fields[field].data(); }
+	double GetTime() const { return time; }
+	std::uint64_t GetStepIndex() const { return stepIndex; }
+	const Settings& GetSettings() const { return settings; }
+};
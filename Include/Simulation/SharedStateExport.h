@@ -0,0 +1,58 @@
+/**
+ * @file SharedStateExport.h
+ * @brief Publishes the simulation's SoA arrays in a named shared-memory segment.
+ *
+ * External analysis tools map the segment read-only and read body states
+ * in place (see SharedStateLayout.h and tools/simreader). Publishing copies
+ * each field array once under a sequence lock: the simulation thread never
+ * takes a lock and never waits for readers; a reader that overlapped a
+ * publish simply retries.
+ *
+ * POSIX shared memory (shm_open) on Linux and macOS, a named file mapping
+ * on Windows. The segment is removed when the exporter is destroyed.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Simulation;
+struct SimSharedHeader;
+
+class SharedStateExport
+{
+public:
+	struct Stats
+	{
+		std::uint64_t publishes = 0;
+		double lastPublishSeconds = 0.0;	///< Time inside the write section of the last publish
+	};
+
+private:
+	std::string name;
+	std::intptr_t handle = -1;		///< File mapping handle (Windows) or shm descriptor
+	void* mapping = nullptr;
+	size_t segmentSize = 0;
+	SimSharedHeader* header = nullptr;
+	std::uint32_t capacity = 0;
+	size_t namesPublished = 0;		///< Body names already in the segment (bodies are never removed)
+	Stats stats;
+
+public:
+	/**
+	 * @param name Segment name; POSIX names start with '/' (e.g. SIM_SHARED_DEFAULT_NAME).
+	 * @param capacity Most bodies the segment can hold; extra bodies are not published.
+	 * Throws if the segment cannot be created.
+	 */
+	SharedStateExport(const std::string& name, std::uint32_t capacity);
+	~SharedStateExport();
+
+	SharedStateExport(const SharedStateExport&) = delete;
+	SharedStateExport& operator=(const SharedStateExport&) = delete;
+
+	/// Copies the current body state into the segment. Never blocks.
+	void Publish(const Simulation& simulation);
+
+	const std::string& GetName() const { return name; }
+	const Stats& GetStats() const { return stats; }
+};
@@ -0,0 +1,59 @@
+/**
+ * @file SharedStateLayout.h
+ * @brief Layout of the shared-memory simulation state segment (plain C).
+ *
+ * Included by the engine (SharedStateExport, the writer) and by the C reader
+ * library in tools/simreader. The segment holds this header, a table of body
+ * names, then one array of doubles per field; every block starts on a
+ * 64-byte boundary and its offset is recorded in the header.
+ *
+ * Consistency uses a sequence lock. The writer makes `sequence` odd before it
+ * touches the names or arrays and even again when done, so it never waits.
+ * A reader reads `sequence`, uses the data in place, reads `sequence` again,
+ * and keeps its result only if both values are equal and even.
+ */
+#ifndef CELESTIAL_SHARED_STATE_LAYOUT_H
+#define CELESTIAL_SHARED_STATE_LAYOUT_H
+
+#include <stdint.h>
+
+#define SIM_SHARED_MAGIC 0x4D495343u		/* "CSIM" in little-endian byte order */
+#define SIM_SHARED_VERSION 1u
+#define SIM_SHARED_DEFAULT_NAME "/celestial_sim_state"
+#define SIM_SHARED_NAME_LENGTH 32			/* Bytes per body name, NUL-terminated */
+
+/* Same order as Simulation::Field */
+enum SimSharedField
+{
+	SIM_POSITION_X,
+	SIM_POSITION_Y,
+	SIM_POSITION_Z,
+	SIM_VELOCITY_X,
+	SIM_VELOCITY_Y,
+	SIM_VELOCITY_Z,
+	SIM_SPIN,			/* Degrees in [0, 360) */
+	SIM_RADIUS,
+	SIM_MASS,
+	SIM_FIELD_COUNT
+};
+
+typedef struct SimSharedHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t capacity;			/* Bodies each array can hold */
+	uint32_t fieldCount;		/* SIM_FIELD_COUNT of the writer */
+	uint64_t segmentSize;		/* Bytes mapped, header included */
+	uint64_t sequence;			/* Sequence lock: odd while the writer updates */
+
+	/* Protected by the sequence lock */
+	uint64_t bodyCount;
+	uint64_t stepIndex;
+	double simulationTime;
+
+	/* Fixed at creation */
+	uint64_t namesOffset;		/* char[capacity][SIM_SHARED_NAME_LENGTH] */
+	uint64_t fieldOffsets[SIM_FIELD_COUNT];	/* double[capacity] each */
+} SimSharedHeader;
+
+#endif
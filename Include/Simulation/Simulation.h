@@ -0,0 +1,86 @@
+/**
+ * @file Simulation.h
+ * @brief Body state of the solar system, stored as structure-of-arrays.
+ *
+ * Every per-body quantity is one contiguous array indexed by body, so passes
+ * over a single field stream through memory, and other processes can map
+ * the arrays exactly as they are (see SharedStateExport).
+ *
+ * Motion is a circular orbit around the parent body plus a spin about the
+ * body's Y axis, both evaluated in closed form from the simulation time.
+ * Parents must be added before their children.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Core/MemoryTracker.h>
+
+class Simulation
+{
+public:
+	struct BodyDesc
+	{
+		std::string name;
+		int parent = -1;			///< Index of the body orbited, -1 = fixed at the origin
+		double orbitRadius = 0.0;
+		double orbitRate = 0.0;		///< Degrees per second
+		double orbitPhase = 0.0;	///< Degrees at time 0
+		double spinRate = 0.0;		///< Degrees per second about the body's Y axis
+		double radius = 1.0;
+		double mass = 1.0;
+	};
+
+	/// State arrays, in the order SharedStateLayout.h publishes them.
+	enum Field
+	{
+		PositionX, PositionY, PositionZ,
+		VelocityX, VelocityY, VelocityZ,
+		Spin,		///< Degrees in [0, 360)
+		Radius,
+		Mass,
+		FieldCount
+	};
+
+private:
+	// Orbit description, one entry per body
+	std::vector<std::string> names;
+	std::vector<int> parents;
+	std::vector<double> orbitRadius;
+	std::vector<double> orbitRate;
+	std::vector<double> orbitPhase;
+	std::vector<double> spinRate;
+
+	TrackedVector<double, MemoryTag::Simulation> fields[FieldCount];	///< Current state, one array per field
+
+	double time = 0.0;
+	std::uint64_t stepIndex = 0;
+
+	void Evaluate(size_t body);
+
+public:
+	/// @return Index of the new body. Throws if the parent index is not an earlier body.
+	size_t AddBody(const BodyDesc& desc);
+
+	/// Adds the bodies the application draws: Sun, Earth and Moon as bodies 0, 1 and 2.
+	void AddSolarSystem();
+
+	/// Advances time and re-evaluates every body, parents first.
+	void Step(double dt);
+
+	size_t GetBodyCount() const { return names.size(); }
+	const std::string& GetName(size_t body) const { return names[body]; }
+
+	/// Contiguous array of one field, GetBodyCount() entries.
+	const double* GetField(Field field) const { return fields[field].data(); }
+
+	glm::dvec3 GetPosition(size_t body) const
+	{
+		return glm::dvec3(fields[PositionX][body], fields[PositionY][body], fields[PositionZ][body]);
+	}
+
+	double GetTime() const { return time; }
+	std::uint64_t GetStepIndex() const { return stepIndex; }
+};
@@ -0,0 +1,70 @@
+/**
+ * @file StateClient.h
+ * @brief Viewer end of the simulation state stream (see StateServer.h).
+ *
+ * Poll() never blocks: it decodes whatever snapshots have arrived,
+ * acknowledges them so the server can use them as delta baselines, and
+ * reports the camera when it has moved. Body state is what the newest
+ * snapshot holds; a body outside the interest radius keeps its last
+ * received state and IsTracked() turns false.
+ */
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Core/Socket.h>
+#include <Simulation/StateProtocol.h>
+
+class StateClient
+{
+public:
+	struct Stats
+	{
+		std::uint64_t snapshots = 0;
+		size_t bytesReceived = 0;
+		std::uint64_t resyncs = 0;	///< Snapshots whose baseline was no longer held
+	};
+
+private:
+	static constexpr size_t HistoryLength = 32;	///< Decoded snapshots kept as baselines; more than the server leaves unacknowledged
+
+	TcpSocket connection;
+	std::vector<unsigned char> receiveBuffer;
+	std::deque<StateProtocol::Snapshot> history;	///< Newest last
+	float interestRadius;
+	float updateRate;
+	glm::vec3 lastCamera = glm::vec3(0.0f);
+
+	std::vector<std::string> names;
+	std::vector<float> radii;
+	std::vector<glm::dvec3> positions;
+	std::vector<double> spins;
+	std::vector<bool> tracked;
+	std::uint64_t stepIndex = 0;
+	double simulationTime = 0.0;
+	Stats stats;
+
+	void SendView(std::uint32_t type, const glm::vec3& camera);
+	void ApplyCatalogue(const unsigned char* payload, size_t size);
+	void ApplySnapshot(const unsigned char* payload, size_t size);
+
+public:
+	/// Connects to a StateServer, retrying until the timeout; throws if it cannot.
+	StateClient(const std::string& host, std::uint16_t port, float updateRate, float interestRadius,
+		const glm::vec3& camera, double connectTimeoutSeconds = 10.0);
+
+	/// Applies everything that has arrived. @return False when the server is gone.
+	bool Poll(const glm::vec3& camera);
+
+	size_t GetBodyCount() const { return names.size(); }
+	const std::string& GetName(size_t body) const { return names[body]; }
+	bool IsTracked(size_t body) const { return body < tracked.size() && tracked[body]; }
+	float GetRadius(size_t body) const { return radii[body]; }
+	glm::dvec3 GetPosition(size_t body) const { return positions[body]; }
+	double GetSpin(size_t body) const { return spins[body]; }
+	std::uint64_t GetStepIndex() const { return stepIndex; }
+	double GetTime() const { return simulationTime; }
+	const Stats& GetStats() const { return stats; }
+};
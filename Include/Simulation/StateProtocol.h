@@ -0,0 +1,139 @@
+/**
+ * @file StateProtocol.h
+ * @brief Wire format between the simulation server and its viewers.
+ *
+ * Body state is quantized before it is sent: positions to fixed point
+ * (PositionStep world units), spin to 16 bits of a turn. A snapshot is
+ * delta-encoded against a baseline, the last snapshot the viewer
+ * acknowledged. Bodies identical to the baseline are left out, changed
+ * fields travel as zigzag varints of the quantized difference, and bodies
+ * that left the viewer's interest area are listed by id. Without a baseline
+ * the same encoding applies against zero.
+ *
+ * Messages are a MessageHeader plus payload; both ends run the same build,
+ * so fixed-size fields travel in native byte order.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Core/Socket.h>
+
+namespace StateProtocol
+{
+	constexpr double PositionStep = 1.0 / 4096.0;	///< World units per quantization step
+	constexpr std::uint32_t NameLength = 32;
+	constexpr std::uint32_t MaxMessageBytes = 1u << 24;	///< Larger payloads end the connection (bounds the receive buffer)
+
+	enum MessageType : std::uint32_t
+	{
+		HelloMessage = 1,		///< Viewer -> server: ViewPayload (first message)
+		ViewMessage = 2,		///< Viewer -> server: ViewPayload, when the camera moved
+		AckMessage = 3,			///< Viewer -> server: snapshot id decoded; 0 = discard the baseline
+		CatalogueMessage = 4,	///< Server -> viewer: CatalogueHeader + CatalogueEntry records
+		SnapshotMessage = 5		///< Server -> viewer: SnapshotHeader + delta records
+	};
+
+	struct MessageHeader
+	{
+		std::uint32_t type;
+		std::uint32_t size;		///< Payload bytes following the header
+	};
+
+	struct ViewPayload
+	{
+		float camera[3];
+		float interestRadius;	///< Bodies whose surface is farther than this are not sent
+		float updateRate;		///< Snapshots per second the viewer wants
+	};
+
+	struct CatalogueHeader
+	{
+		std::uint32_t firstBody;
+		std::uint32_t count;
+	};
+
+	struct CatalogueEntry
+	{
+		char name[NameLength];	///< NUL-terminated
+		float radius;
+	};
+
+	struct SnapshotHeader
+	{
+		std::uint32_t snapshotId;	///< Starts at 1
+		std::uint32_t baselineId;	///< 0 = encoded against zero
+		std::uint64_t stepIndex;
+		double simulationTime;
+	};
+
+	/// One body as it travels, after quantization.
+	struct QuantizedBody
+	{
+		std::uint32_t id;
+		std::int32_t position[3];
+		std::uint16_t spin;
+
+		bool operator==(const QuantizedBody& other) const
+		{
+			return id == other.id && position[0] == other.position[0] && position[1] == other.position[1]
+				&& position[2] == other.position[2] && spin == other.spin;
+		}
+	};
+
+	/// Body set of one snapshot, sorted by id.
+	struct Snapshot
+	{
+		std::uint32_t id = 0;
+		std::vector<QuantizedBody> bodies;
+	};
+
+	QuantizedBody Quantize(std::uint32_t id, const glm::dvec3& position, double spinDegrees);
+	glm::dvec3 DequantizePosition(const QuantizedBody& body);
+	double DequantizeSpin(const QuantizedBody& body);
+
+	/// Appends the records turning baseline into current (both sorted by id) to out.
+	void EncodeDelta(const std::vector<QuantizedBody>& baseline, const std::vector<QuantizedBody>& current,
+		std::vector<unsigned char>& out);
+
+	/// Rebuilds current from baseline and the records. @return False if the records are malformed.
+	bool DecodeDelta(const std::vector<QuantizedBody>& baseline, const unsigned char* data, size_t size,
+		std::vector<QuantizedBody>& current);
+
+	bool SendMessage(const TcpSocket& socket, std::uint32_t type, const void* payload, std::uint32_t size);
+
+	/**
+	 * @brief Appends whatever has arrived on the socket without blocking.
+	 * @return False when the connection closed or failed.
+	 */
+	bool ReceiveAvailable(const TcpSocket& socket, std::vector<unsigned char>& buffer);
+
+	/**
+	 * @brief Calls handler(type, payload, size) for each complete message in buffer and removes them.
+	 * @return False if a header announces more than MaxMessageBytes; the caller drops the connection.
+	 */
+	template <typename Handler>
+	bool ForEachMessage(std::vector<unsigned char>& buffer, Handler&& handler)
+	{
+		size_t offset = 0;
+		bool valid = true;
+		while (buffer.size() - offset >= sizeof(MessageHeader))
+		{
+			MessageHeader header;
+			std::memcpy(&header, buffer.data() + offset, sizeof(header));
+			if (header.size > MaxMessageBytes)
+			{
+				valid = false;
+				break;
+			}
+			if (buffer.size() - offset - sizeof(header) < header.size)
+				break;	// Rest of the message has not arrived yet
+			handler(header.type, buffer.data() + offset + sizeof(header), size_t(header.size));
+			offset += sizeof(header) + header.size;
+		}
+		buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+		return valid;
+	}
+}
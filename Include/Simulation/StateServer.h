@@ -0,0 +1,75 @@
+/**
+ * @file StateServer.h
+ * @brief Streams simulation state to viewer processes over local TCP.
+ *
+ * One process steps the simulation; any number of viewers (Application
+ * started with --connect) draw it. Each viewer asks for its own update rate
+ * and reports its camera; it only receives bodies within its interest
+ * radius, quantized and delta-encoded against the last snapshot it
+ * acknowledged (see StateProtocol.h).
+ *
+ * The server never waits for a viewer: messages are read only when they have
+ * arrived, and a viewer with MaxUnacknowledged snapshots outstanding is
+ * skipped until it catches up.
+ */
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <glm/glm.hpp>
+#include <Core/Socket.h>
+#include <Simulation/StateProtocol.h>
+
+class Simulation;
+
+class StateServer
+{
+public:
+	static constexpr size_t MaxUnacknowledged = 16;
+
+	struct Stats
+	{
+		std::uint64_t snapshotsSent = 0;
+		size_t bytesSent = 0;			///< Snapshot and catalogue messages over all viewers
+		size_t rawBytes = 0;			///< Same snapshots as unquantized, unfiltered records
+		std::uint64_t skippedSends = 0;	///< Viewers that were due but had too many snapshots outstanding
+	};
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Viewer
+	{
+		TcpSocket connection;
+		std::vector<unsigned char> receiveBuffer;
+		bool greeted = false;					///< Hello received
+		glm::vec3 camera = glm::vec3(0.0f);
+		float interestRadius = 0.0f;
+		double updateInterval = 0.0;
+		Clock::time_point nextSend;
+		std::uint32_t knownBodies = 0;			///< Catalogue entries sent
+		std::uint32_t nextSnapshotId = 1;
+		std::deque<StateProtocol::Snapshot> unacknowledged;	///< Sent, oldest first
+		StateProtocol::Snapshot baseline;		///< Last acknowledged; id 0 = none
+	};
+
+	TcpSocket listener;
+	std::vector<Viewer> viewers;
+	std::vector<unsigned char> sendBuffer;	///< Reused message buffer
+	Stats stats;
+
+	bool ReadMessages(Viewer& viewer);
+	bool SendCatalogue(Viewer& viewer, const Simulation& simulation);
+	bool SendSnapshot(Viewer& viewer, const Simulation& simulation);
+
+public:
+	/// Listens on the loopback interface. Throws if the port is unavailable.
+	explicit StateServer(std::uint16_t port);
+
+	/// Accepts new viewers, reads their messages and sends every viewer that is due a snapshot.
+	void Update(const Simulation& simulation);
+
+	size_t GetViewerCount() const { return viewers.size(); }
+	const Stats& GetStats() const { return stats; }
+};
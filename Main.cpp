@@ -1,14 +1,255 @@
 #include "Application.h"
+#include "Simulation/SharedStateLayout.h"
+#include "Simulation/StateServer.h"
+#include "Core/Profiler.h"
+#include "Core/MemoryTracker.h"
+#include "Core/CpuFeatures.h"
+#include "Core/CpuTopology.h"
+#include "Core/JobSystem.h"
+#include "Simulation/NBodySystem.h"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <random>
+#include <thread>
 
-int main()
+namespace
+{
+	// --headless, --frames N, --dome SIZE, --dome-fov DEGREES, --capture FILE,
+	// --cluster-master NODES, --cluster-node HOST, --cluster-port PORT, --tile X Y WIDTH HEIGHT,
+	// --export-state [NAME], --serve, --connect HOST, --state-port PORT, --view-rate HZ, --interest RADIUS,
+	// --metrics-port PORT, --profile FILE, --perf-counters, --memory-report FILE, --memory-debug,
+	// --no-affinity, --job-scaling BODIES, --isa NAME, --model FILE
+	LaunchOptions ParseArguments(int argc, char** argv)
+	{
+		LaunchOptions options;
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string arg = argv[i];
+			bool hasValue = i + 1 < argc;
+			if (arg == "--headless")
+				options.headless = true;
+			else if (arg == "--frames" && hasValue)
+				options.frameCount = std::atoi(argv[++i]);
+			else if (arg == "--dome" && hasValue)
+				options.domeSize = std::atoi(argv[++i]);
+			else if (arg == "--dome-fov" && hasValue)
+				options.domeFieldOfView = static_cast<float>(std::atof(argv[++i]));
+			else if (arg == "--capture" && hasValue)
+				options.capturePath = argv[++i];
+			else if (arg == "--cluster-master" && hasValue)
+				options.clusterNodes = std::atoi(argv[++i]);
+			else if (arg == "--cluster-node" && hasValue)
+				options.clusterHost = argv[++i];
+			else if (arg == "--cluster-port" && hasValue)
+				options.clusterPort = std::atoi(argv[++i]);
+			else if (arg == "--tile" && i + 4 < argc)
+			{
+				for (int c = 0; c < 4; ++c)
+					options.tile[c] = static_cast<float>(std::atof(argv[++i]));
+			}
+			else if (arg == "--export-state")
+				options.exportName = hasValue && argv[i + 1][0] != '-' ? argv[++i] : SIM_SHARED_DEFAULT_NAME;
+			else if (arg == "--serve")
+				options.serveState = true;
+			else if (arg == "--connect" && hasValue)
+				options.stateHost = argv[++i];
+			else if (arg == "--state-port" && hasValue)
+				options.statePort = std::atoi(argv[++i]);
+			else if (arg == "--view-rate" && hasValue)
+				options.viewRate = static_cast<float>(std::atof(argv[++i]));
+			else if (arg == "--interest" && hasValue)
+				options.interestRadius = static_cast<float>(std::atof(argv[++i]));
+			else if (arg == "--metrics-port" && hasValue)
+				options.metricsPort = std::atoi(argv[++i]);
+			else if (arg == "--profile" && hasValue)
+				options.profilePath = argv[++i];
+			else if (arg == "--perf-counters")
+				options.perfCounters = true;
+			else if (arg == "--memory-report" && hasValue)
+				options.memoryReport = argv[++i];
+			else if (arg == "--memory-debug")
+				options.memoryDebug = true;
+			else if (arg == "--no-affinity")
+				options.threadAffinity = false;
+			else if (arg == "--job-scaling" && hasValue)
+				options.jobScalingBodies = std::atoi(argv[++i]);
+			else if (arg == "--isa" && hasValue)
+				options.isa = argv[++i];
+			else if (arg == "--model" && hasValue)
+				options.modelPath = argv[++i];
+			else
+				std::cerr << "[Main] Ignoring unknown argument: " << arg << "\n";
+		}
+		return options;
+	}
+
+	// Set from SIGINT/SIGTERM so the server unwinds and removes its shared memory segment
+	volatile std::sig_atomic_t stopRequested = 0;
+
+	void RequestStop(int)
+	{
+		stopRequested = 1;
+	}
+
+	// Simulation server: no window, fixed 60 Hz steps, state streamed to viewers (runs until Ctrl+C or SIGTERM)
+	void RunStateServer(const LaunchOptions& options)
+	{
+		std::signal(SIGINT, RequestStop);
+		std::signal(SIGTERM, RequestStop);
+
+		Simulation simulation;
+		simulation.AddSolarSystem();
+		StateServer server(static_cast<std::uint16_t>(options.statePort));
+
+		std::unique_ptr<SharedStateExport> stateExport;
+		if (!options.exportName.empty())
+			stateExport = std::make_unique<SharedStateExport>(options.exportName, 64);
+
+		std::unique_ptr<MetricsServer> metricsServer;
+		MetricHistogram* stepSeconds = nullptr;
+		MetricGauge* viewers = nullptr;
+		if (options.metricsPort > 0)
+		{
+			MetricsRegistry& registry = MetricsRegistry::Get();
+			stepSeconds = &registry.AddHistogram("celestial_simulation_step_seconds", "Time of one simulation step.",
+				{ 1e-6, 4e-6, 1.6e-5, 6.4e-5, 2.56e-4, 1.024e-3, 4.096e-3 });
+			viewers = &registry.AddGauge("celestial_state_viewers", "Connected viewer processes.");
+			metricsServer = std::make_unique<MetricsServer>(static_cast<std::uint16_t>(options.metricsPort));
+		}
+
+		const auto step = std::chrono::microseconds(16667);
+		auto nextStep = std::chrono::steady_clock::now();
+		while (!stopRequested)
+		{
+			auto stepStart = std::chrono::steady_clock::now();
+			simulation.Step(std::chrono::duration<double>(step).count());
+			if (stepSeconds)
+			{
+				stepSeconds->Observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count());
+				viewers->Set(static_cast<double>(server.GetViewerCount()));
+			}
+			if (stateExport)
+				stateExport->Publish(simulation);
+			server.Update(simulation);
+
+			// Bandwidth report every ten seconds
+			if (simulation.GetStepIndex() % 600 == 0)
+			{
+				const StateServer::Stats& stats = server.GetStats();
+				std::cout << "[StateServer] " << server.GetViewerCount() << " viewers, " << stats.snapshotsSent
+					<< " snapshots, " << stats.bytesSent << " bytes sent ("
+					<< (stats.rawBytes > 0 ? 100.0 * stats.bytesSent / stats.rawBytes : 0.0) << "% of raw), "
+					<< stats.skippedSends << " sends skipped\n";
+			}
+
+			nextStep += step;
+			std::this_thread::sleep_until(nextStep);
+		}
+
+		std::cout << "[StateServer] Stopping after " << simulation.GetStepIndex() << " steps\n";
+	}
+
+	// N-body force summation with 1, 2, 4 ... threads, workers pinned and unpinned: the scaling curve
+	void RunJobScaling(const LaunchOptions& options)
+	{
+		NBodySystem system;
+		std::mt19937 random(7);
+		std::uniform_real_distribution<double> coordinate(-1.0, 1.0);
+		size_t bodyCount = static_cast<size_t>(std::max(options.jobScalingBodies, static_cast<int>(NBodySystem::ParallelThreshold)));
+		for (size_t i = 0; i < bodyCount; ++i)
+			system.AddBody(glm::dvec3(coordinate(random), coordinate(random), coordinate(random)), glm::dvec3(0.0), 1.0 / bodyCount);
+
+		unsigned int hardware = std::max(std::thread::hardware_concurrency(), 1u);
+		std::vector<unsigned int> threadCounts;
+		for (unsigned int threads = 1; threads < hardware; threads *= 2)
+			threadCounts.push_back(threads);
+		threadCounts.push_back(hardware);
+
+		std::cout << "[JobScaling] " << bodyCount << " bodies, " << hardware << " hardware threads, "
+			<< CpuFeatures::GetName(CpuFeatures::Get().GetActive()) << " kernels\n";
+		double baseline = 0.0;
+		for (bool pin : { true, false })
+		{
+			for (unsigned int threads : threadCounts)
+			{
+				// The calling thread works too, so one thread means no workers in use
+				JobSystem::Configure(std::max(threads - 1, 1u), pin);
+				bool parallel = threads > 1;
+				system.Step(1e-4, 1, parallel);
+
+				int steps = 0;
+				auto start = std::chrono::steady_clock::now();
+				double seconds = 0.0;
+				while (steps < 3 || seconds < 0.5)
+				{
+					system.Step(1e-4, 1, parallel);
+					steps++;
+					seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				}
+
+				double stepSeconds = seconds / steps;
+				if (baseline == 0.0)
+					baseline = stepSeconds;
+				double speedup = baseline / stepSeconds;
+				std::cout << "[JobScaling] " << (pin ? "pinned" : "free  ") << " " << threads << " threads: "
+					<< stepSeconds * 1000.0 << " ms/step, speedup " << speedup << ", efficiency "
+					<< speedup / threads * 100.0 << "%\n";
+			}
+		}
+		JobSystem::Shutdown();
+	}
+}
+
+int main(int argc, char** argv)
 {
 	try
 	{
+		LaunchOptions options = ParseArguments(argc, argv);
+
+		// Place the workers, and keep the render and simulation thread on a performance core, before any job runs
+		CpuTopology::Get().Print();
+
+		// Kernel instruction set: detected, unless capped for testing
+		IsaLevel isa;
+		if (!options.isa.empty() && CpuFeatures::Parse(options.isa.c_str(), isa))
+			CpuFeatures::Get().Force(isa);
+		else if (!options.isa.empty())
+			std::cerr << "[Main] Unknown --isa value: " << options.isa << "\n";
+		CpuFeatures::Get().Print();
+
+		JobSystem::Configure(0, options.threadAffinity);
+		if (options.threadAffinity)
+			CpuTopology::PinCurrentThread(CpuTopology::Get().GetMainThreadProcessors());
+
+		if (options.jobScalingBodies > 0)
+		{
+			RunJobScaling(options);
+			return EXIT_SUCCESS;
+		}
+
+		if (options.serveState)
+		{
+			RunStateServer(options);
+			return EXIT_SUCCESS;
+		}
+
+		if (!options.profilePath.empty())
+			Profiler::Get().Start(options.profilePath, options.perfCounters);
+		if (options.memoryDebug)
+			MemoryTracker::Get().SetDebugMode(true);
+
 		// Create the engine application with window settings
-		Application app(1280, 720, "Celestial Engine - Phase 2");
+		Application app(1280, 720, "Celestial Engine - Phase 2", options);
 
 		// Run the main loop (blocks until exit)
 		app.Run();
+
+		// Trace and summary cover the whole session
+		Profiler::Get().Stop();
+		if (!options.memoryReport.empty())
+			MemoryTracker::Get().WriteReport(options.memoryReport);
 	}
 	catch (const std::exception& e)
 	{
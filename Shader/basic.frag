@@ -8,66 +8,80 @@ in vec3 Tangent;
 // Output
 out vec4 FragOutput;
 
-//  Material structure
+//  Material record (std430, must match GpuMaterial in MaterialTable.h)
 struct Material {
-    vec3 ambient;
-    vec3 diffuse;
-    vec3 specular;
-    float shininess;
-    vec3 emissive;
-
-    sampler2D diffuseMap;
-    sampler2D specularMap;
-
-    int useDiffuseMap;
-    int useSpecularMap;
-    int useNormalMap;
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;      // w = shininess
+    vec4 emissive;
+    ivec4 textureFlags; // x = diffuse map, y = specular map, z = normal map, w = emissive map
 };
 
-uniform Material material;
+layout(std430, binding = 2) readonly buffer MaterialTable {
+    Material materials[];
+};
+
+flat in int MaterialIndex;
+flat in vec3 EyePos;    // Camera position of the view this fragment belongs to
 
-// Light uniforms
-uniform vec3 uLightDir;
-uniform vec3 uLightColor;
-uniform vec3 uViewPos;      // Camera position
+layout(binding = 0) uniform sampler2D uDiffuseMap;
+layout(binding = 1) uniform sampler2D uSpecularMap;
+layout(binding = 3) uniform sampler2D uEmissiveMap;
+
+// Camera and light (std140, shared with basic.vert)
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uViewPos;      // Camera position (first view of a multi-view pass)
+    vec4 uLightDir;
+    vec4 uLightColor;
+};
 
 void main()
 {
+    Material material = materials[MaterialIndex];
+
     // get base color (from texture or material color)
     vec3 baseColor;
-    if (material.useDiffuseMap == 1) {
-        baseColor = texture(material.diffuseMap, TexCoord).rgb;
+    if (material.textureFlags.x == 1) {
+        baseColor = texture(uDiffuseMap, TexCoord).rgb;
     }
     else {
-        baseColor = material.diffuse;
+        baseColor = material.diffuse.rgb;
     }
 
     // Normalize vectors
     vec3 norm = normalize(FragNormal);
-    vec3 lightDir = normalize(uLightDir);
-    vec3 viewDir = normalize(uViewPos - FragPos);
+    vec3 lightDir = normalize(uLightDir.xyz);
+    vec3 viewDir = normalize(EyePos - FragPos);
 
     // Ambient lighting
-    vec3 ambient = material.ambient * baseColor;
+    vec3 ambient = material.ambient.rgb * baseColor;
 
     // Diffuse lighting 
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * uLightColor * baseColor;
+    vec3 diffuse = diff * uLightColor.rgb * baseColor;
 
     // Specular lighting (Phong)
     vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.specular.w);
     
     // Get specular intensity from map if available
-    vec3 specularColor = material.specular;
-    if (material.useSpecularMap == 1) {
-        specularColor = texture(material.specularMap, TexCoord).rgb;
+    vec3 specularColor = material.specular.rgb;
+    if (material.textureFlags.y == 1) {
+        specularColor = texture(uSpecularMap, TexCoord).rgb;
     }
     
-    vec3 specular = spec * uLightColor * specularColor;
+    vec3 specular = spec * uLightColor.rgb * specularColor;
+
+    // Emission: the map is scaled by the emissive color (glTF emissiveFactor)
+    vec3 emissive = material.emissive.rgb;
+    if (material.textureFlags.w == 1) {
+        emissive *= texture(uEmissiveMap, TexCoord).rgb;
+    }
 
     // Combine lighting 
-    vec3 result = ambient + diffuse + specular + material.emissive;
+    vec3 result = ambient + diffuse + specular + emissive;
 
     FragOutput = vec4(result, 1.0);
 }
@@ -5,32 +5,55 @@ layout (location = 2) in vec3 aColor;
 layout (location = 3) in vec2 aTexCoord;
 layout (location = 4) in vec3 aTangent;
 
-uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
-uniform mat3 uNormalMatrix;
+// Per-pass camera data (std140, must match GpuCameraBlock in Renderer.cpp)
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uViewPos;
+    vec4 uLightDir;
+    vec4 uLightColor;
+};
+
+// Per-object data streamed each frame (std430, must match GpuDrawData in Renderer.cpp)
+struct DrawData {
+    mat4 model;
+    vec4 normalMatrix[3];   // mat3 columns padded to vec4
+    ivec4 misc;             // x = MaterialTable slot
+};
+
+layout(std430, binding = 1) readonly buffer DrawDataBuffer {
+    DrawData draws[];
+};
 
 out vec3 FragColor;     // Vertex color
 out vec3 FragNormal;    // World normal space
 out vec3 FragPos;       // World space position
 out vec2 TexCoord;      // Texture corrdinates
 out vec3 Tangent;       // For normal mapping
+flat out int MaterialIndex; // MaterialTable slot of this draw
+flat out vec3 EyePos;       // Camera position for specular (per view in basic_multiview.vert)
 
 void main()
 {
+    // The draw's base instance indexes its DrawData record
+    DrawData draw = draws[gl_BaseInstance];
+    mat3 normalMatrix = mat3(draw.normalMatrix[0].xyz, draw.normalMatrix[1].xyz, draw.normalMatrix[2].xyz);
+
     // calculate world space position
-    vec4 worldPos = uModel * vec4(aPos, 1.0);
+    vec4 worldPos = draw.model * vec4(aPos, 1.0);
     FragPos = worldPos.xyz;
 
     // Transform normal to world space
-    FragNormal = normalize(uNormalMatrix * aNormal);
+    FragNormal = normalize(normalMatrix * aNormal);
 
     // Transform tangent to world space
-    Tangent = normalize(uNormalMatrix * aTangent);
+    Tangent = normalize(normalMatrix * aTangent);
 
     // Pass through color and texture coordinates
     FragColor = aColor;
     TexCoord = aTexCoord;
+    MaterialIndex = draw.misc.x;
+    EyePos = uViewPos.xyz;
 
     // Calculate final clip space position
     gl_Position = uProjection * uView * worldPos;
@@ -0,0 +1,80 @@
+#version 460 core
+// Variant of basic.vert that draws every view of a multi-view pass at once:
+// each instance is one view, routed to its viewport with gl_ViewportIndex
+// (or to a texture layer with gl_Layer for layered stereo and dome targets).
+#extension GL_ARB_shader_viewport_layer_array : require
+
+#define MAX_VIEWS 16    // Must match Renderer::MaxViewsPerPass
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec3 aColor;
+layout (location = 3) in vec2 aTexCoord;
+layout (location = 4) in vec3 aTangent;
+
+// Per-pass camera data (std140, must match GpuCameraBlock in Renderer.cpp)
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uViewPos;
+    vec4 uLightDir;
+    vec4 uLightColor;
+};
+
+// Per-view matrices of the pass (std140, must match GpuViewArray in Renderer.cpp)
+layout(std140, binding = 3) uniform ViewArrayBlock {
+    mat4 uViewProjections[MAX_VIEWS];
+    vec4 uViewPositions[MAX_VIEWS];
+    ivec4 uViewLayers[MAX_VIEWS];   // x = target layer (eye, or cube face)
+};
+
+uniform int uLayered;   // 1: views share the viewport and differ by layer
+
+// Per-object data streamed each frame (std430, must match GpuDrawData in Renderer.cpp)
+struct DrawData {
+    mat4 model;
+    vec4 normalMatrix[3];   // mat3 columns padded to vec4
+    ivec4 misc;             // x = MaterialTable slot
+};
+
+layout(std430, binding = 1) readonly buffer DrawDataBuffer {
+    DrawData draws[];
+};
+
+out vec3 FragColor;     // Vertex color
+out vec3 FragNormal;    // World normal space
+out vec3 FragPos;       // World space position
+out vec2 TexCoord;      // Texture corrdinates
+out vec3 Tangent;       // For normal mapping
+flat out int MaterialIndex; // MaterialTable slot of this draw
+flat out vec3 EyePos;       // Camera position of this instance's view
+
+void main()
+{
+    // The draw's base instance indexes its DrawData record
+    DrawData draw = draws[gl_BaseInstance];
+    mat3 normalMatrix = mat3(draw.normalMatrix[0].xyz, draw.normalMatrix[1].xyz, draw.normalMatrix[2].xyz);
+
+    // calculate world space position
+    vec4 worldPos = draw.model * vec4(aPos, 1.0);
+    FragPos = worldPos.xyz;
+
+    // Transform normal to world space
+    FragNormal = normalize(normalMatrix * aNormal);
+
+    // Transform tangent to world space
+    Tangent = normalize(normalMatrix * aTangent);
+
+    // Pass through color and texture coordinates
+    FragColor = aColor;
+    TexCoord = aTexCoord;
+    MaterialIndex = draw.misc.x;
+    EyePos = uViewPositions[gl_InstanceID].xyz;
+
+    // Instance i renders into viewport i or view i's layer (the base instance still selects the object)
+    if (uLayered != 0)
+        gl_Layer = uViewLayers[gl_InstanceID].x;
+    else
+        gl_ViewportIndex = gl_InstanceID;
+    gl_Position = uViewProjections[gl_InstanceID] * worldPos;
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 460 core
+in vec4 LineColor;
+
+out vec4 FragOutput;
+
+void main()
+{
+    // Unlit: debug geometry keeps its submitted color
+    FragOutput = LineColor;
+}
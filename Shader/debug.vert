@@ -0,0 +1,21 @@
+#version 460 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;   // RGBA8, normalized
+
+// Per-pass camera data (std140, must match GpuCameraBlock in Renderer.cpp)
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uViewPos;
+    vec4 uLightDir;
+    vec4 uLightColor;
+};
+
+out vec4 LineColor;
+
+void main()
+{
+    // Debug vertices are already in world space
+    LineColor = aColor;
+    gl_Position = uProjection * uView * vec4(aPos, 1.0);
+}
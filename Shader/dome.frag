@@ -0,0 +1,25 @@
+#version 460 core
+in vec2 DomeCoord;
+
+uniform samplerCube uFaces;         // Scene in camera space (forward is -Z)
+uniform float uHalfFieldOfView;     // Angle from the zenith at the edge of the circle, in radians
+
+out vec4 FragOutput;
+
+void main()
+{
+    float radius = length(DomeCoord);
+    if (radius > 1.0)
+    {
+        FragOutput = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    // Equidistant fisheye: the angle from the zenith grows linearly with the radius.
+    // Image right and up follow the camera's right and up.
+    float theta = radius * uHalfFieldOfView;
+    vec2 radial = radius > 0.0 ? DomeCoord / radius : vec2(0.0);
+    vec3 direction = vec3(radial * sin(theta), -cos(theta));
+
+    FragOutput = vec4(texture(uFaces, direction).rgb, 1.0);
+}
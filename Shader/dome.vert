@@ -0,0 +1,10 @@
+#version 460 core
+// Full-screen triangle for the dome-master warp, no vertex buffer
+out vec2 DomeCoord;     // [-1, 1] across the dome master, (0, 0) at the zenith
+
+void main()
+{
+    vec2 ndc = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+    DomeCoord = ndc;
+    gl_Position = vec4(ndc, 0.0, 1.0);
+}
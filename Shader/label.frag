@@ -0,0 +1,24 @@
+#version 460 core
+in vec2 TexCoord;
+in vec4 TextColor;
+
+uniform sampler2D uAtlas;   // Single-channel distance field, 0.5 on the glyph edge
+
+out vec4 FragOutput;
+
+void main()
+{
+    float dist = texture(uAtlas, TexCoord).r;
+    float width = max(fwidth(dist), 1e-4);
+
+    // Glyph body, anti-aliased over about one screen pixel
+    float fill = smoothstep(0.5 - width, 0.5 + width, dist);
+    // Dark halo just outside the edge keeps labels readable over bright bodies
+    float halo = smoothstep(0.25 - width, 0.25 + width, dist);
+
+    float alpha = max(fill, halo * 0.75);
+    if (alpha <= 0.0)
+        discard;
+    // Straight alpha: text color where filled, fading to black across the halo
+    FragOutput = vec4(TextColor.rgb * (fill / alpha), alpha * TextColor.a);
+}
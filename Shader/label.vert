@@ -0,0 +1,21 @@
+#version 460 core
+// One instance per glyph, no per-vertex buffer: corners come from gl_VertexID
+layout (location = 0) in vec4 aRect;    // x, y, width, height in viewport pixels (y up)
+layout (location = 1) in vec4 aUvRect;  // u0, v0, u1, v1
+layout (location = 2) in vec4 aColor;   // RGBA8, normalized
+
+uniform vec2 uViewportSize;
+
+out vec2 TexCoord;
+out vec4 TextColor;
+
+void main()
+{
+    // Triangle strip order: (0,0) (1,0) (0,1) (1,1)
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vec2 pixel = aRect.xy + corner * aRect.zw;
+
+    TexCoord = mix(aUvRect.xy, aUvRect.zw, corner);
+    TextColor = aColor;
+    gl_Position = vec4(pixel / uViewportSize * 2.0 - 1.0, 0.0, 1.0);
+}
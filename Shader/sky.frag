@@ -0,0 +1,13 @@
+#version 460 core
+in vec3 ViewDirection;
+
+uniform samplerCube uSky;
+
+out vec4 FragOutput;
+
+void main()
+{
+    vec3 radiance = texture(uSky, normalize(ViewDirection)).rgb;
+    // Soft shoulder so overlapping bright stars saturate gracefully
+    FragOutput = vec4(vec3(1.0) - exp(-radiance), 1.0);
+}
@@ -0,0 +1,25 @@
+#version 460 core
+// Per-pass camera data (std140, must match GpuCameraBlock in Renderer.cpp)
+layout(std140, binding = 0) uniform CameraBlock {
+    mat4 uView;
+    mat4 uProjection;
+    vec4 uViewPos;
+    vec4 uLightDir;
+    vec4 uLightColor;
+};
+
+out vec3 ViewDirection;
+
+void main()
+{
+    // One triangle covering the screen, no vertex buffer
+    vec2 ndc = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+
+    // Rotation only: the cubemap is centred on the camera
+    mat4 rotation = mat4(mat3(uView));
+    vec4 world = inverse(uProjection * rotation) * vec4(ndc, 1.0, 1.0);
+    ViewDirection = world.xyz / world.w;
+
+    // z = w puts the sky on the far plane
+    gl_Position = vec4(ndc, 1.0, 1.0);
+}
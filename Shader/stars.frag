@@ -0,0 +1,12 @@
+#version 460 core
+in vec3 StarColor;
+
+out vec4 FragOutput;
+
+void main()
+{
+    // Round, soft-edged sprite; accumulated additively into the cube face
+    vec2 d = gl_PointCoord * 2.0 - 1.0;
+    float falloff = exp(-3.0 * dot(d, d));
+    FragOutput = vec4(StarColor * falloff, 1.0);
+}
@@ -0,0 +1,20 @@
+#version 460 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in float aMagnitude;
+layout (location = 2) in vec4 aColor;   // RGBA8, normalized
+
+uniform mat4 uFaceViewProjection;   // Cubemap face camera at the capture position
+uniform float uPointScale;
+
+out vec3 StarColor;
+
+void main()
+{
+    // Relative flux: magnitude 0 is 1.0, each 5 magnitudes is a factor of 100
+    float flux = pow(10.0, -0.4 * aMagnitude);
+
+    // Bright stars get bigger sprites, faint ones stay one texel and just dim
+    gl_PointSize = uPointScale * clamp(1.5 + 1.5 * sqrt(flux), 1.5, 6.0);
+    StarColor = aColor.rgb * flux * 8.0;
+    gl_Position = uFaceViewProjection * vec4(aPos, 1.0);
+}
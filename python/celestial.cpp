@@ -0,0 +1,664 @@
+/**
+ * @file celestial.cpp
+ * @brief Python extension module "celestial": orbit propagator and N-body engine.
+ *
+ * State arrays are returned as NumPy arrays that view the engine's own SoA
+ * storage (no copy): each is numpy.frombuffer over a memoryview of a small
+ * buffer-protocol object that keeps its engine alive. While any such array
+ * exists the engine refuses to add bodies, since that could move the
+ * storage (BufferError, as with bytearray). Without NumPy installed the
+ * same views are returned as memoryviews.
+ *
+ * step() and step_all() release the GIL; N-body forces are spread over the
+ * engine's JobSystem, and step_all() steps independent systems in parallel
+ * for parameter sweeps. Arrays of an engine that is being stepped by
+ * another Python thread may be read mid-step.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <Simulation/Simulation.h>
+#include <Simulation/NBodySystem.h>
+#include <Core/JobSystem.h>
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+namespace
+{
+	PyObject* SimulationType = nullptr;
+	PyObject* NBodyType = nullptr;
+	PyObject* FieldBufferType = nullptr;
+	PyObject* NumPy = nullptr;	///< numpy module, or None when unavailable
+
+	Py_ssize_t ItemSize = sizeof(double);
+
+	// Shared by both engine types: buffer exports and the re-entrancy guard
+	struct EngineObject
+	{
+		PyObject_HEAD
+		Py_ssize_t exports;		///< Live buffer views; bodies cannot be added while nonzero
+		bool busy;				///< Being stepped with the GIL released
+	};
+
+	struct SimulationObject
+	{
+		EngineObject base;
+		Simulation* simulation;
+	};
+
+	struct NBodyObject
+	{
+		EngineObject base;
+		NBodySystem* system;
+	};
+
+	/// One engine array, exported through the buffer protocol.
+	struct FieldBufferObject
+	{
+		PyObject_HEAD
+		EngineObject* owner;	///< Strong reference
+		int field;
+		Py_ssize_t length;		///< Shape of the exported view
+	};
+
+	bool CheckIdle(EngineObject* engine)
+	{
+		if (engine->busy)
+		{
+			PyErr_SetString(PyExc_RuntimeError, "engine is being stepped by another thread");
+			return false;
+		}
+		return true;
+	}
+
+	bool CheckResizable(EngineObject* engine)
+	{
+		if (!CheckIdle(engine))
+			return false;
+		if (engine->exports > 0)
+		{
+			PyErr_SetString(PyExc_BufferError, "cannot add bodies while state arrays are in use; delete the arrays first");
+			return false;
+		}
+		return true;
+	}
+
+	// ----------------------------------------------------
+	// Field buffers
+	// ----------------------------------------------------
+	int FieldBuffer_GetBuffer(PyObject* self, Py_buffer* view, int flags)
+	{
+		FieldBufferObject* buffer = reinterpret_cast<FieldBufferObject*>(self);
+		PyObject* owner = reinterpret_cast<PyObject*>(buffer->owner);
+
+		double* data = nullptr;
+		bool writable = false;
+		if (Py_IS_TYPE(owner, reinterpret_cast<PyTypeObject*>(SimulationType)))
+		{
+			// Propagator state is computed from the orbit description, so it is read-only
+			Simulation* simulation = reinterpret_cast<SimulationObject*>(owner)->simulation;
+			data = const_cast<double*>(simulation->GetField(static_cast<Simulation::Field>(buffer->field)));
+			buffer->length = static_cast<Py_ssize_t>(simulation->GetBodyCount());
+		}
+		else
+		{
+			NBodySystem* system = reinterpret_cast<NBodyObject*>(owner)->system;
+			data = system->GetField(static_cast<NBodySystem::Field>(buffer->field));
+			buffer->length = static_cast<Py_ssize_t>(system->GetBodyCount());
+			writable = true;
+		}
+
+		if ((flags & PyBUF_WRITABLE) && !writable)
+		{
+			PyErr_SetString(PyExc_BufferError, "simulation state is read-only");
+			view->obj = nullptr;
+			return -1;
+		}
+
+		static double empty = 0.0;
+		view->obj = Py_NewRef(self);
+		view->buf = data ? data : &empty;
+		view->len = buffer->length * ItemSize;
+		view->readonly = writable ? 0 : 1;
+		view->itemsize = ItemSize;
+		view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+		view->ndim = 1;
+		view->shape = (flags & PyBUF_ND) ? &buffer->length : nullptr;
+		view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &ItemSize : nullptr;
+		view->suboffsets = nullptr;
+		view->internal = nullptr;
+
+		buffer->owner->exports++;
+		return 0;
+	}
+
+	void FieldBuffer_ReleaseBuffer(PyObject* self, Py_buffer*)
+	{
+		reinterpret_cast<FieldBufferObject*>(self)->owner->exports--;
+	}
+
+	void FieldBuffer_Dealloc(PyObject* self)
+	{
+		PyTypeObject* type = Py_TYPE(self);
+		Py_XDECREF(reinterpret_cast<PyObject*>(reinterpret_cast<FieldBufferObject*>(self)->owner));
+		PyObject_Free(self);
+		Py_DECREF(type);
+	}
+
+	PyType_Slot FieldBufferSlots[] = {
+		{ Py_bf_getbuffer, reinterpret_cast<void*>(FieldBuffer_GetBuffer) },
+		{ Py_bf_releasebuffer, reinterpret_cast<void*>(FieldBuffer_ReleaseBuffer) },
+		{ Py_tp_dealloc, reinterpret_cast<void*>(FieldBuffer_Dealloc) },
+		{ Py_tp_doc, const_cast<char*>("View of one engine state array (see celestial module docs).") },
+		{ 0, nullptr }
+	};
+
+	PyType_Spec FieldBufferSpec = {
+		"celestial.FieldBuffer", sizeof(FieldBufferObject), 0,
+#ifdef Py_TPFLAGS_DISALLOW_INSTANTIATION
+		Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+#else
+		Py_TPFLAGS_DEFAULT,
+#endif
+		FieldBufferSlots
+	};
+
+	/// NumPy array (or memoryview) over one field of an engine.
+	PyObject* MakeFieldView(PyObject* owner, void* closure)
+	{
+		FieldBufferObject* buffer = PyObject_New(FieldBufferObject, reinterpret_cast<PyTypeObject*>(FieldBufferType));
+		if (!buffer)
+			return nullptr;
+		buffer->owner = reinterpret_cast<EngineObject*>(Py_NewRef(owner));
+		buffer->field = static_cast<int>(reinterpret_cast<std::intptr_t>(closure));
+		buffer->length = 0;
+
+		// The memoryview holds the export for as long as it (or an array over it) lives
+		PyObject* view = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(buffer));
+		Py_DECREF(buffer);
+		if (!view || NumPy == Py_None)
+			return view;
+		PyObject* array = PyObject_CallMethod(NumPy, "frombuffer", "Os", view, "float64");
+		Py_DECREF(view);
+		return array;
+	}
+
+	// ----------------------------------------------------
+	// Simulation (orbit propagator)
+	// ----------------------------------------------------
+	Simulation* GetSimulation(PyObject* self)
+	{
+		Simulation* simulation = reinterpret_cast<SimulationObject*>(self)->simulation;
+		if (!simulation)
+			PyErr_SetString(PyExc_RuntimeError, "Simulation was not initialized");
+		return simulation;
+	}
+
+	int Simulation_Init(PyObject* self, PyObject* args, PyObject* kwargs)
+	{
+		static const char* keywords[] = { nullptr };
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, ":Simulation", const_cast<char**>(keywords)))
+			return -1;
+
+		SimulationObject* object = reinterpret_cast<SimulationObject*>(self);
+		if (!CheckResizable(&object->base))
+			return -1;
+		delete object->simulation;
+		object->simulation = new Simulation();
+		return 0;
+	}
+
+	void Simulation_Dealloc(PyObject* self)
+	{
+		PyTypeObject* type = Py_TYPE(self);
+		delete reinterpret_cast<SimulationObject*>(self)->simulation;
+		type->tp_free(self);
+		Py_DECREF(type);
+	}
+
+	PyObject* Simulation_AddBody(PyObject* self, PyObject* args, PyObject* kwargs)
+	{
+		static const char* keywords[] = { "name", "parent", "orbit_radius", "orbit_rate", "orbit_phase",
+			"spin_rate", "radius", "mass", nullptr };
+		Simulation::BodyDesc desc;
+		const char* name = nullptr;
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|idddddd:add_body", const_cast<char**>(keywords), &name,
+			&desc.parent, &desc.orbitRadius, &desc.orbitRate, &desc.orbitPhase, &desc.spinRate, &desc.radius, &desc.mass))
+			return nullptr;
+
+		Simulation* simulation = GetSimulation(self);
+		if (!simulation || !CheckResizable(reinterpret_cast<EngineObject*>(self)))
+			return nullptr;
+		desc.name = name;
+		try {
+			return PyLong_FromSize_t(simulation->AddBody(desc));
+		}
+		catch (const std::exception& e) {
+			PyErr_SetString(PyExc_ValueError, e.what());
+			return nullptr;
+		}
+	}
+
+	PyObject* Simulation_AddSolarSystem(PyObject* self, PyObject*)
+	{
+		Simulation* simulation = GetSimulation(self);
+		if (!simulation || !CheckResizable(reinterpret_cast<EngineObject*>(self)))
+			return nullptr;
+		simulation->AddSolarSystem();
+		Py_RETURN_NONE;
+	}
+
+	PyObject* Simulation_Step(PyObject* self, PyObject* args, PyObject* kwargs)
+	{
+		static const char* keywords[] = { "dt", "count", nullptr };
+		double dt = 0.0;
+		Py_ssize_t count = 1;
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|n:step", const_cast<char**>(keywords), &dt, &count))
+			return nullptr;
+
+		Simulation* simulation = GetSimulation(self);
+		EngineObject* engine = reinterpret_cast<EngineObject*>(self);
+		if (!simulation || !CheckIdle(engine))
+			return nullptr;
+
+		engine->busy = true;
+		Py_BEGIN_ALLOW_THREADS
+		for (Py_ssize_t i = 0; i < count; ++i)
+			simulation->Step(dt);
+		Py_END_ALLOW_THREADS
+		engine->busy = false;
+		Py_RETURN_NONE;
+	}
+
+	PyObject* Simulation_GetTime(PyObject* self, void*)
+	{
+		Simulation* simulation = GetSimulation(self);
+		return simulation ? PyFloat_FromDouble(simulation->GetTime()) : nullptr;
+	}
+
+	PyObject* Simulation_GetStepIndex(PyObject* self, void*)
+	{
+		Simulation* simulation = GetSimulation(self);
+		return simulation ? PyLong_FromUnsignedLongLong(simulation->GetStepIndex()) : nullptr;
+	}
+
+	PyObject* Simulation_GetBodyCount(PyObject* self, void*)
+	{
+		Simulation* simulation = GetSimulation(self);
+		return simulation ? PyLong_FromSize_t(simulation->GetBodyCount()) : nullptr;
+	}
+
+	PyObject* Simulation_GetNames(PyObject* self, void*)
+	{
+		Simulation* simulation = GetSimulation(self);
+		if (!simulation)
+			return nullptr;
+		PyObject* names = PyList_New(static_cast<Py_ssize_t>(simulation->GetBodyCount()));
+		for (size_t i = 0; names && i < simulation->GetBodyCount(); ++i)
+			PyList_SET_ITEM(names, static_cast<Py_ssize_t>(i), PyUnicode_FromString(simulation->GetName(i).c_str()));
+		return names;
+	}
+
+	PyObject* Simulation_GetField(PyObject* self, void* closure)
+	{
+		return GetSimulation(self) ? MakeFieldView(self, closure) : nullptr;
+	}
+
+#define CELESTIAL_FIELD(name, field, doc) \
+	{ name, Simulation_GetField, nullptr, const_cast<char*>(doc), reinterpret_cast<void*>(std::intptr_t(Simulation::field)) }
+
+	PyGetSetDef SimulationGetSet[] = {
+		{ "time", Simulation_GetTime, nullptr, const_cast<char*>("Simulated seconds."), nullptr },
+		{ "step_index", Simulation_GetStepIndex, nullptr, const_cast<char*>("Steps taken."), nullptr },
+		{ "body_count", Simulation_GetBodyCount, nullptr, const_cast<char*>("Number of bodies."), nullptr },
+		{ "names", Simulation_GetNames, nullptr, const_cast<char*>("Body names, by index."), nullptr },
+		CELESTIAL_FIELD("position_x", PositionX, "Read-only float64 view."),
+		CELESTIAL_FIELD("position_y", PositionY, "Read-only float64 view."),
+		CELESTIAL_FIELD("position_z", PositionZ, "Read-only float64 view."),
+		CELESTIAL_FIELD("velocity_x", VelocityX, "Read-only float64 view."),
+		CELESTIAL_FIELD("velocity_y", VelocityY, "Read-only float64 view."),
+		CELESTIAL_FIELD("velocity_z", VelocityZ, "Read-only float64 view."),
+		CELESTIAL_FIELD("spin", Spin, "Read-only float64 view, degrees in [0, 360)."),
+		CELESTIAL_FIELD("radius", Radius, "Read-only float64 view."),
+		CELESTIAL_FIELD("mass", Mass, "Read-only float64 view."),
+		{ nullptr, nullptr, nullptr, nullptr, nullptr }
+	};
+
+#undef CELESTIAL_FIELD
+
+	PyMethodDef SimulationMethods[] = {
+		{ "add_body", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(Simulation_AddBody)), METH_VARARGS | METH_KEYWORDS,
+			"add_body(name, parent=-1, orbit_radius=0, orbit_rate=0, orbit_phase=0, spin_rate=0, radius=1, mass=1) -> index\n"
+			"Rates in degrees per second; the parent must be an earlier body." },
+		{ "add_solar_system", Simulation_AddSolarSystem, METH_NOARGS, "Adds the Sun, Earth and Moon drawn by the engine." },
+		{ "step", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(Simulation_Step)), METH_VARARGS | METH_KEYWORDS,
+			"step(dt, count=1)\nAdvances count steps of dt seconds without holding the GIL." },
+		{ nullptr, nullptr, 0, nullptr }
+	};
+
+	PyType_Slot SimulationSlots[] = {
+		{ Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew) },
+		{ Py_tp_init, reinterpret_cast<void*>(Simulation_Init) },
+		{ Py_tp_dealloc, reinterpret_cast<void*>(Simulation_Dealloc) },
+		{ Py_tp_methods, SimulationMethods },
+		{ Py_tp_getset, SimulationGetSet },
+		{ Py_tp_doc, const_cast<char*>("Simulation()\n\nClosed-form orbit propagator: circular orbits around parent bodies.") },
+		{ 0, nullptr }
+	};
+
+	PyType_Spec SimulationSpec = {
+		"celestial.Simulation", sizeof(SimulationObject), 0, Py_TPFLAGS_DEFAULT, SimulationSlots
+	};
+
+	// ----------------------------------------------------
+	// NBody
+	// ----------------------------------------------------
+	NBodySystem* GetSystem(PyObject* self)
+	{
+		NBodySystem* system = reinterpret_cast<NBodyObject*>(self)->system;
+		if (!system)
+			PyErr_SetString(PyExc_RuntimeError, "NBody was not initialized");
+		return system;
+	}
+
+	int NBody_Init(PyObject* self, PyObject* args, PyObject* kwargs)
+	{
+		static const char* keywords[] = { "gravitational_constant", "softening", nullptr };
+		NBodySystem::Settings settings;
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|dd:NBody", const_cast<char**>(keywords),
+			&settings.gravitationalConstant, &settings.softening))
+			return -1;
+
+		NBodyObject* object = reinterpret_cast<NBodyObject*>(self);
+		if (!CheckResizable(&object->base))
+			return -1;
+		delete object->system;
+		object->system = new NBodySystem(settings);
+		return 0;
+	}
+
+	void NBody_Dealloc(PyObject* self)
+	{
+		PyTypeObject* type = Py_TYPE(self);
+		delete reinterpret_cast<NBodyObject*>(self)->system;
+		type->tp_free(self);
+		Py_DECREF(type);
+	}
+
+	PyObject* NBody_AddBody(PyObject* self, PyObject* args, PyObject* kwargs)
+	{
+		static const char* keywords[] = { "position", "velocity", "mass", nullptr };
+		glm::dvec3 position, velocity;
+		double mass = 0.0;
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, "(ddd)(ddd)d:add_body", const_cast<char**>(keywords),
+			&position.x, &position.y, &position.z, &velocity.x, &velocity.y, &velocity.z, &mass))
+			return nullptr;
+
+		NBodySystem* system = GetSystem(self);
+		if (!system || !CheckResizable(reinterpret_cast<EngineObject*>(self)))
+			return nullptr;
+		return PyLong_FromSize_t(system->AddBody(position, velocity, mass));
+	}
+
+	PyObject* NBody_AddBodies(PyObject* self, PyObject* args)
+	{
+		Py_ssize_t count = 0;
+		if (!PyArg_ParseTuple(args, "n:add_bodies", &count))
+			return nullptr;
+		if (count < 0)
+		{
+			PyErr_SetString(PyExc_ValueError, "count must not be negative");
+			return nullptr;
+		}
+
+		NBodySystem* system = GetSystem(self);
+		if (!system || !CheckResizable(reinterpret_cast<EngineObject*>(self)))
+			return nullptr;
+		system->AddBodies(static_cast<size_t>(count));
+		Py_RETURN_NONE;
+	}
+
+	PyObject* NBody_Step(PyObject* self, PyObject* args, PyObject* kwargs)
+	{
+		static const char* keywords[] = { "dt", "count", nullptr };
+		double dt = 0.0;
+		Py_ssize_t count = 1;
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, "d|n:step", const_cast<char**>(keywords), &dt, &count))
+			return nullptr;
+
+		NBodySystem* system = GetSystem(self);
+		EngineObject* engine = reinterpret_cast<EngineObject*>(self);
+		if (!system || !CheckIdle(engine))
+			return nullptr;
+
+		// The arrays may have been written from Python since the last step
+		system->InvalidateAccelerations();
+		engine->busy = true;
+		Py_BEGIN_ALLOW_THREADS
+		system->Step(dt, static_cast<size_t>(count < 0 ? 0 : count), true);
+		Py_END_ALLOW_THREADS
+		engine->busy = false;
+		Py_RETURN_NONE;
+	}
+
+	PyObject* NBody_Energy(PyObject* self, PyObject*)
+	{
+		NBodySystem* system = GetSystem(self);
+		if (!system)
+			return nullptr;
+		double energy = 0.0;
+		Py_BEGIN_ALLOW_THREADS
+		energy = system->ComputeEnergy();
+		Py_END_ALLOW_THREADS
+		return PyFloat_FromDouble(energy);
+	}
+
+	PyObject* NBody_GetTime(PyObject* self, void*)
+	{
+		NBodySystem* system = GetSystem(self);
+		return system ? PyFloat_FromDouble(system->GetTime()) : nullptr;
+	}
+
+	PyObject* NBody_GetStepIndex(PyObject* self, void*)
+	{
+		NBodySystem* system = GetSystem(self);
+		return system ? PyLong_FromUnsignedLongLong(system->GetStepIndex()) : nullptr;
+	}
+
+	PyObject* NBody_GetBodyCount(PyObject* self, void*)
+	{
+		NBodySystem* system = GetSystem(self);
+		return system ? PyLong_FromSize_t(system->GetBodyCount()) : nullptr;
+	}
+
+	PyObject* NBody_GetGravitationalConstant(PyObject* self, void*)
+	{
+		NBodySystem* system = GetSystem(self);
+		return system ? PyFloat_FromDouble(system->GetSettings().gravitationalConstant) : nullptr;
+	}
+
+	PyObject* NBody_GetSoftening(PyObject* self, void*)
+	{
+		NBodySystem* system = GetSystem(self);
+		return system ? PyFloat_FromDouble(system->GetSettings().softening) : nullptr;
+	}
+
+	PyObject* NBody_GetField(PyObject* self, void* closure)
+	{
+		return GetSystem(self) ? MakeFieldView(self, closure) : nullptr;
+	}
+
+#define CELESTIAL_FIELD(name, field) \
+	{ name, NBody_GetField, nullptr, const_cast<char*>("Writable float64 view."), reinterpret_cast<void*>(std::intptr_t(NBodySystem::field)) }
+
+	PyGetSetDef NBodyGetSet[] = {
+		{ "time", NBody_GetTime, nullptr, const_cast<char*>("Simulated time."), nullptr },
+		{ "step_index", NBody_GetStepIndex, nullptr, const_cast<char*>("Steps taken."), nullptr },
+		{ "body_count", NBody_GetBodyCount, nullptr, const_cast<char*>("Number of bodies."), nullptr },
+		{ "gravitational_constant", NBody_GetGravitationalConstant, nullptr, nullptr, nullptr },
+		{ "softening", NBody_GetSoftening, nullptr, nullptr, nullptr },
+		CELESTIAL_FIELD("position_x", PositionX),
+		CELESTIAL_FIELD("position_y", PositionY),
+		CELESTIAL_FIELD("position_z", PositionZ),
+		CELESTIAL_FIELD("velocity_x", VelocityX),
+		CELESTIAL_FIELD("velocity_y", VelocityY),
+		CELESTIAL_FIELD("velocity_z", VelocityZ),
+		CELESTIAL_FIELD("mass", Mass),
+		{ nullptr, nullptr, nullptr, nullptr, nullptr }
+	};
+
+#undef CELESTIAL_FIELD
+
+	PyMethodDef NBodyMethods[] = {
+		{ "add_body", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(NBody_AddBody)), METH_VARARGS | METH_KEYWORDS,
+			"add_body(position, velocity, mass) -> index" },
+		{ "add_bodies", NBody_AddBodies, METH_VARARGS,
+			"add_bodies(count)\nAppends count massless bodies at rest, to be filled through the arrays." },
+		{ "step", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(NBody_Step)), METH_VARARGS | METH_KEYWORDS,
+			"step(dt, count=1)\nLeapfrog steps without holding the GIL; large systems use every worker thread." },
+		{ "energy", NBody_Energy, METH_NOARGS, "energy() -> total (softened) energy" },
+		{ nullptr, nullptr, 0, nullptr }
+	};
+
+	PyType_Slot NBodySlots[] = {
+		{ Py_tp_new, reinterpret_cast<void*>(PyType_GenericNew) },
+		{ Py_tp_init, reinterpret_cast<void*>(NBody_Init) },
+		{ Py_tp_dealloc, reinterpret_cast<void*>(NBody_Dealloc) },
+		{ Py_tp_methods, NBodyMethods },
+		{ Py_tp_getset, NBodyGetSet },
+		{ Py_tp_doc, const_cast<char*>("NBody(gravitational_constant=1.0, softening=1e-3)\n\n"
+			"Direct-summation gravity with kick-drift-kick leapfrog integration.") },
+		{ 0, nullptr }
+	};
+
+	PyType_Spec NBodySpec = {
+		"celestial.NBody", sizeof(NBodyObject), 0, Py_TPFLAGS_DEFAULT, NBodySlots
+	};
+
+	// ----------------------------------------------------
+	// Module
+	// ----------------------------------------------------
+	PyObject* StepAll(PyObject*, PyObject* args, PyObject* kwargs)
+	{
+		static const char* keywords[] = { "systems", "dt", "count", nullptr };
+		PyObject* sequence = nullptr;
+		double dt = 0.0;
+		Py_ssize_t count = 1;
+		if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Od|n:step_all", const_cast<char**>(keywords), &sequence, &dt, &count))
+			return nullptr;
+
+		PyObject* items = PySequence_Fast(sequence, "systems must be a sequence of NBody");
+		if (!items)
+			return nullptr;
+
+		// Claim every system first: a system listed twice would otherwise be stepped by two threads
+		std::vector<NBodyObject*> systems;
+		Py_ssize_t size = PySequence_Fast_GET_SIZE(items);
+		bool valid = true;
+		for (Py_ssize_t i = 0; i < size && valid; ++i)
+		{
+			PyObject* item = PySequence_Fast_GET_ITEM(items, i);
+			if (!PyObject_TypeCheck(item, reinterpret_cast<PyTypeObject*>(NBodyType)))
+			{
+				PyErr_SetString(PyExc_TypeError, "systems must be a sequence of NBody");
+				valid = false;
+			}
+			else if (std::find(systems.begin(), systems.end(), reinterpret_cast<NBodyObject*>(item)) != systems.end())
+			{
+				PyErr_SetString(PyExc_ValueError, "a system is listed more than once");
+				valid = false;
+			}
+			else if (!GetSystem(item) || !CheckIdle(reinterpret_cast<EngineObject*>(item)))
+				valid = false;
+			else
+			{
+				NBodyObject* system = reinterpret_cast<NBodyObject*>(item);
+				system->base.busy = true;
+				system->system->InvalidateAccelerations();
+				systems.push_back(system);
+			}
+		}
+
+		if (valid)
+		{
+			// One system per item; each steps on a single thread so the workers are not oversubscribed
+			std::exception_ptr error;
+			Py_BEGIN_ALLOW_THREADS
+			try {
+				JobSystem::Get().ParallelFor(systems.size(), [&](size_t i) {
+					systems[i]->system->Step(dt, static_cast<size_t>(count < 0 ? 0 : count), false);
+				});
+			}
+			catch (...) {
+				error = std::current_exception();
+			}
+			Py_END_ALLOW_THREADS
+			if (error)
+			{
+				PyErr_SetString(PyExc_RuntimeError, "step_all failed");
+				valid = false;
+			}
+		}
+
+		for (NBodyObject* system : systems)
+			system->base.busy = false;
+		Py_DECREF(items);
+		if (!valid)
+			return nullptr;
+		Py_RETURN_NONE;
+	}
+
+	PyObject* WorkerCount(PyObject*, PyObject*)
+	{
+		// The calling thread works alongside the workers
+		return PyLong_FromUnsignedLong(JobSystem::Get().GetWorkerCount() + 1);
+	}
+
+	PyMethodDef ModuleMethods[] = {
+		{ "step_all", reinterpret_cast<PyCFunction>(reinterpret_cast<void(*)(void)>(StepAll)), METH_VARARGS | METH_KEYWORDS,
+			"step_all(systems, dt, count=1)\nSteps independent NBody systems in parallel without holding the GIL." },
+		{ "worker_count", WorkerCount, METH_NOARGS, "Threads used by step() and step_all()." },
+		{ nullptr, nullptr, 0, nullptr }
+	};
+
+	PyModuleDef ModuleDefinition = {
+		PyModuleDef_HEAD_INIT, "celestial",
+		"Celestial engine simulation: orbit propagator (Simulation) and N-body engine (NBody)\n"
+		"with zero-copy NumPy views of their state arrays.",
+		-1, ModuleMethods
+	};
+
+	void ShutdownJobSystem()
+	{
+		JobSystem::Shutdown();
+	}
+}
+
+PyMODINIT_FUNC PyInit_celestial()
+{
+	PyObject* module = PyModule_Create(&ModuleDefinition);
+	if (!module)
+		return nullptr;
+
+	SimulationType = PyType_FromSpec(&SimulationSpec);
+	NBodyType = PyType_FromSpec(&NBodySpec);
+	FieldBufferType = PyType_FromSpec(&FieldBufferSpec);
+	if (!SimulationType || !NBodyType || !FieldBufferType
+		|| PyModule_AddObjectRef(module, "Simulation", SimulationType) < 0
+		|| PyModule_AddObjectRef(module, "NBody", NBodyType) < 0)
+	{
+		Py_DECREF(module);
+		return nullptr;
+	}
+
+	// NumPy is optional: without it the views are memoryviews
+	NumPy = PyImport_ImportModule("numpy");
+	if (!NumPy)
+	{
+		PyErr_Clear();
+		NumPy = Py_NewRef(Py_None);
+	}
+
+	Py_AtExit(ShutdownJobSystem);
+	return module;
+}
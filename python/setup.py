@@ -0,0 +1,53 @@
+"""
+Builds the "celestial" Python extension from the engine's simulation sources.
+
+    python setup.py build_ext --inplace
+
+glm is found in GLM_INCLUDE_DIR, or the engine's library include folder on
+Windows. NumPy is used at run time when installed but is not needed to build.
+"""
+import os
+import sys
+
+from setuptools import Extension, setup
+
+here = os.path.dirname(os.path.abspath(__file__))
+root = os.path.dirname(here)
+
+include_dirs = [os.path.join(root, "Include")]
+glm = os.environ.get("GLM_INCLUDE_DIR", r"C:\Workspace\OpenGLlibraries\include" if sys.platform == "win32" else "")
+if glm:
+    include_dirs.append(glm)
+
+if sys.platform == "win32":
+    compile_args = ["/std:c++20", "/O2", "/EHsc"]
+else:
+    compile_args = ["-std=c++20", "-O3"]
+
+sources = [
+    "celestial.cpp",
+    "../src/Simulation/Simulation.cpp",
+    "../src/Simulation/NBodySystem.cpp",
+    "../src/Simulation/NBodyKernels.cpp",
+    "../src/Core/JobSystem.cpp",
+    "../src/Core/CpuTopology.cpp",
+    "../src/Core/CpuFeatures.cpp",
+    "../src/Core/Profiler.cpp",
+    "../src/Core/PerfCounters.cpp",
+    "../src/Core/MemoryTracker.cpp",
+]
+
+setup(
+    name="celestial",
+    version="0.1",
+    description="Celestial engine orbit propagator and N-body engine with zero-copy NumPy views",
+    ext_modules=[
+        Extension(
+            "celestial",
+            sources=sources,
+            include_dirs=include_dirs,
+            extra_compile_args=compile_args,
+            language="c++",
+        )
+    ],
+)
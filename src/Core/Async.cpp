@@ -0,0 +1,49 @@
+/**
+ * @file Async.cpp
+ * @brief The GL thread's queue of coroutines to resume.
+ */
+#include <Core/Async.h>
+
+MainThreadQueue& MainThreadQueue::Get()
+{
+	static MainThreadQueue queue;
+	return queue;
+}
+
+void MainThreadQueue::Post(std::coroutine_handle<> handle)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back(handle);
+	}
+	posted.notify_all();
+
+	if (WakeFunction function = wake.load(std::memory_order_acquire))
+		function();
+}
+
+size_t MainThreadQueue::RunPending()
+{
+	std::vector<std::coroutine_handle<>> batch;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		batch.swap(pending);
+	}
+
+	// Coroutines resumed here may post again; those wait for the next drain
+	for (std::coroutine_handle<> handle : batch)
+		handle.resume();
+	return batch.size();
+}
+
+void MainThreadQueue::RunUntil(const std::function<bool()>& done)
+{
+	while (!done())
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			posted.wait(lock, [this] { return !pending.empty(); });
+		}
+		RunPending();
+	}
+}
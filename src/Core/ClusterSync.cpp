@@ -0,0 +1,257 @@
+/**
+ * @file ClusterSync.cpp
+ * @brief Cluster wire protocol, delta broadcast and swap barrier.
+ */
+#include <Core/ClusterSync.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+	enum MessageType : std::uint32_t
+	{
+		FrameMessage = 1,	///< Master -> node: FrameHeader + ClusterTransform records
+		ReadyMessage = 2,	///< Node -> master: frame index drawn
+		SwapMessage = 3,	///< Master -> node: frame index released
+		QuitMessage = 4		///< Master -> node: no payload
+	};
+
+	struct MessageHeader
+	{
+		std::uint32_t type;
+		std::uint32_t size;		///< Payload bytes following the header
+	};
+
+	struct FrameHeader
+	{
+		std::uint64_t frameIndex;
+		double simulationTime;
+		float camera[5];		///< Position xyz, yaw, pitch
+		std::uint32_t transformCount;
+	};
+
+	// Largest frame a node accepts, checked before allocating for the payload
+	constexpr std::uint32_t MaxTransformsPerFrame = 1u << 20;
+	constexpr size_t MaxFrameBytes = sizeof(FrameHeader) + size_t(MaxTransformsPerFrame) * sizeof(ClusterTransform);
+
+	bool SendMessage(const TcpSocket& socket, std::uint32_t type, const void* payload, std::uint32_t size)
+	{
+		MessageHeader header = { type, size };
+		return socket.SendAll(&header, sizeof(header)) && (size == 0 || socket.SendAll(payload, size));
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	// ReceiveAll that gives up at the deadline. @return False on timeout or a closed connection.
+	bool ReceiveAllBefore(const TcpSocket& socket, void* data, size_t size, Clock::time_point deadline)
+	{
+		unsigned char* bytes = static_cast<unsigned char*>(data);
+		while (size > 0)
+		{
+			double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+			if (remaining <= 0.0 || !socket.WaitReadable(remaining))
+				return false;
+
+			std::ptrdiff_t received = socket.ReceiveSome(bytes, size);
+			if (received <= 0)
+				return false;
+			bytes += received;
+			size -= static_cast<size_t>(received);
+		}
+		return true;
+	}
+}
+
+// ----------------------------------------------------
+// Master
+// ----------------------------------------------------
+ClusterMaster::ClusterMaster(std::uint16_t port, int nodeCount, double connectTimeoutSeconds, double barrierTimeoutSeconds)
+	: barrierTimeoutSeconds(barrierTimeoutSeconds)
+{
+	listener = TcpSocket::Listen(port, false);
+	std::cout << "[ClusterMaster] Waiting for " << nodeCount << " render nodes on port " << port << "\n";
+
+	auto deadline = Clock::now() + std::chrono::duration<double>(connectTimeoutSeconds);
+	while (static_cast<int>(nodes.size()) < nodeCount)
+	{
+		double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+		if (remaining <= 0.0)
+			throw std::runtime_error("ClusterMaster: only " + std::to_string(nodes.size()) + " of "
+				+ std::to_string(nodeCount) + " render nodes connected");
+
+		TcpSocket node = listener.Accept(remaining);
+		if (node.IsValid())
+		{
+			nodes.push_back(std::move(node));
+			std::cout << "[ClusterMaster] Node " << nodes.size() << "/" << nodeCount << " connected\n";
+		}
+	}
+}
+
+ClusterMaster::~ClusterMaster()
+{
+	Shutdown();
+}
+
+void ClusterMaster::DropNode(size_t index, const char* reason)
+{
+	std::cerr << "[ClusterMaster] Dropping node " << index << ": " << reason << "\n";
+	nodes.erase(nodes.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+void ClusterMaster::Broadcast(const ClusterFrame& frame)
+{
+	// Header first, then only the records the nodes do not already hold
+	sendBuffer.resize(sizeof(FrameHeader));
+	std::uint32_t changed = 0;
+	for (const ClusterTransform& transform : frame.transforms)
+	{
+		if (transform.id >= lastSent.size())
+		{
+			lastSent.resize(transform.id + 1);
+			hasSent.resize(transform.id + 1, false);
+		}
+		if (hasSent[transform.id] && std::memcmp(&lastSent[transform.id], &transform, sizeof(transform)) == 0)
+			continue;
+
+		lastSent[transform.id] = transform;
+		hasSent[transform.id] = true;
+		size_t offset = sendBuffer.size();
+		sendBuffer.resize(offset + sizeof(transform));
+		std::memcpy(sendBuffer.data() + offset, &transform, sizeof(transform));
+		changed++;
+	}
+
+	FrameHeader header;
+	header.frameIndex = frame.frameIndex;
+	header.simulationTime = frame.simulationTime;
+	header.camera[0] = frame.cameraPosition.x;
+	header.camera[1] = frame.cameraPosition.y;
+	header.camera[2] = frame.cameraPosition.z;
+	header.camera[3] = frame.cameraYaw;
+	header.camera[4] = frame.cameraPitch;
+	header.transformCount = changed;
+	std::memcpy(sendBuffer.data(), &header, sizeof(header));
+
+	std::uint32_t size = static_cast<std::uint32_t>(sendBuffer.size());
+	for (size_t i = nodes.size(); i-- > 0;)
+	{
+		if (!SendMessage(nodes[i], FrameMessage, sendBuffer.data(), size))
+			DropNode(i, "send failed");
+	}
+
+	stats.framesSent++;
+	stats.bytesSent += (sizeof(MessageHeader) + size) * nodes.size();
+	stats.transformsSent += changed;
+}
+
+void ClusterMaster::SwapBarrier(std::uint64_t frameIndex)
+{
+	auto start = Clock::now();
+	auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(barrierTimeoutSeconds));
+
+	// Every node must have drawn this frame; the slowest one sets the pace, up to the timeout
+	for (size_t i = nodes.size(); i-- > 0;)
+	{
+		MessageHeader header;
+		std::uint64_t readyIndex = 0;
+		if (!ReceiveAllBefore(nodes[i], &header, sizeof(header), deadline) || header.type != ReadyMessage
+			|| header.size != sizeof(readyIndex) || !ReceiveAllBefore(nodes[i], &readyIndex, sizeof(readyIndex), deadline))
+		{
+			DropNode(i, "lost or stalled during swap barrier");
+			continue;
+		}
+		if (readyIndex != frameIndex)
+			std::cerr << "[ClusterMaster] Node " << i << " ready for frame " << readyIndex << ", expected " << frameIndex << "\n";
+	}
+
+	// Release everyone at once
+	for (size_t i = nodes.size(); i-- > 0;)
+	{
+		if (!SendMessage(nodes[i], SwapMessage, &frameIndex, sizeof(frameIndex)))
+			DropNode(i, "send failed");
+	}
+
+	stats.lastBarrierSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+	stats.maxBarrierSeconds = std::max(stats.maxBarrierSeconds, stats.lastBarrierSeconds);
+}
+
+void ClusterMaster::Shutdown()
+{
+	if (!listener.IsValid())
+		return;
+
+	for (TcpSocket& node : nodes)
+		SendMessage(node, QuitMessage, nullptr, 0);
+	nodes.clear();
+	listener.Close();
+
+	std::cout << "[ClusterMaster] Sent " << stats.framesSent << " frames, "
+		<< (stats.framesSent ? stats.bytesSent / stats.framesSent : 0) << " B/frame, slowest barrier "
+		<< stats.maxBarrierSeconds * 1000.0 << " ms\n";
+}
+
+// ----------------------------------------------------
+// Node
+// ----------------------------------------------------
+ClusterNode::ClusterNode(const std::string& host, std::uint16_t port, double connectTimeoutSeconds)
+{
+	connection = TcpSocket::Connect(host, port, connectTimeoutSeconds);
+	if (!connection.IsValid())
+		throw std::runtime_error("ClusterNode: cannot reach master at " + host + ":" + std::to_string(port));
+	std::cout << "[ClusterNode] Connected to master at " << host << ":" << port << "\n";
+}
+
+bool ClusterNode::Receive(ClusterFrame& frame)
+{
+	MessageHeader header;
+	if (!connection.ReceiveAll(&header, sizeof(header)) || header.type == QuitMessage)
+		return false;
+	if (header.type != FrameMessage || header.size < sizeof(FrameHeader))
+	{
+		std::cerr << "[ClusterNode] Unexpected message " << header.type << "\n";
+		return false;
+	}
+	if (header.size > MaxFrameBytes)
+	{
+		std::cerr << "[ClusterNode] Frame of " << header.size << " bytes exceeds the protocol limit\n";
+		return false;
+	}
+
+	receiveBuffer.resize(header.size);
+	if (!connection.ReceiveAll(receiveBuffer.data(), header.size))
+		return false;
+
+	FrameHeader frameHeader;
+	std::memcpy(&frameHeader, receiveBuffer.data(), sizeof(frameHeader));
+	if (sizeof(FrameHeader) + size_t(frameHeader.transformCount) * sizeof(ClusterTransform) != header.size)
+	{
+		std::cerr << "[ClusterNode] Malformed frame " << frameHeader.frameIndex << "\n";
+		return false;
+	}
+
+	frame.frameIndex = frameHeader.frameIndex;
+	frame.simulationTime = frameHeader.simulationTime;
+	frame.cameraPosition = glm::vec3(frameHeader.camera[0], frameHeader.camera[1], frameHeader.camera[2]);
+	frame.cameraYaw = frameHeader.camera[3];
+	frame.cameraPitch = frameHeader.camera[4];
+	frame.transforms.resize(frameHeader.transformCount);
+	if (frameHeader.transformCount > 0)
+		std::memcpy(frame.transforms.data(), receiveBuffer.data() + sizeof(FrameHeader),
+			frame.transforms.size() * sizeof(ClusterTransform));
+	return true;
+}
+
+bool ClusterNode::SwapBarrier(std::uint64_t frameIndex)
+{
+	if (!SendMessage(connection, ReadyMessage, &frameIndex, sizeof(frameIndex)))
+		return false;
+
+	MessageHeader header;
+	std::uint64_t releasedIndex = 0;
+	return connection.ReceiveAll(&header, sizeof(header)) && header.type == SwapMessage
+		&& header.size == sizeof(releasedIndex) && connection.ReceiveAll(&releasedIndex, sizeof(releasedIndex));
+}
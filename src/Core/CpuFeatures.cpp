@@ -0,0 +1,151 @@
+/**
+ * @file CpuFeatures.cpp
+ * @brief cpuid/xgetbv queries and the forced-level override.
+ */
+#include <Core/CpuFeatures.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#ifdef CELESTIAL_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+#ifdef CELESTIAL_X86
+	struct Registers
+	{
+		std::uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+	};
+
+	Registers CpuId(std::uint32_t leaf, std::uint32_t subleaf)
+	{
+		Registers r;
+#ifdef _MSC_VER
+		int values[4];
+		__cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+		r.eax = values[0]; r.ebx = values[1]; r.ecx = values[2]; r.edx = values[3];
+#else
+		if (!__get_cpuid_count(leaf, subleaf, &r.eax, &r.ebx, &r.ecx, &r.edx))
+			r = Registers{};
+#endif
+		return r;
+	}
+
+	// Register state the OS saves on context switches (XCR0)
+	std::uint64_t EnabledStateMask()
+	{
+#ifdef _MSC_VER
+		return _xgetbv(0);
+#else
+		std::uint32_t low, high;
+		__asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+		return (static_cast<std::uint64_t>(high) << 32) | low;
+#endif
+	}
+
+	bool Bit(std::uint32_t value, int bit)
+	{
+		return (value >> bit) & 1u;
+	}
+
+	IsaLevel Detect()
+	{
+		std::uint32_t maxLeaf = CpuId(0, 0).eax;
+		if (maxLeaf < 1)
+			return IsaLevel::Scalar;
+		Registers leaf1 = CpuId(1, 0);
+		Registers leaf7 = maxLeaf >= 7 ? CpuId(7, 0) : Registers{};
+
+		bool sse42 = Bit(leaf1.ecx, 20) && Bit(leaf1.ecx, 23);	// SSE4.2, POPCNT
+		if (!sse42)
+			return IsaLevel::Scalar;
+
+		// AVX state (XMM and YMM) must be enabled by the OS, not just present in the CPU
+		bool osxsave = Bit(leaf1.ecx, 27);
+		std::uint64_t state = osxsave ? EnabledStateMask() : 0;
+		bool avxState = (state & 0x6) == 0x6;
+		bool avx2 = avxState && Bit(leaf1.ecx, 28) && Bit(leaf1.ecx, 12) && Bit(leaf7.ebx, 5);	// AVX, FMA, AVX2
+		if (!avx2)
+			return IsaLevel::Sse4;
+
+		// Plus opmask and the upper ZMM state
+		bool avx512State = (state & 0xE6) == 0xE6;
+		bool avx512 = avx512State && Bit(leaf7.ebx, 16) && Bit(leaf7.ebx, 17) && Bit(leaf7.ebx, 30) && Bit(leaf7.ebx, 31);	// F, DQ, BW, VL
+		return avx512 ? IsaLevel::Avx512 : IsaLevel::Avx2;
+	}
+#else
+	IsaLevel Detect()
+	{
+		return IsaLevel::Scalar;
+	}
+#endif
+}
+
+CpuFeatures::CpuFeatures()
+	: supported(Detect()), active(supported)
+{
+	const char* override = std::getenv("CELESTIAL_ISA");
+	if (!override || !*override)
+		return;
+
+	IsaLevel level;
+	if (Parse(override, level))
+		Force(level);
+	else
+		std::cerr << "[CpuFeatures] Unknown CELESTIAL_ISA value: " << override << "\n";
+}
+
+CpuFeatures& CpuFeatures::Get()
+{
+	static CpuFeatures features;
+	return features;
+}
+
+void CpuFeatures::Force(IsaLevel level)
+{
+	if (level > supported)
+	{
+		std::cerr << "[CpuFeatures] " << GetName(level) << " is not supported here, using " << GetName(supported) << "\n";
+		level = supported;
+	}
+	active = level;
+	forced = true;
+}
+
+void CpuFeatures::Print() const
+{
+	std::cout << "[CpuFeatures] Supported: " << GetName(supported) << ", kernels use: " << GetName(active)
+		<< (forced ? " (forced)" : "") << "\n";
+}
+
+const char* CpuFeatures::GetName(IsaLevel level)
+{
+	switch (level)
+	{
+	case IsaLevel::Scalar: return "scalar";
+	case IsaLevel::Sse4: return "sse4";
+	case IsaLevel::Avx2: return "avx2";
+	case IsaLevel::Avx512: return "avx512";
+	default: return "unknown";
+	}
+}
+
+bool CpuFeatures::Parse(const char* name, IsaLevel& level)
+{
+	for (int i = 0; i < static_cast<int>(IsaLevel::Count); ++i)
+	{
+		if (std::strcmp(name, GetName(static_cast<IsaLevel>(i))) == 0)
+		{
+			level = static_cast<IsaLevel>(i);
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file CpuTopology.cpp
+ * @brief Topology detection per OS, worker placement order and thread pinning.
+ */
+#include <Core/CpuTopology.h>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <string>
+#endif
+
+namespace
+{
+	// Renumbers the keys in order of first appearance
+	template<typename Key>
+	unsigned int Densify(std::map<Key, unsigned int>& ids, Key key)
+	{
+		auto inserted = ids.emplace(key, static_cast<unsigned int>(ids.size()));
+		return inserted.first->second;
+	}
+
+	// One core and one domain per hardware thread when nothing better is known
+	std::vector<CpuTopology::LogicalProcessor> Fallback()
+	{
+		unsigned int count = std::max(std::thread::hardware_concurrency(), 1u);
+		std::vector<CpuTopology::LogicalProcessor> processors(count);
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			processors[i].id = i;
+			processors[i].core = i;
+		}
+		return processors;
+	}
+
+#ifdef __linux__
+	std::string ReadLine(const std::string& path)
+	{
+		std::ifstream file(path);
+		std::string line;
+		std::getline(file, line);
+		return line;
+	}
+
+	unsigned int ReadUnsigned(const std::string& path, unsigned int fallback)
+	{
+		std::string line = ReadLine(path);
+		return line.empty() ? fallback : static_cast<unsigned int>(std::stoul(line));
+	}
+
+	// "0-3,8,10-11"
+	std::vector<unsigned int> ParseCpuList(const std::string& list)
+	{
+		std::vector<unsigned int> cpus;
+		std::stringstream stream(list);
+		std::string range;
+		while (std::getline(stream, range, ','))
+		{
+			if (range.empty())
+				continue;
+			size_t dash = range.find('-');
+			unsigned int first = static_cast<unsigned int>(std::stoul(range.substr(0, dash)));
+			unsigned int last = dash == std::string::npos ? first : static_cast<unsigned int>(std::stoul(range.substr(dash + 1)));
+			for (unsigned int cpu = first; cpu <= last; ++cpu)
+				cpus.push_back(cpu);
+		}
+		return cpus;
+	}
+
+	std::vector<CpuTopology::LogicalProcessor> DetectProcessors()
+	{
+		const std::string root = "/sys/devices/system/cpu/";
+		std::vector<unsigned int> online = ParseCpuList(ReadLine(root + "online"));
+		if (online.empty())
+			return Fallback();
+
+		// Intel hybrid parts list their E-cores here; ARM big.LITTLE reports cpu_capacity instead
+		std::vector<unsigned int> atomCpus = ParseCpuList(ReadLine("/sys/devices/cpu_atom/cpus"));
+
+		std::vector<CpuTopology::LogicalProcessor> processors;
+		for (unsigned int id : online)
+		{
+			std::string base = root + "cpu" + std::to_string(id) + "/";
+			unsigned int package = ReadUnsigned(base + "topology/physical_package_id", 0);
+
+			CpuTopology::LogicalProcessor processor;
+			processor.id = id;
+			processor.core = package * 65536 + ReadUnsigned(base + "topology/core_id", id);
+
+			// The L3 is identified by the lowest processor sharing it; without one the package is the domain
+			processor.l3Domain = 0x80000000u + package;
+			for (int index = 0; index < 8; ++index)
+			{
+				std::string cache = base + "cache/index" + std::to_string(index) + "/";
+				if (ReadLine(cache + "level") != "3")
+					continue;
+				std::vector<unsigned int> shared = ParseCpuList(ReadLine(cache + "shared_cpu_list"));
+				if (!shared.empty())
+					processor.l3Domain = *std::min_element(shared.begin(), shared.end());
+				break;
+			}
+
+			bool isAtom = std::find(atomCpus.begin(), atomCpus.end(), id) != atomCpus.end();
+			processor.efficiencyClass = ReadUnsigned(base + "cpu_capacity", isAtom ? 0 : 1);
+			processors.push_back(processor);
+		}
+		return processors;
+	}
+#elif defined(_WIN32)
+	std::vector<CpuTopology::LogicalProcessor> DetectProcessors()
+	{
+		DWORD length = 0;
+		GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+		std::vector<char> buffer(length);
+		auto* first = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+		if (length == 0 || !GetLogicalProcessorInformationEx(RelationAll, first, &length))
+			return Fallback();
+
+		std::map<unsigned int, CpuTopology::LogicalProcessor> byId;
+		std::vector<std::pair<GROUP_AFFINITY, unsigned int>> caches;	// L3 masks and their index
+		unsigned int coreIndex = 0;
+
+		for (DWORD offset = 0; offset < length;)
+		{
+			auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+			if (info->Relationship == RelationProcessorCore)
+			{
+				const GROUP_AFFINITY& mask = info->Processor.GroupMask[0];
+				for (unsigned int bit = 0; bit < 64; ++bit)
+				{
+					if (!(mask.Mask & (KAFFINITY(1) << bit)))
+						continue;
+					CpuTopology::LogicalProcessor processor;
+					processor.id = mask.Group * 64 + bit;
+					processor.core = coreIndex;
+					processor.efficiencyClass = info->Processor.EfficiencyClass;	// Higher = faster
+					byId[processor.id] = processor;
+				}
+				coreIndex++;
+			}
+			else if (info->Relationship == RelationCache && info->Cache.Level == 3)
+			{
+				caches.emplace_back(info->Cache.GroupMask, static_cast<unsigned int>(caches.size()));
+			}
+			offset += info->Size;
+		}
+
+		if (byId.empty())
+			return Fallback();
+
+		std::vector<CpuTopology::LogicalProcessor> processors;
+		for (auto& [id, processor] : byId)
+		{
+			for (const auto& [mask, index] : caches)
+				if (mask.Group == id / 64 && (mask.Mask & (KAFFINITY(1) << (id % 64))))
+					processor.l3Domain = index;
+			processors.push_back(processor);
+		}
+		return processors;
+	}
+#else
+	std::vector<CpuTopology::LogicalProcessor> DetectProcessors()
+	{
+		return Fallback();
+	}
+#endif
+}
+
+CpuTopology::CpuTopology(std::vector<LogicalProcessor> records)
+	: processors(std::move(records))
+{
+	if (processors.empty())
+		processors = Fallback();
+
+	std::sort(processors.begin(), processors.end(),
+		[](const LogicalProcessor& a, const LogicalProcessor& b) { return a.id < b.id; });
+
+	// Efficiency classes become ranks so the slowest type is 0
+	std::vector<unsigned int> classes;
+	for (const LogicalProcessor& processor : processors)
+		classes.push_back(processor.efficiencyClass);
+	std::sort(classes.begin(), classes.end());
+	classes.erase(std::unique(classes.begin(), classes.end()), classes.end());
+
+	std::map<unsigned int, unsigned int> coreIds, domainIds;
+	std::map<unsigned int, unsigned int> threadsPerCore;
+	for (LogicalProcessor& processor : processors)
+	{
+		processor.core = Densify(coreIds, processor.core);
+		processor.l3Domain = Densify(domainIds, processor.l3Domain);
+		processor.efficiencyClass = static_cast<unsigned int>(
+			std::lower_bound(classes.begin(), classes.end(), processor.efficiencyClass) - classes.begin());
+		processor.smtIndex = threadsPerCore[processor.core]++;
+	}
+
+	coreCount = static_cast<unsigned int>(coreIds.size());
+	l3DomainCount = static_cast<unsigned int>(domainIds.size());
+	topEfficiencyClass = static_cast<unsigned int>(classes.size() - 1);
+
+	for (const LogicalProcessor& processor : processors)
+	{
+		if (IsPerformanceCore(processor))
+		{
+			reservedCore = processor.core;
+			break;
+		}
+	}
+}
+
+const CpuTopology& CpuTopology::Get()
+{
+	static CpuTopology topology = Detect();
+	return topology;
+}
+
+CpuTopology CpuTopology::Detect()
+{
+	return CpuTopology(DetectProcessors());
+}
+
+std::vector<unsigned int> CpuTopology::GetMainThreadProcessors() const
+{
+	std::vector<unsigned int> ids;
+	for (const LogicalProcessor& processor : processors)
+		if (processor.core == reservedCore)
+			ids.push_back(processor.id);
+	return ids;
+}
+
+std::vector<CpuTopology::LogicalProcessor> CpuTopology::GetWorkerOrder() const
+{
+	auto Group = [&](const LogicalProcessor& processor) {
+		if (processor.core == reservedCore)
+			return 3;
+		if (processor.smtIndex > 0)
+			return 2;
+		return IsPerformanceCore(processor) ? 0 : 1;
+	};
+
+	std::vector<LogicalProcessor> order = processors;
+	std::stable_sort(order.begin(), order.end(), [&](const LogicalProcessor& a, const LogicalProcessor& b) {
+		int groupA = Group(a), groupB = Group(b);
+		if (groupA != groupB)
+			return groupA < groupB;
+		if (a.efficiencyClass != b.efficiencyClass)
+			return a.efficiencyClass > b.efficiencyClass;
+		if (a.l3Domain != b.l3Domain)
+			return a.l3Domain < b.l3Domain;
+		return a.core < b.core;
+	});
+	return order;
+}
+
+void CpuTopology::Print() const
+{
+	unsigned int performanceCores = 0;
+	std::vector<bool> counted(coreCount, false);
+	for (const LogicalProcessor& processor : processors)
+	{
+		if (!counted[processor.core] && IsPerformanceCore(processor))
+			performanceCores++;
+		counted[processor.core] = true;
+	}
+
+	std::cout << "[CpuTopology] " << processors.size() << " hardware threads on " << coreCount << " cores, "
+		<< l3DomainCount << " L3 domain" << (l3DomainCount == 1 ? "" : "s");
+	if (IsHybrid())
+		std::cout << ", hybrid: " << performanceCores << " performance and " << coreCount - performanceCores << " efficiency cores";
+	std::cout << "\n";
+}
+
+bool CpuTopology::PinCurrentThread(const std::vector<unsigned int>& processorIds)
+{
+	if (processorIds.empty())
+		return false;
+
+#ifdef _WIN32
+	// A thread lives in one processor group; ids from other groups are ignored
+	GROUP_AFFINITY affinity = {};
+	affinity.Group = static_cast<WORD>(processorIds[0] / 64);
+	for (unsigned int id : processorIds)
+		if (id / 64 == affinity.Group)
+			affinity.Mask |= KAFFINITY(1) << (id % 64);
+	return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (unsigned int id : processorIds)
+		if (id < CPU_SETSIZE)
+			CPU_SET(id, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,53 @@
+/**
+ * @file FramePacer.cpp
+ * @brief Render-on-demand and background throttling decisions.
+ */
+#include <Core/FramePacer.h>
+#include <algorithm>
+
+void FramePacer::RequestFrame()
+{
+	// Only the first request since the last frame needs to wake the loop
+	if (!frameRequested.exchange(true, std::memory_order_acq_rel) && wake)
+		wake();
+}
+
+double FramePacer::GetWaitTimeout(double now, WindowState state) const
+{
+	if (state == WindowState::Minimized)
+		return settings.minimizedWakeInterval;
+
+	if (!WantsFrame())
+		return settings.idleWakeInterval;	// Nothing to draw: sleep until an event arrives
+
+	if (state == WindowState::Unfocused && settings.unfocusedFrameRate > 0.0)
+	{
+		double due = lastFrameTime + 1.0 / settings.unfocusedFrameRate;
+		if (now < due)
+			return std::min(due - now, settings.idleWakeInterval);
+	}
+	return 0.0;
+}
+
+bool FramePacer::BeginFrame(double now, WindowState state, double waitedSeconds)
+{
+	stats.iterations++;
+	stats.idleSeconds += waitedSeconds;
+
+	// A minimized or throttled window keeps any request for later
+	if (state == WindowState::Minimized)
+		return false;
+
+	if (state == WindowState::Unfocused && settings.unfocusedFrameRate > 0.0
+		&& now < lastFrameTime + 1.0 / settings.unfocusedFrameRate)
+		return false;
+
+	// Test and clear in one step: a request from another thread can't slip in between and be lost
+	bool requested = frameRequested.exchange(false, std::memory_order_acq_rel);
+	if (settings.onDemand && !continuous && !requested)
+		return false;
+
+	lastFrameTime = now;
+	stats.framesRendered++;
+	return true;
+}
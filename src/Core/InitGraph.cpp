@@ -0,0 +1,215 @@
+/**
+ * @file InitGraph.cpp
+ * @brief Dependency resolution, the main-thread/worker scheduler and the timeline report.
+ */
+#include <Core/InitGraph.h>
+#include <Core/JobSystem.h>
+#include <Core/Profiler.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+InitGraph::InitGraph(std::chrono::steady_clock::time_point timelineOrigin)
+	: origin(timelineOrigin)
+{
+}
+
+void InitGraph::Add(const char* name, Affinity affinity, std::function<void()> work, std::vector<std::string> dependencies)
+{
+	for (const Task& task : tasks)
+		if (std::strcmp(task.name, name) == 0)
+			throw std::runtime_error(std::string("InitGraph: duplicate task ") + name);
+
+	Task task;
+	task.name = name;
+	task.affinity = affinity;
+	task.work = std::move(work);
+	task.dependencies = std::move(dependencies);
+	tasks.push_back(std::move(task));
+}
+
+void InitGraph::Link()
+{
+	for (size_t i = 0; i < tasks.size(); ++i)
+	{
+		tasks[i].pendingDependencies = tasks[i].dependencies.size();
+		for (const std::string& dependency : tasks[i].dependencies)
+		{
+			auto found = std::find_if(tasks.begin(), tasks.end(), [&](const Task& t) { return dependency == t.name; });
+			if (found == tasks.end())
+				throw std::runtime_error("InitGraph: " + std::string(tasks[i].name) + " depends on unknown task " + dependency);
+			found->dependents.push_back(i);
+		}
+	}
+
+	// Kahn's algorithm on a copy of the counts: anything left over sits on a cycle
+	std::vector<size_t> pending(tasks.size());
+	std::vector<size_t> ready;
+	for (size_t i = 0; i < tasks.size(); ++i)
+	{
+		pending[i] = tasks[i].pendingDependencies;
+		if (pending[i] == 0)
+			ready.push_back(i);
+	}
+	size_t visited = 0;
+	while (!ready.empty())
+	{
+		size_t task = ready.back();
+		ready.pop_back();
+		visited++;
+		for (size_t dependent : tasks[task].dependents)
+			if (--pending[dependent] == 0)
+				ready.push_back(dependent);
+	}
+	if (visited != tasks.size())
+		throw std::runtime_error("InitGraph: dependency cycle between startup tasks");
+}
+
+void InitGraph::Run()
+{
+	Link();
+	runStart = Now();
+
+	// Shared with the worker jobs; everything below is guarded by mutex
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::deque<size_t> mainReady;
+	size_t completed = 0;
+	size_t running = 0;
+	std::exception_ptr error;
+
+	std::function<void(size_t)> Start;
+
+	// Called with the lock held once a task has returned
+	auto Complete = [&](size_t index) {
+		Task& task = tasks[index];
+		completed++;
+		running--;
+		for (size_t dependent : task.dependents)
+		{
+			Task& next = tasks[dependent];
+			if (next.criticalPredecessor == static_cast<size_t>(-1) || tasks[next.criticalPredecessor].end < task.end)
+				next.criticalPredecessor = index;
+			if (--next.pendingDependencies == 0 && !error)
+				Start(dependent);
+		}
+		changed.notify_all();
+	};
+
+	auto Execute = [&](size_t index) {
+		Task& task = tasks[index];
+		task.start = Now();
+		std::exception_ptr failure;
+		try
+		{
+			ProfileScope scope(task.name);
+			task.work();
+		}
+		catch (...)
+		{
+			failure = std::current_exception();
+		}
+		task.end = Now();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (failure && !error)
+			error = failure;
+		Complete(index);
+	};
+
+	// Called with the lock held
+	Start = [&](size_t index) {
+		running++;
+		if (tasks[index].affinity == Affinity::Worker)
+			JobSystem::Get().Submit([&, index] { Execute(index); });
+		else
+			mainReady.push_back(index);
+	};
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (size_t i = 0; i < tasks.size(); ++i)
+			if (tasks[i].pendingDependencies == 0)
+				Start(i);
+	}
+
+	// Main-thread tasks run here as they become ready; otherwise wait for the workers
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		changed.wait(lock, [&] { return !mainReady.empty() || running == 0; });
+		if (mainReady.empty())
+			break;	// Nothing running and nothing ready: done, or stopped by an error
+
+		size_t index = mainReady.front();
+		mainReady.pop_front();
+		if (error)
+		{
+			running--;	// Queued before the failure; skipped
+			continue;
+		}
+		lock.unlock();
+		Execute(index);
+		lock.lock();
+	}
+	lock.unlock();
+
+	runEnd = Now();
+	finished = error == nullptr && completed == tasks.size();
+	if (error)
+		std::rethrow_exception(error);
+}
+
+std::vector<InitGraph::TaskRecord> InitGraph::GetTimeline() const
+{
+	std::vector<TaskRecord> timeline;
+	timeline.reserve(tasks.size());
+	for (const Task& task : tasks)
+		timeline.push_back(TaskRecord{ task.name, task.affinity, task.start, task.end });
+	std::sort(timeline.begin(), timeline.end(), [](const TaskRecord& a, const TaskRecord& b) { return a.start < b.start; });
+	return timeline;
+}
+
+void InitGraph::PrintTimeline() const
+{
+	if (!finished)
+		return;
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(1);
+
+	double busy = 0.0;
+	for (const TaskRecord& record : GetTimeline())
+	{
+		busy += record.end - record.start;
+		out << "[InitGraph] " << std::setw(8) << record.start * 1000.0 << " ms  " << std::setw(7)
+			<< (record.end - record.start) * 1000.0 << " ms  "
+			<< (record.affinity == Affinity::MainThread ? "main  " : "worker") << "  " << record.name << "\n";
+	}
+
+	// Walk back from the task that finished last through the dependency that released it
+	std::vector<const char*> criticalPath;
+	size_t last = static_cast<size_t>(-1);
+	for (size_t i = 0; i < tasks.size(); ++i)
+		if (last == static_cast<size_t>(-1) || tasks[i].end > tasks[last].end)
+			last = i;
+	for (size_t i = last; i != static_cast<size_t>(-1); i = tasks[i].criticalPredecessor)
+		criticalPath.push_back(tasks[i].name);
+	std::reverse(criticalPath.begin(), criticalPath.end());
+
+	double wall = runEnd - runStart;
+	out << "[InitGraph] " << tasks.size() << " tasks in " << wall * 1000.0 << " ms (" << busy * 1000.0
+		<< " ms of work, overlap x" << std::setprecision(2) << (wall > 0.0 ? busy / wall : 0.0) << "), critical path: ";
+	for (size_t i = 0; i < criticalPath.size(); ++i)
+		out << (i ? " > " : "") << criticalPath[i];
+	out << "\n";
+
+	std::cout << out.str();
+}
@@ -5,6 +5,7 @@
 std::unordered_map<int, bool> Input::keyStates;
 glm::dvec2 Input::mousePos(0.0);
 glm::dvec2 Input::mouseDelta(0.0);
+bool Input::activity = false;
 
 void Input::Initialize(GLFWwindow* window)
 {
@@ -36,8 +37,17 @@ glm::dvec2 Input::GetMouseDelta()
 	return delta;
 }
 
+bool Input::ConsumeActivity()
+{
+	bool active = activity;
+	activity = false;
+	return active;
+}
+
 void Input::KeyCallback(GLFWwindow*, int key, int, int action, int)
 {
+	activity = true;
+
 	// track key press/release state
 	if (action == GLFW_PRESS)
 	{
@@ -52,6 +62,7 @@ void Input::KeyCallback(GLFWwindow*, int key, int, int action, int)
 void Input::CursorPosCallback(GLFWwindow*, double xpos, double ypos)
 {
 	static bool firstMouse = true;
+	activity = true;
 	
 	// Initialize mouse position on first callback to avoid large delta
 	if (firstMouse) {
@@ -0,0 +1,263 @@
+#include <Core/JobSystem.h>
+#include <Core/CpuTopology.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <memory>
+
+JobSystem* JobSystem::instance = nullptr;
+
+namespace
+{
+	// L3 domain of the calling worker; the main thread counts as domain 0 (it sits on the first performance core)
+	thread_local unsigned int currentDomain = 0;
+}
+
+JobSystem::JobSystem(unsigned int threadCount, bool pinWorkers)
+{
+	if (threadCount == 0)
+	{
+		unsigned int hardware = std::thread::hardware_concurrency();
+		threadCount = hardware > 1 ? hardware - 1 : 1;
+	}
+
+	// Placement: consecutive workers fill one L3 domain before the next
+	const CpuTopology& topology = CpuTopology::Get();
+	std::vector<CpuTopology::LogicalProcessor> order = topology.GetWorkerOrder();
+	pinned = pinWorkers && order.size() > 1;
+
+	unsigned int domainCount = pinned ? topology.GetL3DomainCount() : 1;
+	domainQueues.resize(domainCount);
+	domainWorkers.assign(domainCount, 0);
+	workerDomains.resize(threadCount);
+	for (unsigned int i = 0; i < threadCount; ++i)
+	{
+		workerDomains[i] = pinned ? order[i % order.size()].l3Domain : 0;
+		domainWorkers[workerDomains[i]]++;
+	}
+
+	workerPinned.assign(threadCount, 0);
+	workers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; ++i)
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i, order[i % order.size()].id);
+
+	std::cout << "[JobSystem] Started " << threadCount << " worker threads";
+	if (!pinned)
+	{
+		std::cout << "\n";
+		return;
+	}
+
+	// Report what each worker actually got, not what was requested
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		pinReported.wait(lock, [&] { return pinsReported == threadCount; });
+	}
+	unsigned int pinnedCount = static_cast<unsigned int>(std::count(workerPinned.begin(), workerPinned.end(), 1));
+	std::cout << " (" << pinnedCount << " of " << threadCount << " pinned, " << domainCount << " L3 domain"
+		<< (domainCount == 1 ? "" : "s") << ")\n";
+	if (pinnedCount < threadCount)
+	{
+		std::cerr << "[JobSystem] Could not pin workers";
+		for (unsigned int i = 0; i < threadCount; ++i)
+			if (!workerPinned[i])
+				std::cerr << " " << i << " (CPU " << order[i % order.size()].id << ")";
+		std::cerr << ", the OS schedules them freely\n";
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wakeUp.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+JobSystem& JobSystem::Get()
+{
+	if (!instance)
+		instance = new JobSystem();
+	return *instance;
+}
+
+void JobSystem::Configure(unsigned int threadCount, bool pinWorkers)
+{
+	delete instance;
+	instance = new JobSystem(threadCount, pinWorkers);
+}
+
+void JobSystem::Shutdown()
+{
+	delete instance;
+	instance = nullptr;
+}
+
+bool JobSystem::PopJob(unsigned int domain, std::function<void()>& job)
+{
+	auto Take = [&job](std::deque<std::function<void()>>& source) {
+		if (source.empty())
+			return false;
+		job = std::move(source.front());
+		source.pop_front();
+		return true;
+	};
+
+	if (Take(domainQueues[domain]) || Take(queue))
+		return true;
+
+	// Idle otherwise: help the other domains
+	for (size_t i = 1; i < domainQueues.size(); ++i)
+		if (Take(domainQueues[(domain + i) % domainQueues.size()]))
+			return true;
+	return false;
+}
+
+void JobSystem::WorkerLoop(unsigned int index, unsigned int processorId)
+{
+	currentDomain = workerDomains[index];
+	if (pinned)
+	{
+		bool success = CpuTopology::PinCurrentThread({ processorId });
+		std::lock_guard<std::mutex> lock(mutex);
+		workerPinned[index] = success ? 1 : 0;
+		pinsReported++;
+		pinReported.notify_one();
+	}
+
+	for (;;)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			bool found = false;
+			wakeUp.wait(lock, [&] { return (found = PopJob(currentDomain, job)) || stopping; });
+
+			// Drain the queues before stopping so no submitted job is lost
+			if (!found)
+				return;
+		}
+		job();
+	}
+}
+
+void JobSystem::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.push_back(std::move(job));
+	}
+	wakeUp.notify_one();
+}
+
+void JobSystem::SubmitToDomain(unsigned int domain, std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		domainQueues[domain % domainQueues.size()].push_back(std::move(job));
+	}
+	// Any woken worker takes it: its own domain may be idle while this one is busy
+	wakeUp.notify_one();
+}
+
+void JobSystem::ParallelFor(size_t count, const std::function<void(size_t)>& body)
+{
+	if (count == 0)
+		return;
+
+	// One contiguous block of items per domain, sized by the threads working on it
+	struct Range
+	{
+		std::atomic<size_t> next{ 0 };
+		size_t end = 0;
+	};
+
+	// Shared with the helper jobs, which may start after this call has returned
+	struct State
+	{
+		std::unique_ptr<Range[]> ranges;
+		size_t rangeCount = 0;
+		std::atomic<size_t> finished{ 0 };
+		size_t count = 0;
+		const std::function<void(size_t)>* body = nullptr;
+		std::mutex mutex;
+		std::condition_variable done;
+		std::exception_ptr error;
+	};
+
+	const size_t domainCount = domainQueues.size();
+	const unsigned int callerDomain = std::min<unsigned int>(currentDomain, static_cast<unsigned int>(domainCount - 1));
+
+	auto state = std::make_shared<State>();
+	state->count = count;
+	state->body = &body;
+	state->rangeCount = domainCount;
+	state->ranges = std::make_unique<Range[]>(domainCount);
+
+	// The caller works too, in its own domain
+	size_t totalThreads = workers.size() + 1;
+	size_t threadsBefore = 0;
+	for (size_t domain = 0; domain < domainCount; ++domain)
+	{
+		size_t threads = domainWorkers[domain] + (domain == callerDomain ? 1 : 0);
+		state->ranges[domain].next = count * threadsBefore / totalThreads;
+		threadsBefore += threads;
+		state->ranges[domain].end = count * threadsBefore / totalThreads;
+	}
+
+	auto Run = [](State& s, size_t firstRange) {
+		for (size_t r = 0; r < s.rangeCount; ++r)
+		{
+			Range& range = s.ranges[(firstRange + r) % s.rangeCount];
+			for (size_t i = range.next.fetch_add(1); i < range.end; i = range.next.fetch_add(1))
+			{
+				try {
+					(*s.body)(i);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(s.mutex);
+					if (!s.error)
+						s.error = std::current_exception();
+				}
+
+				if (s.finished.fetch_add(1) + 1 == s.count)
+				{
+					std::lock_guard<std::mutex> lock(s.mutex);
+					s.done.notify_all();
+				}
+			}
+		}
+	};
+
+	if (domainCount == 1)
+	{
+		size_t helpers = std::min<size_t>(workers.size(), count - 1);
+		for (size_t i = 0; i < helpers; ++i)
+			Submit([state, Run] { Run(*state, 0); });
+	}
+	else
+	{
+		for (size_t domain = 0; domain < domainCount; ++domain)
+		{
+			size_t items = state->ranges[domain].end - state->ranges[domain].next;
+			if (domain == callerDomain)
+				items = items > 0 ? items - 1 : 0;
+			size_t helpers = std::min<size_t>(domainWorkers[domain], items);
+			for (size_t i = 0; i < helpers; ++i)
+				SubmitToDomain(static_cast<unsigned int>(domain), [state, Run, domain] { Run(*state, domain); });
+		}
+	}
+
+	Run(*state, callerDomain);
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->done.wait(lock, [&] { return state->finished.load() == count; });
+
+	if (state->error)
+		std::rethrow_exception(state->error);
+}
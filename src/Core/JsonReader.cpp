@@ -0,0 +1,319 @@
+#include <Core/JsonReader.h>
+#include <charconv>
+#include <cstdint>
+
+namespace
+{
+	class Parser
+	{
+	private:
+		const char* begin;
+		const char* cursor;
+		const char* end;
+		JsonHandler& handler;
+		std::string scratch;		///< Unescaped string storage
+		const char* failure = nullptr;
+
+		bool Fail(const char* message)
+		{
+			if (!failure)
+				failure = message;
+			return false;
+		}
+
+		void SkipWhitespace()
+		{
+			while (cursor < end && (*cursor == ' ' || *cursor == '\n' || *cursor == '\r' || *cursor == '\t'))
+				++cursor;
+		}
+
+		bool Literal(const char* word, size_t length)
+		{
+			if (static_cast<size_t>(end - cursor) < length || std::string_view(cursor, length) != std::string_view(word, length))
+				return Fail("invalid literal");
+			cursor += length;
+			return true;
+		}
+
+		static int HexDigit(char c)
+		{
+			if (c >= '0' && c <= '9') return c - '0';
+			if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+			if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+			return -1;
+		}
+
+		bool ReadHex4(uint32_t& value)
+		{
+			if (end - cursor < 4)
+				return Fail("truncated \\u escape");
+			value = 0;
+			for (int i = 0; i < 4; ++i)
+			{
+				int digit = HexDigit(cursor[i]);
+				if (digit < 0)
+					return Fail("invalid \\u escape");
+				value = (value << 4) | static_cast<uint32_t>(digit);
+			}
+			cursor += 4;
+			return true;
+		}
+
+		void AppendUtf8(uint32_t codepoint)
+		{
+			if (codepoint < 0x80) {
+				scratch += static_cast<char>(codepoint);
+			}
+			else if (codepoint < 0x800) {
+				scratch += static_cast<char>(0xC0 | (codepoint >> 6));
+				scratch += static_cast<char>(0x80 | (codepoint & 0x3F));
+			}
+			else if (codepoint < 0x10000) {
+				scratch += static_cast<char>(0xE0 | (codepoint >> 12));
+				scratch += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+				scratch += static_cast<char>(0x80 | (codepoint & 0x3F));
+			}
+			else {
+				scratch += static_cast<char>(0xF0 | (codepoint >> 18));
+				scratch += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+				scratch += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+				scratch += static_cast<char>(0x80 | (codepoint & 0x3F));
+			}
+		}
+
+		// Cursor is past the opening quote; on success `out` views the string contents
+		bool ReadString(std::string_view& out)
+		{
+			const char* start = cursor;
+
+			// Fast path: scan to the closing quote, no escapes
+			while (cursor < end && *cursor != '"' && *cursor != '\\')
+			{
+				if (static_cast<unsigned char>(*cursor) < 0x20)
+					return Fail("control character in string");
+				++cursor;
+			}
+			if (cursor >= end)
+				return Fail("unterminated string");
+			if (*cursor == '"')
+			{
+				out = std::string_view(start, static_cast<size_t>(cursor - start));
+				++cursor;
+				return true;
+			}
+
+			// Slow path: copy and unescape
+			scratch.assign(start, cursor);
+			while (cursor < end && *cursor != '"')
+			{
+				char c = *cursor++;
+				if (c != '\\')
+				{
+					if (static_cast<unsigned char>(c) < 0x20)
+						return Fail("control character in string");
+					scratch += c;
+					continue;
+				}
+				if (cursor >= end)
+					return Fail("unterminated escape");
+
+				switch (*cursor++)
+				{
+				case '"': scratch += '"'; break;
+				case '\\': scratch += '\\'; break;
+				case '/': scratch += '/'; break;
+				case 'b': scratch += '\b'; break;
+				case 'f': scratch += '\f'; break;
+				case 'n': scratch += '\n'; break;
+				case 'r': scratch += '\r'; break;
+				case 't': scratch += '\t'; break;
+				case 'u':
+				{
+					uint32_t codepoint;
+					if (!ReadHex4(codepoint))
+						return false;
+
+					// Surrogate pair
+					if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
+					{
+						uint32_t low;
+						if (end - cursor < 2 || cursor[0] != '\\' || cursor[1] != 'u')
+							return Fail("unpaired surrogate");
+						cursor += 2;
+						if (!ReadHex4(low) || low < 0xDC00 || low > 0xDFFF)
+							return Fail("invalid surrogate pair");
+						codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+					}
+					AppendUtf8(codepoint);
+					break;
+				}
+				default:
+					return Fail("invalid escape");
+				}
+			}
+			if (cursor >= end)
+				return Fail("unterminated string");
+			++cursor;
+
+			out = scratch;
+			return true;
+		}
+
+		bool ReadNumber()
+		{
+			// Validate the JSON grammar (from_chars alone is more permissive)
+			const char* start = cursor;
+			if (cursor < end && *cursor == '-')
+				++cursor;
+			if (cursor >= end || *cursor < '0' || *cursor > '9')
+				return Fail("invalid number");
+			if (*cursor == '0')
+				++cursor;
+			else
+				while (cursor < end && *cursor >= '0' && *cursor <= '9') ++cursor;
+			if (cursor < end && *cursor == '.')
+			{
+				++cursor;
+				if (cursor >= end || *cursor < '0' || *cursor > '9')
+					return Fail("invalid number");
+				while (cursor < end && *cursor >= '0' && *cursor <= '9') ++cursor;
+			}
+			if (cursor < end && (*cursor == 'e' || *cursor == 'E'))
+			{
+				++cursor;
+				if (cursor < end && (*cursor == '+' || *cursor == '-'))
+					++cursor;
+				if (cursor >= end || *cursor < '0' || *cursor > '9')
+					return Fail("invalid number");
+				while (cursor < end && *cursor >= '0' && *cursor <= '9') ++cursor;
+			}
+
+			double value = 0.0;
+			std::from_chars_result result = std::from_chars(start, cursor, value);
+			if (result.ec != std::errc() && result.ec != std::errc::result_out_of_range)
+				return Fail("invalid number");
+			return handler.Number(value) || Fail("rejected by handler");
+		}
+
+		bool ParseValue(int depth)
+		{
+			if (depth > JsonReader::MaxDepth)
+				return Fail("nesting too deep");
+
+			SkipWhitespace();
+			if (cursor >= end)
+				return Fail("unexpected end of input");
+
+			switch (*cursor)
+			{
+			case '{':
+			{
+				++cursor;
+				if (!handler.StartObject())
+					return Fail("rejected by handler");
+
+				SkipWhitespace();
+				if (cursor < end && *cursor == '}')
+				{
+					++cursor;
+					return handler.EndObject() || Fail("rejected by handler");
+				}
+
+				for (;;)
+				{
+					SkipWhitespace();
+					if (cursor >= end || *cursor != '"')
+						return Fail("expected object key");
+					++cursor;
+
+					std::string_view key;
+					if (!ReadString(key))
+						return false;
+					if (!handler.Key(key))
+						return Fail("rejected by handler");
+
+					SkipWhitespace();
+					if (cursor >= end || *cursor != ':')
+						return Fail("expected ':'");
+					++cursor;
+
+					if (!ParseValue(depth + 1))
+						return false;
+
+					SkipWhitespace();
+					if (cursor < end && *cursor == ',') { ++cursor; continue; }
+					if (cursor < end && *cursor == '}') { ++cursor; break; }
+					return Fail("expected ',' or '}'");
+				}
+				return handler.EndObject() || Fail("rejected by handler");
+			}
+			case '[':
+			{
+				++cursor;
+				if (!handler.StartArray())
+					return Fail("rejected by handler");
+
+				SkipWhitespace();
+				if (cursor < end && *cursor == ']')
+				{
+					++cursor;
+					return handler.EndArray() || Fail("rejected by handler");
+				}
+
+				for (;;)
+				{
+					if (!ParseValue(depth + 1))
+						return false;
+
+					SkipWhitespace();
+					if (cursor < end && *cursor == ',') { ++cursor; continue; }
+					if (cursor < end && *cursor == ']') { ++cursor; break; }
+					return Fail("expected ',' or ']'");
+				}
+				return handler.EndArray() || Fail("rejected by handler");
+			}
+			case '"':
+			{
+				++cursor;
+				std::string_view value;
+				if (!ReadString(value))
+					return false;
+				return handler.String(value) || Fail("rejected by handler");
+			}
+			case 't':
+				return Literal("true", 4) && (handler.Bool(true) || Fail("rejected by handler"));
+			case 'f':
+				return Literal("false", 5) && (handler.Bool(false) || Fail("rejected by handler"));
+			case 'n':
+				return Literal("null", 4) && (handler.Null() || Fail("rejected by handler"));
+			default:
+				return ReadNumber();
+			}
+		}
+
+	public:
+		Parser(std::string_view text, JsonHandler& handler)
+			: begin(text.data()), cursor(text.data()), end(text.data() + text.size()), handler(handler) {}
+
+		bool Run(std::string* error)
+		{
+			bool ok = ParseValue(0);
+			if (ok)
+			{
+				SkipWhitespace();
+				if (cursor != end)
+					ok = Fail("trailing characters");
+			}
+
+			if (!ok && error)
+				*error = std::string(failure ? failure : "parse error") + " at offset " + std::to_string(cursor - begin);
+			return ok;
+		}
+	};
+}
+
+bool JsonReader::Parse(std::string_view text, JsonHandler& handler, std::string* error)
+{
+	Parser parser(text, handler);
+	return parser.Run(error);
+}
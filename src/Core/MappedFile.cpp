@@ -0,0 +1,130 @@
+#include <Core/MappedFile.h>
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		std::swap(data_, other.data_);
+		std::swap(size_, other.size_);
+#ifdef _WIN32
+		std::swap(file_, other.file_);
+		std::swap(mapping_, other.mapping_);
+#else
+		std::swap(fd_, other.fd_);
+#endif
+	}
+	return *this;
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		std::cerr << "[MappedFile] Cannot open " << path << "\n";
+		return false;
+	}
+	file_ = file;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		std::cerr << "[MappedFile] Cannot query size of " << path << "\n";
+		Close();
+		return false;
+	}
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	if (size_ == 0)
+		return true;
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+	{
+		std::cerr << "[MappedFile] Cannot map " << path << "\n";
+		Close();
+		return false;
+	}
+	mapping_ = mapping;
+
+	data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	fd_ = open(path.c_str(), O_RDONLY);
+	if (fd_ < 0)
+	{
+		std::cerr << "[MappedFile] Cannot open " << path << "\n";
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(fd_, &info) != 0)
+	{
+		std::cerr << "[MappedFile] Cannot query size of " << path << "\n";
+		Close();
+		return false;
+	}
+	size_ = static_cast<size_t>(info.st_size);
+	if (size_ == 0)
+		return true;
+
+	void* view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+	data_ = view == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(view);
+#endif
+
+	if (!data_)
+	{
+		std::cerr << "[MappedFile] Cannot map view of " << path << "\n";
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (data_)
+		UnmapViewOfFile(data_);
+	if (mapping_)
+		CloseHandle(static_cast<HANDLE>(mapping_));
+	if (file_)
+		CloseHandle(static_cast<HANDLE>(file_));
+	mapping_ = nullptr;
+	file_ = nullptr;
+#else
+	if (data_)
+		munmap(const_cast<uint8_t*>(data_), size_);
+	if (fd_ >= 0)
+		close(fd_);
+	fd_ = -1;
+#endif
+	data_ = nullptr;
+	size_ = 0;
+}
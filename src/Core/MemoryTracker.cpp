@@ -0,0 +1,332 @@
+/**
+ * @file MemoryTracker.cpp
+ * @brief Block headers, tag counters, frame bookkeeping, the JSON report and the optional global new hook.
+ */
+#include <Core/MemoryTracker.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <locale>
+#include <sstream>
+
+namespace
+{
+	// Precedes every block; the user pointer is aligned, the header sits right below it
+	struct BlockHeader
+	{
+		std::uint64_t size;
+		std::uint32_t offset;	///< From the malloc'd pointer to the user pointer
+		std::uint16_t tag;
+		std::uint16_t magic;
+	};
+	static_assert(sizeof(BlockHeader) == 16, "Header must keep 16-byte alignment");
+
+	constexpr std::uint16_t HeaderMagic = 0x4D54;
+	constexpr size_t DefaultAlignment = alignof(std::max_align_t) > 16 ? alignof(std::max_align_t) : 16;
+
+	thread_local MemoryTag currentTag = MemoryTag::General;
+
+	const char* const TagNames[MemoryTracker::TagCount] = {
+		"General", "Mesh", "Texture", "Shader", "Scene", "Renderer", "Simulation", "Network"
+	};
+
+	void RaiseMaximum(std::atomic<std::int64_t>& maximum, std::int64_t value)
+	{
+		std::int64_t seen = maximum.load(std::memory_order_relaxed);
+		while (value > seen && !maximum.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void RaiseMaximum(std::atomic<std::uint64_t>& maximum, std::uint64_t value)
+	{
+		std::uint64_t seen = maximum.load(std::memory_order_relaxed);
+		while (value > seen && !maximum.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+		{
+		}
+	}
+}
+
+// ----------------------------------------------------
+// Allocation
+// ----------------------------------------------------
+MemoryTracker& MemoryTracker::Get()
+{
+	// Constant-initialised and trivially destructible: usable from operator new at any point of the program
+	static MemoryTracker tracker;
+	return tracker;
+}
+
+void* MemoryTracker::TryAllocate(size_t size, size_t alignment, MemoryTag tag) noexcept
+{
+	if (alignment < DefaultAlignment)
+		alignment = DefaultAlignment;
+
+	// malloc already returns DefaultAlignment; larger alignments need slack to round up into
+	size_t slack = sizeof(BlockHeader) + (alignment - DefaultAlignment);
+	if (size > static_cast<size_t>(-1) - slack)
+		return nullptr;
+	void* raw = std::malloc(size + slack);
+	if (!raw)
+		return nullptr;
+
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(BlockHeader);
+	address = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+	BlockHeader* header = reinterpret_cast<BlockHeader*>(address) - 1;
+	header->size = size;
+	header->offset = static_cast<std::uint32_t>(address - reinterpret_cast<std::uintptr_t>(raw));
+	header->tag = static_cast<std::uint16_t>(tag);
+	header->magic = HeaderMagic;
+
+	Get().OnAllocate(tag, size);
+	return reinterpret_cast<void*>(address);
+}
+
+void* MemoryTracker::Allocate(size_t size, size_t alignment, MemoryTag tag)
+{
+	void* pointer = TryAllocate(size, alignment, tag);
+	if (!pointer)
+		throw std::bad_alloc();
+	return pointer;
+}
+
+void MemoryTracker::Free(void* pointer) noexcept
+{
+	if (!pointer)
+		return;
+
+	BlockHeader* header = static_cast<BlockHeader*>(pointer) - 1;
+	if (header->magic != HeaderMagic)
+	{
+		// Not ours (or corrupted): leaking is safer than freeing a foreign pointer
+		std::fprintf(stderr, "[MemoryTracker] Free of an untracked or corrupted block %p\n", pointer);
+		return;
+	}
+	header->magic = 0;	// A second free of the same block is caught above
+
+	Get().OnFree(static_cast<MemoryTag>(header->tag), static_cast<size_t>(header->size));
+	std::free(static_cast<unsigned char*>(pointer) - header->offset);
+}
+
+void MemoryTracker::OnAllocate(MemoryTag tag, size_t size)
+{
+	Counters& tagCounters = counters[static_cast<size_t>(tag)];
+	std::int64_t bytes = static_cast<std::int64_t>(size);
+	RaiseMaximum(tagCounters.peakBytes, tagCounters.currentBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+	tagCounters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	tagCounters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+	tagCounters.totalBytes.fetch_add(size, std::memory_order_relaxed);
+	tagCounters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+	tagCounters.frameBytes.fetch_add(size, std::memory_order_relaxed);
+
+	// No logging here: printing would allocate. EndFrame() reports the offenders.
+	if (steadyState.load(std::memory_order_relaxed) && flaggedInFrame.fetch_add(1, std::memory_order_relaxed) == 0)
+	{
+		firstFlaggedSize.store(size, std::memory_order_relaxed);
+		firstFlaggedTag.store(static_cast<int>(tag), std::memory_order_relaxed);
+	}
+}
+
+void MemoryTracker::OnFree(MemoryTag tag, size_t size)
+{
+	Counters& tagCounters = counters[static_cast<size_t>(tag)];
+	tagCounters.currentBytes.fetch_sub(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+	tagCounters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryTag MemoryTracker::GetCurrentTag()
+{
+	return currentTag;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag)
+{
+	return tag < MemoryTag::Count ? TagNames[static_cast<size_t>(tag)] : "Unknown";
+}
+
+// ----------------------------------------------------
+// Frames
+// ----------------------------------------------------
+void MemoryTracker::SetDebugMode(bool enabled, std::uint64_t warmup)
+{
+	warmupFrames = warmup;
+	debugMode.store(enabled, std::memory_order_relaxed);
+	if (enabled)
+		std::cout << "[MemoryTracker] Flagging allocations in frames after " << warmup << " warm-up frames"
+			<< (IsGlobalHookEnabled() ? "" : " (tracked containers only; build with CELESTIAL_TRACK_ALLOCATIONS for all)")
+			<< "\n";
+}
+
+void MemoryTracker::BeginFrame()
+{
+	for (Counters& tagCounters : counters)
+	{
+		tagCounters.frameAllocations.store(0, std::memory_order_relaxed);
+		tagCounters.frameBytes.store(0, std::memory_order_relaxed);
+	}
+	flaggedInFrame.store(0, std::memory_order_relaxed);
+	steadyState.store(debugMode.load(std::memory_order_relaxed) && GetFrameIndex() >= warmupFrames, std::memory_order_relaxed);
+}
+
+void MemoryTracker::EndFrame()
+{
+	steadyState.store(false, std::memory_order_relaxed);
+
+	for (Counters& tagCounters : counters)
+	{
+		std::uint64_t allocations = tagCounters.frameAllocations.load(std::memory_order_relaxed);
+		tagCounters.lastFrameAllocations.store(allocations, std::memory_order_relaxed);
+		tagCounters.lastFrameBytes.store(tagCounters.frameBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		RaiseMaximum(tagCounters.maxFrameAllocations, allocations);
+	}
+
+	std::uint64_t flagged = flaggedInFrame.exchange(0, std::memory_order_relaxed);
+	if (flagged > 0)
+	{
+		if (flaggedFrames < MaxReportedFrames)
+		{
+			std::cerr << "[MemoryTracker] Frame " << GetFrameIndex() << ": " << flagged
+				<< " allocations in the steady-state loop, first " << firstFlaggedSize.load(std::memory_order_relaxed)
+				<< " bytes tagged " << GetTagName(static_cast<MemoryTag>(firstFlaggedTag.load(std::memory_order_relaxed)))
+				<< (flaggedFrames + 1 == MaxReportedFrames ? " (further frames are only counted)" : "") << "\n";
+		}
+		flaggedFrames++;
+		flaggedAllocations += flagged;
+	}
+	frameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------
+// Reporting
+// ----------------------------------------------------
+MemoryTracker::TagStats MemoryTracker::GetStats(MemoryTag tag) const
+{
+	const Counters& tagCounters = counters[static_cast<size_t>(tag)];
+	TagStats stats;
+	stats.currentBytes = tagCounters.currentBytes.load(std::memory_order_relaxed);
+	stats.peakBytes = tagCounters.peakBytes.load(std::memory_order_relaxed);
+	stats.liveAllocations = tagCounters.liveAllocations.load(std::memory_order_relaxed);
+	stats.totalAllocations = tagCounters.totalAllocations.load(std::memory_order_relaxed);
+	stats.totalBytes = tagCounters.totalBytes.load(std::memory_order_relaxed);
+	stats.lastFrameAllocations = tagCounters.lastFrameAllocations.load(std::memory_order_relaxed);
+	stats.lastFrameBytes = tagCounters.lastFrameBytes.load(std::memory_order_relaxed);
+	stats.maxFrameAllocations = tagCounters.maxFrameAllocations.load(std::memory_order_relaxed);
+	return stats;
+}
+
+std::string MemoryTracker::ToJson() const
+{
+	std::ostringstream out;
+	out.imbue(std::locale::classic());
+
+	out << "{\n  \"globalHook\": " << (IsGlobalHookEnabled() ? "true" : "false")
+		<< ",\n  \"frames\": " << GetFrameIndex() << ",\n  \"tags\": {";
+	for (size_t tag = 0; tag < TagCount; ++tag)
+	{
+		TagStats stats = GetStats(static_cast<MemoryTag>(tag));
+		out << (tag ? "," : "") << "\n    \"" << TagNames[tag] << "\": {"
+			<< "\"currentBytes\": " << stats.currentBytes
+			<< ", \"peakBytes\": " << stats.peakBytes
+			<< ", \"liveAllocations\": " << stats.liveAllocations
+			<< ", \"totalAllocations\": " << stats.totalAllocations
+			<< ", \"totalBytes\": " << stats.totalBytes
+			<< ", \"lastFrameAllocations\": " << stats.lastFrameAllocations
+			<< ", \"lastFrameBytes\": " << stats.lastFrameBytes
+			<< ", \"maxFrameAllocations\": " << stats.maxFrameAllocations << "}";
+	}
+	out << "\n  },\n  \"steadyState\": {\"debug\": " << (debugMode.load() ? "true" : "false")
+		<< ", \"warmupFrames\": " << warmupFrames
+		<< ", \"flaggedFrames\": " << flaggedFrames
+		<< ", \"flaggedAllocations\": " << flaggedAllocations << "}\n}\n";
+	return out.str();
+}
+
+bool MemoryTracker::WriteReport(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		std::cerr << "[MemoryTracker] Cannot write " << path << "\n";
+		return false;
+	}
+	file << ToJson();
+	std::cout << "[MemoryTracker] Wrote report to " << path << "\n";
+	return true;
+}
+
+// ----------------------------------------------------
+// MemoryTagScope
+// ----------------------------------------------------
+MemoryTagScope::MemoryTagScope(MemoryTag tag)
+	: previous(currentTag)
+{
+	currentTag = tag;
+}
+
+MemoryTagScope::~MemoryTagScope()
+{
+	currentTag = previous;
+}
+
+// ----------------------------------------------------
+// Global operator new/delete (CELESTIAL_TRACK_ALLOCATIONS builds)
+// ----------------------------------------------------
+#ifdef CELESTIAL_TRACK_ALLOCATIONS
+
+void* operator new(size_t size)
+{
+	return MemoryTracker::Allocate(size, DefaultAlignment, currentTag);
+}
+
+void* operator new[](size_t size)
+{
+	return MemoryTracker::Allocate(size, DefaultAlignment, currentTag);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return MemoryTracker::TryAllocate(size, DefaultAlignment, currentTag);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return MemoryTracker::TryAllocate(size, DefaultAlignment, currentTag);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return MemoryTracker::Allocate(size, static_cast<size_t>(alignment), currentTag);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return MemoryTracker::Allocate(size, static_cast<size_t>(alignment), currentTag);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return MemoryTracker::TryAllocate(size, static_cast<size_t>(alignment), currentTag);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return MemoryTracker::TryAllocate(size, static_cast<size_t>(alignment), currentTag);
+}
+
+// The header records everything needed, so every delete form frees the same way
+void operator delete(void* pointer) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { MemoryTracker::Free(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { MemoryTracker::Free(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { MemoryTracker::Free(pointer); }
+
+#endif
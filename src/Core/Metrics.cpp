@@ -0,0 +1,229 @@
+/**
+ * @file Metrics.cpp
+ * @brief Metric storage, Prometheus text formatting and the HTTP serving thread.
+ */
+#include <Core/Metrics.h>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <locale>
+#include <sstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// Resident set size of this process in bytes, 0 if unavailable
+	double ProcessResidentBytes()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return static_cast<double>(counters.WorkingSetSize);
+		return 0.0;
+#else
+		long pages = 0, residentPages = 0;
+		FILE* statm = std::fopen("/proc/self/statm", "r");
+		if (!statm)
+			return 0.0;
+		int read = std::fscanf(statm, "%ld %ld", &pages, &residentPages);
+		std::fclose(statm);
+		return read == 2 ? static_cast<double>(residentPages) * static_cast<double>(sysconf(_SC_PAGESIZE)) : 0.0;
+#endif
+	}
+
+	void WriteHeader(std::ostringstream& out, const std::string& name, const std::string& help, const char* type)
+	{
+		out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+	}
+}
+
+// ----------------------------------------------------
+// Histogram
+// ----------------------------------------------------
+MetricHistogram::MetricHistogram(std::vector<double> upperBounds)
+	: bounds(std::move(upperBounds)), buckets(new std::atomic<std::uint64_t>[bounds.size() + 1])
+{
+	std::sort(bounds.begin(), bounds.end());
+	for (size_t i = 0; i <= bounds.size(); ++i)
+		buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void MetricHistogram::Observe(double value)
+{
+	// First bound >= value: Prometheus buckets are "less than or equal"
+	size_t bucket = static_cast<size_t>(std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin());
+	buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+	sum.fetch_add(value, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ----------------------------------------------------
+// Registry
+// ----------------------------------------------------
+MetricsRegistry::MetricsRegistry()
+{
+	AddCallback("celestial_process_resident_bytes", "Resident memory of the process.", ProcessResidentBytes);
+}
+
+MetricsRegistry& MetricsRegistry::Get()
+{
+	static MetricsRegistry registry;
+	return registry;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::Add(const std::string& name, const std::string& help, Kind kind)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Entry& entry = entries.emplace_back();	// deque: earlier entries never move
+	entry.name = name;
+	entry.help = help;
+	entry.kind = kind;
+	return entry;
+}
+
+MetricCounter& MetricsRegistry::AddCounter(const std::string& name, const std::string& help)
+{
+	auto counter = std::make_unique<MetricCounter>();
+	MetricCounter& result = *counter;
+	Add(name, help, Kind::Counter).counter = std::move(counter);
+	return result;
+}
+
+MetricGauge& MetricsRegistry::AddGauge(const std::string& name, const std::string& help)
+{
+	auto gauge = std::make_unique<MetricGauge>();
+	MetricGauge& result = *gauge;
+	Add(name, help, Kind::Gauge).gauge = std::move(gauge);
+	return result;
+}
+
+MetricHistogram& MetricsRegistry::AddHistogram(const std::string& name, const std::string& help, std::vector<double> upperBounds)
+{
+	auto histogram = std::make_unique<MetricHistogram>(std::move(upperBounds));
+	MetricHistogram& result = *histogram;
+	Add(name, help, Kind::Histogram).histogram = std::move(histogram);
+	return result;
+}
+
+void MetricsRegistry::AddCallback(const std::string& name, const std::string& help, std::function<double()> read)
+{
+	Add(name, help, Kind::Callback).callback = std::move(read);
+}
+
+std::string MetricsRegistry::Format() const
+{
+	std::ostringstream out;
+	out.imbue(std::locale::classic());
+	out.precision(12);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for (const Entry& entry : entries)
+	{
+		switch (entry.kind)
+		{
+		case Kind::Counter:
+			WriteHeader(out, entry.name + "_total", entry.help, "counter");
+			out << entry.name << "_total " << entry.counter->Get() << '\n';
+			break;
+		case Kind::Gauge:
+			WriteHeader(out, entry.name, entry.help, "gauge");
+			out << entry.name << ' ' << entry.gauge->Get() << '\n';
+			break;
+		case Kind::Callback:
+			WriteHeader(out, entry.name, entry.help, "gauge");
+			out << entry.name << ' ' << entry.callback() << '\n';
+			break;
+		case Kind::Histogram:
+		{
+			// Buckets are read one by one while the owner keeps observing, so the total
+			// is taken from the buckets themselves to keep +Inf and _count consistent
+			const MetricHistogram& histogram = *entry.histogram;
+			WriteHeader(out, entry.name, entry.help, "histogram");
+			std::uint64_t cumulative = 0;
+			for (size_t i = 0; i < histogram.GetBounds().size(); ++i)
+			{
+				cumulative += histogram.GetBucket(i);
+				out << entry.name << "_bucket{le=\"" << histogram.GetBounds()[i] << "\"} " << cumulative << '\n';
+			}
+			cumulative += histogram.GetBucket(histogram.GetBounds().size());
+			out << entry.name << "_bucket{le=\"+Inf\"} " << cumulative << '\n';
+			out << entry.name << "_sum " << histogram.GetSum() << '\n';
+			out << entry.name << "_count " << cumulative << '\n';
+			break;
+		}
+		}
+	}
+	return out.str();
+}
+
+// ----------------------------------------------------
+// Server
+// ----------------------------------------------------
+MetricsServer::MetricsServer(std::uint16_t port, const MetricsRegistry& metricsRegistry)
+	: registry(metricsRegistry)
+{
+	listener = TcpSocket::Listen(port, true);
+	thread = std::thread(&MetricsServer::ServeLoop, this);
+	std::cout << "[MetricsServer] Serving http://127.0.0.1:" << port << "/metrics\n";
+}
+
+MetricsServer::~MetricsServer()
+{
+	stopping.store(true);
+	if (thread.joinable())
+		thread.join();
+}
+
+void MetricsServer::ServeLoop()
+{
+	// Short accept timeout so shutdown is noticed promptly
+	while (!stopping.load())
+	{
+		TcpSocket connection = listener.Accept(0.25);
+		if (connection.IsValid())
+			Serve(connection);
+	}
+}
+
+void MetricsServer::Serve(const TcpSocket& connection)
+{
+	// Read the request head; a scraper sends nothing else worth waiting for
+	std::string request;
+	char chunk[1024];
+	while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+	{
+		if (!connection.WaitReadable(1.0))
+			return;
+		std::ptrdiff_t received = connection.ReceiveSome(chunk, sizeof(chunk));
+		if (received <= 0)
+			return;
+		request.append(chunk, static_cast<size_t>(received));
+	}
+
+	std::string status = "200 OK";
+	std::string contentType = "text/plain; version=0.0.4; charset=utf-8";
+	std::string body;
+	if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0)
+	{
+		body = registry.Format();
+		scrapes.fetch_add(1, std::memory_order_relaxed);
+	}
+	else
+	{
+		status = request.rfind("GET ", 0) == 0 ? "404 Not Found" : "405 Method Not Allowed";
+		contentType = "text/plain; charset=utf-8";
+		body = status + "\n";
+	}
+
+	std::string response = "HTTP/1.1 " + status + "\r\nContent-Type: " + contentType
+		+ "\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+	connection.SendAll(response.data(), response.size());
+}
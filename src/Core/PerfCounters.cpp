@@ -0,0 +1,115 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief perf_event_open counter group for the calling thread (Linux only).
+ */
+#include <Core/PerfCounters.h>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+	const std::uint64_t EventConfigs[PerfCounters::EventCount] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES,
+		PERF_COUNT_HW_BRANCH_MISSES
+	};
+
+	int OpenEvent(std::uint64_t config, int groupLeader)
+	{
+		perf_event_attr attributes;
+		std::memset(&attributes, 0, sizeof(attributes));
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof(attributes);
+		attributes.config = config;
+		attributes.disabled = groupLeader < 0 ? 1 : 0;	// The leader starts the whole group
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		attributes.read_format = PERF_FORMAT_GROUP;
+
+		// This thread, any CPU
+		return static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, groupLeader, 0));
+	}
+}
+
+PerfCounters::PerfCounters()
+{
+	for (int event = 0; event < EventCount; ++event)
+	{
+		descriptors[event] = -1;
+		groupSlot[event] = -1;
+	}
+
+	// Without cycles there is no leader and nothing worth reporting
+	descriptors[Cycles] = OpenEvent(EventConfigs[Cycles], -1);
+	if (descriptors[Cycles] < 0)
+		return;
+	groupSlot[Cycles] = groupSize++;
+
+	for (int event = Cycles + 1; event < EventCount; ++event)
+	{
+		descriptors[event] = OpenEvent(EventConfigs[event], descriptors[Cycles]);
+		if (descriptors[event] >= 0)
+			groupSlot[event] = groupSize++;
+	}
+
+	ioctl(descriptors[Cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(descriptors[Cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters()
+{
+	// Siblings first, then the leader
+	for (int event = EventCount; event-- > 0;)
+		if (descriptors[event] >= 0)
+			close(descriptors[event]);
+}
+
+bool PerfCounters::Read(Values& values) const
+{
+	if (!IsOpen())
+		return false;
+
+	// PERF_FORMAT_GROUP: event count, then one value per event in opening order
+	std::uint64_t buffer[1 + EventCount];
+	ssize_t expected = static_cast<ssize_t>(sizeof(std::uint64_t) * (1 + groupSize));
+	if (read(descriptors[Cycles], buffer, sizeof(buffer)) != expected)
+		return false;
+
+	for (int event = 0; event < EventCount; ++event)
+		values.counts[event] = groupSlot[event] >= 0 ? buffer[1 + groupSlot[event]] : 0;
+	return true;
+}
+
+#else
+
+PerfCounters::PerfCounters()
+{
+	for (int event = 0; event < EventCount; ++event)
+	{
+		descriptors[event] = -1;
+		groupSlot[event] = -1;
+	}
+}
+
+PerfCounters::~PerfCounters()
+{
+}
+
+bool PerfCounters::Read(Values&) const
+{
+	return false;
+}
+
+#endif
+
+const char* PerfCounters::GetName(Event event)
+{
+	static const char* const Names[EventCount] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+	return Names[event];
+}
@@ -0,0 +1,217 @@
+/**
+ * @file Profiler.cpp
+ * @brief Scope sampling, per-thread counter groups, trace writing and the summary report.
+ */
+#include <Core/Profiler.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <locale>
+#include <map>
+#include <memory>
+
+namespace
+{
+	std::atomic<std::uint32_t> nextThreadIndex{ 0 };
+
+	// Small stable ids for the trace's thread lanes
+	std::uint32_t ThreadIndex()
+	{
+		thread_local std::uint32_t index = nextThreadIndex.fetch_add(1);
+		return index;
+	}
+
+	std::atomic<bool> reportedUnavailable{ false };
+
+	// Opened on the first counted scope of each thread; a failed open is kept so it is not retried
+	PerfCounters* ThreadCounters()
+	{
+		thread_local std::unique_ptr<PerfCounters> counters;
+		if (!counters)
+		{
+			counters = std::make_unique<PerfCounters>();
+			if (!counters->IsOpen() && !reportedUnavailable.exchange(true))
+				std::cerr << "[Profiler] Hardware counters unavailable (perf_event_open failed or unsupported platform), "
+					"recording times only\n";
+		}
+		return counters->IsOpen() ? counters.get() : nullptr;
+	}
+
+	double Ratio(std::uint64_t numerator, std::uint64_t denominator)
+	{
+		return denominator > 0 ? static_cast<double>(numerator) / static_cast<double>(denominator) : 0.0;
+	}
+}
+
+// ----------------------------------------------------
+// Profiler
+// ----------------------------------------------------
+Profiler& Profiler::Get()
+{
+	static Profiler profiler;
+	return profiler;
+}
+
+void Profiler::Start(const std::string& path, bool useHardwareCounters)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		samples.clear();
+		dropped = 0;
+		tracePath = path;
+	}
+	hardwareCounters.store(useHardwareCounters, std::memory_order_relaxed);
+
+	// Published before capturing: a scope that sees capturing (acquire) also sees this origin
+	originTicks.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+	capturing.store(true, std::memory_order_release);
+	std::cout << "[Profiler] Capturing" << (useHardwareCounters ? " with hardware counters" : "") << " to " << path << "\n";
+}
+
+void Profiler::Stop()
+{
+	if (!capturing.exchange(false))
+		return;
+
+	std::vector<Sample> captured;
+	size_t droppedSamples;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		captured.swap(samples);
+		droppedSamples = dropped;
+	}
+
+	WriteTrace(captured);
+	PrintSummary(captured);
+	if (droppedSamples > 0)
+		std::cerr << "[Profiler] Dropped " << droppedSamples << " samples over the " << MaxSamples << " limit\n";
+}
+
+void Profiler::Record(const Sample& sample)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (samples.size() < MaxSamples)
+		samples.push_back(sample);
+	else
+		dropped++;
+}
+
+void Profiler::WriteTrace(const std::vector<Sample>& captured) const
+{
+	std::ofstream file(tracePath);
+	if (!file)
+	{
+		std::cerr << "[Profiler] Cannot write " << tracePath << "\n";
+		return;
+	}
+	file.imbue(std::locale::classic());
+	file << std::fixed << std::setprecision(3);	// Microsecond timestamps keep nanosecond resolution in long captures
+
+	// Chrome trace event format: complete events ("X") with microsecond timestamps
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	for (size_t i = 0; i < captured.size(); ++i)
+	{
+		const Sample& sample = captured[i];
+		file << (i ? ",\n" : "\n") << "{\"name\":\"" << sample.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << sample.thread
+			<< ",\"ts\":" << sample.start * 1e6 << ",\"dur\":" << sample.duration * 1e6
+			<< ",\"args\":{\"elements\":" << sample.elements;
+		if (sample.hasCounters)
+		{
+			for (int event = 0; event < PerfCounters::EventCount; ++event)
+				file << ",\"" << PerfCounters::GetName(static_cast<PerfCounters::Event>(event)) << "\":"
+					<< sample.counters.counts[event];
+			file << ",\"ipc\":" << Ratio(sample.counters.counts[PerfCounters::Instructions], sample.counters.counts[PerfCounters::Cycles]);
+			if (sample.elements > 0)
+				file << ",\"cache_misses_per_element\":" << Ratio(sample.counters.counts[PerfCounters::CacheMisses], sample.elements)
+					<< ",\"branch_misses_per_element\":" << Ratio(sample.counters.counts[PerfCounters::BranchMisses], sample.elements);
+		}
+		file << "}}";
+	}
+	file << "\n]}\n";
+
+	std::cout << "[Profiler] Wrote " << captured.size() << " samples to " << tracePath << "\n";
+}
+
+void Profiler::PrintSummary(const std::vector<Sample>& captured)
+{
+	struct Totals
+	{
+		size_t calls = 0;
+		double seconds = 0.0;
+		std::uint64_t elements = 0;
+		std::uint64_t countedElements = 0;	///< Elements of the samples that carry counters
+		PerfCounters::Values counters;
+		bool hasCounters = false;
+	};
+
+	std::map<std::string, Totals> scopes;
+	for (const Sample& sample : captured)
+	{
+		Totals& totals = scopes[sample.name];
+		totals.calls++;
+		totals.seconds += sample.duration;
+		totals.elements += sample.elements;
+		if (sample.hasCounters)
+		{
+			totals.hasCounters = true;
+			totals.countedElements += sample.elements;
+			for (int event = 0; event < PerfCounters::EventCount; ++event)
+				totals.counters.counts[event] += sample.counters.counts[event];
+		}
+	}
+
+	for (const auto& [name, totals] : scopes)
+	{
+		std::cout << "[Profiler] " << name << ": " << totals.calls << " calls, " << totals.seconds * 1000.0 << " ms";
+		if (totals.elements > 0)
+			std::cout << ", " << totals.seconds * 1e9 / static_cast<double>(totals.elements) << " ns/element";
+		if (totals.hasCounters)
+		{
+			const std::uint64_t* counts = totals.counters.counts;
+			std::cout << ", IPC " << Ratio(counts[PerfCounters::Instructions], counts[PerfCounters::Cycles]);
+			if (totals.countedElements > 0)
+				std::cout << ", cache misses/element " << Ratio(counts[PerfCounters::CacheMisses], totals.countedElements)
+					<< ", branch misses/element " << Ratio(counts[PerfCounters::BranchMisses], totals.countedElements);
+		}
+		std::cout << "\n";
+	}
+}
+
+// ----------------------------------------------------
+// ProfileScope
+// ----------------------------------------------------
+ProfileScope::ProfileScope(const char* scopeName, std::uint64_t elementCount)
+	: name(scopeName), elements(elementCount)
+{
+	Profiler& profiler = Profiler::Get();
+	active = profiler.IsCapturing();
+	if (!active)
+		return;
+
+	if (profiler.UsesHardwareCounters())
+	{
+		counters = ThreadCounters();
+		if (counters && !counters->Read(begin))
+			counters = nullptr;
+	}
+	start = profiler.Now();
+}
+
+ProfileScope::~ProfileScope()
+{
+	if (!active)
+		return;
+
+	Profiler& profiler = Profiler::Get();
+	double end = profiler.Now();
+
+	Profiler::Sample sample = { name, ThreadIndex(), start, end - start, elements, {}, false };
+	PerfCounters::Values now;
+	if (counters && counters->Read(now))
+	{
+		for (int event = 0; event < PerfCounters::EventCount; ++event)
+			sample.counters.counts[event] = now.counts[event] - begin.counts[event];
+		sample.hasCounters = true;
+	}
+	profiler.Record(sample);
+}
@@ -0,0 +1,227 @@
+/**
+ * @file Socket.cpp
+ * @brief TcpSocket on Winsock (Windows) or BSD sockets (elsewhere).
+ */
+#include <Core/Socket.h>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+using NativeSocket = SOCKET;
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+using NativeSocket = int;
+#endif
+
+namespace
+{
+	NativeSocket ToNative(std::intptr_t handle) { return static_cast<NativeSocket>(handle); }
+
+	void CloseNative(std::intptr_t handle)
+	{
+#ifdef _WIN32
+		closesocket(ToNative(handle));
+#else
+		close(ToNative(handle));
+#endif
+	}
+
+	// Winsock needs one WSAStartup per process before any other call
+	void EnsureInitialized()
+	{
+#ifdef _WIN32
+		static const bool initialized = []() {
+			WSADATA data;
+			return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+		}();
+		if (!initialized)
+			throw std::runtime_error("TcpSocket: WSAStartup failed");
+#endif
+	}
+
+	void DisableNagle(std::intptr_t handle)
+	{
+		int enabled = 1;
+		setsockopt(ToNative(handle), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+	}
+
+	// select() on one socket; false on timeout or error
+	bool WaitFor(std::intptr_t handle, double timeoutSeconds)
+	{
+		fd_set readSet;
+		FD_ZERO(&readSet);
+		FD_SET(ToNative(handle), &readSet);
+		timeval timeout;
+		timeout.tv_sec = static_cast<long>(timeoutSeconds);
+		timeout.tv_usec = static_cast<long>((timeoutSeconds - static_cast<double>(timeout.tv_sec)) * 1e6);
+		return select(static_cast<int>(ToNative(handle)) + 1, &readSet, nullptr, nullptr, &timeout) > 0;
+	}
+}
+
+TcpSocket::~TcpSocket()
+{
+	Close();
+}
+
+TcpSocket::TcpSocket(TcpSocket&& other) noexcept
+	: handle(other.handle)
+{
+	other.handle = -1;
+}
+
+TcpSocket& TcpSocket::operator=(TcpSocket&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		handle = other.handle;
+		other.handle = -1;
+	}
+	return *this;
+}
+
+void TcpSocket::Close()
+{
+	if (IsValid())
+	{
+		CloseNative(handle);
+		handle = -1;
+	}
+}
+
+TcpSocket TcpSocket::Listen(std::uint16_t port, bool loopbackOnly)
+{
+	EnsureInitialized();
+
+	NativeSocket native = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	TcpSocket listener(static_cast<std::intptr_t>(native));
+	if (native == static_cast<NativeSocket>(-1))
+		throw std::runtime_error("TcpSocket: socket() failed");
+
+	// A restarted process can take over the port right away
+	int reuse = 1;
+	setsockopt(native, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(loopbackOnly ? INADDR_LOOPBACK : INADDR_ANY);
+	if (bind(native, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(native, SOMAXCONN) != 0)
+		throw std::runtime_error("TcpSocket: cannot listen on port " + std::to_string(port));
+
+	return listener;
+}
+
+TcpSocket TcpSocket::Connect(const std::string& host, std::uint16_t port, double timeoutSeconds)
+{
+	EnsureInitialized();
+
+	addrinfo hints = {};
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+	addrinfo* results = nullptr;
+	if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &results) != 0 || !results)
+	{
+		std::cerr << "[TcpSocket] Cannot resolve " << host << "\n";
+		return TcpSocket();
+	}
+
+	// The listener may still be starting; retry until the deadline
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeoutSeconds);
+	TcpSocket connection;
+	while (!connection.IsValid())
+	{
+		NativeSocket native = socket(results->ai_family, results->ai_socktype, results->ai_protocol);
+		if (native != static_cast<NativeSocket>(-1) &&
+			connect(native, results->ai_addr, static_cast<int>(results->ai_addrlen)) == 0)
+		{
+			connection = TcpSocket(static_cast<std::intptr_t>(native));
+			break;
+		}
+		if (native != static_cast<NativeSocket>(-1))
+			CloseNative(static_cast<std::intptr_t>(native));
+
+		if (std::chrono::steady_clock::now() >= deadline)
+			break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	freeaddrinfo(results);
+
+	if (connection.IsValid())
+		DisableNagle(connection.handle);
+	return connection;
+}
+
+TcpSocket TcpSocket::Accept(double timeoutSeconds) const
+{
+	if (!IsValid() || !WaitFor(handle, timeoutSeconds))
+		return TcpSocket();
+
+	NativeSocket native = accept(ToNative(handle), nullptr, nullptr);
+	if (native == static_cast<NativeSocket>(-1))
+		return TcpSocket();
+
+	TcpSocket connection(static_cast<std::intptr_t>(native));
+	DisableNagle(connection.handle);
+	return connection;
+}
+
+bool TcpSocket::WaitReadable(double timeoutSeconds) const
+{
+	return IsValid() && WaitFor(handle, timeoutSeconds);
+}
+
+bool TcpSocket::SendAll(const void* data, size_t size) const
+{
+	const char* bytes = static_cast<const char*>(data);
+	while (size > 0)
+	{
+#ifdef _WIN32
+		int sent = send(ToNative(handle), bytes, static_cast<int>(size), 0);
+#else
+		ssize_t sent = send(ToNative(handle), bytes, size, MSG_NOSIGNAL);	// A dead peer must not raise SIGPIPE
+#endif
+		if (sent <= 0)
+			return false;
+		bytes += sent;
+		size -= static_cast<size_t>(sent);
+	}
+	return true;
+}
+
+bool TcpSocket::ReceiveAll(void* data, size_t size) const
+{
+	char* bytes = static_cast<char*>(data);
+	while (size > 0)
+	{
+		std::ptrdiff_t received = ReceiveSome(bytes, size);
+		if (received <= 0)
+			return false;
+		bytes += received;
+		size -= static_cast<size_t>(received);
+	}
+	return true;
+}
+
+std::ptrdiff_t TcpSocket::ReceiveSome(void* data, size_t size) const
+{
+#ifdef _WIN32
+	return recv(ToNative(handle), static_cast<char*>(data), static_cast<int>(size), 0);
+#else
+	return recv(ToNative(handle), data, size, 0);
+#endif
+}
@@ -3,9 +3,9 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 
-Window::Window(int w, int h, const std::string& title)
+Window::Window(int w, int h, const std::string& title, bool visible)
 
-	: width_(w), height_(h), title_(title) {}
+	: width_(w), height_(h), title_(title), visible_(visible) {}
 
 Window::~Window()
 {
@@ -28,6 +28,9 @@ bool Window::Initialize()
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
+	// Headless runs render offscreen; the hidden window only provides the context
+	glfwWindowHint(GLFW_VISIBLE, visible_ ? GLFW_TRUE : GLFW_FALSE);
+
 	// Create Window
 	handle_ = glfwCreateWindow(width_, height_, title_.c_str(), nullptr, nullptr);
 	if (!handle_)
@@ -48,6 +51,13 @@ bool Window::Initialize()
 		return false;
 	}
 
+	// Window-state changes mark the contents as damaged so the loop redraws
+	glfwSetWindowUserPointer(handle_, this);
+	glfwSetFramebufferSizeCallback(handle_, FramebufferSizeCallback);
+	glfwSetWindowRefreshCallback(handle_, RefreshCallback);
+	glfwSetWindowFocusCallback(handle_, FocusCallback);
+	glfwSetWindowIconifyCallback(handle_, IconifyCallback);
+
 	std::cout << "[Window] Initialized successfullly ("
 		<< width_ << "x" << height_ << ')\n';
 
@@ -60,6 +70,17 @@ void Window::PollEvents() const
 	glfwPollEvents();
 }
 
+void Window::WaitEvents(double timeoutSeconds) const
+{
+	// Sleeps in the OS event queue instead of spinning
+	glfwWaitEventsTimeout(timeoutSeconds);
+}
+
+void Window::Wake()
+{
+	glfwPostEmptyEvent();
+}
+
 void Window::SwapBuffers() const
 {
 	// Swaps front and back buffer to present rendered frame
@@ -72,6 +93,51 @@ bool Window::ShouldClose() const
 	return glfwWindowShouldClose(handle_);
 }
 
+bool Window::IsFocused() const
+{
+	return glfwGetWindowAttrib(handle_, GLFW_FOCUSED) != 0;
+}
+
+bool Window::IsMinimized() const
+{
+	return glfwGetWindowAttrib(handle_, GLFW_ICONIFIED) != 0;
+}
+
+bool Window::ConsumeDamage()
+{
+	bool damaged = damaged_;
+	damaged_ = false;
+	return damaged;
+}
+
+void Window::FramebufferSizeCallback(GLFWwindow* window, int width, int height)
+{
+	Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window));
+	if (!self)
+		return;
+	self->width_ = width;
+	self->height_ = height;
+	self->damaged_ = true;
+}
+
+void Window::RefreshCallback(GLFWwindow* window)
+{
+	if (Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window)))
+		self->damaged_ = true;
+}
+
+void Window::FocusCallback(GLFWwindow* window, int)
+{
+	if (Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window)))
+		self->damaged_ = true;
+}
+
+void Window::IconifyCallback(GLFWwindow* window, int)
+{
+	if (Window* self = static_cast<Window*>(glfwGetWindowUserPointer(window)))
+		self->damaged_ = true;
+}
+
 glm::ivec2 Window::GetSize() const
 {
 	return { width_, height_ };
@@ -0,0 +1,50 @@
+/**
+ * @file AssetLoader.cpp
+ * @brief Texture and mesh loading coroutines.
+ */
+#include <Renderer/AssetLoader.h>
+#include <Core/MemoryTracker.h>
+#include <Core/Profiler.h>
+#include <iostream>
+#include <utility>
+
+Task<std::shared_ptr<Texture>> Assets::LoadTexture(std::string path)
+{
+	auto texture = std::make_shared<Texture>();
+
+	co_await ResumeOnWorker{};
+	bool decoded = false;
+	{
+		ProfileScope scope("Assets.DecodeTexture");
+		MemoryTagScope tag(MemoryTag::Texture);
+		decoded = texture->DecodeFromFile(path);
+	}
+
+	// Back on the GL thread even on failure, so the caller always continues there
+	co_await ResumeOnMainThread{};
+	if (!decoded)
+		co_return nullptr;
+
+	ProfileScope scope("Assets.UploadTexture");
+	if (!texture->Upload())
+		co_return nullptr;
+	co_return std::move(texture);
+}
+
+Task<std::unique_ptr<Mesh>> Assets::GenerateMesh(MeshDesc desc)
+{
+	co_await ResumeOnWorker{};
+	MeshData data;
+	{
+		ProfileScope scope("Assets.GenerateMesh");
+		data = Mesh::GenerateSphere(desc.radius, desc.sectors, desc.stacks);
+		Mesh::BuildClusters(data);
+	}
+
+	co_await ResumeOnMainThread{};
+	ProfileScope scope("Assets.UploadMesh");
+	auto mesh = std::make_unique<Mesh>(std::move(data));
+	std::cout << "[AssetLoader] Generated sphere: " << mesh->GetVertices().size() << " vertices, "
+		<< mesh->GetClusters().size() << " clusters\n";
+	co_return std::move(mesh);
+}
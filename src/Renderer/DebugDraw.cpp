@@ -0,0 +1,379 @@
+/**
+ * @file DebugDraw.cpp
+ * @brief Per-thread submission rings and the once-per-frame batch upload.
+ *
+ * Ring protocol (one producer = the owning thread, one consumer = the GL thread):
+ *  - The producer writes a whole shape, then publishes it by storing `head`
+ *    (release). A shape is therefore either fully visible to Collect() or not
+ *    at all, never half a line.
+ *  - The consumer reads `head` (acquire), copies up to it and hands the space
+ *    back by storing `tail` (release).
+ *  - A shape that does not fit the free space is dropped and counted.
+ *
+ * The registry mutex is taken only when a thread submits for the first time
+ * and by Collect(), never on the per-shape path.
+ */
+#include <Renderer/DebugDraw.h>
+
+#if CELESTIAL_DEBUG_DRAW
+
+#include <Renderer/Shader.h>
+#include <Renderer/StreamBuffer.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	using Vertex = DebugDraw::Vertex;
+
+	enum PrimitiveKind { KindPoints = 0, KindLines = 1, KindCount = 2 };
+
+	struct Ring
+	{
+		std::unique_ptr<Vertex[]> vertices{ new Vertex[DebugDraw::RingVertices] };
+		std::atomic<size_t> head{ 0 };	///< Written by the owning thread
+		std::atomic<size_t> tail{ 0 };	///< Written by Collect()
+		size_t snapshot = 0;			///< Consumer-only: head observed by the current Collect()
+		size_t take = 0;				///< Consumer-only: vertices uploaded from this ring this frame
+	};
+
+	struct ThreadRings
+	{
+		Ring rings[KindCount];
+	};
+
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<ThreadRings>> threads;	///< Never shrinks; rings outlive their threads
+		std::atomic<size_t> dropped{ 0 };
+	};
+
+	static_assert((DebugDraw::RingVertices & (DebugDraw::RingVertices - 1)) == 0, "RingVertices must be a power of two");
+	static_assert(sizeof(Vertex) == 16, "DebugDraw::Vertex must stay tightly packed");
+
+	constexpr size_t RingMask = DebugDraw::RingVertices - 1;
+	constexpr size_t ChunkVertices = 256;	///< Stack batch for polylines
+
+	Registry& GetRegistry()
+	{
+		static Registry registry;
+		return registry;
+	}
+
+	ThreadRings& LocalRings()
+	{
+		thread_local ThreadRings* local = nullptr;
+		if (!local)
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			registry.threads.push_back(std::make_unique<ThreadRings>());
+			local = registry.threads.back().get();
+		}
+		return *local;
+	}
+
+	void Push(PrimitiveKind kind, const Vertex* vertices, size_t count)
+	{
+		Ring& ring = LocalRings().rings[kind];
+		size_t head = ring.head.load(std::memory_order_relaxed);
+		size_t tail = ring.tail.load(std::memory_order_acquire);
+		if (head + count - tail > DebugDraw::RingVertices)
+		{
+			GetRegistry().dropped.fetch_add(count, std::memory_order_relaxed);
+			return;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+			ring.vertices[(head + i) & RingMask] = vertices[i];
+		ring.head.store(head + count, std::memory_order_release);
+	}
+
+	uint32_t PackColor(const glm::vec3& color)
+	{
+		auto Channel = [](float value) {
+			return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		};
+		// Byte order R, G, B, A in memory (little endian)
+		return Channel(color.x) | (Channel(color.y) << 8) | (Channel(color.z) << 16) | (255u << 24);
+	}
+
+	// The 12 edges of a box whose corner i has x/y/z from bits 0/1/2 of i
+	void PushBoxEdges(const glm::vec3 corners[8], uint32_t color)
+	{
+		Vertex lines[24];
+		size_t n = 0;
+		for (int i = 0; i < 8; ++i)
+		{
+			for (int bit = 1; bit < 8; bit <<= 1)
+			{
+				if (i & bit) continue;
+				lines[n++] = { corners[i], color };
+				lines[n++] = { corners[i | bit], color };
+			}
+		}
+		Push(KindLines, lines, n);
+	}
+
+	// Copies `count` vertices starting at ring index `from`, splitting at the wrap
+	void CopyOut(const Ring& ring, size_t from, size_t count, Vertex* out)
+	{
+		size_t begin = from & RingMask;
+		size_t first = std::min(count, DebugDraw::RingVertices - begin);
+		std::memcpy(out, &ring.vertices[begin], first * sizeof(Vertex));
+		std::memcpy(out + first, &ring.vertices[0], (count - first) * sizeof(Vertex));
+	}
+}
+
+// -----------------------------------------------------
+// Submission
+// -----------------------------------------------------
+
+void DebugDraw::Point(const glm::vec3& position, const glm::vec3& color)
+{
+	Vertex vertex = { position, PackColor(color) };
+	Push(KindPoints, &vertex, 1);
+}
+
+void DebugDraw::Line(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color)
+{
+	uint32_t packed = PackColor(color);
+	Vertex line[2] = { { from, packed }, { to, packed } };
+	Push(KindLines, line, 2);
+}
+
+void DebugDraw::Polyline(const glm::vec3* points, size_t count, const glm::vec3& color, bool closed)
+{
+	if (!points || count < 2)
+		return;
+
+	uint32_t packed = PackColor(color);
+	size_t segments = closed ? count : count - 1;
+
+	Vertex lines[ChunkVertices];
+	size_t n = 0;
+	for (size_t i = 0; i < segments; ++i)
+	{
+		lines[n++] = { points[i], packed };
+		lines[n++] = { points[(i + 1) % count], packed };
+		if (n == ChunkVertices)
+		{
+			Push(KindLines, lines, n);
+			n = 0;
+		}
+	}
+	if (n > 0)
+		Push(KindLines, lines, n);
+}
+
+void DebugDraw::Circle(const glm::vec3& center, const glm::vec3& normal, float radius, const glm::vec3& color,
+	unsigned int segments)
+{
+	float length = glm::length(normal);
+	if (length <= 0.0f)
+		return;
+	segments = std::clamp(segments, 3u, MaxSegments);
+
+	// Orthonormal basis of the circle's plane
+	glm::vec3 n = normal / length;
+	glm::vec3 helper = std::abs(n.y) < 0.99f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+	glm::vec3 u = glm::normalize(glm::cross(helper, n)) * radius;
+	glm::vec3 v = glm::cross(n, u);
+
+	uint32_t packed = PackColor(color);
+	Vertex lines[MaxSegments * 2];
+	glm::vec3 previous = center + u;
+	for (unsigned int i = 1; i <= segments; ++i)
+	{
+		float angle = 6.28318530718f * static_cast<float>(i) / static_cast<float>(segments);
+		glm::vec3 current = center + u * std::cos(angle) + v * std::sin(angle);
+		lines[(i - 1) * 2] = { previous, packed };
+		lines[(i - 1) * 2 + 1] = { current, packed };
+		previous = current;
+	}
+	Push(KindLines, lines, segments * 2);
+}
+
+void DebugDraw::Sphere(const glm::vec3& center, float radius, const glm::vec3& color, unsigned int segments)
+{
+	Circle(center, glm::vec3(1.0f, 0.0f, 0.0f), radius, color, segments);
+	Circle(center, glm::vec3(0.0f, 1.0f, 0.0f), radius, color, segments);
+	Circle(center, glm::vec3(0.0f, 0.0f, 1.0f), radius, color, segments);
+}
+
+void DebugDraw::Box(const glm::vec3& min, const glm::vec3& max, const glm::vec3& color)
+{
+	glm::vec3 corners[8];
+	for (int i = 0; i < 8; ++i)
+		corners[i] = glm::vec3((i & 1) ? max.x : min.x, (i & 2) ? max.y : min.y, (i & 4) ? max.z : min.z);
+	PushBoxEdges(corners, PackColor(color));
+}
+
+void DebugDraw::Box(const glm::mat4& transform, const glm::vec3& color)
+{
+	glm::vec3 corners[8];
+	for (int i = 0; i < 8; ++i)
+	{
+		glm::vec4 local((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+		corners[i] = glm::vec3(transform * local);
+	}
+	PushBoxEdges(corners, PackColor(color));
+}
+
+void DebugDraw::Axes(const glm::mat4& transform, float size)
+{
+	glm::vec3 origin = glm::vec3(transform[3]);
+	Vertex lines[6] = {
+		{ origin, PackColor(glm::vec3(1.0f, 0.0f, 0.0f)) },
+		{ origin + glm::vec3(transform[0]) * size, PackColor(glm::vec3(1.0f, 0.0f, 0.0f)) },
+		{ origin, PackColor(glm::vec3(0.0f, 1.0f, 0.0f)) },
+		{ origin + glm::vec3(transform[1]) * size, PackColor(glm::vec3(0.0f, 1.0f, 0.0f)) },
+		{ origin, PackColor(glm::vec3(0.0f, 0.0f, 1.0f)) },
+		{ origin + glm::vec3(transform[2]) * size, PackColor(glm::vec3(0.0f, 0.0f, 1.0f)) },
+	};
+	Push(KindLines, lines, 6);
+}
+
+void DebugDraw::ViewFrustum(const glm::mat4& viewProjection, const glm::vec3& color)
+{
+	// Corners of the NDC cube taken back to world space
+	glm::mat4 inverse = glm::inverse(viewProjection);
+	glm::vec3 corners[8];
+	for (int i = 0; i < 8; ++i)
+	{
+		glm::vec4 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+		glm::vec4 world = inverse * ndc;
+		corners[i] = glm::vec3(world) / world.w;
+	}
+	PushBoxEdges(corners, PackColor(color));
+}
+
+// -----------------------------------------------------
+// Rendering
+// -----------------------------------------------------
+
+DebugDraw::DebugDraw()
+{
+	shader = std::make_unique<Shader>("Shader/debug.vert", "Shader/debug.frag");
+
+	// Same separate-format layout as the geometry pages; the buffer is rebound every frame
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
+	glVertexAttribFormat(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(Vertex, color));
+	glVertexAttribBinding(0, 0);
+	glVertexAttribBinding(1, 0);
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
+}
+
+DebugDraw::~DebugDraw()
+{
+	if (vao)
+		glDeleteVertexArrays(1, &vao);
+}
+
+void DebugDraw::Collect(StreamBuffer& streamBuffer)
+{
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	stats.points = 0;
+	stats.lineVertices = 0;
+	stats.threads = registry.threads.size();
+	buffer = 0;
+
+	// Pass 1: snapshot what each ring has published and fit it into the frame budget.
+	// Points come first in the batch, then lines; anything over budget is discarded.
+	size_t budget = MaxFrameVertices;
+	size_t counts[KindCount] = {};
+	for (int kind = 0; kind < KindCount; ++kind)
+	{
+		// Lines are taken in whole pairs, or every vertex after an odd cut would be mispaired
+		const size_t vertsPerPrimitive = kind == KindLines ? 2 : 1;
+		for (auto& thread : registry.threads)
+		{
+			Ring& ring = thread->rings[kind];
+			ring.snapshot = ring.head.load(std::memory_order_acquire);
+			size_t available = ring.snapshot - ring.tail.load(std::memory_order_relaxed);
+			ring.take = std::min(available, budget) / vertsPerPrimitive * vertsPerPrimitive;
+			budget -= ring.take;
+			counts[kind] += ring.take;
+			if (available > ring.take)
+				registry.dropped.fetch_add(available - ring.take, std::memory_order_relaxed);
+		}
+	}
+
+	size_t total = counts[KindPoints] + counts[KindLines];
+	Vertex* out = nullptr;
+	if (total > 0)
+	{
+		StreamBuffer::Allocation alloc = streamBuffer.Allocate(total * sizeof(Vertex), sizeof(Vertex));
+		if (alloc.IsValid())
+		{
+			out = static_cast<Vertex*>(alloc.data);
+			buffer = alloc.buffer;
+			offset = alloc.offset;
+			stats.points = counts[KindPoints];
+			stats.lineVertices = counts[KindLines];
+		}
+		else
+		{
+			// No stream space this frame: the rings are still drained below, so count what they held
+			registry.dropped.fetch_add(total, std::memory_order_relaxed);
+		}
+	}
+
+	// Pass 2: copy into the mapping (sequential writes) and release the ring space
+	for (int kind = 0; kind < KindCount; ++kind)
+	{
+		for (auto& thread : registry.threads)
+		{
+			Ring& ring = thread->rings[kind];
+			if (out && ring.take > 0)
+			{
+				CopyOut(ring, ring.tail.load(std::memory_order_relaxed), ring.take, out);
+				out += ring.take;
+			}
+			ring.tail.store(ring.snapshot, std::memory_order_release);
+		}
+	}
+
+	size_t dropped = registry.dropped.load(std::memory_order_relaxed);
+	if (dropped > 0 && stats.dropped == 0)
+		std::cerr << "[DebugDraw] Buffers full, dropping debug geometry\n";
+	stats.dropped = dropped;
+}
+
+void DebugDraw::Render() const
+{
+	if (!buffer || (stats.points == 0 && stats.lineVertices == 0))
+		return;
+
+	shader->Bind();
+	glBindVertexArray(vao);
+	glBindVertexBuffer(0, buffer, static_cast<GLintptr>(offset), sizeof(Vertex));
+
+	// One draw per primitive type, covering every thread's submissions
+	if (stats.points > 0)
+	{
+		glPointSize(4.0f);
+		glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(stats.points));
+	}
+	if (stats.lineVertices > 0)
+		glDrawArrays(GL_LINES, static_cast<GLint>(stats.points), static_cast<GLsizei>(stats.lineVertices));
+
+	glBindVertexArray(0);
+	shader->Unbind();
+}
+
+#endif // CELESTIAL_DEBUG_DRAW
@@ -0,0 +1,220 @@
+/**
+ * @file DomeTarget.cpp
+ * @brief Cube face setup, fisheye warp and dome-master readback.
+ */
+#include <Renderer/DomeTarget.h>
+#include <Renderer/Shader.h>
+#include <glad/glad.h>
+#include <FreeImage.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+	// GL cubemap face order (+X, -X, +Y, -Y, +Z, -Z), same convention as SkyCache
+	const glm::vec3 FaceDirections[6] = {
+		{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+		{ 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+	};
+	const glm::vec3 FaceUps[6] = {
+		{ 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+		{ 0.0f, 0.0f, -1.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }
+	};
+
+	// Smallest angle between the forward axis (-Z) and any direction on a face
+	float FaceMinAngle(int face)
+	{
+		if (face == 5) return 0.0f;		// Forward face contains the axis
+		if (face == 4)					// Back face comes closest at its corners: 180 - acos(1/sqrt(3)) ~ 125.26
+			return 180.0f - glm::degrees(std::acos(1.0f / std::sqrt(3.0f)));
+		return 45.0f;					// Side faces start halfway along the forward face's edge
+	}
+}
+
+DomeTarget::DomeTarget()
+	: DomeTarget(Settings())
+{
+}
+
+DomeTarget::DomeTarget(const Settings& newSettings)
+	: settings(newSettings)
+{
+	settings.fieldOfView = std::clamp(settings.fieldOfView, 1.0f, 360.0f);
+
+	// Faces entirely outside the dome are never rendered
+	for (int face = 0; face < 6; ++face)
+		if (FaceMinAngle(face) < settings.fieldOfView * 0.5f)
+			activeFaces[activeFaceCount++] = face;
+
+	warpShader = std::make_unique<Shader>("Shader/dome.vert", "Shader/dome.frag");
+
+	glGenTextures(1, &colorCubemap);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, colorCubemap);
+	glTexStorage2D(GL_TEXTURE_CUBE_MAP, 1, GL_RGBA8, settings.faceSize, settings.faceSize);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+	glGenTextures(1, &depthCubemap);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, depthCubemap);
+	glTexStorage2D(GL_TEXTURE_CUBE_MAP, 1, GL_DEPTH_COMPONENT32F, settings.faceSize, settings.faceSize);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+	glGenTextures(1, &outputTexture);
+	glBindTexture(GL_TEXTURE_2D, outputTexture);
+	glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, settings.outputSize, settings.outputSize);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	// Layered: every face attached, the shader picks one per primitive with gl_Layer
+	glGenFramebuffers(1, &layeredFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, layeredFramebuffer);
+	glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, colorCubemap, 0);
+	glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthCubemap, 0);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+	// Per face: overlays, and the fallback without multi-view
+	glGenFramebuffers(6, faceFramebuffers);
+	for (int face = 0; face < 6 && status == GL_FRAMEBUFFER_COMPLETE; ++face)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, faceFramebuffers[face]);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, colorCubemap, 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, depthCubemap, 0);
+		status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	}
+
+	glGenFramebuffers(1, &outputFramebuffer);
+	if (status == GL_FRAMEBUFFER_COMPLETE)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, outputFramebuffer);
+		glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, outputTexture, 0);
+		status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	glGenVertexArrays(1, &warpVao);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		glDeleteVertexArrays(1, &warpVao);
+		glDeleteFramebuffers(1, &outputFramebuffer);
+		glDeleteFramebuffers(6, faceFramebuffers);
+		glDeleteFramebuffers(1, &layeredFramebuffer);
+		glDeleteTextures(1, &outputTexture);
+		glDeleteTextures(1, &depthCubemap);
+		glDeleteTextures(1, &colorCubemap);
+		throw std::runtime_error("DomeTarget: incomplete framebuffer (status " + std::to_string(status) + ")");
+	}
+
+	GpuResourceRegistry& registry = GpuResourceRegistry::Get();
+	size_t cubeTexels = size_t(settings.faceSize) * size_t(settings.faceSize) * 6;
+	records[0] = registry.Register(GpuResourceRegistry::Category::RenderTarget, colorCubemap,
+		cubeTexels * GpuResourceRegistry::BytesPerTexel(GL_RGBA8), GL_RGBA8, "DomeTarget color cubemap");
+	records[1] = registry.Register(GpuResourceRegistry::Category::RenderTarget, depthCubemap,
+		cubeTexels * GpuResourceRegistry::BytesPerTexel(GL_DEPTH_COMPONENT32F), GL_DEPTH_COMPONENT32F, "DomeTarget depth cubemap");
+	records[2] = registry.Register(GpuResourceRegistry::Category::RenderTarget, outputTexture,
+		size_t(settings.outputSize) * size_t(settings.outputSize) * GpuResourceRegistry::BytesPerTexel(GL_RGBA8), GL_RGBA8,
+		"DomeTarget dome master");
+
+	std::cout << "[DomeTarget] " << settings.outputSize << "^2 dome master, " << settings.fieldOfView
+		<< " deg equidistant, " << activeFaceCount << " of 6 faces at " << settings.faceSize << "^2\n";
+}
+
+DomeTarget::~DomeTarget()
+{
+	for (GpuResourceRegistry::Handle& record : records)
+		GpuResourceRegistry::Get().Unregister(record);
+	glDeleteVertexArrays(1, &warpVao);
+	glDeleteFramebuffers(1, &outputFramebuffer);
+	glDeleteFramebuffers(6, faceFramebuffers);
+	glDeleteFramebuffers(1, &layeredFramebuffer);
+	glDeleteTextures(1, &outputTexture);
+	glDeleteTextures(1, &depthCubemap);
+	glDeleteTextures(1, &colorCubemap);
+}
+
+glm::mat4 DomeTarget::GetFaceView(int face, const glm::mat4& cameraView)
+{
+	// The cube lives in the camera's view space, so its -Z face looks forward
+	return glm::lookAt(glm::vec3(0.0f), FaceDirections[face], FaceUps[face]) * cameraView;
+}
+
+glm::mat4 DomeTarget::GetFaceProjection(float nearPlane, float farPlane)
+{
+	return glm::perspective(glm::radians(90.0f), 1.0f, nearPlane, farPlane);
+}
+
+void DomeTarget::Resolve() const
+{
+	for (GpuResourceRegistry::Handle record : records)
+		GpuResourceRegistry::Get().Touch(record);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, outputFramebuffer);
+	glViewport(0, 0, settings.outputSize, settings.outputSize);
+
+	// Every pixel is written (black outside the circle), so no clear is needed
+	glDisable(GL_DEPTH_TEST);
+
+	warpShader->Bind();
+	warpShader->SetInt("uFaces", 0);
+	warpShader->SetFloat("uHalfFieldOfView", glm::radians(settings.fieldOfView) * 0.5f);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, colorCubemap);
+	glBindVertexArray(warpVao);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	warpShader->Unbind();
+
+	glEnable(GL_DEPTH_TEST);
+}
+
+void DomeTarget::Present(unsigned int framebuffer, const glm::ivec4& viewport) const
+{
+	// Largest centred square inside the viewport
+	int size = std::min(viewport.z, viewport.w);
+	int x = viewport.x + (viewport.z - size) / 2;
+	int y = viewport.y + (viewport.w - size) / 2;
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, outputFramebuffer);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+	glBlitFramebuffer(0, 0, settings.outputSize, settings.outputSize, x, y, x + size, y + size,
+		GL_COLOR_BUFFER_BIT, GL_LINEAR);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
+
+bool DomeTarget::SaveImage(const std::string& path) const
+{
+	FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename(path.c_str());
+	if (format == FIF_UNKNOWN)
+		format = FIF_PNG;
+
+	// GL and FreeImage both store rows bottom-up; BGRA matches FreeImage's 32-bit layout
+	FIBITMAP* bitmap = FreeImage_Allocate(settings.outputSize, settings.outputSize, 32);
+	if (!bitmap)
+	{
+		std::cerr << "[DomeTarget] Failed to allocate " << settings.outputSize << "^2 image\n";
+		return false;
+	}
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, outputFramebuffer);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, settings.outputSize, settings.outputSize, GL_BGRA, GL_UNSIGNED_BYTE, FreeImage_GetBits(bitmap));
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+	bool saved = FreeImage_Save(format, bitmap, path.c_str()) != 0;
+	FreeImage_Unload(bitmap);
+
+	if (saved)
+		std::cout << "[DomeTarget] Saved dome master to " << path << "\n";
+	else
+		std::cerr << "[DomeTarget] Failed to save dome master to " << path << "\n";
+	return saved;
+}
@@ -0,0 +1,314 @@
+/**
+ * @file GeometryPool.cpp
+ * @brief Implementation of the paged mesh suballocator.
+ *
+ * Vertex layout is declared once per page VAO with the separate attribute
+ * format API (GL 4.3), so a page's vertex buffer can be swapped during
+ * defragmentation with a single glBindVertexBuffer.
+ */
+#include <Renderer/GeometryPool.h>
+#include <Renderer/Mesh.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+GeometryPool* GeometryPool::instance = nullptr;
+
+GeometryPool& GeometryPool::Get()
+{
+	if (!instance)
+		instance = new GeometryPool();
+	return *instance;
+}
+
+void GeometryPool::Shutdown()
+{
+	delete instance;
+	instance = nullptr;
+}
+
+GeometryPool::~GeometryPool()
+{
+	for (auto& page : pages)
+	{
+		GpuResourceRegistry::Get().Unregister(page->vertexRecord);
+		GpuResourceRegistry::Get().Unregister(page->indexRecord);
+		glDeleteVertexArrays(1, &page->vao);
+		glDeleteBuffers(1, &page->vbo);
+		glDeleteBuffers(1, &page->ebo);
+	}
+}
+
+void GeometryPool::CreateBuffers(Page& page, unsigned int& vbo, unsigned int& ebo) const
+{
+	// Immutable storage; DYNAMIC_STORAGE allows glBufferSubData for uploads
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(page.vertexCapacity) * sizeof(Vertex),
+		nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+	glGenBuffers(1, &ebo);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(page.indexCapacity) * sizeof(unsigned int),
+		nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GeometryPool::BindPageBuffers(const Page& page) const
+{
+	glBindVertexArray(page.vao);
+	glBindVertexBuffer(0, page.vbo, 0, sizeof(Vertex));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, page.ebo);
+	glBindVertexArray(0);
+}
+
+GeometryPool::Page& GeometryPool::CreatePage(uint32_t minVertices, uint32_t minIndices)
+{
+	auto page = std::make_unique<Page>(std::max(minVertices, DefaultPageVertices),
+		std::max(minIndices, DefaultPageIndices));
+
+	CreateBuffers(*page, page->vbo, page->ebo);
+
+	glGenVertexArrays(1, &page->vao);
+	glBindVertexArray(page->vao);
+
+	// Vertex layout (all attributes read from binding 0):
+	// 0 -> position(vec3), 1 -> normal (vec3), 2 -> color (vec3), 3 -> texCoord (vec2), 4 -> tangent (vec3)
+	glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
+	glVertexAttribFormat(1, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, normal));
+	glVertexAttribFormat(2, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, color));
+	glVertexAttribFormat(3, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, texCoord));
+	glVertexAttribFormat(4, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, tangent));
+	for (unsigned int attrib = 0; attrib < 5; ++attrib)
+	{
+		glVertexAttribBinding(attrib, 0);
+		glEnableVertexAttribArray(attrib);
+	}
+	glBindVertexArray(0);
+
+	BindPageBuffers(*page);
+
+	std::string owner = "GeometryPool page " + std::to_string(pages.size());
+	page->vertexRecord = GpuResourceRegistry::Get().Register(GpuResourceRegistry::Category::Buffer, page->vbo,
+		size_t(page->vertexCapacity) * sizeof(Vertex), 0, owner + " vertices");
+	page->indexRecord = GpuResourceRegistry::Get().Register(GpuResourceRegistry::Category::Buffer, page->ebo,
+		size_t(page->indexCapacity) * sizeof(unsigned int), 0, owner + " indices");
+
+	std::cout << "[GeometryPool] Page " << pages.size() << " created ("
+		<< page->vertexCapacity << " vertices, " << page->indexCapacity << " indices)\n";
+
+	pages.push_back(std::move(page));
+	return *pages.back();
+}
+
+GeometryPool::Handle GeometryPool::Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	if (vertices.empty() || indices.empty())
+		return InvalidHandle;
+
+	uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+	uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+	Entry entry;
+	entry.vertexCount = vertexCount;
+	entry.indexCount = indexCount;
+
+	// First page with room for both ranges
+	Page* target = nullptr;
+	for (uint32_t i = 0; i < pages.size() && !target; ++i)
+	{
+		Page& page = *pages[i];
+		entry.vertexAlloc = page.vertexAllocator.Allocate(vertexCount);
+		if (!entry.vertexAlloc.IsValid())
+			continue;
+
+		entry.indexAlloc = page.indexAllocator.Allocate(indexCount);
+		if (!entry.indexAlloc.IsValid())
+		{
+			page.vertexAllocator.Free(entry.vertexAlloc);
+			continue;
+		}
+
+		entry.page = i;
+		target = &page;
+	}
+
+	if (!target)
+	{
+		entry.page = static_cast<uint32_t>(pages.size());
+		target = &CreatePage(vertexCount, indexCount);
+		entry.vertexAlloc = target->vertexAllocator.Allocate(vertexCount);
+		entry.indexAlloc = target->indexAllocator.Allocate(indexCount);
+	}
+
+	// Upload into the reserved ranges
+	glBindBuffer(GL_COPY_WRITE_BUFFER, target->vbo);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(entry.vertexAlloc.offset) * sizeof(Vertex),
+		static_cast<GLsizeiptr>(vertexCount) * sizeof(Vertex), vertices.data());
+	glBindBuffer(GL_COPY_WRITE_BUFFER, target->ebo);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(entry.indexAlloc.offset) * sizeof(unsigned int),
+		static_cast<GLsizeiptr>(indexCount) * sizeof(unsigned int), indices.data());
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	target->liveAllocations++;
+	entry.live = true;
+
+	Handle handle;
+	if (!freeEntries.empty())
+	{
+		handle = freeEntries.back();
+		freeEntries.pop_back();
+		entries[handle] = entry;
+	}
+	else
+	{
+		handle = static_cast<Handle>(entries.size());
+		entries.push_back(entry);
+	}
+	return handle;
+}
+
+void GeometryPool::Free(Handle handle)
+{
+	if (handle >= entries.size() || !entries[handle].live)
+		return;
+
+	Entry& entry = entries[handle];
+	Page& page = *pages[entry.page];
+	page.vertexAllocator.Free(entry.vertexAlloc);
+	page.indexAllocator.Free(entry.indexAlloc);
+	page.liveAllocations--;
+	page.needsFragmentationCheck = true;
+
+	entry = Entry{};
+	freeEntries.push_back(handle);
+}
+
+GeometryView GeometryPool::GetView(Handle handle) const
+{
+	GeometryView view;
+	if (handle >= entries.size() || !entries[handle].live)
+		return view;
+
+	const Entry& entry = entries[handle];
+	const Page& page = *pages[entry.page];
+	GpuResourceRegistry::Get().Touch(page.vertexRecord);	// Views are fetched by the renderer for each draw
+	GpuResourceRegistry::Get().Touch(page.indexRecord);
+	view.vao = page.vao;
+	view.firstIndex = entry.indexAlloc.offset;
+	view.indexCount = entry.indexCount;
+	view.baseVertex = static_cast<int>(entry.vertexAlloc.offset);
+	view.page = entry.page;
+	return view;
+}
+
+bool GeometryPool::DefragmentIfNeeded(float threshold)
+{
+	for (uint32_t i = 0; i < pages.size(); ++i)
+	{
+		Page& page = *pages[i];
+		if (!page.needsFragmentationCheck)
+			continue;
+		page.needsFragmentationCheck = false;
+
+		if (page.liveAllocations == 0)
+			continue;
+
+		auto Fragmentation = [](const OffsetAllocator& allocator) {
+			OffsetAllocator::StorageReport report = allocator.GetStorageReport();
+			if (report.totalFreeSpace == 0)
+				return 0.0f;
+			return 1.0f - static_cast<float>(report.largestFreeRegion) / static_cast<float>(report.totalFreeSpace);
+		};
+
+		if (Fragmentation(page.vertexAllocator) > threshold || Fragmentation(page.indexAllocator) > threshold)
+		{
+			Defragment(i);
+			return true;	// At most one page per call to bound the per-frame cost
+		}
+	}
+	return false;
+}
+
+void GeometryPool::Defragment(uint32_t pageIndex)
+{
+	if (pageIndex >= pages.size())
+		return;
+
+	Page& page = *pages[pageIndex];
+
+	// Live entries of this page, in their current vertex order
+	std::vector<Handle> live;
+	for (Handle h = 0; h < entries.size(); ++h)
+		if (entries[h].live && entries[h].page == pageIndex)
+			live.push_back(h);
+	std::sort(live.begin(), live.end(), [this](Handle a, Handle b) {
+		return entries[a].vertexAlloc.offset < entries[b].vertexAlloc.offset;
+	});
+
+	unsigned int newVbo = 0, newEbo = 0;
+	CreateBuffers(page, newVbo, newEbo);
+
+	// Re-allocating in order from an empty allocator packs everything at the front
+	page.vertexAllocator.Reset();
+	page.indexAllocator.Reset();
+
+	for (Handle h : live)
+	{
+		Entry& entry = entries[h];
+		OffsetAllocator::Allocation newVertices = page.vertexAllocator.Allocate(entry.vertexCount);
+		OffsetAllocator::Allocation newIndices = page.indexAllocator.Allocate(entry.indexCount);
+
+		// GPU-side copies, queued behind any pending draws reading the old buffers
+		glBindBuffer(GL_COPY_READ_BUFFER, page.vbo);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, newVbo);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+			static_cast<GLintptr>(entry.vertexAlloc.offset) * sizeof(Vertex),
+			static_cast<GLintptr>(newVertices.offset) * sizeof(Vertex),
+			static_cast<GLsizeiptr>(entry.vertexCount) * sizeof(Vertex));
+
+		glBindBuffer(GL_COPY_READ_BUFFER, page.ebo);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, newEbo);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+			static_cast<GLintptr>(entry.indexAlloc.offset) * sizeof(unsigned int),
+			static_cast<GLintptr>(newIndices.offset) * sizeof(unsigned int),
+			static_cast<GLsizeiptr>(entry.indexCount) * sizeof(unsigned int));
+
+		entry.vertexAlloc = newVertices;
+		entry.indexAlloc = newIndices;
+	}
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	// GL defers the actual deletion until in-flight commands are done with them
+	glDeleteBuffers(1, &page.vbo);
+	glDeleteBuffers(1, &page.ebo);
+	page.vbo = newVbo;
+	page.ebo = newEbo;
+	BindPageBuffers(page);
+	GpuResourceRegistry::Get().Resize(page.vertexRecord, newVbo, size_t(page.vertexCapacity) * sizeof(Vertex));
+	GpuResourceRegistry::Get().Resize(page.indexRecord, newEbo, size_t(page.indexCapacity) * sizeof(unsigned int));
+
+	defragmentations++;
+	std::cout << "[GeometryPool] Defragmented page " << pageIndex << " (" << live.size() << " meshes)\n";
+}
+
+GeometryPool::Stats GeometryPool::GetStats() const
+{
+	Stats stats;
+	stats.pages = pages.size();
+	stats.defragmentations = defragmentations;
+	for (const auto& page : pages)
+		stats.capacityBytes += static_cast<size_t>(page->vertexCapacity) * sizeof(Vertex)
+			+ static_cast<size_t>(page->indexCapacity) * sizeof(unsigned int);
+	for (const Entry& entry : entries)
+	{
+		if (!entry.live) continue;
+		stats.allocations++;
+		stats.usedBytes += static_cast<size_t>(entry.vertexCount) * sizeof(Vertex)
+			+ static_cast<size_t>(entry.indexCount) * sizeof(unsigned int);
+	}
+	return stats;
+}
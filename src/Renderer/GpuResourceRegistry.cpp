@@ -0,0 +1,256 @@
+/**
+ * @file GpuResourceRegistry.cpp
+ * @brief GPU resource records, per-category totals and the vendor video memory queries.
+ */
+#include <Renderer/GpuResourceRegistry.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// Vendor query tokens, not part of the core profile loader
+#ifndef GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX
+#define GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX 0x9047
+#define GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX 0x9049
+#define GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX 0x904A
+#define GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX 0x904B
+#endif
+#ifndef GL_TEXTURE_FREE_MEMORY_ATI
+#define GL_TEXTURE_FREE_MEMORY_ATI 0x87FC
+#endif
+
+namespace
+{
+	bool HasExtension(const char* name)
+	{
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; ++i)
+		{
+			const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+			if (extension && std::strcmp(extension, name) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	// Both extensions report kilobytes
+	size_t Kilobytes(GLint value)
+	{
+		return value > 0 ? static_cast<size_t>(value) * 1024 : 0;
+	}
+
+	double Megabytes(size_t bytes)
+	{
+		return static_cast<double>(bytes) / (1024.0 * 1024.0);
+	}
+}
+
+GpuResourceRegistry& GpuResourceRegistry::Get()
+{
+	static GpuResourceRegistry registry;
+	return registry;
+}
+
+void GpuResourceRegistry::Initialize()
+{
+	if (HasExtension("GL_NVX_gpu_memory_info"))
+		driverQuery = DriverQuery::Nvx;
+	else if (HasExtension("GL_ATI_meminfo"))
+		driverQuery = DriverQuery::Ati;
+
+	SampleDriverMemory();
+	DriverMemory memory = GetDriverMemory();
+	if (driverQuery == DriverQuery::None)
+		std::cout << "[GpuResourceRegistry] No video memory query extension, reporting engine allocations only\n";
+	else
+		std::cout << "[GpuResourceRegistry] Video memory via " << memory.source << ": "
+			<< Megabytes(memory.availableBytes) << " MB available"
+			<< (memory.dedicatedBytes ? " of " + std::to_string(memory.dedicatedBytes / (1024 * 1024)) + " MB dedicated" : std::string())
+			<< "\n";
+}
+
+GpuResourceRegistry::Handle GpuResourceRegistry::Register(Category category, unsigned int glName, size_t bytes,
+	unsigned int internalFormat, std::string owner)
+{
+	Handle handle;
+	if (!freeHandles.empty())
+	{
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	else
+	{
+		slots.emplace_back();
+		handle = static_cast<Handle>(slots.size());
+	}
+
+	Resource& resource = slots[handle - 1];
+	resource.handle = handle;
+	resource.category = category;
+	resource.glName = glName;
+	resource.bytes = bytes;
+	resource.internalFormat = internalFormat;
+	resource.owner = std::move(owner);
+	resource.lastUsedFrame = frameIndex;
+
+	categoryBytes[static_cast<size_t>(category)].fetch_add(bytes, std::memory_order_relaxed);
+	categoryCounts[static_cast<size_t>(category)].fetch_add(1, std::memory_order_relaxed);
+	return handle;
+}
+
+void GpuResourceRegistry::Unregister(Handle& handle)
+{
+	if (handle == InvalidHandle)
+		return;
+
+	Resource& resource = slots[handle - 1];
+	categoryBytes[static_cast<size_t>(resource.category)].fetch_sub(resource.bytes, std::memory_order_relaxed);
+	categoryCounts[static_cast<size_t>(resource.category)].fetch_sub(1, std::memory_order_relaxed);
+	resource = Resource{};
+	freeHandles.push_back(handle);
+	handle = InvalidHandle;
+}
+
+void GpuResourceRegistry::Resize(Handle handle, unsigned int glName, size_t bytes)
+{
+	if (handle == InvalidHandle)
+		return;
+
+	Resource& resource = slots[handle - 1];
+	std::atomic<size_t>& total = categoryBytes[static_cast<size_t>(resource.category)];
+	total.fetch_sub(resource.bytes, std::memory_order_relaxed);
+	total.fetch_add(bytes, std::memory_order_relaxed);
+	resource.glName = glName;
+	resource.bytes = bytes;
+	resource.lastUsedFrame = frameIndex;
+}
+
+void GpuResourceRegistry::BeginFrame()
+{
+	frameIndex++;
+	if (driverQuery != DriverQuery::None && frameIndex % DriverQueryInterval == 0)
+		SampleDriverMemory();
+}
+
+void GpuResourceRegistry::SampleDriverMemory()
+{
+	if (driverQuery == DriverQuery::Nvx)
+	{
+		GLint dedicated = 0, available = 0, evictionCount = 0, evicted = 0;
+		glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &dedicated);
+		glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &available);
+		glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTION_COUNT_NVX, &evictionCount);
+		glGetIntegerv(GL_GPU_MEMORY_INFO_EVICTED_MEMORY_NVX, &evicted);
+		driverDedicatedBytes.store(Kilobytes(dedicated), std::memory_order_relaxed);
+		driverAvailableBytes.store(Kilobytes(available), std::memory_order_relaxed);
+		driverEvictedBytes.store(Kilobytes(evicted), std::memory_order_relaxed);
+		driverEvictionCount.store(evictionCount > 0 ? static_cast<std::uint64_t>(evictionCount) : 0, std::memory_order_relaxed);
+	}
+	else if (driverQuery == DriverQuery::Ati)
+	{
+		// Total free, largest free block, total auxiliary free, largest auxiliary block
+		GLint textureFree[4] = {};
+		glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, textureFree);
+		driverAvailableBytes.store(Kilobytes(textureFree[0]), std::memory_order_relaxed);
+	}
+}
+
+size_t GpuResourceRegistry::GetTotalBytes() const
+{
+	size_t total = 0;
+	for (const std::atomic<size_t>& bytes : categoryBytes)
+		total += bytes.load(std::memory_order_relaxed);
+	return total;
+}
+
+GpuResourceRegistry::DriverMemory GpuResourceRegistry::GetDriverMemory() const
+{
+	DriverMemory memory;
+	memory.source = driverQuery == DriverQuery::Nvx ? "NVX_gpu_memory_info"
+		: driverQuery == DriverQuery::Ati ? "ATI_meminfo" : "none";
+	memory.dedicatedBytes = driverDedicatedBytes.load(std::memory_order_relaxed);
+	memory.availableBytes = driverAvailableBytes.load(std::memory_order_relaxed);
+	memory.evictedBytes = driverEvictedBytes.load(std::memory_order_relaxed);
+	memory.evictionCount = driverEvictionCount.load(std::memory_order_relaxed);
+	return memory;
+}
+
+std::vector<GpuResourceRegistry::Resource> GpuResourceRegistry::GetResources() const
+{
+	std::vector<Resource> resources;
+	for (const Resource& resource : slots)
+		if (resource.handle != InvalidHandle)
+			resources.push_back(resource);
+	std::sort(resources.begin(), resources.end(),
+		[](const Resource& a, const Resource& b) { return a.bytes > b.bytes; });
+	return resources;
+}
+
+void GpuResourceRegistry::PrintReport(size_t largest) const
+{
+	std::cout << "[GpuResourceRegistry] " << Megabytes(GetTotalBytes()) << " MB in use:";
+	for (size_t category = 0; category < static_cast<size_t>(Category::Count); ++category)
+		std::cout << " " << GetCategoryName(static_cast<Category>(category)) << " "
+			<< Megabytes(categoryBytes[category].load(std::memory_order_relaxed)) << " MB ("
+			<< categoryCounts[category].load(std::memory_order_relaxed) << ")";
+	std::cout << "\n";
+
+	DriverMemory memory = GetDriverMemory();
+	if (driverQuery != DriverQuery::None)
+	{
+		std::cout << "[GpuResourceRegistry] Driver (" << memory.source << "): " << Megabytes(memory.availableBytes) << " MB available";
+		if (driverQuery == DriverQuery::Nvx)
+			std::cout << " of " << Megabytes(memory.dedicatedBytes) << " MB, " << memory.evictionCount << " evictions ("
+				<< Megabytes(memory.evictedBytes) << " MB)";
+		std::cout << "\n";
+	}
+
+	std::vector<Resource> resources = GetResources();
+	for (size_t i = 0; i < std::min(largest, resources.size()); ++i)
+	{
+		const Resource& resource = resources[i];
+		std::cout << "[GpuResourceRegistry]   " << Megabytes(resource.bytes) << " MB " << GetCategoryName(resource.category)
+			<< " " << resource.owner;
+		if (resource.internalFormat)
+			std::cout << " (" << GetFormatName(resource.internalFormat) << ")";
+		std::cout << ", last used " << frameIndex - resource.lastUsedFrame << " frames ago\n";
+	}
+}
+
+const char* GpuResourceRegistry::GetCategoryName(Category category)
+{
+	switch (category)
+	{
+	case Category::Buffer: return "Buffer";
+	case Category::Texture: return "Texture";
+	case Category::RenderTarget: return "RenderTarget";
+	default: return "Unknown";
+	}
+}
+
+const char* GpuResourceRegistry::GetFormatName(unsigned int internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_RGBA: return "RGBA";
+	case GL_RGBA8: return "RGBA8";
+	case GL_R8: return "R8";
+	case GL_R11F_G11F_B10F: return "R11F_G11F_B10F";
+	case GL_DEPTH_COMPONENT32F: return "DEPTH32F";
+	default: return "other";
+	}
+}
+
+size_t GpuResourceRegistry::BytesPerTexel(unsigned int internalFormat)
+{
+	switch (internalFormat)
+	{
+	case GL_R8: return 1;
+	case GL_RGBA:
+	case GL_RGBA8:
+	case GL_R11F_G11F_B10F:
+	case GL_DEPTH_COMPONENT32F: return 4;
+	default: return 4;
+	}
+}
@@ -0,0 +1,142 @@
+/**
+ * @file LabelRenderer.cpp
+ * @brief Glyph instance generation and the single instanced label draw.
+ */
+#include <Renderer/LabelRenderer.h>
+#include <Renderer/Shader.h>
+#include <Renderer/StreamBuffer.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+	// Per-instance record read by label.vert (32 bytes)
+	struct GlyphInstance
+	{
+		float rect[4];		// x, y, width, height in viewport pixels (y up)
+		uint16_t uv[4];		// u0, v0, u1, v1, normalized
+		uint32_t color;		// RGBA8
+		uint32_t padding;
+	};
+	static_assert(sizeof(GlyphInstance) == 32, "GlyphInstance must match the label VAO layout");
+
+	uint16_t PackUnorm16(float value)
+	{
+		return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	uint32_t PackColor(const glm::vec3& color)
+	{
+		auto Channel = [](float value) {
+			return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		};
+		return Channel(color.x) | (Channel(color.y) << 8) | (Channel(color.z) << 16) | (255u << 24);
+	}
+}
+
+LabelRenderer::LabelRenderer()
+{
+	font.Upload();
+	shader = std::make_unique<Shader>("Shader/label.vert", "Shader/label.frag");
+
+	// Instanced attributes only: binding 0 advances once per instance
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+	glVertexAttribFormat(0, 4, GL_FLOAT, GL_FALSE, offsetof(GlyphInstance, rect));
+	glVertexAttribFormat(1, 4, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(GlyphInstance, uv));
+	glVertexAttribFormat(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(GlyphInstance, color));
+	for (unsigned int attrib = 0; attrib < 3; ++attrib)
+	{
+		glVertexAttribBinding(attrib, 0);
+		glEnableVertexAttribArray(attrib);
+	}
+	glVertexBindingDivisor(0, 1);
+	glBindVertexArray(0);
+}
+
+LabelRenderer::~LabelRenderer()
+{
+	if (vao)
+		glDeleteVertexArrays(1, &vao);
+}
+
+void LabelRenderer::Render(const std::vector<LabelCandidate>& labels, const glm::mat4& viewProjection,
+	const glm::vec2& viewportSize, StreamBuffer& streamBuffer)
+{
+	glyphsDrawn = 0;
+	if (labels.empty())
+		return;
+
+	const std::vector<PlacedLabel>& placed = layout.Run(labels, viewProjection, viewportSize, font);
+	if (placed.empty())
+		return;
+
+	// Count first so the instances go out in one allocation
+	size_t glyphCount = 0;
+	for (const PlacedLabel& label : placed)
+		for (char c : labels[label.candidate].text)
+			glyphCount += font.GetGlyph(c).visible ? 1 : 0;
+	glyphCount = std::min(glyphCount, MaxGlyphs);
+	if (glyphCount == 0)
+		return;
+
+	StreamBuffer::Allocation alloc = streamBuffer.Allocate(glyphCount * sizeof(GlyphInstance), sizeof(GlyphInstance));
+	if (!alloc.IsValid())
+		return;
+
+	// Highest priority labels first, so the cap cuts the least important ones
+	GlyphInstance* out = static_cast<GlyphInstance*>(alloc.data);
+	float pixelSize = layout.GetSettings().pixelSize;
+	size_t written = 0;
+	for (const PlacedLabel& label : placed)
+	{
+		const LabelCandidate& candidate = labels[label.candidate];
+		uint32_t color = PackColor(candidate.color);
+		glm::vec2 pen = label.origin;
+
+		for (char c : candidate.text)
+		{
+			const SdfGlyph& glyph = font.GetGlyph(c);
+			if (glyph.visible && written < glyphCount)
+			{
+				GlyphInstance instance;
+				instance.rect[0] = pen.x + glyph.offset.x * pixelSize;
+				instance.rect[1] = pen.y + glyph.offset.y * pixelSize;
+				instance.rect[2] = glyph.size.x * pixelSize;
+				instance.rect[3] = glyph.size.y * pixelSize;
+				instance.uv[0] = PackUnorm16(glyph.uvMin.x);
+				instance.uv[1] = PackUnorm16(glyph.uvMin.y);
+				instance.uv[2] = PackUnorm16(glyph.uvMax.x);
+				instance.uv[3] = PackUnorm16(glyph.uvMax.y);
+				instance.color = color;
+				instance.padding = 0;
+				std::memcpy(out + written, &instance, sizeof(instance));
+				written++;
+			}
+			pen.x += glyph.advance * pixelSize;
+		}
+	}
+
+	// Overlay state: labels ignore depth and blend over the scene
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	shader->Bind();
+	shader->SetVec2("uViewportSize", viewportSize);
+	shader->SetInt("uAtlas", 0);
+	font.Bind(0);
+
+	glBindVertexArray(vao);
+	glBindVertexBuffer(0, alloc.buffer, static_cast<GLintptr>(alloc.offset), sizeof(GlyphInstance));
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(written));
+	glBindVertexArray(0);
+
+	shader->Unbind();
+	glDisable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+
+	glyphsDrawn = written;
+}
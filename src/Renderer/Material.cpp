@@ -6,26 +6,32 @@ Material::Material() { }
 void Material::SetProperties(const MaterialProperties& props)
 {
 	properties = props;
+	dirty = true;
 }
 
 void Material::SetAmbientColor(const glm::vec3& color) {
     properties.ambient = color;
+    dirty = true;
 }
 
 void Material::SetDiffuseColor(const glm::vec3& color) {
     properties.diffuse = color;
+    dirty = true;
 }
 
 void Material::SetSpecularColor(const glm::vec3& color) {
     properties.specular = color;
+    dirty = true;
 }
 
 void Material::SetShininess(float shine) {
     properties.shininess = shine;
+    dirty = true;
 }
 
 void Material::SetEmissiveColor(const glm::vec3& color) {
     properties.emissive = color;
+    dirty = true;
 }
 
 void Material::SetTexture(Render::TextureType type, Texture* texture)
@@ -38,6 +44,7 @@ void Material::SetTexture(Render::TextureType type, Texture* texture)
     {
         textures.erase(type);
     }
+    dirty = true;   // texture presence flags are part of the GPU record
 }
 
 bool Material::HasTexture(Render::TextureType type) const {
@@ -46,35 +53,17 @@ bool Material::HasTexture(Render::TextureType type) const {
 
 void Material::Apply(Shader& shader) const
 {
-    // Set material properties as uniforms
-    shader.SetVec3("material.ambient", properties.ambient);
-    shader.SetVec3("material.diffuse", properties.diffuse);
-    shader.SetVec3("material.specular", properties.specular);
-    shader.SetFloat("material.shininess", properties.shininess);
-    shader.SetVec3("material.emissive", properties.emissive);
+    (void)shader; // Samplers use fixed binding points declared in the shader
 
-    // Helper lambda to bind texture if it exists
-    auto BindTextureIfPresent = [&](Render::TextureType type, const std::string& uniformName,
-        const std::string& useFlagName, int unit) {
-            if (textures.count(type))
-            {
-                textures.at(type)->Bind(unit);
-                shader.SetInt(uniformName, unit);
-                shader.SetInt(useFlagName, 1);
-            }
-            else
-            {
-                shader.SetInt(useFlagName, 0);
-            }
+    // Unit 0: Diffuse, Unit 1: Specular, Unit 2: Normal, Unit 3: Emissive
+    auto BindTextureIfPresent = [&](Render::TextureType type, unsigned int unit) {
+            auto it = textures.find(type);
+            if (it != textures.end())
+                it->second->Bind(unit);
         };
 
-    // Bind supported textures
-    // Unit 0: Diffuse
-        BindTextureIfPresent(Render::TextureType::Diffuse, "material.diffuseMap", "material.useDiffuseMap", 0);
-
-        // Unit 1: Specular
-        BindTextureIfPresent(Render::TextureType::Specular, "material.specularMap", "material.useSpecularMap", 1);
-
-        // Unit 2: Normal
-        BindTextureIfPresent(Render::TextureType::Normal, "material.normalMap", "material.useNormalMap", 2);
-};
\ No newline at end of file
+    BindTextureIfPresent(Render::TextureType::Diffuse, 0);
+    BindTextureIfPresent(Render::TextureType::Specular, 1);
+    BindTextureIfPresent(Render::TextureType::Normal, 2);
+    BindTextureIfPresent(Render::TextureType::Emissive, 3);
+}
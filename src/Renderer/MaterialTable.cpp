@@ -0,0 +1,109 @@
+/**
+ * @file MaterialTable.cpp
+ * @brief Implementation of the dirty-tracked material SSBO.
+ */
+#include <Renderer/MaterialTable.h>
+#include <glad/glad.h>
+#include <iostream>
+
+MaterialTable::~MaterialTable()
+{
+	GpuResourceRegistry::Get().Unregister(record);
+	if (ssbo)
+		glDeleteBuffers(1, &ssbo);
+}
+
+GpuMaterial MaterialTable::Pack(const Material& material)
+{
+	const MaterialProperties& props = material.GetProperties();
+
+	GpuMaterial gpu;
+	gpu.ambient = glm::vec4(props.ambient, 0.0f);
+	gpu.diffuse = glm::vec4(props.diffuse, 0.0f);
+	gpu.specular = glm::vec4(props.specular, props.shininess);
+	gpu.emissive = glm::vec4(props.emissive, 0.0f);
+	gpu.textureFlags = glm::ivec4(
+		material.HasTexture(Render::TextureType::Diffuse) ? 1 : 0,
+		material.HasTexture(Render::TextureType::Specular) ? 1 : 0,
+		material.HasTexture(Render::TextureType::Normal) ? 1 : 0,
+		material.HasTexture(Render::TextureType::Emissive) ? 1 : 0);
+	return gpu;
+}
+
+void MaterialTable::Grow(size_t minCapacity)
+{
+	size_t newCapacity = capacity ? capacity : 64;
+	while (newCapacity < minCapacity)
+		newCapacity *= 2;
+
+	if (!ssbo)
+		glGenBuffers(1, &ssbo);
+
+	// Re-specify the store; every existing record has to be sent again
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, newCapacity * sizeof(GpuMaterial), nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+	for (auto& material : materials)
+		material->dirty = true;
+
+	capacity = newCapacity;
+	if (record == GpuResourceRegistry::InvalidHandle)
+		record = GpuResourceRegistry::Get().Register(GpuResourceRegistry::Category::Buffer, ssbo,
+			capacity * sizeof(GpuMaterial), 0, "MaterialTable");
+	else
+		GpuResourceRegistry::Get().Resize(record, ssbo, capacity * sizeof(GpuMaterial));
+	std::cout << "[MaterialTable] Capacity: " << capacity << " materials\n";
+}
+
+unsigned int MaterialTable::Register(const std::shared_ptr<Material>& material)
+{
+	if (material->tableSlot >= 0)
+		return static_cast<unsigned int>(material->tableSlot);
+
+	material->tableSlot = static_cast<int>(materials.size());
+	material->dirty = true;
+	materials.push_back(material);
+
+	return static_cast<unsigned int>(material->tableSlot);
+}
+
+size_t MaterialTable::Upload()
+{
+	if (materials.size() > capacity)
+		Grow(materials.size());
+
+	size_t uploaded = 0;
+	std::vector<GpuMaterial> staging;
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+
+	size_t slot = 0;
+	while (slot < materials.size())
+	{
+		if (!materials[slot]->dirty) { ++slot; continue; }
+
+		// Gather a run of consecutive dirty slots
+		size_t first = slot;
+		staging.clear();
+		while (slot < materials.size() && materials[slot]->dirty)
+		{
+			staging.push_back(Pack(*materials[slot]));
+			materials[slot]->dirty = false;
+			++slot;
+		}
+
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, first * sizeof(GpuMaterial),
+			staging.size() * sizeof(GpuMaterial), staging.data());
+		uploaded += staging.size();
+	}
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	return uploaded;
+}
+
+void MaterialTable::Bind() const
+{
+	GpuResourceRegistry::Get().Touch(record);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BindingPoint, ssbo);
+}
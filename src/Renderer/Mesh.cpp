@@ -1,56 +1,201 @@
 ﻿#include <Renderer/Mesh.h>
+#include <Core/MemoryTracker.h>
 #include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <utility>
 
+namespace
+{
+	// Smallest sphere around the AABB center that contains all given vertices
+	void ComputeBoundingSphere(const std::vector<Vertex>& vertices, const unsigned int* indices,
+		unsigned int indexCount, glm::vec3& center, float& radius)
+	{
+		glm::vec3 minP(vertices[indices[0]].position);
+		glm::vec3 maxP = minP;
+		for (unsigned int i = 1; i < indexCount; ++i)
+		{
+			const glm::vec3& p = vertices[indices[i]].position;
+			minP = glm::min(minP, p);
+			maxP = glm::max(maxP, p);
+		}
+
+		center = (minP + maxP) * 0.5f;
+		float radiusSq = 0.0f;
+		for (unsigned int i = 0; i < indexCount; ++i)
+		{
+			glm::vec3 d = vertices[indices[i]].position - center;
+			radiusSq = std::max(radiusSq, glm::dot(d, d));
+		}
+		radius = std::sqrt(radiusSq);
+	}
+
+	/**
+	 * @brief Partitions the triangles into clusters for per-camera culling.
+	 *
+	 * Triangles are taken in index order, so clusters are only as compact as the
+	 * index list; generators should emit triangles in tiles and pass the tile
+	 * boundaries as breaks.
+	 *
+	 * Normal cone (per cluster):
+	 *  - axis = normalized sum of the unit triangle normals
+	 *  - cosine of the half-angle = smallest dot(axis, n) over the triangles
+	 *  - apex = center - axis * t, with t the largest distance along the axis
+	 *    at which a triangle plane still lies in front of the apex
+	 * If the normals spread over more than ~84 degrees the cone is disabled.
+	 */
+	void ComputeClusters(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+		const std::vector<unsigned int>& clusterBreaks, std::vector<MeshCluster>& clusters, glm::vec3& boundsCenter, float& boundsRadius)
+	{
+		clusters.clear();
+		if (indices.empty())
+			return;
+
+		ComputeBoundingSphere(vertices, indices.data(), static_cast<unsigned int>(indices.size()), boundsCenter, boundsRadius);
+
+		unsigned int triangleCount = static_cast<unsigned int>(indices.size() / 3);
+		if (triangleCount < Mesh::MinClusteredTriangles)
+			return;
+
+		size_t nextBreak = 0;
+		unsigned int first = 0;
+		while (first < triangleCount * 3)
+		{
+			// End at the next forced break or after ClusterTriangles, whichever comes first
+			while (nextBreak < clusterBreaks.size() && clusterBreaks[nextBreak] <= first)
+				nextBreak++;
+			unsigned int end = std::min(first + Mesh::ClusterTriangles * 3, triangleCount * 3);
+			if (nextBreak < clusterBreaks.size())
+				end = std::min(end, clusterBreaks[nextBreak]);
+
+			MeshCluster cluster{};
+			cluster.firstIndex = first;
+			cluster.indexCount = end - first;
+			ComputeBoundingSphere(vertices, indices.data() + first, cluster.indexCount, cluster.center, cluster.radius);
+
+			// Axis: average facing of the non-degenerate triangles
+			glm::vec3 axis(0.0f);
+			for (unsigned int i = first; i < end; i += 3)
+			{
+				const glm::vec3& p0 = vertices[indices[i]].position;
+				glm::vec3 n = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+				float length = glm::length(n);
+				if (length > 0.0f)
+					axis += n / length;
+			}
+
+			cluster.coneApex = cluster.center;
+			cluster.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+			cluster.coneCutoff = 1.0f;
+
+			float axisLength = glm::length(axis);
+			if (axisLength > 0.0f)
+			{
+				axis /= axisLength;
+
+				float minDot = 1.0f;
+				float maxT = 0.0f;
+				for (unsigned int i = first; i < end; i += 3)
+				{
+					const glm::vec3& p0 = vertices[indices[i]].position;
+					glm::vec3 n = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+					float length = glm::length(n);
+					if (length == 0.0f)
+						continue;
+					n /= length;
+
+					float dn = glm::dot(axis, n);
+					minDot = std::min(minDot, dn);
+					if (dn > 0.0f)
+						maxT = std::max(maxT, glm::dot(cluster.center - p0, n) / dn);
+				}
+
+				// Wide cones reject almost nothing and the apex estimate degrades
+				if (minDot > 0.1f)
+				{
+					cluster.coneAxis = axis;
+					cluster.coneApex = cluster.center - axis * maxT;
+					cluster.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+				}
+			}
+
+			clusters.push_back(cluster);
+			first = end;
+		}
+	}
+}
 
 /**
- * @brief Initializes the Mesh by uploading vertex data to GPU buffers.
+ * @brief Initializes the Mesh by uploading vertex data to the GeometryPool.
  *
- * Creates and binds a VAO + VBO, then sets up vertex attribute pointers
- * for position and color. At this stage, each vertex contains 6 floats:
- *  - vec3 position (x, y, z)
- *  - vec3 color (r, g, b)
+ * The pool sub-allocates a vertex range and an index range from one of its
+ * large shared buffers. Vertex layout (declared once per pool page):
+ *  - 0 -> position (vec3), 1 -> normal (vec3), 2 -> color (vec3)
+ *  - 3 -> texCoord (vec2), 4 -> tangent (vec3)
  *
  * @param vertices The list of vertices to upload.
  */
 
-Mesh::Mesh(const std::vector<Vertex>& verts, const std::vector<unsigned int>& inds) 
-	: vertices(verts), indices(inds)
+Mesh::Mesh(std::vector<Vertex> verts, std::vector<unsigned int> inds,
+	const std::vector<unsigned int>& clusterBreaks)
+	: vertices(std::move(verts)), indices(std::move(inds))
+{
+	MemoryTagScope tag(MemoryTag::Mesh);
+	Initialize();
+	ComputeClusters(vertices, indices, clusterBreaks, clusters, boundsCenter, boundsRadius);
+}
+
+Mesh::Mesh(MeshData data)
 {
+	if (!data.clustered)
+		BuildClusters(data);
+
+	vertices = std::move(data.vertices);
+	indices = std::move(data.indices);
+	clusters = std::move(data.clusters);
+	boundsCenter = data.boundsCenter;
+	boundsRadius = data.boundsRadius;
+
+	MemoryTagScope tag(MemoryTag::Mesh);
 	Initialize();
 }
 
+void Mesh::BuildClusters(MeshData& data)
+{
+	ComputeClusters(data.vertices, data.indices, data.clusterBreaks, data.clusters, data.boundsCenter, data.boundsRadius);
+	data.clustered = true;
+}
+
 // Move constructor
 Mesh::Mesh(Mesh&& other) noexcept
-	: VAO(other.VAO), VBO(other.VBO), EBO(other.EBO),
-	  vertices(std::move(other.vertices)), indices(std::move(other.indices))
+	: geometry(other.geometry),
+	  vertices(std::move(other.vertices)), indices(std::move(other.indices)),
+	  clusters(std::move(other.clusters)),
+	  boundsCenter(other.boundsCenter), boundsRadius(other.boundsRadius)
 {
-	// Invalidate the other mesh's handles so its destructor doesn't delete them
-	other.VAO = 0;
-	other.VBO = 0;
-	other.EBO = 0;
+	// Invalidate the other mesh's handle so its destructor doesn't free the range
+	other.geometry = GeometryPool::InvalidHandle;
 }
 
 // Move assignment
 Mesh& Mesh::operator=(Mesh&& other) noexcept
 {
 	if (this != &other) {
-		// Clean up existing resources
-		glDeleteVertexArrays(1, &VAO);
-		glDeleteBuffers(1, &VBO);
-		glDeleteBuffers(1, &EBO);
+		// Release the existing range
+		if (GeometryPool* pool = GeometryPool::Instance())
+			pool->Free(geometry);
 
 		// Transfer ownership
-		VAO = other.VAO;
-		VBO = other.VBO;
-		EBO = other.EBO;
+		geometry = other.geometry;
 		vertices = std::move(other.vertices);
 		indices = std::move(other.indices);
+		clusters = std::move(other.clusters);
+		boundsCenter = other.boundsCenter;
+		boundsRadius = other.boundsRadius;
 
 		// Invalidate other
-		other.VAO = 0;
-		other.VBO = 0;
-		other.EBO = 0;
+		other.geometry = GeometryPool::InvalidHandle;
 	}
 	return *this;
 }
@@ -58,74 +203,48 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept
 
 void Mesh::Initialize()
 {
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glGenBuffers(1, &EBO);
-
-	glBindVertexArray(VAO);
-
-	// Upload vertex data
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), 
-		vertices.data(), GL_STATIC_DRAW);
-
-	// Upload index data
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), 
-		indices.data(), GL_STATIC_DRAW);
-
-	// Vertex layout:
-	// 0 -> position(vec3)
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	// 1 -> normal (vec3)
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-	glEnableVertexAttribArray(1);
-
-	//2 -> color (vec3)
-	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
-	glEnableVertexAttribArray(2);
-
-	// 3-> texCoord (vec2)
-	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
-	glEnableVertexAttribArray(3);
-
-	// 4-> tangent (vec3)
-	glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, tangent));
-	glEnableVertexAttribArray(4);
-
-	glBindVertexArray(0);
+	geometry = GeometryPool::Get().Allocate(vertices, indices);
 }
 
 /**
-* @brief Deletes VAO and VBO from GPU memory.
+* @brief Returns the vertex/index ranges to the GeometryPool.
+* The pool may already be shut down at application exit; then there is nothing to free.
 */
 Mesh::~Mesh()
 {
-	glDeleteVertexArrays(1, &VAO);
-	glDeleteBuffers(1, &VBO);
-	glDeleteBuffers(1, &EBO);
+	if (GeometryPool* pool = GeometryPool::Instance())
+		pool->Free(geometry);
+}
+
+GeometryView Mesh::GetView() const
+{
+	if (GeometryPool* pool = GeometryPool::Instance())
+		return pool->GetView(geometry);
+	return GeometryView{};
 }
 
 /**
  * @brief Renders the Mesh.
  *
- * Issues a glDrawArrays call to render the vertex buffer.
- * Currently assumes the mesh has 3 vertices (for a test triangle).
+ * Issues an indexed draw of the mesh's range in its pool page. The draw is a
+ * single instance with a base instance so shaders can read per-draw data
+ * (material slot) without a uniform update.
  *
- * @note This will be extended to use a stored vertex count or index buffer.
+ * The page VAO is shared by every mesh in the page and is left bound, so
+ * consecutive draws from one page don't pay for a VAO switch.
  */
 
-void Mesh::Draw() const{
-	if (VAO == 0 || indices.empty()) {
-		std::cerr << "[Mesh] Error: Cannot draw - VAO=" << VAO << ", indices=" << indices.size() << "\n";
+void Mesh::Draw(unsigned int baseInstance) const{
+	GeometryView view = GetView();
+	if (view.vao == 0 || view.indexCount == 0) {
+		std::cerr << "[Mesh] Error: Cannot draw - VAO=" << view.vao << ", indices=" << view.indexCount << "\n";
 		return;
 	}
 	
-	glBindVertexArray(VAO);
-	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
+	glBindVertexArray(view.vao);
+	glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(view.indexCount),
+		GL_UNSIGNED_INT, (void*)(static_cast<size_t>(view.firstIndex) * sizeof(unsigned int)),
+		1, view.baseVertex, baseInstance);
 }
 
 
@@ -145,6 +264,16 @@ void Mesh::Draw() const{
  */
 Mesh Mesh::CreateSphere(float radius, unsigned int sectors, unsigned int stacks)
 {
+	Mesh sphere(GenerateSphere(radius, sectors, stacks));
+	std::cout << "[Mesh] Created sphere: " << sphere.GetVertices().size() << " vertices, "
+		<< sphere.GetIndices().size() << " indices, "
+		<< sphere.GetClusters().size() << " clusters\n";
+	return sphere;
+}
+
+MeshData Mesh::GenerateSphere(float radius, unsigned int sectors, unsigned int stacks)
+{
+	MemoryTagScope tag(MemoryTag::Mesh);
 	std::vector<Vertex> verts;
 	std::vector<unsigned int> inds;
 
@@ -186,29 +315,41 @@ Mesh Mesh::CreateSphere(float radius, unsigned int sectors, unsigned int stacks)
 		}
 	}
 
-	// build indices 
-	for (unsigned int i = 0; i < stacks; ++i)
+	// Build indices in tiles of TileSize x TileSize quads (one cluster each, 128
+	// triangles away from the poles) instead of full rows, so each cluster is a
+	// compact patch with a narrow normal cone. Also keeps vertex reuse local.
+	const unsigned int TileSize = 8;
+	std::vector<unsigned int> tileStarts;
+
+	for (unsigned int ti = 0; ti < stacks; ti += TileSize)
 	{
-		unsigned int k1 = i * (sectors + 1);
-		unsigned int k2 = k1 + sectors + 1;
-		
-		for (unsigned int j = 0; j < sectors; ++j, ++k1, ++k2)
+		for (unsigned int tj = 0; tj < sectors; tj += TileSize)
 		{
-			if (i != 0)
-			{
-				inds.push_back(k1);
-				inds.push_back(k2);
-				inds.push_back(k1 + 1);
-			}
-			if (i != (stacks - 1))
+			tileStarts.push_back(static_cast<unsigned int>(inds.size()));
+
+			for (unsigned int i = ti; i < std::min(ti + TileSize, stacks); ++i)
 			{
-				inds.push_back(k1 + 1);
-				inds.push_back(k2);
-				inds.push_back(k2 + 1);
+				for (unsigned int j = tj; j < std::min(tj + TileSize, sectors); ++j)
+				{
+					unsigned int k1 = i * (sectors + 1) + j;
+					unsigned int k2 = k1 + sectors + 1;
+
+					if (i != 0)
+					{
+						inds.push_back(k1);
+						inds.push_back(k2);
+						inds.push_back(k1 + 1);
+					}
+					if (i != (stacks - 1))
+					{
+						inds.push_back(k1 + 1);
+						inds.push_back(k2);
+						inds.push_back(k2 + 1);
+					}
+				}
 			}
 		}
 	}
 
-	std::cout << "[Mesh] Created sphere: " << verts.size() << " vertices, " << inds.size() << " indices\n";
-	return Mesh(verts, inds);
+	return MeshData{ std::move(verts), std::move(inds), std::move(tileStarts) };
 }
\ No newline at end of file
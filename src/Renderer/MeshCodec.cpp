@@ -0,0 +1,376 @@
+/**
+ * @file MeshCodec.cpp
+ * @brief Implementation of the index (delta/zigzag/varint) and vertex (byte plane) codecs.
+ *
+ * Vertex block layout, per block of up to 16 vertices:
+ *   header : stride / 4 bytes, 2-bit mode per channel (channel k at bits 2*(k%4) of byte k/4)
+ *   data   : per channel, 16 values at 0 / 2 / 4 / 8 bits (0 / 4 / 8 / 16 bytes)
+ * Values are packed low bits first. A partial last block is padded with
+ * copies of the last vertex, which encode as zero deltas.
+ */
+#include <Renderer/MeshCodec.h>
+#include <Renderer/Mesh.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define MESHCODEC_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// The channel decoder must inline into the block loop to keep values in registers
+#ifdef _MSC_VER
+#define MESHCODEC_INLINE __forceinline
+#else
+#define MESHCODEC_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace
+{
+	constexpr uint8_t ModeBits[4] = { 0, 2, 4, 8 };
+
+	uint8_t ZigzagByte(uint8_t delta)
+	{
+		return static_cast<uint8_t>((delta << 1) ^ static_cast<uint8_t>(static_cast<int8_t>(delta) >> 7));
+	}
+
+#ifndef MESHCODEC_SSE2
+	uint8_t UnzigzagByte(uint8_t value)
+	{
+		return static_cast<uint8_t>((value >> 1) ^ static_cast<uint8_t>(-(value & 1)));
+	}
+#endif
+
+	size_t HeaderSize(size_t stride) { return stride / 4; }
+
+	// Data bytes described by one header byte (four 2-bit channel modes)
+	size_t HeaderPayload(uint8_t modes)
+	{
+		return (ModeBits[modes & 3] + ModeBits[(modes >> 2) & 3]
+			+ ModeBits[(modes >> 4) & 3] + ModeBits[(modes >> 6) & 3]) * 2;
+	}
+
+	void EncodeChannel(std::vector<uint8_t>& out, const uint8_t* values, uint8_t& mode)
+	{
+		uint8_t maxValue = 0;
+		for (size_t i = 0; i < MeshCodec::BlockVertices; ++i)
+			maxValue = std::max(maxValue, values[i]);
+
+		mode = maxValue == 0 ? 0 : maxValue < 4 ? 1 : maxValue < 16 ? 2 : 3;
+		unsigned int bits = ModeBits[mode];
+		if (bits == 0)
+			return;
+
+		unsigned int perByte = 8 / bits;
+		for (size_t i = 0; i < MeshCodec::BlockVertices; i += perByte)
+		{
+			uint8_t packed = 0;
+			for (unsigned int m = 0; m < perByte; ++m)
+				packed |= static_cast<uint8_t>(values[i + m] << (m * bits));
+			out.push_back(packed);
+		}
+	}
+
+#ifdef MESHCODEC_SSE2
+	// Unpacks 16 values, un-zigzags them and adds them up onto the previous byte
+	MESHCODEC_INLINE __m128i DecodeChannel(const uint8_t*& data, unsigned int mode, uint8_t previous)
+	{
+		__m128i values;
+		switch (mode)
+		{
+		case 0:
+			return _mm_set1_epi8(static_cast<char>(previous));
+		case 1:
+		{
+			int word;
+			std::memcpy(&word, data, 4);
+			data += 4;
+			__m128i x = _mm_cvtsi32_si128(word);
+			__m128i mask = _mm_set1_epi8(3);
+			__m128i v0 = _mm_and_si128(x, mask);
+			__m128i v1 = _mm_and_si128(_mm_srli_epi16(x, 2), mask);
+			__m128i v2 = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+			__m128i v3 = _mm_and_si128(_mm_srli_epi16(x, 6), mask);
+			values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v0, v1), _mm_unpacklo_epi8(v2, v3));
+			break;
+		}
+		case 2:
+		{
+			__m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+			data += 8;
+			__m128i mask = _mm_set1_epi8(15);
+			values = _mm_unpacklo_epi8(_mm_and_si128(x, mask), _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+			break;
+		}
+		default:
+			values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			data += 16;
+			break;
+		}
+
+		// Un-zigzag: (v >> 1) ^ -(v & 1), with the byte shift emulated on 16-bit lanes
+		__m128i one = _mm_set1_epi8(1);
+		__m128i half = _mm_and_si128(_mm_srli_epi16(values, 1), _mm_set1_epi8(0x7f));
+		__m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(values, one));
+		__m128i deltas = _mm_xor_si128(half, sign);
+
+		// Inclusive prefix sum across the 16 lanes
+		deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 1));
+		deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 2));
+		deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 4));
+		deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 8));
+		return _mm_add_epi8(deltas, _mm_set1_epi8(static_cast<char>(previous)));
+	}
+
+	uint8_t LastByte(__m128i v)
+	{
+		return static_cast<uint8_t>(_mm_extract_epi16(v, 7) >> 8);
+	}
+
+	// Interleaves four channel registers into 16 vertices, 4 bytes per vertex
+	MESHCODEC_INLINE void StoreChannels(uint8_t* destination, size_t stride, size_t count, __m128i a0, __m128i a1, __m128i a2, __m128i a3)
+	{
+		__m128i t0 = _mm_unpacklo_epi8(a0, a1);
+		__m128i t1 = _mm_unpackhi_epi8(a0, a1);
+		__m128i t2 = _mm_unpacklo_epi8(a2, a3);
+		__m128i t3 = _mm_unpackhi_epi8(a2, a3);
+
+		__m128i rows[4] = {
+			_mm_unpacklo_epi16(t0, t2), _mm_unpackhi_epi16(t0, t2),
+			_mm_unpacklo_epi16(t1, t3), _mm_unpackhi_epi16(t1, t3)
+		};
+
+		if (count == MeshCodec::BlockVertices)
+		{
+			// Full block: fixed, branch-free sequence of 4-byte stores
+			for (int r = 0; r < 4; ++r)
+			{
+				__m128i row = rows[r];
+				for (int i = 0; i < 4; ++i)
+				{
+					int word = _mm_cvtsi128_si32(row);
+					std::memcpy(destination + (r * 4 + i) * stride, &word, 4);
+					row = _mm_srli_si128(row, 4);
+				}
+			}
+			return;
+		}
+
+		alignas(16) uint8_t words[64];
+		for (int r = 0; r < 4; ++r)
+			_mm_store_si128(reinterpret_cast<__m128i*>(words + r * 16), rows[r]);
+		for (size_t i = 0; i < count; ++i)
+			std::memcpy(destination + i * stride, words + i * 4, 4);
+	}
+#endif
+
+	void WriteVarint(std::vector<uint8_t>& out, uint32_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<uint8_t>(value));
+	}
+}
+
+std::vector<uint8_t> MeshCodec::EncodeVertexBuffer(const void* vertices, size_t count, size_t stride)
+{
+	std::vector<uint8_t> out;
+	if (stride == 0 || stride % 4 != 0 || stride > MaxVertexStride)
+	{
+		std::cerr << "[MeshCodec] Unsupported vertex stride " << stride << "\n";
+		return out;
+	}
+
+	const uint8_t* source = static_cast<const uint8_t*>(vertices);
+	uint8_t previous[MaxVertexStride] = {};
+	uint8_t values[BlockVertices];
+
+	for (size_t block = 0; block < count; block += BlockVertices)
+	{
+		size_t blockCount = std::min(BlockVertices, count - block);
+
+		size_t headerOffset = out.size();
+		out.resize(out.size() + HeaderSize(stride), 0);
+
+		for (size_t k = 0; k < stride; ++k)
+		{
+			uint8_t last = previous[k];
+			for (size_t i = 0; i < BlockVertices; ++i)
+			{
+				// Pad partial blocks by repeating the last vertex (zero deltas)
+				size_t v = block + std::min(i, blockCount - 1);
+				uint8_t current = source[v * stride + k];
+				values[i] = ZigzagByte(static_cast<uint8_t>(current - last));
+				last = current;
+			}
+			previous[k] = last;
+
+			uint8_t mode;
+			EncodeChannel(out, values, mode);
+			out[headerOffset + k / 4] |= static_cast<uint8_t>(mode << ((k % 4) * 2));
+		}
+	}
+	return out;
+}
+
+bool MeshCodec::DecodeVertexBuffer(void* destination, size_t count, size_t stride, const uint8_t* data, size_t size)
+{
+	if (stride == 0 || stride % 4 != 0 || stride > MaxVertexStride)
+		return false;
+
+	uint8_t* out = static_cast<uint8_t*>(destination);
+	const uint8_t* end = data + size;
+	uint8_t previous[MaxVertexStride] = {};
+
+	for (size_t block = 0; block < count; block += BlockVertices)
+	{
+		size_t blockCount = std::min(BlockVertices, count - block);
+
+		const uint8_t* header = data;
+		if (static_cast<size_t>(end - data) < HeaderSize(stride))
+			return false;
+		data += HeaderSize(stride);
+
+		// Payload size check up front keeps the channel loop branch-free
+		size_t payload = 0;
+		for (size_t h = 0; h < HeaderSize(stride); ++h)
+			payload += HeaderPayload(header[h]);
+		if (static_cast<size_t>(end - data) < payload)
+			return false;
+
+		uint8_t* blockOut = out + block * stride;
+
+#ifdef MESHCODEC_SSE2
+		for (size_t k = 0; k < stride; k += 4)
+		{
+			unsigned int modes = header[k / 4];
+			__m128i c0 = DecodeChannel(data, modes & 3, previous[k]);
+			__m128i c1 = DecodeChannel(data, (modes >> 2) & 3, previous[k + 1]);
+			__m128i c2 = DecodeChannel(data, (modes >> 4) & 3, previous[k + 2]);
+			__m128i c3 = DecodeChannel(data, (modes >> 6) & 3, previous[k + 3]);
+
+			previous[k] = LastByte(c0);
+			previous[k + 1] = LastByte(c1);
+			previous[k + 2] = LastByte(c2);
+			previous[k + 3] = LastByte(c3);
+
+			StoreChannels(blockOut + k, stride, blockCount, c0, c1, c2, c3);
+		}
+#else
+		for (size_t k = 0; k < stride; ++k)
+		{
+			unsigned int bits = ModeBits[(header[k / 4] >> ((k % 4) * 2)) & 3];
+			uint8_t last = previous[k];
+			for (size_t i = 0; i < BlockVertices; ++i)
+			{
+				uint8_t value = 0;
+				if (bits)
+				{
+					size_t bit = i * bits;
+					value = static_cast<uint8_t>((data[bit / 8] >> (bit % 8)) & ((1u << bits) - 1));
+				}
+				last = static_cast<uint8_t>(last + UnzigzagByte(value));
+				if (i < blockCount)
+					blockOut[i * stride + k] = last;
+			}
+			previous[k] = last;
+			data += bits * 2;
+		}
+#endif
+	}
+	return data == end;
+}
+
+std::vector<uint8_t> MeshCodec::EncodeIndexBuffer(const unsigned int* indices, size_t count)
+{
+	std::vector<uint8_t> out;
+	out.reserve(count * 2);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		// Predict from the same corner of the previous triangle
+		uint32_t predicted = i >= 3 ? indices[i - 3] : 0;
+		int32_t delta = static_cast<int32_t>(indices[i] - predicted);
+		uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+		WriteVarint(out, zigzag);
+	}
+	return out;
+}
+
+bool MeshCodec::DecodeIndexBuffer(unsigned int* destination, size_t count, const uint8_t* data, size_t size)
+{
+	const uint8_t* end = data + size;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint32_t zigzag;
+
+		// Single-byte deltas dominate; keep that path short
+		if (data < end && *data < 0x80)
+		{
+			zigzag = *data++;
+		}
+		else
+		{
+			zigzag = 0;
+			unsigned int shift = 0;
+			uint8_t byte;
+			do {
+				if (data >= end || shift > 28)
+					return false;
+				byte = *data++;
+				zigzag |= static_cast<uint32_t>(byte & 0x7f) << shift;
+				shift += 7;
+			} while (byte & 0x80);
+		}
+
+		uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1));
+		uint32_t predicted = i >= 3 ? destination[i - 3] : 0;
+		destination[i] = predicted + delta;
+	}
+	return data == end;
+}
+
+MeshCodec::Report MeshCodec::Measure(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	Report report;
+	std::vector<uint8_t> vertexData = EncodeVertexBuffer(vertices.data(), vertices.size(), sizeof(Vertex));
+	std::vector<uint8_t> indexData = EncodeIndexBuffer(indices.data(), indices.size());
+
+	size_t vertexBytes = vertices.size() * sizeof(Vertex);
+	size_t indexBytes = indices.size() * sizeof(unsigned int);
+	report.rawBytes = vertexBytes + indexBytes;
+	report.encodedBytes = vertexData.size() + indexData.size();
+
+	std::vector<Vertex> decodedVertices(vertices.size());
+	std::vector<unsigned int> decodedIndices(indices.size());
+
+	// Best of several runs, to keep page faults and frequency ramp-up out of the number
+	double vertexSeconds = 1e30, indexSeconds = 1e30;
+	for (int run = 0; run < 5; ++run)
+	{
+		auto start = Clock::now();
+		DecodeVertexBuffer(decodedVertices.data(), vertices.size(), sizeof(Vertex), vertexData.data(), vertexData.size());
+		auto middle = Clock::now();
+		DecodeIndexBuffer(decodedIndices.data(), indices.size(), indexData.data(), indexData.size());
+		auto stop = Clock::now();
+
+		vertexSeconds = std::min(vertexSeconds, std::chrono::duration<double>(middle - start).count());
+		indexSeconds = std::min(indexSeconds, std::chrono::duration<double>(stop - middle).count());
+	}
+
+	if (std::memcmp(decodedVertices.data(), vertices.data(), vertexBytes) != 0
+		|| decodedIndices != indices)
+		std::cerr << "[MeshCodec] Round trip mismatch\n";
+
+	report.vertexDecodeGBps = vertexSeconds > 0.0 ? vertexBytes / vertexSeconds / 1e9 : 0.0;
+	report.indexDecodeGBps = indexSeconds > 0.0 ? indexBytes / indexSeconds / 1e9 : 0.0;
+	return report;
+}
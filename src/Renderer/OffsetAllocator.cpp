@@ -0,0 +1,344 @@
+/**
+ * @file OffsetAllocator.cpp
+ * @brief Implementation of the O(1) TLSF-style range allocator.
+ *
+ * Size -> bin mapping ("small float"):
+ *   - sizes < 8 map directly to bins 0..7 (denormals)
+ *   - larger sizes keep their 3 bits below the highest set bit as mantissa
+ *     and use the bit position as exponent: bin = (exp << 3) | mantissa
+ *
+ * Allocate() rounds the request UP to a bin so any node found there fits;
+ * free nodes are inserted with the size rounded DOWN so a bin never holds a
+ * node smaller than the bin's lower bound.
+ */
+#include <Renderer/OffsetAllocator.h>
+#include <cassert>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+	uint32_t LeadingZeros(uint32_t v)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		return _BitScanReverse(&index, v) ? 31 - index : 32;
+#else
+		return v ? static_cast<uint32_t>(__builtin_clz(v)) : 32;
+#endif
+	}
+
+	uint32_t TrailingZeros(uint32_t v)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		return _BitScanForward(&index, v) ? index : 32;
+#else
+		return v ? static_cast<uint32_t>(__builtin_ctz(v)) : 32;
+#endif
+	}
+
+	// Index of the lowest set bit at or above startBit, or NoSpace
+	uint32_t FindLowestSetBitAfter(uint32_t bitMask, uint32_t startBit)
+	{
+		if (startBit >= 32)
+			return OffsetAllocator::NoSpace;
+		uint32_t maskBeforeStart = (1u << startBit) - 1;
+		uint32_t masked = bitMask & ~maskBeforeStart;
+		return masked ? TrailingZeros(masked) : OffsetAllocator::NoSpace;
+	}
+
+	namespace SmallFloat
+	{
+		constexpr uint32_t MantissaBits = 3;
+		constexpr uint32_t MantissaValue = 1 << MantissaBits;
+		constexpr uint32_t MantissaMask = MantissaValue - 1;
+
+		uint32_t UintToFloatRoundUp(uint32_t size)
+		{
+			uint32_t exp = 0;
+			uint32_t mantissa = 0;
+
+			if (size < MantissaValue)
+			{
+				mantissa = size;
+			}
+			else
+			{
+				uint32_t highestSetBit = 31 - LeadingZeros(size);
+				uint32_t mantissaStartBit = highestSetBit - MantissaBits;
+				exp = mantissaStartBit + 1;
+				mantissa = (size >> mantissaStartBit) & MantissaMask;
+
+				uint32_t lowBitsMask = (1u << mantissaStartBit) - 1;
+				if ((size & lowBitsMask) != 0)
+					mantissa++;
+			}
+
+			// '+' lets a mantissa overflow carry into the exponent
+			return (exp << MantissaBits) + mantissa;
+		}
+
+		uint32_t UintToFloatRoundDown(uint32_t size)
+		{
+			uint32_t exp = 0;
+			uint32_t mantissa = 0;
+
+			if (size < MantissaValue)
+			{
+				mantissa = size;
+			}
+			else
+			{
+				uint32_t highestSetBit = 31 - LeadingZeros(size);
+				uint32_t mantissaStartBit = highestSetBit - MantissaBits;
+				exp = mantissaStartBit + 1;
+				mantissa = (size >> mantissaStartBit) & MantissaMask;
+			}
+
+			return (exp << MantissaBits) | mantissa;
+		}
+	}
+}
+
+OffsetAllocator::OffsetAllocator(uint32_t size, uint32_t maxAllocs)
+	: size(size), maxAllocs(maxAllocs)
+{
+	Reset();
+}
+
+void OffsetAllocator::Reset()
+{
+	freeStorage = 0;
+	usedBinsTop = 0;
+	for (uint32_t i = 0; i < NumTopBins; i++)
+		usedBins[i] = 0;
+	for (uint32_t i = 0; i < NumLeafBins; i++)
+		binIndices[i] = Unused;
+
+	nodes.assign(maxAllocs, Node{});
+	freeNodes.resize(maxAllocs);
+
+	// Freelist is a stack: nodes in inverse order so that 0 is popped first
+	for (uint32_t i = 0; i < maxAllocs; i++)
+		freeNodes[i] = maxAllocs - i - 1;
+	freeOffset = maxAllocs - 1;
+
+	// Start state: the whole range is one big free node
+	InsertNodeIntoBin(size, 0);
+}
+
+OffsetAllocator::Allocation OffsetAllocator::Allocate(uint32_t allocSize)
+{
+	// Out of node storage (one node is needed for a potential split)
+	if (freeOffset == 0 || allocSize == 0)
+		return {};
+
+	// Round up to a bin so every node inside it is large enough
+	uint32_t minBinIndex = SmallFloat::UintToFloatRoundUp(allocSize);
+	// Largest result is 240 (0xFFFFFFFF rounds up to exponent 30, mantissa 0)
+	assert(minBinIndex < NumLeafBins);
+
+	uint32_t minTopBinIndex = minBinIndex >> TopBinsIndexShift;
+	uint32_t minLeafBinIndex = minBinIndex & LeafBinsIndexMask;
+
+	uint32_t topBinIndex = minTopBinIndex;
+	uint32_t leafBinIndex = NoSpace;
+
+	// Search the requested top bin first, starting at the requested leaf
+	if (usedBinsTop & (1u << topBinIndex))
+		leafBinIndex = FindLowestSetBitAfter(usedBins[topBinIndex], minLeafBinIndex);
+
+	// Otherwise take the lowest leaf of the next non-empty top bin
+	if (leafBinIndex == NoSpace)
+	{
+		topBinIndex = FindLowestSetBitAfter(usedBinsTop, minTopBinIndex + 1);
+		if (topBinIndex == NoSpace)
+			return {};
+
+		leafBinIndex = TrailingZeros(usedBins[topBinIndex]);
+	}
+
+	uint32_t binIndex = (topBinIndex << TopBinsIndexShift) | leafBinIndex;
+
+	// Pop the head of the bin
+	uint32_t nodeIndex = binIndices[binIndex];
+	Node& node = nodes[nodeIndex];
+	uint32_t nodeTotalSize = node.dataSize;
+	node.dataSize = allocSize;
+	node.used = true;
+	binIndices[binIndex] = node.binListNext;
+	if (node.binListNext != Unused)
+		nodes[node.binListNext].binListPrev = Unused;
+	freeStorage -= nodeTotalSize;
+
+	// Bin empty?
+	if (binIndices[binIndex] == Unused)
+	{
+		usedBins[topBinIndex] &= ~(1u << leafBinIndex);
+		if (usedBins[topBinIndex] == 0)
+			usedBinsTop &= ~(1u << topBinIndex);
+	}
+
+	// Return the unused tail of the node to the bins
+	uint32_t remainder = nodeTotalSize - allocSize;
+	if (remainder > 0)
+	{
+		uint32_t newNodeIndex = InsertNodeIntoBin(remainder, node.dataOffset + allocSize);
+
+		// Link the split-off node between this node and its old next neighbor
+		Node& splitNode = nodes[nodeIndex];
+		if (splitNode.neighborNext != Unused)
+			nodes[splitNode.neighborNext].neighborPrev = newNodeIndex;
+		nodes[newNodeIndex].neighborPrev = nodeIndex;
+		nodes[newNodeIndex].neighborNext = splitNode.neighborNext;
+		splitNode.neighborNext = newNodeIndex;
+	}
+
+	return { nodes[nodeIndex].dataOffset, nodeIndex };
+}
+
+void OffsetAllocator::Free(Allocation allocation)
+{
+	if (allocation.metadata == NoSpace || allocation.metadata >= maxAllocs)
+		return;
+
+	uint32_t nodeIndex = allocation.metadata;
+	Node& node = nodes[nodeIndex];
+	assert(node.used && "OffsetAllocator: double free");
+
+	uint32_t offset = node.dataOffset;
+	uint32_t freeSize = node.dataSize;
+
+	// Merge with a free previous neighbor
+	if (node.neighborPrev != Unused && !nodes[node.neighborPrev].used)
+	{
+		const Node prevNode = nodes[node.neighborPrev];
+		offset = prevNode.dataOffset;
+		freeSize += prevNode.dataSize;
+
+		RemoveNodeFromBin(node.neighborPrev);
+		node.neighborPrev = prevNode.neighborPrev;
+	}
+
+	// Merge with a free next neighbor
+	if (node.neighborNext != Unused && !nodes[node.neighborNext].used)
+	{
+		const Node nextNode = nodes[node.neighborNext];
+		freeSize += nextNode.dataSize;
+
+		RemoveNodeFromBin(node.neighborNext);
+		node.neighborNext = nextNode.neighborNext;
+	}
+
+	uint32_t neighborNext = node.neighborNext;
+	uint32_t neighborPrev = node.neighborPrev;
+
+	// Release this node and insert the combined range as a new free node
+	freeNodes[++freeOffset] = nodeIndex;
+	uint32_t combinedNodeIndex = InsertNodeIntoBin(freeSize, offset);
+
+	if (neighborNext != Unused)
+	{
+		nodes[combinedNodeIndex].neighborNext = neighborNext;
+		nodes[neighborNext].neighborPrev = combinedNodeIndex;
+	}
+	if (neighborPrev != Unused)
+	{
+		nodes[combinedNodeIndex].neighborPrev = neighborPrev;
+		nodes[neighborPrev].neighborNext = combinedNodeIndex;
+	}
+}
+
+uint32_t OffsetAllocator::InsertNodeIntoBin(uint32_t dataSize, uint32_t dataOffset)
+{
+	// Round down so the node is never smaller than its bin's lower bound
+	uint32_t binIndex = SmallFloat::UintToFloatRoundDown(dataSize);
+	uint32_t topBinIndex = binIndex >> TopBinsIndexShift;
+	uint32_t leafBinIndex = binIndex & LeafBinsIndexMask;
+
+	// First node in the bin: mark the bin as used
+	if (binIndices[binIndex] == Unused)
+	{
+		usedBins[topBinIndex] |= 1u << leafBinIndex;
+		usedBinsTop |= 1u << topBinIndex;
+	}
+
+	// Push at the head of the bin's list
+	uint32_t topNodeIndex = binIndices[binIndex];
+	uint32_t nodeIndex = freeNodes[freeOffset--];
+
+	Node& node = nodes[nodeIndex];
+	node = Node{};
+	node.dataOffset = dataOffset;
+	node.dataSize = dataSize;
+	node.binListNext = topNodeIndex;
+	if (topNodeIndex != Unused)
+		nodes[topNodeIndex].binListPrev = nodeIndex;
+	binIndices[binIndex] = nodeIndex;
+
+	freeStorage += dataSize;
+	return nodeIndex;
+}
+
+void OffsetAllocator::RemoveNodeFromBin(uint32_t nodeIndex)
+{
+	Node& node = nodes[nodeIndex];
+
+	if (node.binListPrev != Unused)
+	{
+		// Easy case: unlink from the middle of the list
+		nodes[node.binListPrev].binListNext = node.binListNext;
+		if (node.binListNext != Unused)
+			nodes[node.binListNext].binListPrev = node.binListPrev;
+	}
+	else
+	{
+		// Head of the list: update the bin and possibly its bitmasks
+		uint32_t binIndex = SmallFloat::UintToFloatRoundDown(node.dataSize);
+		uint32_t topBinIndex = binIndex >> TopBinsIndexShift;
+		uint32_t leafBinIndex = binIndex & LeafBinsIndexMask;
+
+		binIndices[binIndex] = node.binListNext;
+		if (node.binListNext != Unused)
+			nodes[node.binListNext].binListPrev = Unused;
+
+		if (binIndices[binIndex] == Unused)
+		{
+			usedBins[topBinIndex] &= ~(1u << leafBinIndex);
+			if (usedBins[topBinIndex] == 0)
+				usedBinsTop &= ~(1u << topBinIndex);
+		}
+	}
+
+	freeNodes[++freeOffset] = nodeIndex;
+	freeStorage -= node.dataSize;
+}
+
+uint32_t OffsetAllocator::AllocationSize(Allocation allocation) const
+{
+	if (allocation.metadata == NoSpace || allocation.metadata >= maxAllocs)
+		return 0;
+	return nodes[allocation.metadata].dataSize;
+}
+
+OffsetAllocator::StorageReport OffsetAllocator::GetStorageReport() const
+{
+	StorageReport report;
+	report.totalFreeSpace = freeStorage;
+
+	// The highest non-empty bin holds the largest region (approximately;
+	// nodes within one bin differ by less than one mantissa step)
+	if (usedBinsTop)
+	{
+		uint32_t topBinIndex = 31 - LeadingZeros(usedBinsTop);
+		uint32_t leafBinIndex = 31 - LeadingZeros(usedBins[topBinIndex]);
+		uint32_t nodeIndex = binIndices[(topBinIndex << TopBinsIndexShift) | leafBinIndex];
+		for (; nodeIndex != Unused; nodeIndex = nodes[nodeIndex].binListNext)
+			if (nodes[nodeIndex].dataSize > report.largestFreeRegion)
+				report.largestFreeRegion = nodes[nodeIndex].dataSize;
+	}
+	return report;
+}
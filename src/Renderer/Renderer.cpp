@@ -13,9 +13,70 @@
 * - Draw() may be overloaded for instancing, batching, or indexed meshes.
 */
 #include <Renderer/Renderer.h>
+#include <Renderer/StereoTarget.h>
+#include <Renderer/DomeTarget.h>
+#include <Renderer/GpuResourceRegistry.h>
+#include <Core/Profiler.h>
 #include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 
+namespace
+{
+    // std430 record read by basic.vert (DrawData block, binding 1), one per scene object
+    struct GpuDrawData
+    {
+        glm::mat4 model;
+        glm::vec4 normalMatrix[3];  // mat3 columns padded to vec4
+        glm::ivec4 misc;            // x = MaterialTable slot
+    };
+
+    // std140 block shared by both shaders (CameraBlock, binding 0), one per camera pass
+    struct GpuCameraBlock
+    {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::vec4 viewPos;
+        glm::vec4 lightDir;
+        glm::vec4 lightColor;
+    };
+
+    // std140 block read by basic_multiview.vert (ViewArrayBlock, binding 3), one per multi-view pass
+    struct GpuViewArray
+    {
+        glm::mat4 viewProjections[Renderer::MaxViewsPerPass];
+        glm::vec4 viewPositions[Renderer::MaxViewsPerPass];
+        glm::ivec4 viewLayers[Renderer::MaxViewsPerPass];     // x = layer for layered passes
+    };
+
+    constexpr unsigned int CameraBlockBinding = 0;
+    constexpr unsigned int DrawDataBinding = 1;
+    constexpr unsigned int ViewArrayBinding = 3;
+
+    bool HasExtension(const char* name)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension && std::strcmp(extension, name) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool ViewportsOverlap(const glm::ivec4& a, const glm::ivec4& b)
+    {
+        return a.x < b.x + b.z && b.x < a.x + a.z && a.y < b.y + b.w && b.y < a.y + a.w;
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+}
+
 Renderer::Renderer() = default;
 Renderer::~Renderer() = default;
 
@@ -33,8 +94,42 @@ void Renderer::Initialize() {
     // Check OpenGL version
     std::cout << "[Renderer] OpenGL Version: " << glGetString(GL_VERSION) << "\n";
     std::cout << "[Renderer] GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << "\n";
+
+    // Every GL object created from here on is recorded with its size
+    GpuResourceRegistry::Get().Initialize();
     
     shader = std::make_unique<Shader>("Shader/basic.vert", "Shader/basic.frag");
+
+    // Several cameras on one framebuffer can share a pass if the vertex shader may pick the viewport
+    if (HasExtension("GL_ARB_shader_viewport_layer_array"))
+    {
+        GLint maxViewports = 0;
+        glGetIntegerv(GL_MAX_VIEWPORTS, &maxViewports);
+        maxViewsPerPass = static_cast<unsigned int>(std::clamp<GLint>(maxViewports, 1, MaxViewsPerPass));
+        multiViewShader = std::make_unique<Shader>("Shader/basic_multiview.vert", "Shader/basic.frag");
+        multiViewSupported = true;
+        std::cout << "[Renderer] Multi-view passes enabled (up to " << maxViewsPerPass << " views)\n";
+    }
+    else
+    {
+        std::cout << "[Renderer] ARB_shader_viewport_layer_array missing, one pass per camera\n";
+    }
+
+    // Slot 0 of the material table is the fallback for objects without a material
+    defaultMaterial = std::make_shared<Material>();
+    materialTable.Register(defaultMaterial);
+
+    // Transient per-frame data is written straight into a persistently mapped ring
+    streamBuffer = std::make_unique<StreamBuffer>(StreamBufferSize);
+
+    // Lines and shapes submitted through DebugDraw from any thread
+    debugDraw = std::make_unique<DebugDraw>();
+
+    // Star field rendered into a cubemap, sampled behind the scene each pass
+    skyCache = std::make_unique<SkyCache>();
+
+    // Body names, drawn over the scene after decluttering
+    labelRenderer = std::make_unique<LabelRenderer>();
     
     // Check for OpenGL errors
     GLenum err = glGetError();
@@ -55,89 +150,325 @@ void Renderer::Clear(const glm::vec4& color)
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-/**
-* @brief Draws a mesh using the provided shader.
-*
-* Binds the shader and issues the mesh draw call. Assumes both objects are valid
-* and the OpenGL context is current. Mesh and Shader are not owned by Renderer.
-*
-* @param mesh   The mesh to render.
-* @param shader The shader program to use.
-*/
+void Renderer::ClearViewport(const glm::ivec4& viewport, const glm::vec4& color)
+{
+    // glClear ignores the viewport; the scissor limits it to this camera's rectangle
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(viewport.x, viewport.y, viewport.z, viewport.w);
+    Clear(color);
+    glDisable(GL_SCISSOR_TEST);
+}
 
-void Renderer::DrawScene(const CameraRenderData& camData, int layer)
+size_t Renderer::BuildPassViews(const CameraRenderData& camData, PassView out[2]) const
+{
+    const Camera& camera = *camData.camera;
+
+    if (camData.stereo == StereoMode::Mono)
+    {
+        PassView& view = out[0];
+        view.view = camera.GetViewMatrix();
+        view.projection = camera.GetProjectionMatrix();
+        view.position = camera.GetPosition();
+        view.viewport = camData.viewport;
+        view.framebuffer = camData.framebuffer;
+        view.layer = 0;
+        view.renderLayer = camData.renderLayer;
+        view.camera = &camera;
+        view.eye = -1;
+        return 1;
+    }
+
+    // Side by side halves the viewport; layered gives each eye the whole target
+    glm::ivec4 eyeViewport = camData.viewport;
+    if (camData.stereo == StereoMode::Layered && camData.stereoTarget)
+    {
+        camData.stereoTarget->Touch();
+        eyeViewport = glm::ivec4(0, 0, camData.stereoTarget->GetWidth(), camData.stereoTarget->GetHeight());
+    }
+    else
+        eyeViewport.z /= 2;
+    float aspect = static_cast<float>(eyeViewport.z) / static_cast<float>(std::max(eyeViewport.w, 1));
+
+    for (int eye = 0; eye < 2; ++eye)
+    {
+        PassView& view = out[eye];
+        float eyeOffset = (eye == 0 ? -0.5f : 0.5f) * camData.eyeSeparation;
+        camera.GetEyeMatrices(eyeOffset, camData.convergence, aspect, view.view, view.projection);
+        view.position = camera.GetPosition() + camera.GetRight() * eyeOffset;
+        view.viewport = eyeViewport;
+        if (camData.stereo == StereoMode::SideBySide)
+            view.viewport.x += eye * eyeViewport.z;
+        view.framebuffer = camData.stereo == StereoMode::Layered && camData.stereoTarget
+            ? camData.stereoTarget->GetEyeFramebuffer(eye) : camData.framebuffer;
+        view.layer = eye;
+        view.renderLayer = camData.renderLayer;
+        view.camera = &camera;
+        view.eye = eye;
+    }
+    return 2;
+}
+
+void Renderer::DrawLayeredStereo(const CameraRenderData& camData, const PassView eyes[2])
+{
+    const glm::vec4 clearColor(0.1f, 0.1f, 0.1f, 1.0f);
+
+    if (IsMultiViewActive())
+    {
+        // Both eyes at once: instance i goes to layer i (clearing a layered target clears every layer)
+        glBindFramebuffer(GL_FRAMEBUFFER, camData.stereoTarget->GetLayeredFramebuffer());
+        glViewport(eyes[0].viewport.x, eyes[0].viewport.y, eyes[0].viewport.z, eyes[0].viewport.w);
+        Clear(clearColor);
+        DrawViews(eyes, 2, camData.stereoTarget->GetLayeredFramebuffer());
+        return;
+    }
+
+    // Fallback: one ordinary pass per eye framebuffer
+    for (int eye = 0; eye < 2; ++eye)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, eyes[eye].framebuffer);
+        glViewport(eyes[eye].viewport.x, eyes[eye].viewport.y, eyes[eye].viewport.z, eyes[eye].viewport.w);
+        Clear(clearColor);
+        DrawViews(&eyes[eye], 1);
+    }
+}
+
+void Renderer::DrawDome(const CameraRenderData& camData)
+{
+    const DomeTarget& dome = *camData.domeTarget;
+    const Camera& camera = *camData.camera;
+    const int faceSize = dome.GetSettings().faceSize;
+    const glm::vec4 clearColor(0.1f, 0.1f, 0.1f, 1.0f);
+
+    // Faces outside the dome were dropped by the target; the rest share one projection
+    glm::mat4 cameraView = camera.GetViewMatrix();
+    glm::mat4 projection = DomeTarget::GetFaceProjection(camera.GetNearPlane(), camera.GetFarPlane());
+    PassView faces[6];
+    size_t faceCount = 0;
+    for (int i = 0; i < dome.GetActiveFaceCount(); ++i)
+    {
+        int face = dome.GetActiveFaces()[i];
+        PassView& view = faces[faceCount++];
+        view.view = DomeTarget::GetFaceView(face, cameraView);
+        view.projection = projection;
+        view.position = camera.GetPosition();
+        view.viewport = glm::ivec4(0, 0, faceSize, faceSize);
+        view.framebuffer = dome.GetFaceFramebuffer(face);
+        view.layer = face;
+        view.renderLayer = camData.renderLayer;
+        view.camera = &camera;
+        view.eye = -1;
+    }
+    stats.domeFaces += static_cast<unsigned int>(faceCount);
+
+    if (IsMultiViewActive() && faceCount > 1 && faceCount <= maxViewsPerPass)
+    {
+        // All faces at once: each view goes to its face's layer (the clear covers every face)
+        glBindFramebuffer(GL_FRAMEBUFFER, dome.GetLayeredFramebuffer());
+        glViewport(0, 0, faceSize, faceSize);
+        Clear(clearColor);
+        DrawViews(faces, faceCount, dome.GetLayeredFramebuffer());
+    }
+    else
+    {
+        for (size_t f = 0; f < faceCount; ++f)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, faces[f].framebuffer);
+            glViewport(0, 0, faceSize, faceSize);
+            Clear(clearColor);
+            DrawViews(&faces[f], 1);
+        }
+    }
+
+    // Fisheye warp, then a scaled copy into the camera's viewport
+    dome.Resolve();
+    glBindFramebuffer(GL_FRAMEBUFFER, camData.framebuffer);
+    ClearViewport(camData.viewport, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    dome.Present(camData.framebuffer, camData.viewport);
+}
+
+void Renderer::DrawViews(const PassView* views, size_t viewCount, unsigned int layeredFramebuffer)
 {
-    (void)layer;
-    
     if (!shader) {
         std::cerr << "[Renderer] ERROR: Shader is null!\n";
         return;
     }
-    
-    shader->Bind();
 
-    // Upload camera-specific uniforms
-    glm::mat4 view = camData.camera->GetViewMatrix();
-    glm::mat4 proj = camData.camera->GetProjectionMatrix();
+    auto passStart = Clock::now();
+
+    // One view uses the regular path; several share one instanced pass
+    bool multiView = viewCount > 1;
+    bool layered = multiView && layeredFramebuffer != 0;
+    Shader& passShader = multiView ? *multiViewShader : *shader;
+    const PassView& primary = views[0];
+    int renderLayer = primary.renderLayer;
+
+    passShader.Bind();
+    stats.scenePasses++;
+
+    // Light and the first view's matrices; the multi-view shader reads per-view data from the view array
+    UploadCameraData(primary);
+    if (multiView)
+    {
+        UploadViewArray(views, viewCount);
+        passShader.SetInt("uLayered", layered ? 1 : 0);
+
+        // Layered views share one viewport; the others get one viewport each
+        if (!layered)
+        {
+            float viewports[MaxViewsPerPass * 4];
+            for (size_t v = 0; v < viewCount; ++v)
+            {
+                viewports[v * 4 + 0] = static_cast<float>(views[v].viewport.x);
+                viewports[v * 4 + 1] = static_cast<float>(views[v].viewport.y);
+                viewports[v * 4 + 2] = static_cast<float>(views[v].viewport.z);
+                viewports[v * 4 + 3] = static_cast<float>(views[v].viewport.w);
+            }
+            glViewportArrayv(0, static_cast<GLsizei>(viewCount), viewports);
+        }
+    }
+
+    // Cull every object against the pass's views, collecting indirect commands.
+    // Both eyes of a stereo camera are covered by one union frustum.
+    viewFrustums.clear();
+    viewPositions.clear();
+    for (size_t v = 0; v < viewCount; ++v)
+    {
+        viewFrustums.emplace_back(views[v].projection * views[v].view);
+        viewPositions.push_back(views[v].position);
+    }
+    if (viewCount == 2 && views[0].eye == 0 && views[1].eye == 1 && views[0].camera == views[1].camera)
+    {
+        Frustum combined = Frustum::StereoUnion(views[0].projection * views[0].view, views[1].projection * views[1].view);
+        viewFrustums.assign(1, combined);
+    }
+
+    indirectCommands.clear();
+    objectDraws.clear();
+
+    for (size_t i = 0; i < sceneObjects.size(); ++i)
+    {
+        const RenderObject* obj = sceneObjects[i];
+        if (obj->renderLayer != renderLayer) continue;
 
-    shader->SetVec3("uLightDir", glm::normalize(glm::vec3(0.5f, 0.7f, 1.0f)));
+        size_t firstCommand = indirectCommands.size();
+        size_t commandCount = CullObject(*obj, static_cast<unsigned int>(i), viewFrustums.data(), viewFrustums.size(),
+            viewPositions.data(), viewPositions.size(), static_cast<unsigned int>(viewCount));
+        if (commandCount == 0) continue;
+
+        ObjectDraw draw;
+        draw.material = obj->material ? obj->material.get() : defaultMaterial.get();
+        draw.vao = obj->mesh->GetView().vao;
+        draw.firstCommand = firstCommand;
+        draw.commandCount = commandCount;
+        objectDraws.push_back(draw);
+    }
 
     // Draw all objects in scene
     int drawCount = 0;
     static bool firstFrame = true;
-    
-    for (const auto* obj : sceneObjects)
+
+    if (!indirectCommands.empty())
     {
-        if (obj->renderLayer != camData.renderLayer) continue;
+        size_t size = indirectCommands.size() * sizeof(IndirectCommand);
+        StreamBuffer::Allocation alloc = streamBuffer->Allocate(size);
+        if (alloc.IsValid())
+        {
+            std::memcpy(alloc.data, indirectCommands.data(), size);
+            stats.streamedBytes += size;
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, alloc.buffer);
 
-        // Apply material before drawing
-        if (obj->material) {
-            obj->material->Apply(*shader);
-        }
+            const Material* boundMaterial = nullptr;
+            for (const ObjectDraw& draw : objectDraws)
+            {
+                // Material parameters are already resident in the table; only rebind
+                // textures when the material changes between consecutive draws
+                if (draw.material != boundMaterial) {
+                    draw.material->Apply(passShader);
+                    boundMaterial = draw.material;
+                }
 
-        glm::mat4 model = obj->transform.GetModelMatrix();
-        glm::mat3 normalMatrix = obj->transform.GetNormalMatrix();
+                // One call for all surviving clusters; each command's base instance
+                // selects the object's record in the DrawData array
+                glBindVertexArray(draw.vao);
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                    (const void*)(alloc.offset + draw.firstCommand * sizeof(IndirectCommand)),
+                    static_cast<GLsizei>(draw.commandCount), sizeof(IndirectCommand));
+                stats.drawCalls++;
 
-        shader->SetMat4("uModel", model);
-        shader->SetMat4("uView", view);
-        shader->SetMat4("uProjection", proj);
-        shader->SetMat3("uNormalMatrix", normalMatrix);
-        shader->SetVec3("uViewPos", camData.camera->GetPosition());
-        shader->SetVec3("uLightColor", glm::vec3(1.0f, 1.0f, 1.0f));
-        shader->SetVec3("uLightDir", glm::normalize(glm::vec3(0.0f, 0.0f, 1.0f)));
-
-        if (firstFrame) {
-            glm::vec3 pos = obj->transform.GetPosition();
-            std::cout << "[Renderer] Drawing object at (" << pos.x << ", " << pos.y << ", " << pos.z << ")\n";
-        }
+                // Check for OpenGL errors after draw
+                GLenum err = glGetError();
+                if (err != GL_NO_ERROR && firstFrame) {
+                    std::cerr << "[Renderer] OpenGL Error after draw: " << err << "\n";
+                }
 
-        obj->mesh->Draw();
-        
-        // Check for OpenGL errors after draw
-        GLenum err = glGetError();
-        if (err != GL_NO_ERROR && firstFrame) {
-            std::cerr << "[Renderer] OpenGL Error after draw: " << err << "\n";
+                drawCount++;
+            }
+
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
         }
-        
-        drawCount++;
     }
     
     if (firstFrame) {
-        std::cout << "[Renderer] Drew " << drawCount << " objects in first frame\n";
-        glm::vec3 pos = camData.camera->GetPosition();
-        glm::vec3 front = camData.camera->GetFront();
+        std::cout << "[Renderer] Drew " << drawCount << " objects in first frame (" << viewCount << " views)\n";
+        glm::vec3 pos = primary.position;
+        glm::vec3 front = primary.camera->GetFront();
         std::cout << "[Renderer] Camera pos: (" << pos.x << ", " << pos.y << ", " << pos.z << ")\n";
         std::cout << "[Renderer] Camera front: (" << front.x << ", " << front.y << ", " << front.z << ")\n";
         std::cout << "[Renderer] Camera looking at: (" << (pos.x + front.x) << ", " 
                   << (pos.y + front.y) << ", " << (pos.z + front.z) << ")\n";
         
         // Print shader ID
-        std::cout << "[Renderer] Shader program ID: " << shader->GetID() << "\n";
+        std::cout << "[Renderer] Shader program ID: " << passShader.GetID() << "\n";
         
         firstFrame = false;
     }
 
-    shader->Unbind();
+    passShader.Unbind();
+    stats.sceneCpuSeconds += std::chrono::duration<double>(Clock::now() - passStart).count();
+
+    // Overlays are one or two draws each, so they simply run once per view
+    for (size_t v = 0; v < viewCount; ++v)
+    {
+        const PassView& view = views[v];
+        if (layered)
+            glBindFramebuffer(GL_FRAMEBUFFER, view.framebuffer);
+        if (multiView)
+        {
+            glViewport(view.viewport.x, view.viewport.y, view.viewport.z, view.viewport.w);
+            UploadCameraData(view);
+        }
+
+        // Cached stars fill whatever the scene left at the far plane
+        skyCache->Draw();
+
+        // Debug lines on top of the scene, depth-tested, with this pass's camera block
+        debugDraw->Render();
+
+        // Labels last: screen-space overlay without depth test
+        labelRenderer->Render(labels, view.projection * view.view,
+            glm::vec2(static_cast<float>(view.viewport.z), static_cast<float>(view.viewport.w)), *streamBuffer);
+        stats.labelsPlaced += labelRenderer->GetLayout().GetStats().placed;
+        stats.labelSeconds += labelRenderer->GetLayout().GetStats().seconds;
+        stats.labelPasses++;
+    }
+}
+
+bool Renderer::CanJoinViewGroup(const PassView& view) const
+{
+    if (viewGroup.empty())
+        return true;
+    if (!IsMultiViewActive() || viewGroup.size() >= maxViewsPerPass)
+        return false;
+
+    const PassView& first = viewGroup.front();
+    if (view.framebuffer != first.framebuffer || view.renderLayer != first.renderLayer)
+        return false;
+
+    // Overlapping views would share depth in one pass; they must stay in submission order
+    for (const PassView& member : viewGroup)
+        if (ViewportsOverlap(member.viewport, view.viewport))
+            return false;
+    return true;
 }
 
 void Renderer::RenderFrame(const std::vector<CameraRenderData>& cameras)
@@ -147,31 +478,302 @@ void Renderer::RenderFrame(const std::vector<CameraRenderData>& cameras)
 
     if (cameras.empty()) return; // Check if vector is empty
 
+    stats = RenderStats{};
+    GpuResourceRegistry::Get().BeginFrame();
+
+    // Re-send only materials whose parameters changed since last frame
+    materialTable.Upload();
+    materialTable.Bind();
+
+    // Model matrices and material slots for every object, shared by all cameras
+    UploadDrawData();
+
+    // Gather this frame's debug geometry once; every camera pass draws it
+    debugDraw->Collect(*streamBuffer);
+
+    // Compact at most one fragmented geometry page (GPU-side copy)
+    GeometryPool::Get().DefragmentIfNeeded();
+
+    // Refresh at most one sky face, around the first active camera (other views are close enough)
     for (const auto& camData : cameras)
     {
-        if (!camData.active || !camData.camera)
-            continue;
+        if (camData.active && camData.camera)
+        {
+            skyCache->Update(camData.camera->GetPosition());
+            break;
+        }
+    }
+
+    // Consecutive cameras on the same framebuffer and layer with disjoint viewports
+    // are drawn in one pass when multi-view is active; otherwise each gets its own
+    auto FlushViewGroup = [&]() {
+        if (viewGroup.empty()) return;
+        const PassView& first = viewGroup.front();
 
         // Bind frambuffer if needed
-        if (camData.framebuffer != currentFBO)
+        if (first.framebuffer != currentFBO)
         {
-            glBindFramebuffer(GL_FRAMEBUFFER, camData.framebuffer);
-            currentFBO = camData.framebuffer;
+            glBindFramebuffer(GL_FRAMEBUFFER, first.framebuffer);
+            currentFBO = first.framebuffer;
         }
 
-        // Set viewport for this camera
-        glViewport(camData.viewport.x, camData.viewport.y,
-            camData.viewport.z, camData.viewport.w);
+        // Clear each camera's own rectangle before the pass
+        for (const PassView& member : viewGroup)
+            ClearViewport(member.viewport, { 0.1f, 0.1f, 0.1f, 1.0f });
+
+        // Set viewport for this camera (a multi-view pass sets its own viewport array)
+        glViewport(first.viewport.x, first.viewport.y, first.viewport.z, first.viewport.w);
+
+        // Draw scene from the group's perspectives
+        DrawViews(viewGroup.data(), viewGroup.size());
+        viewGroup.clear();
+    };
 
-        // Clear before each camera pass
-        Clear({ 0.1f, 0.1f, 0.1f, 1.0f });
+    viewGroup.clear();
+    for (const auto& camData : cameras)
+    {
+        if (!camData.active || !camData.camera)
+            continue;
+
+        // Stereo cameras contribute two eye views; side-by-side eyes group like any other views
+        PassView views[2];
+        size_t viewCount = BuildPassViews(camData, views);
+
+        if (camData.domeTarget)
+        {
+            FlushViewGroup();
+            DrawDome(camData);
+            currentFBO = camData.framebuffer;   // Present() leaves the camera's framebuffer bound
+            continue;
+        }
+
+        if (camData.stereo == StereoMode::Layered && camData.stereoTarget)
+        {
+            FlushViewGroup();
+            DrawLayeredStereo(camData, views);
+            currentFBO = -1;    // Left on an eye framebuffer
+            continue;
+        }
 
-        // Draw scene from this camera's perspective
-        DrawScene(camData, camData.renderLayer);
+        for (size_t v = 0; v < viewCount; ++v)
+        {
+            if (!CanJoinViewGroup(views[v]))
+                FlushViewGroup();
+            viewGroup.push_back(views[v]);
+        }
     }
+    FlushViewGroup();
 
     // Return to default frambuffer after all cameras
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Fence this frame's part of the ring so it is not overwritten while in flight
+    streamBuffer->EndFrame();
+
+    // Periodic streaming report, averaged over the window
+    static unsigned int reportFrames = 0;
+    static size_t reportBytes = 0;
+    static double reportSeconds = 0.0;
+    reportFrames++;
+    reportBytes += stats.streamedBytes;
+    reportSeconds += stats.streamWriteSeconds;
+    if (reportFrames == 600) {
+        const StreamBuffer::Stats& ringStats = streamBuffer->GetStats();
+        double gbps = reportSeconds > 0.0 ? reportBytes / reportSeconds / 1e9 : 0.0;
+        std::cout << "[Renderer] Streamed " << (reportBytes / reportFrames) << " B/frame at "
+                  << gbps << " GB/s, fence waits: " << ringStats.fenceWaits
+                  << " (" << ringStats.fenceWaitSeconds * 1000.0 << " ms total)\n";
+        std::cout << "[Renderer] Scene passes: " << stats.scenePasses << " (" << stats.domeFaces << " dome faces)"
+                  << ", draw calls: " << stats.drawCalls
+                  << ", cull + submit " << stats.sceneCpuSeconds * 1000.0 << " ms (last frame)\n";
+        std::cout << "[Renderer] Clusters drawn: " << stats.clustersDrawn << "/" << stats.clustersTested
+                  << ", triangles submitted: " << stats.trianglesSubmitted << "\n";
+        std::cout << "[Renderer] Sky faces rendered: " << skyCache->GetStats().facesRendered
+                  << ", cubemap refreshes: " << skyCache->GetStats().refreshes << "\n";
+        // Every view lays out the same candidates: report the placement per view
+        unsigned int labelPasses = std::max(stats.labelPasses, 1u);
+        std::cout << "[Renderer] Labels placed: " << stats.labelsPlaced / labelPasses << "/" << labels.size()
+                  << " per view over " << stats.labelPasses << " views, layout "
+                  << stats.labelSeconds * 1000.0 << " ms (last frame, all views)\n";
+        GpuResourceRegistry::Get().PrintReport(0);
+        reportFrames = 0;
+        reportBytes = 0;
+        reportSeconds = 0.0;
+    }
+}
+
+void Renderer::UploadDrawData()
+{
+    if (sceneObjects.empty()) return;
+
+    size_t size = sceneObjects.size() * sizeof(GpuDrawData);
+    StreamBuffer::Allocation alloc = streamBuffer->Allocate(size, streamBuffer->GetStorageAlignment());
+    if (!alloc.IsValid()) return;
+
+    auto start = Clock::now();
+    ProfileScope scope("Renderer.UploadDrawData", sceneObjects.size());
+
+    // Assemble each record on the stack and copy it out in one go; the mapping
+    // is write-combined, so it must be written sequentially and never read
+    GpuDrawData* out = static_cast<GpuDrawData*>(alloc.data);
+    for (size_t i = 0; i < sceneObjects.size(); ++i)
+    {
+        const RenderObject* obj = sceneObjects[i];
+        const Material* material = obj->material ? obj->material.get() : defaultMaterial.get();
+        glm::mat3 normalMatrix = obj->transform.GetNormalMatrix();
+
+        GpuDrawData record;
+        record.model = obj->transform.GetModelMatrix();
+        record.normalMatrix[0] = glm::vec4(normalMatrix[0], 0.0f);
+        record.normalMatrix[1] = glm::vec4(normalMatrix[1], 0.0f);
+        record.normalMatrix[2] = glm::vec4(normalMatrix[2], 0.0f);
+        record.misc = glm::ivec4(material->GetTableSlot(), 0, 0, 0);
+        std::memcpy(out + i, &record, sizeof(record));
+    }
+
+    stats.streamWriteSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    stats.streamedBytes += size;
+
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, DrawDataBinding, alloc.buffer,
+        static_cast<GLintptr>(alloc.offset), static_cast<GLsizeiptr>(size));
+}
+
+size_t Renderer::CullObject(const RenderObject& obj, unsigned int objectIndex, const Frustum* frustums,
+    size_t frustumCount, const glm::vec3* cameraPositions, size_t positionCount, unsigned int instanceCount)
+{
+    if (!obj.mesh) return 0;
+
+    GeometryView view = obj.mesh->GetView();
+    if (view.indexCount == 0) return 0;
+
+    glm::mat4 model = obj.transform.GetModelMatrix();
+    glm::vec3 scale = obj.transform.GetScale();
+    float maxScale = std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+    float minScale = std::min(std::abs(scale.x), std::min(std::abs(scale.y), std::abs(scale.z)));
+
+    // Whole-object rejection first: the object is kept if any view sees it
+    glm::vec3 center = glm::vec3(model * glm::vec4(obj.mesh->GetBoundsCenter(), 1.0f));
+    float boundsRadius = obj.mesh->GetBoundsRadius() * maxScale;
+    bool anyView = false;
+    for (size_t f = 0; f < frustumCount && !anyView; ++f)
+        anyView = frustums[f].IntersectsSphere(center, boundsRadius);
+    if (!anyView)
+        return 0;
+
+    // One instance per view; the multi-view shader maps gl_InstanceID to the viewport
+    IndirectCommand command;
+    command.instanceCount = instanceCount;
+    command.baseVertex = view.baseVertex;
+    command.baseInstance = objectIndex;
+
+    const std::vector<MeshCluster>& clusters = obj.mesh->GetClusters();
+    if (clusters.empty())
+    {
+        command.count = view.indexCount;
+        command.firstIndex = view.firstIndex;
+        indirectCommands.push_back(command);
+        stats.trianglesSubmitted += view.indexCount / 3;
+        return 1;
+    }
+
+    // Cone test in object space; angles survive only rotation + uniform scale
+    bool coneTest = maxScale - minScale <= 1e-4f * maxScale;
+    glm::mat4 inverseModel = glm::inverse(model);
+    glm::vec3 localCameras[MaxViewsPerPass];
+    for (size_t p = 0; p < positionCount; ++p)
+        localCameras[p] = glm::vec3(inverseModel * glm::vec4(cameraPositions[p], 1.0f));
+
+    size_t firstCommand = indirectCommands.size();
+    for (const MeshCluster& cluster : clusters)
+    {
+        stats.clustersTested++;
+
+        // Kept if some view sees its front and some frustum contains it (conservative for several views)
+        bool frontFacing = !coneTest || cluster.coneCutoff >= 1.0f;
+        for (size_t p = 0; p < positionCount && !frontFacing; ++p)
+        {
+            glm::vec3 toApex = cluster.coneApex - localCameras[p];
+            float distance = glm::length(toApex);
+            frontFacing = distance <= 0.0f || glm::dot(toApex / distance, cluster.coneAxis) < cluster.coneCutoff;
+        }
+        if (!frontFacing)
+            continue;
+
+        glm::vec3 clusterCenter = glm::vec3(model * glm::vec4(cluster.center, 1.0f));
+        bool inside = false;
+        for (size_t f = 0; f < frustumCount && !inside; ++f)
+            inside = frustums[f].IntersectsSphere(clusterCenter, cluster.radius * maxScale);
+        if (!inside)
+            continue;
+
+        stats.clustersDrawn++;
+        stats.trianglesSubmitted += cluster.indexCount / 3;
+
+        // Extend the previous command when the ranges are contiguous
+        unsigned int firstIndex = view.firstIndex + cluster.firstIndex;
+        if (indirectCommands.size() > firstCommand)
+        {
+            IndirectCommand& last = indirectCommands.back();
+            if (last.firstIndex + last.count == firstIndex)
+            {
+                last.count += cluster.indexCount;
+                continue;
+            }
+        }
+
+        command.firstIndex = firstIndex;
+        command.count = cluster.indexCount;
+        indirectCommands.push_back(command);
+    }
+    return indirectCommands.size() - firstCommand;
+}
+
+void Renderer::UploadViewArray(const PassView* views, size_t viewCount)
+{
+    StreamBuffer::Allocation alloc = streamBuffer->Allocate(sizeof(GpuViewArray), streamBuffer->GetUniformAlignment());
+    if (!alloc.IsValid()) return;
+
+    auto start = Clock::now();
+
+    // Unused slots are left untouched; the shader only indexes up to the instance count
+    GpuViewArray* out = static_cast<GpuViewArray*>(alloc.data);
+    for (size_t v = 0; v < viewCount; ++v)
+    {
+        glm::mat4 viewProjection = views[v].projection * views[v].view;
+        glm::vec4 position(views[v].position, 1.0f);
+        glm::ivec4 layer(views[v].layer, 0, 0, 0);
+        std::memcpy(&out->viewProjections[v], &viewProjection, sizeof(viewProjection));
+        std::memcpy(&out->viewPositions[v], &position, sizeof(position));
+        std::memcpy(&out->viewLayers[v], &layer, sizeof(layer));
+    }
+
+    stats.streamWriteSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    stats.streamedBytes += sizeof(GpuViewArray);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, ViewArrayBinding, alloc.buffer,
+        static_cast<GLintptr>(alloc.offset), static_cast<GLsizeiptr>(sizeof(GpuViewArray)));
+}
+
+void Renderer::UploadCameraData(const PassView& view)
+{
+    StreamBuffer::Allocation alloc = streamBuffer->Allocate(sizeof(GpuCameraBlock), streamBuffer->GetUniformAlignment());
+    if (!alloc.IsValid()) return;
+
+    auto start = Clock::now();
+
+    GpuCameraBlock block;
+    block.view = view.view;
+    block.projection = view.projection;
+    block.viewPos = glm::vec4(view.position, 1.0f);
+    block.lightDir = glm::vec4(glm::normalize(glm::vec3(0.0f, 0.0f, 1.0f)), 0.0f);
+    block.lightColor = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    std::memcpy(alloc.data, &block, sizeof(block));
+
+    stats.streamWriteSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    stats.streamedBytes += sizeof(block);
+
+    glBindBufferRange(GL_UNIFORM_BUFFER, CameraBlockBinding, alloc.buffer,
+        static_cast<GLintptr>(alloc.offset), sizeof(GpuCameraBlock));
 }
 
 
@@ -180,10 +782,19 @@ void Renderer::AddRenderObject(const RenderObject& object)
     // Store pointer to the object instead of copying it
     // This avoids copying the Mesh which contains OpenGL resources
     sceneObjects.push_back(&object);
+
+    if (object.material)
+        materialTable.Register(object.material);
+}
+
+void Renderer::AddLabel(const LabelCandidate& label)
+{
+    labels.push_back(label);
 }
 
 void Renderer::ResetSceneObjects()
 {
     sceneObjects.clear();
+    labels.clear();
 }
 
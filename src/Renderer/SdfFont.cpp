@@ -0,0 +1,240 @@
+/**
+ * @file SdfFont.cpp
+ * @brief Builds the built-in SDF atlas from a 5x7 bitmap font and uploads it.
+ *
+ * Grid units: one bitmap pixel = 1 unit, baseline at y = 0, cap height 7 units
+ * (= 1 em). Stroke nodes sit at pixel centers with radius StrokeRadius; the
+ * atlas stores the distance to the union of the node capsules.
+ */
+#include <Renderer/SdfFont.h>
+#include <Core/JobSystem.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+	// Classic 5x7 LCD font, printable ASCII. Five column bytes per glyph, bit 0 = top row.
+	const uint8_t Font5x7[95][5] = {
+		{ 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, { 0x00, 0x07, 0x00, 0x07, 0x00 }, // space ! "
+		{ 0x14, 0x7F, 0x14, 0x7F, 0x14 }, { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, // # $ %
+		{ 0x36, 0x49, 0x55, 0x22, 0x50 }, { 0x00, 0x05, 0x03, 0x00, 0x00 }, { 0x00, 0x1C, 0x22, 0x41, 0x00 }, // & ' (
+		{ 0x00, 0x41, 0x22, 0x1C, 0x00 }, { 0x08, 0x2A, 0x1C, 0x2A, 0x08 }, { 0x08, 0x08, 0x3E, 0x08, 0x08 }, // ) * +
+		{ 0x00, 0x50, 0x30, 0x00, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, { 0x00, 0x60, 0x60, 0x00, 0x00 }, // , - .
+		{ 0x20, 0x10, 0x08, 0x04, 0x02 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // / 0 1
+		{ 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 }, // 2 3 4
+		{ 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 }, // 5 6 7
+		{ 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, { 0x00, 0x36, 0x36, 0x00, 0x00 }, // 8 9 :
+		{ 0x00, 0x56, 0x36, 0x00, 0x00 }, { 0x08, 0x14, 0x22, 0x41, 0x00 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, // ; < =
+		{ 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x51, 0x09, 0x06 }, { 0x32, 0x49, 0x79, 0x41, 0x3E }, // > ? @
+		{ 0x7E, 0x11, 0x11, 0x11, 0x7E }, { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // A B C
+		{ 0x7F, 0x41, 0x41, 0x22, 0x1C }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, { 0x7F, 0x09, 0x09, 0x01, 0x01 }, // D E F
+		{ 0x3E, 0x41, 0x41, 0x51, 0x32 }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, // G H I
+		{ 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, { 0x7F, 0x40, 0x40, 0x40, 0x40 }, // J K L
+		{ 0x7F, 0x02, 0x04, 0x02, 0x7F }, { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E }, // M N O
+		{ 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, { 0x7F, 0x09, 0x19, 0x29, 0x46 }, // P Q R
+		{ 0x46, 0x49, 0x49, 0x49, 0x31 }, { 0x01, 0x01, 0x7F, 0x01, 0x01 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, // S T U
+		{ 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x7F, 0x20, 0x18, 0x20, 0x7F }, { 0x63, 0x14, 0x08, 0x14, 0x63 }, // V W X
+		{ 0x03, 0x04, 0x78, 0x04, 0x03 }, { 0x61, 0x51, 0x49, 0x45, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x00 }, // Y Z [
+		{ 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x7F, 0x00 }, { 0x04, 0x02, 0x01, 0x02, 0x04 }, // \ ] ^
+		{ 0x40, 0x40, 0x40, 0x40, 0x40 }, { 0x00, 0x01, 0x02, 0x04, 0x00 }, { 0x20, 0x54, 0x54, 0x54, 0x78 }, // _ ` a
+		{ 0x7F, 0x48, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x20 }, { 0x38, 0x44, 0x44, 0x48, 0x7F }, // b c d
+		{ 0x38, 0x54, 0x54, 0x54, 0x18 }, { 0x08, 0x7E, 0x09, 0x01, 0x02 }, { 0x0C, 0x52, 0x52, 0x52, 0x3E }, // e f g
+		{ 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, { 0x20, 0x40, 0x44, 0x3D, 0x00 }, // h i j
+		{ 0x7F, 0x10, 0x28, 0x44, 0x00 }, { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x18, 0x04, 0x78 }, // k l m
+		{ 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, { 0x7C, 0x14, 0x14, 0x14, 0x08 }, // n o p
+		{ 0x08, 0x14, 0x14, 0x18, 0x7C }, { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x20 }, // q r s
+		{ 0x04, 0x3F, 0x44, 0x40, 0x20 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, { 0x1C, 0x20, 0x40, 0x20, 0x1C }, // t u v
+		{ 0x3C, 0x40, 0x30, 0x40, 0x3C }, { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x0C, 0x50, 0x50, 0x50, 0x3C }, // w x y
+		{ 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, { 0x00, 0x00, 0x7F, 0x00, 0x00 }, // z { |
+		{ 0x00, 0x41, 0x36, 0x08, 0x00 }, { 0x08, 0x04, 0x08, 0x10, 0x08 },                                     // } ~
+	};
+
+	constexpr int GridColumns = 5;
+	constexpr int GridRows = 7;			///< = 1 em
+	constexpr float StrokeRadius = 0.45f;	///< In grid units
+	constexpr float Padding = 1.0f;		///< Cell margin around the 5x7 box, in grid units
+	constexpr float Spread = 0.75f;		///< Distance (grid units) mapped to 0 and 1 on either side of the edge
+	constexpr int TexelsPerUnit = 8;
+	constexpr int AtlasColumns = 16;
+
+	constexpr int CellWidth = static_cast<int>((GridColumns + 2 * Padding) * TexelsPerUnit);	// 56
+	constexpr int CellHeight = static_cast<int>((GridRows + 2 * Padding) * TexelsPerUnit);		// 72
+
+	struct Segment
+	{
+		glm::vec2 a;
+		glm::vec2 b;
+	};
+
+	bool IsLit(const uint8_t* columns, int column, int row)
+	{
+		if (column < 0 || column >= GridColumns || row < 0 || row >= GridRows)
+			return false;
+		return (columns[column] >> row) & 1;
+	}
+
+	// Stroke skeleton: a node per lit pixel, capsules to lit neighbours; diagonals
+	// only where no orthogonal path already joins the two pixels
+	void BuildSkeleton(const uint8_t* columns, std::vector<Segment>& segments)
+	{
+		segments.clear();
+		auto Center = [](int column, int row) {
+			return glm::vec2(column + 0.5f, GridRows - row - 0.5f);	// Row 0 is the top row
+		};
+
+		for (int c = 0; c < GridColumns; ++c)
+		{
+			for (int r = 0; r < GridRows; ++r)
+			{
+				if (!IsLit(columns, c, r))
+					continue;
+
+				glm::vec2 p = Center(c, r);
+				segments.push_back({ p, p });
+
+				bool right = IsLit(columns, c + 1, r);
+				bool down = IsLit(columns, c, r + 1);
+				bool left = IsLit(columns, c - 1, r);
+				if (right)
+					segments.push_back({ p, Center(c + 1, r) });
+				if (down)
+					segments.push_back({ p, Center(c, r + 1) });
+				if (IsLit(columns, c + 1, r + 1) && !right && !down)
+					segments.push_back({ p, Center(c + 1, r + 1) });
+				if (IsLit(columns, c - 1, r + 1) && !left && !down)
+					segments.push_back({ p, Center(c - 1, r + 1) });
+			}
+		}
+	}
+
+	float SegmentDistance(const glm::vec2& p, const Segment& s)
+	{
+		glm::vec2 ab = s.b - s.a;
+		glm::vec2 ap = p - s.a;
+		float lengthSquared = glm::dot(ab, ab);
+		float t = lengthSquared > 0.0f ? std::clamp(glm::dot(ap, ab) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+		glm::vec2 d = ap - ab * t;
+		return std::sqrt(glm::dot(d, d));
+	}
+}
+
+SdfFont::SdfFont()
+{
+	BuildBuiltinFace();
+}
+
+SdfFont::~SdfFont()
+{
+	GpuResourceRegistry::Get().Unregister(record);
+	if (texture)
+		glDeleteTextures(1, &texture);
+}
+
+void SdfFont::BuildBuiltinFace()
+{
+	const int glyphCount = LastChar - FirstChar + 1;
+	const int atlasRows = (glyphCount + AtlasColumns - 1) / AtlasColumns;
+	atlasWidth = AtlasColumns * CellWidth;
+	atlasHeight = atlasRows * CellHeight;
+	atlas.assign(static_cast<size_t>(atlasWidth) * atlasHeight, 0);
+	glyphs.assign(glyphCount, SdfGlyph{});
+
+	// Everything in em: 1 em = GridRows units
+	const float em = 1.0f / GridRows;
+	distanceRange = 2.0f * Spread * em;
+
+	// Glyph cells are disjoint, so they are built in parallel
+	JobSystem::Get().ParallelFor(static_cast<size_t>(glyphCount), [&](size_t index) {
+		int g = static_cast<int>(index);
+		const uint8_t* columns = Font5x7[g];
+		int cellX = (g % AtlasColumns) * CellWidth;
+		int cellY = (atlasRows - 1 - g / AtlasColumns) * CellHeight;	// First glyphs in the top row
+
+		SdfGlyph& glyph = glyphs[g];
+		glyph.advance = (GridColumns + 1) * em;
+		glyph.visible = false;
+		for (int c = 0; c < GridColumns; ++c)
+			glyph.visible |= columns[c] != 0;
+		if (!glyph.visible)
+			return;
+
+		glyph.offset = glm::vec2(-Padding * em, -Padding * em);
+		glyph.size = glm::vec2((GridColumns + 2 * Padding) * em, (GridRows + 2 * Padding) * em);
+		glyph.uvMin = glm::vec2(static_cast<float>(cellX) / atlasWidth, static_cast<float>(cellY) / atlasHeight);
+		glyph.uvMax = glm::vec2(static_cast<float>(cellX + CellWidth) / atlasWidth,
+			static_cast<float>(cellY + CellHeight) / atlasHeight);
+
+		std::vector<Segment> segments;
+		BuildSkeleton(columns, segments);
+
+		for (int y = 0; y < CellHeight; ++y)
+		{
+			for (int x = 0; x < CellWidth; ++x)
+			{
+				// Texel center in grid units, cell origin at (-Padding, -Padding)
+				glm::vec2 p((x + 0.5f) / TexelsPerUnit - Padding, (y + 0.5f) / TexelsPerUnit - Padding);
+
+				float nearest = 1e9f;
+				for (const Segment& segment : segments)
+					nearest = std::min(nearest, SegmentDistance(p, segment));
+
+				float signedDistance = nearest - StrokeRadius;	// > 0 outside the stroke
+				float value = std::clamp(0.5f - signedDistance / (2.0f * Spread), 0.0f, 1.0f);
+				atlas[static_cast<size_t>(cellY + y) * atlasWidth + cellX + x] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+			}
+		}
+	});
+}
+
+void SdfFont::Upload()
+{
+	if (texture)
+		return;
+
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, atlasWidth, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// Linear filtering interpolates distances, which is what keeps edges smooth when magnified
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	record = GpuResourceRegistry::Get().Register(GpuResourceRegistry::Category::Texture, texture,
+		atlas.size() * GpuResourceRegistry::BytesPerTexel(GL_R8), GL_R8, "SdfFont atlas");
+
+	std::cout << "[SdfFont] Built " << glyphs.size() << " glyph atlas (" << atlasWidth << "x" << atlasHeight << ")\n";
+}
+
+void SdfFont::Bind(unsigned int unit) const
+{
+	GpuResourceRegistry::Get().Touch(record);
+	glActiveTexture(GL_TEXTURE0 + unit);
+	glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+const SdfGlyph& SdfFont::GetGlyph(char c) const
+{
+	int code = static_cast<unsigned char>(c);
+	if (code < FirstChar || code > LastChar)
+		code = '?';
+	return glyphs[code - FirstChar];
+}
+
+glm::vec2 SdfFont::Measure(std::string_view text, float pixelSize) const
+{
+	float width = 0.0f;
+	for (char c : text)
+		width += GetGlyph(c).advance;
+
+	// The last glyph's trailing gap is not part of the ink
+	if (!text.empty())
+		width -= 1.0f / GridRows;
+	return glm::vec2(std::max(width, 0.0f) * pixelSize, pixelSize);
+}
@@ -4,6 +4,7 @@
  */
 #include <Renderer/Shader.h>
 #include <glad/glad.h>
+#include <Core/MemoryTracker.h>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -20,6 +21,7 @@
  * @param fragmentSrc The source code for the fragment shader.
  */
 Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
+	MemoryTagScope tag(MemoryTag::Shader);
 	std::string vertexCode = LoadFile(vertexPath);
 	std::string fragmentCode = LoadFile(fragmentPath);
 
@@ -133,6 +135,11 @@ void Shader::SetFloat(const std::string& name, float value) const
 	glUniform1f(GetUniformLocation(name), value);
 }
 
+void Shader::SetVec2(const std::string& name, const glm::vec2& value) const
+{
+	glUniform2fv(GetUniformLocation(name), 1, &value[0]);
+}
+
 void Shader::SetVec3(const std::string& name, const glm::vec3& value) const
 {
 	glUniform3fv(GetUniformLocation(name), 1, &value[0]);
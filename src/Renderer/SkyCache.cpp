@@ -0,0 +1,199 @@
+/**
+ * @file SkyCache.cpp
+ * @brief Star cubemap capture (one face per frame) and sky sampling.
+ */
+#include <Renderer/SkyCache.h>
+#include <Renderer/Shader.h>
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace
+{
+	// GL cubemap face order (+X, -X, +Y, -Y, +Z, -Z) with the matching up vectors
+	const glm::vec3 FaceDirections[6] = {
+		{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+		{ 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+	};
+	const glm::vec3 FaceUps[6] = {
+		{ 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f },
+		{ 0.0f, 0.0f, -1.0f }, { 0.0f, -1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f }
+	};
+}
+
+SkyCache::SkyCache()
+	: SkyCache(Settings())
+{
+}
+
+SkyCache::SkyCache(const Settings& newSettings)
+	: settings(newSettings)
+{
+	catalog.Generate(StarCatalog::Settings());
+	const std::vector<Star>& stars = catalog.GetStars();
+
+	starShader = std::make_unique<Shader>("Shader/stars.vert", "Shader/stars.frag");
+	skyShader = std::make_unique<Shader>("Shader/sky.vert", "Shader/sky.frag");
+
+	// Two cubemaps so a refresh never shows a mix of old and new faces.
+	// R11G11B10F keeps bright stars from clipping when they overlap.
+	glGenTextures(2, cubemaps);
+	for (unsigned int cubemap : cubemaps)
+	{
+		glBindTexture(GL_TEXTURE_CUBE_MAP, cubemap);
+		glTexStorage2D(GL_TEXTURE_CUBE_MAP, 1, GL_R11F_G11F_B10F, settings.faceSize, settings.faceSize);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	}
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+	glGenFramebuffers(1, &framebuffer);
+
+	// Static star buffer, same attribute setup style as GeometryPool
+	glGenBuffers(1, &starBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, starBuffer);
+	glBufferStorage(GL_ARRAY_BUFFER, stars.size() * sizeof(Star), stars.data(), 0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenVertexArrays(1, &starVao);
+	glBindVertexArray(starVao);
+	glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, offsetof(Star, position));
+	glVertexAttribFormat(1, 1, GL_FLOAT, GL_FALSE, offsetof(Star, magnitude));
+	glVertexAttribFormat(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(Star, color));
+	for (unsigned int attrib = 0; attrib < 3; ++attrib)
+	{
+		glVertexAttribBinding(attrib, 0);
+		glEnableVertexAttribArray(attrib);
+	}
+	glBindVertexBuffer(0, starBuffer, 0, sizeof(Star));
+	glBindVertexArray(0);
+
+	glGenVertexArrays(1, &skyVao);
+
+	// The nearest star shifts by about travel / distance radians; allow parallaxTexels of that
+	const float texelAngle = glm::radians(90.0f) / static_cast<float>(settings.faceSize);
+	refreshDistance = catalog.GetMinDistance() * std::tan(texelAngle * settings.parallaxTexels);
+
+	GpuResourceRegistry& registry = GpuResourceRegistry::Get();
+	size_t cubemapBytes = size_t(settings.faceSize) * size_t(settings.faceSize) * 6
+		* GpuResourceRegistry::BytesPerTexel(GL_R11F_G11F_B10F);
+	for (int i = 0; i < 2; ++i)
+		records[i] = registry.Register(GpuResourceRegistry::Category::RenderTarget, cubemaps[i], cubemapBytes,
+			GL_R11F_G11F_B10F, "SkyCache cubemap " + std::to_string(i));
+	records[2] = registry.Register(GpuResourceRegistry::Category::Buffer, starBuffer, stars.size() * sizeof(Star), 0,
+		"SkyCache stars");
+
+	std::cout << "[SkyCache] " << settings.faceSize << "^2 cubemap, refresh after "
+		<< refreshDistance << " units of camera travel\n";
+}
+
+SkyCache::~SkyCache()
+{
+	for (GpuResourceRegistry::Handle& record : records)
+		GpuResourceRegistry::Get().Unregister(record);
+	glDeleteVertexArrays(1, &skyVao);
+	glDeleteVertexArrays(1, &starVao);
+	glDeleteBuffers(1, &starBuffer);
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteTextures(2, cubemaps);
+}
+
+void SkyCache::RenderFace(unsigned int cubemap, int face, const glm::vec3& origin)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, cubemap, 0);
+	glViewport(0, 0, settings.faceSize, settings.faceSize);
+
+	const float black[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	glClearBufferfv(GL_COLOR, 0, black);
+
+	float far = catalog.GetMaxDistance() * 2.0f;	// Room for camera travel inside the shell
+	glm::mat4 view = glm::lookAt(origin, origin + FaceDirections[face], FaceUps[face]);
+	glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, far);
+
+	// Stars are additive points; no depth needed for a background layer
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE);
+	glEnable(GL_PROGRAM_POINT_SIZE);
+
+	starShader->Bind();
+	starShader->SetMat4("uFaceViewProjection", projection * view);
+	starShader->SetFloat("uPointScale", settings.pointScale * static_cast<float>(settings.faceSize) / 1024.0f);
+	glBindVertexArray(starVao);
+	glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(catalog.GetStars().size()));
+	glBindVertexArray(0);
+	starShader->Unbind();
+
+	glDisable(GL_PROGRAM_POINT_SIZE);
+	glDisable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	stats.facesRendered++;
+	stats.lastFaceSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void SkyCache::Update(const glm::vec3& cameraPosition)
+{
+	if (!valid)
+	{
+		// Nothing to show yet: fill the front cubemap in one go
+		for (int face = 0; face < 6; ++face)
+			RenderFace(cubemaps[front], face, cameraPosition);
+		frontOrigin = cameraPosition;
+		valid = true;
+		return;
+	}
+
+	if (nextFace < 0)
+	{
+		if (glm::length(cameraPosition - frontOrigin) < refreshDistance)
+			return;
+		backOrigin = cameraPosition;
+		nextFace = 0;
+	}
+
+	RenderFace(cubemaps[1 - front], nextFace, backOrigin);
+	if (++nextFace == 6)
+	{
+		front = 1 - front;
+		frontOrigin = backOrigin;
+		nextFace = -1;
+		stats.refreshes++;
+	}
+}
+
+void SkyCache::Draw() const
+{
+	if (!valid)
+		return;
+
+	GpuResourceRegistry::Get().Touch(records[front]);
+
+	// Far plane only: fragments survive where the scene left the cleared depth
+	glDepthFunc(GL_LEQUAL);
+	glDepthMask(GL_FALSE);
+
+	skyShader->Bind();
+	skyShader->SetInt("uSky", 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, cubemaps[front]);
+	glBindVertexArray(skyVao);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+	skyShader->Unbind();
+
+	glDepthMask(GL_TRUE);
+	glDepthFunc(GL_LESS);
+}
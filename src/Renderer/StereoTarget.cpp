@@ -0,0 +1,78 @@
+/**
+ * @file StereoTarget.cpp
+ * @brief Texture-array framebuffers for layered stereo output.
+ */
+#include <Renderer/StereoTarget.h>
+#include <glad/glad.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+StereoTarget::StereoTarget(int w, int h)
+	: width(w), height(h)
+{
+	glGenTextures(1, &colorArray);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, colorArray);
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, width, height, 2);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glGenTextures(1, &depthArray);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, depthArray);
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT32F, width, height, 2);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	// Layered: all layers attached, the shader picks one per primitive
+	glGenFramebuffers(1, &layeredFramebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, layeredFramebuffer);
+	glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, colorArray, 0);
+	glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthArray, 0);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+
+	// Per eye: one layer of each array
+	glGenFramebuffers(2, eyeFramebuffers);
+	for (int eye = 0; eye < 2 && status == GL_FRAMEBUFFER_COMPLETE; ++eye)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, eyeFramebuffers[eye]);
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, colorArray, 0, eye);
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthArray, 0, eye);
+		status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	if (status != GL_FRAMEBUFFER_COMPLETE)
+	{
+		glDeleteFramebuffers(2, eyeFramebuffers);
+		glDeleteFramebuffers(1, &layeredFramebuffer);
+		glDeleteTextures(1, &depthArray);
+		glDeleteTextures(1, &colorArray);
+		throw std::runtime_error("StereoTarget: incomplete framebuffer (status " + std::to_string(status) + ")");
+	}
+
+	GpuResourceRegistry& registry = GpuResourceRegistry::Get();
+	size_t layerTexels = size_t(width) * size_t(height) * 2;
+	colorRecord = registry.Register(GpuResourceRegistry::Category::RenderTarget, colorArray,
+		layerTexels * GpuResourceRegistry::BytesPerTexel(GL_RGBA8), GL_RGBA8, "StereoTarget color");
+	depthRecord = registry.Register(GpuResourceRegistry::Category::RenderTarget, depthArray,
+		layerTexels * GpuResourceRegistry::BytesPerTexel(GL_DEPTH_COMPONENT32F), GL_DEPTH_COMPONENT32F, "StereoTarget depth");
+
+	std::cout << "[StereoTarget] Created " << width << "x" << height << " x2 layers\n";
+}
+
+void StereoTarget::Touch() const
+{
+	GpuResourceRegistry::Get().Touch(colorRecord);
+	GpuResourceRegistry::Get().Touch(depthRecord);
+}
+
+StereoTarget::~StereoTarget()
+{
+	GpuResourceRegistry::Get().Unregister(depthRecord);
+	GpuResourceRegistry::Get().Unregister(colorRecord);
+	glDeleteFramebuffers(2, eyeFramebuffers);
+	glDeleteFramebuffers(1, &layeredFramebuffer);
+	glDeleteTextures(1, &depthArray);
+	glDeleteTextures(1, &colorArray);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file StreamBuffer.cpp
+ * @brief Implementation of the fenced, persistently mapped ring allocator.
+ *
+ * Ring invariants:
+ *  - Regions never wrap: when an allocation does not fit before the end of
+ *    the buffer, the open region is closed (fenced) and the head restarts
+ *    at 0.
+ *  - inFlight is ordered oldest -> newest, which is also the order in which
+ *    the head will run into them, so waiting only ever pops from the front.
+ *  - Regions of the previous lap all start at or after the head; everything
+ *    before the head belongs to the current lap.
+ */
+#include <Renderer/StreamBuffer.h>
+#include <glad/glad.h>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+	size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+StreamBuffer::StreamBuffer(size_t size)
+	: capacity(size)
+{
+	GLint alignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	if (alignment > 0) uniformAlignment = static_cast<size_t>(alignment);
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+	if (alignment > 0) storageAlignment = static_cast<size_t>(alignment);
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+	mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, static_cast<GLsizeiptr>(capacity), flags));
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if (!mapped)
+		throw std::runtime_error("StreamBuffer: failed to persistently map buffer");
+
+	record = GpuResourceRegistry::Get().Register(GpuResourceRegistry::Category::Buffer, buffer, capacity, 0, "StreamBuffer ring");
+
+	std::cout << "[StreamBuffer] Mapped " << (capacity >> 20) << " MB ring (UBO align "
+		<< uniformAlignment << ", SSBO align " << storageAlignment << ")\n";
+}
+
+StreamBuffer::~StreamBuffer()
+{
+	for (auto& region : inFlight)
+		glDeleteSync(static_cast<GLsync>(region.fence));
+	GpuResourceRegistry::Get().Unregister(record);
+
+	if (buffer)
+	{
+		// Persistent mappings are released with the buffer
+		glDeleteBuffers(1, &buffer);
+	}
+}
+
+void StreamBuffer::CloseRegion()
+{
+	if (head == regionBegin)
+		return;
+
+	FencedRegion region;
+	region.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	region.begin = regionBegin;
+	region.end = head;
+	inFlight.push_back(region);
+
+	regionBegin = head;
+}
+
+void StreamBuffer::WaitUntil(size_t end)
+{
+	while (!inFlight.empty())
+	{
+		// Retire every previous-lap region that starts before end, including
+		// ones the alignment padding skips: the head must never pass a live region
+		FencedRegion& oldest = inFlight.front();
+		bool reached = oldest.begin >= head && oldest.begin < end;
+		if (!reached)
+			break;
+
+		GLsync fence = static_cast<GLsync>(oldest.fence);
+
+		// Fast path: already signaled
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			do {
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms slices
+			} while (result == GL_TIMEOUT_EXPIRED);
+			auto stop = std::chrono::high_resolution_clock::now();
+
+			stats.fenceWaits++;
+			stats.fenceWaitSeconds += std::chrono::duration<double>(stop - start).count();
+		}
+		if (result == GL_WAIT_FAILED)
+			std::cerr << "[StreamBuffer] glClientWaitSync failed\n";
+
+		glDeleteSync(fence);
+		inFlight.pop_front();
+	}
+}
+
+StreamBuffer::Allocation StreamBuffer::Allocate(size_t size, size_t alignment)
+{
+	Allocation allocation;
+	if (size == 0 || size > capacity)
+	{
+		std::cerr << "[StreamBuffer] Allocation of " << size << " bytes does not fit the ring\n";
+		return allocation;
+	}
+
+	size_t offset = AlignUp(head, alignment);
+	if (offset + size > capacity)
+	{
+		// Wrap: fence what has been written so far, then retire the rest of
+		// the previous lap so inFlight is again ordered from address 0
+		CloseRegion();
+		WaitUntil(capacity);
+		offset = 0;
+		head = 0;
+		regionBegin = 0;
+	}
+
+	WaitUntil(offset + size);
+
+	head = offset + size;
+
+	allocation.data = mapped + offset;
+	allocation.offset = offset;
+	allocation.size = size;
+	allocation.buffer = buffer;
+
+	stats.frameBytes += size;
+	stats.frameAllocations++;
+	stats.totalBytes += size;
+	return allocation;
+}
+
+void StreamBuffer::EndFrame()
+{
+	GpuResourceRegistry::Get().Touch(record);
+	CloseRegion();
+	stats.frameBytes = 0;
+	stats.frameAllocations = 0;
+}
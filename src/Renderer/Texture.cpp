@@ -1,22 +1,34 @@
 #include "Renderer/Texture.h"
 #include "glad/glad.h"
+#include "Core/MemoryTracker.h"
 #include <iostream>
 
-
 Texture::Texture()
 	:textureID(0), width(0), height(0), channels(0) {
 }
 
 Texture::~Texture()
 {
+	ReleaseDecoded();
 	if (textureID != 0)
 	{
+		GpuResourceRegistry::Get().Unregister(record);
 		glDeleteTextures(1, &textureID);
 		std::cout << "[Texture] Delete texture: " << path << "\n";
 	}
 }
 
 bool Texture::LoadFromFile(const std::string& filepath)
+{
+	return DecodeFromFile(filepath) && Upload();
+}
+
+bool Texture::LoadFromMemory(const unsigned char* bytes, size_t size, const std::string& name)
+{
+	return DecodeFromMemory(bytes, size, name) && Upload();
+}
+
+bool Texture::DecodeFromFile(const std::string& filepath)
 {
 	path = filepath;
 
@@ -41,6 +53,44 @@ bool Texture::LoadFromFile(const std::string& filepath)
 		return false;
 	}
 
+	return StoreDecoded(bitmap);
+}
+
+bool Texture::DecodeFromMemory(const unsigned char* bytes, size_t size, const std::string& name)
+{
+	path = name;
+
+	// FreeImage only reads from the block; the const_cast is safe
+	FIMEMORY* memory = FreeImage_OpenMemory(const_cast<BYTE*>(bytes), static_cast<DWORD>(size));
+	if (!memory)
+	{
+		std::cerr << "[Texture] Failed to open memory stream: " << name << "\n";
+		return false;
+	}
+
+	FREE_IMAGE_FORMAT format = FreeImage_GetFileTypeFromMemory(memory, 0);
+	if (format == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(format))
+	{
+		std::cerr << "[Texture] Unsupported image format: " << name << "\n";
+		FreeImage_CloseMemory(memory);
+		return false;
+	}
+
+	FIBITMAP* bitmap = FreeImage_LoadFromMemory(format, memory, 0);
+	FreeImage_CloseMemory(memory);
+	if (!bitmap)
+	{
+		std::cerr << "[Texture] Failed to load data: " << name << "\n";
+		return false;
+	}
+
+	return StoreDecoded(bitmap);
+}
+
+bool Texture::StoreDecoded(FIBITMAP* bitmap)
+{
+	ReleaseDecoded();
+
 	// Convert to 32-bit (RGBA) for consistency
 	FIBITMAP* bitmap32 = FreeImage_ConvertTo32Bits(bitmap);
 
@@ -49,7 +99,7 @@ bool Texture::LoadFromFile(const std::string& filepath)
 
 	if (!bitmap32)
 	{
-		std::cerr << "[Texture] Failed to convert to 32-bit: " << filepath << "\n";
+		std::cerr << "[Texture] Failed to convert to 32-bit: " << path << "\n";
 		return false;
 	}
 
@@ -58,7 +108,33 @@ bool Texture::LoadFromFile(const std::string& filepath)
 	height = FreeImage_GetHeight(bitmap32);
 	channels = 4;	// we converted to 32-bit, so it's always RGBA
 
-	unsigned char* data = FreeImage_GetBits(bitmap32);
+	// FreeImage allocates with malloc, so the decoded image is charged by hand while it is alive
+	decoded = bitmap32;
+	decodedBytes = size_t(FreeImage_GetPitch(bitmap32)) * height;
+	MemoryTracker::Get().AddExternal(MemoryTag::Texture, decodedBytes);
+	return true;
+}
+
+void Texture::ReleaseDecoded()
+{
+	if (!decoded)
+		return;
+
+	FreeImage_Unload(decoded);
+	MemoryTracker::Get().RemoveExternal(MemoryTag::Texture, decodedBytes);
+	decoded = nullptr;
+	decodedBytes = 0;
+}
+
+bool Texture::Upload()
+{
+	if (!decoded)
+	{
+		std::cerr << "[Texture] Nothing decoded to upload: " << path << "\n";
+		return false;
+	}
+
+	unsigned char* data = FreeImage_GetBits(decoded);
 
 	// Generate OpenGL texture
 	glGenTextures(1, &textureID);
@@ -79,10 +155,14 @@ bool Texture::LoadFromFile(const std::string& filepath)
 	// Generate mipmaps
 	glGenerateMipmap(GL_TEXTURE_2D);
 
+	record = GpuResourceRegistry::Get().Register(GpuResourceRegistry::Category::Texture, textureID,
+		GpuResourceRegistry::WithMipChain(size_t(width) * size_t(height) * GpuResourceRegistry::BytesPerTexel(GL_RGBA)),
+		GL_RGBA, "Texture " + path);
+
 	// Free CPU memory
-	FreeImage_Unload(bitmap32);
+	ReleaseDecoded();
 
-	std::cout << "[Texture] Loaded: " << filepath
+	std::cout << "[Texture] Loaded: " << path
 		<< " (" << width << "x" << height << ", " << channels << " channels\n";
 
 	return true;
@@ -90,6 +170,7 @@ bool Texture::LoadFromFile(const std::string& filepath)
 
 void Texture::Bind(unsigned int unit) const
 {
+	GpuResourceRegistry::Get().Touch(record);
 	glActiveTexture(GL_TEXTURE0 + unit);
 	glBindTexture(GL_TEXTURE_2D, textureID);
 }
@@ -0,0 +1,45 @@
+#include "Renderer/TextureCache.h"
+#include "Core/MemoryTracker.h"
+#include <iostream>
+
+TextureCache& TextureCache::Get()
+{
+	static TextureCache cache;
+	return cache;
+}
+
+std::shared_ptr<Texture> TextureCache::Load(const std::string& filePath)
+{
+	MemoryTagScope tag(MemoryTag::Texture);
+	if (auto existing = entries[filePath].lock())
+	{
+		hits++;
+		return existing;
+	}
+
+	auto texture = std::make_shared<Texture>();
+	if (!texture->LoadFromFile(filePath))
+		return nullptr;
+
+	loads++;
+	entries[filePath] = texture;
+	return texture;
+}
+
+std::shared_ptr<Texture> TextureCache::LoadFromMemory(const std::string& key, const unsigned char* data, size_t size)
+{
+	MemoryTagScope tag(MemoryTag::Texture);
+	if (auto existing = entries[key].lock())
+	{
+		hits++;
+		return existing;
+	}
+
+	auto texture = std::make_shared<Texture>();
+	if (!texture->LoadFromMemory(data, size, key))
+		return nullptr;
+
+	loads++;
+	entries[key] = texture;
+	return texture;
+}
@@ -27,7 +27,33 @@ glm::mat4 Camera::GetProjectionMatrix() const
 	// - fov controls zoom
 	// - aspect ensures correct proportions
 	// - near/far clip planes define depth range
-	return glm::perspective(glm::radians(fov), aspectRatio, nearPlane, farPlane);
+	if (tile == glm::vec4(0.0f, 0.0f, 1.0f, 1.0f))
+		return glm::perspective(glm::radians(fov), aspectRatio, nearPlane, farPlane);
+
+	// Tile of a display wall: the matching window of the full near plane
+	float top = nearPlane * tan(glm::radians(fov) * 0.5f);
+	float halfWidth = top * aspectRatio;
+	float left = -halfWidth + 2.0f * halfWidth * tile.x;
+	float bottom = -top + 2.0f * top * tile.y;
+	return glm::frustum(left, left + 2.0f * halfWidth * tile.z, bottom, bottom + 2.0f * top * tile.w, nearPlane, farPlane);
+}
+
+void Camera::SetTile(const glm::vec4& newTile, float wallAspect)
+{
+	tile = newTile;
+	aspectRatio = wallAspect;
+}
+
+void Camera::GetEyeMatrices(float eyeOffset, float convergence, float aspect, glm::mat4& view, glm::mat4& projection) const
+{
+	glm::vec3 eye = position + right * eyeOffset;
+	view = glm::lookAt(eye, eye + front, up);
+
+	// Shift the near-plane window so both frusta meet on the convergence plane
+	float top = nearPlane * tan(glm::radians(fov) * 0.5f);
+	float halfWidth = top * aspect;
+	float shift = eyeOffset * nearPlane / convergence;
+	projection = glm::frustum(-halfWidth - shift, halfWidth - shift, -top, top, nearPlane, farPlane);
 }
 
 void Camera::Move(const glm::vec3& delta)
@@ -47,6 +73,14 @@ void Camera::Rotate(float yawDelta, float pitchDelta)
 	UpdateCameraVectors();
 }
 
+void Camera::SetPose(const glm::vec3& newPosition, float newYaw, float newPitch)
+{
+	position = newPosition;
+	yaw = newYaw;
+	pitch = glm::clamp(newPitch, -89.0f, 89.0f);
+	UpdateCameraVectors();
+}
+
 void Camera::UpdateCameraVectors()
 {
 	// Converts yaw & pitch (in degrees) to a normalized direction vector
@@ -9,7 +9,7 @@
 CameraController::CameraController(Camera& cam)
 	: camera(cam){ }
 
-void CameraController::Update(float deltaTime)
+bool CameraController::Update(float deltaTime)
 {
 	glm::vec3 moveDelta(0.0f);
 	float velocity = movementSpeed * deltaTime;
@@ -33,4 +33,6 @@ void CameraController::Update(float deltaTime)
 	glm::dvec2 delta = Input::GetMouseDelta();
 	camera.Rotate(static_cast<float>(delta.x) * mouseSensitivity,
 		static_cast<float>(-delta.y) * mouseSensitivity);
+
+	return moveDelta != glm::vec3(0.0f) || delta.x != 0.0 || delta.y != 0.0;
 }
\ No newline at end of file
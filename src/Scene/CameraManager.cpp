@@ -111,6 +111,47 @@ void CameraManager::SetActive(const std::string& name, bool active)
 	}
 }
 
+void CameraManager::SetStereo(const std::string& name, StereoMode mode, float eyeSeparation,
+	float convergence, const StereoTarget* target)
+{
+	auto it = cameras.find(name);
+	if (it == cameras.end())
+		throw std::runtime_error("CameraManager: Camera not found: " + name);
+	if (mode == StereoMode::Layered && !target)
+		throw std::runtime_error("CameraManager: Layered stereo needs a StereoTarget: " + name);
+
+	it->second.stereo = mode;
+	it->second.eyeSeparation = eyeSeparation;
+	it->second.convergence = convergence;
+	it->second.stereoTarget = target;
+
+	// Keep the copy handed to the Renderer in sync
+	auto vecIt = std::find_if(activeCameras.begin(), activeCameras.end(),
+		[&name](const CameraRenderData& d) { return d.name == name; });
+	if (vecIt != activeCameras.end())
+		*vecIt = it->second;
+
+	std::cout << "[CameraManager] " << name << " stereo mode: "
+		<< (mode == StereoMode::Mono ? "mono" : mode == StereoMode::SideBySide ? "side-by-side" : "layered") << "\n";
+}
+
+void CameraManager::SetDome(const std::string& name, const DomeTarget* target)
+{
+	auto it = cameras.find(name);
+	if (it == cameras.end())
+		throw std::runtime_error("CameraManager: Camera not found: " + name);
+
+	it->second.domeTarget = target;
+
+	// Keep the copy handed to the Renderer in sync
+	auto vecIt = std::find_if(activeCameras.begin(), activeCameras.end(),
+		[&name](const CameraRenderData& d) { return d.name == name; });
+	if (vecIt != activeCameras.end())
+		*vecIt = it->second;
+
+	std::cout << "[CameraManager] " << name << " output: " << (target ? "dome master" : "perspective") << "\n";
+}
+
 CameraRenderData& CameraManager::GetCameraData(const std::string& name)
 { 
 	auto it = cameras.find(name);
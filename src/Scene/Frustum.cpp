@@ -0,0 +1,125 @@
+/**
+ * @file Frustum.cpp
+ * @brief Implements plane extraction and sphere tests for Frustum.
+ */
+
+#include "Scene/Frustum.h"
+#include <algorithm>
+
+Frustum::Frustum(const glm::mat4& viewProjection)
+{
+	Update(viewProjection);
+}
+
+void Frustum::Update(const glm::mat4& viewProjection)
+{
+	// GLM is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+	const glm::mat4& m = viewProjection;
+	glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+	glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+	glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+	glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+	planes[0] = row3 + row0;	// left
+	planes[1] = row3 - row0;	// right
+	planes[2] = row3 + row1;	// bottom
+	planes[3] = row3 - row1;	// top
+	planes[4] = row3 + row2;	// near (OpenGL clip space, z in [-w, w])
+	planes[5] = row3 - row2;	// far
+
+	// Normalize so w is a true distance and sphere radii can be compared directly
+	for (glm::vec4& plane : planes)
+	{
+		float length = glm::length(glm::vec3(plane));
+		if (length > 0.0f)
+			plane /= length;
+	}
+}
+
+Frustum Frustum::StereoUnion(const glm::mat4& leftViewProjection, const glm::mat4& rightViewProjection)
+{
+	const Frustum eyes[2] = { Frustum(leftViewProjection), Frustum(rightViewProjection) };
+	const glm::mat4 inverses[2] = { glm::inverse(leftViewProjection), glm::inverse(rightViewProjection) };
+
+	// Corner i of each eye: bit 0 = x (left/right), bit 1 = y (bottom/top), bit 2 = z (near/far)
+	glm::vec3 corners[2][8];
+	glm::vec3 centroid(0.0f);
+	for (int eye = 0; eye < 2; ++eye)
+	{
+		for (int i = 0; i < 8; ++i)
+		{
+			glm::vec4 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+			glm::vec4 world = inverses[eye] * ndc;
+			corners[eye][i] = glm::vec3(world) / world.w;
+			centroid += corners[eye][i] / 16.0f;
+		}
+	}
+
+	float extent = 0.0f;
+	for (int eye = 0; eye < 2; ++eye)
+		for (const glm::vec3& corner : corners[eye])
+			extent = std::max(extent, glm::length(corner - centroid));
+	const float tolerance = 1e-4f * extent;
+
+	auto EnclosesAll = [&](const glm::vec4& plane) {
+		for (int eye = 0; eye < 2; ++eye)
+			for (const glm::vec3& corner : corners[eye])
+				if (glm::dot(glm::vec3(plane), corner) + plane.w < -tolerance)
+					return false;
+		return true;
+	};
+
+	auto PlaneThrough = [&](const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+		glm::vec3 normal = glm::cross(b - a, c - a);
+		float length = glm::length(normal);
+		if (length <= 0.0f)
+			return glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		normal /= length;
+		if (glm::dot(normal, centroid - a) < 0.0f)
+			normal = -normal;	// Inward, like the extracted planes
+		return glm::vec4(normal, -glm::dot(normal, a));
+	};
+
+	Frustum combined;
+	for (int side = 0; side < 6; ++side)
+	{
+		glm::vec4 candidates[4] = { eyes[0].planes[side], eyes[1].planes[side], glm::vec4(0.0f), glm::vec4(0.0f) };
+		int candidateCount = 2;
+
+		// Left/right/bottom/top: chords from one eye's near edge to the other eye's far corner
+		if (side < 4)
+		{
+			int axisBit = side < 2 ? 1 : 2;		// x or y
+			int otherBit = side < 2 ? 2 : 1;
+			int sideBits = (side & 1) ? axisBit : 0;
+			for (int eye = 0; eye < 2; ++eye)
+			{
+				const glm::vec3* nearEye = corners[eye];
+				const glm::vec3* farEye = corners[1 - eye];
+				candidates[candidateCount++] = PlaneThrough(nearEye[sideBits], nearEye[sideBits | otherBit], farEye[sideBits | 4]);
+			}
+		}
+
+		// Planes that cannot be bounded are dropped (always inside)
+		combined.planes[side] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		for (int c = 0; c < candidateCount; ++c)
+		{
+			if (EnclosesAll(candidates[c]))
+			{
+				combined.planes[side] = candidates[c];
+				break;
+			}
+		}
+	}
+	return combined;
+}
+
+bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+{
+	for (const glm::vec4& plane : planes)
+	{
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,1116 @@
+/**
+ * @file GltfImporter.cpp
+ * @brief Implements glTF 2.0 / GLB import: SAX document reader, accessor conversion, resource creation.
+ */
+
+#include "Scene/GltfImporter.h"
+#include "Core/JobSystem.h"
+#include "Core/JsonReader.h"
+#include "Core/MappedFile.h"
+#include "Core/MemoryTracker.h"
+#include "Renderer/TextureCache.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+	// ---- Document (only the fields the engine consumes) ----
+
+	struct GltfBuffer
+	{
+		std::string uri;
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+	};
+
+	struct GltfBufferView
+	{
+		int buffer = -1;
+		size_t byteOffset = 0;
+		size_t byteLength = 0;
+		size_t byteStride = 0;
+	};
+
+	struct GltfAccessor
+	{
+		int bufferView = -1;
+		size_t byteOffset = 0;
+		int componentType = 0;
+		bool normalized = false;
+		size_t count = 0;
+		int components = 0;
+		bool sparse = false;
+	};
+
+	struct GltfImage
+	{
+		std::string uri;
+		int bufferView = -1;
+	};
+
+	struct GltfMaterial
+	{
+		float baseColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		float emissive[3] = { 0.0f, 0.0f, 0.0f };
+		float metallic = 1.0f;
+		float roughness = 1.0f;
+		int baseColorTexture = -1;
+		int normalTexture = -1;
+		int emissiveTexture = -1;
+	};
+
+	struct GltfPrimitive
+	{
+		int position = -1;
+		int normal = -1;
+		int texCoord = -1;
+		int tangent = -1;
+		int color = -1;
+		int indices = -1;
+		int material = -1;
+		int mode = 4;	// TRIANGLES
+	};
+
+	struct GltfMesh
+	{
+		std::string name;
+		std::vector<GltfPrimitive> primitives;
+	};
+
+	struct GltfNode
+	{
+		std::string name;
+		int mesh = -1;
+		std::vector<int> children;
+		bool hasMatrix = false;
+		float matrix[16] = { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+		float translation[3] = { 0.0f, 0.0f, 0.0f };
+		float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };	// x, y, z, w
+		float scale[3] = { 1.0f, 1.0f, 1.0f };
+	};
+
+	struct GltfDocument
+	{
+		std::vector<GltfBuffer> buffers;
+		std::vector<GltfBufferView> bufferViews;
+		std::vector<GltfAccessor> accessors;
+		std::vector<GltfImage> images;
+		std::vector<int> textures;		// texture -> image
+		std::vector<GltfMaterial> materials;
+		std::vector<GltfMesh> meshes;
+		std::vector<GltfNode> nodes;
+		std::vector<std::vector<int>> scenes;
+		int scene = -1;
+		std::string version;
+	};
+
+	constexpr int ComponentByte = 5120;
+	constexpr int ComponentUnsignedByte = 5121;
+	constexpr int ComponentShort = 5122;
+	constexpr int ComponentUnsignedShort = 5123;
+	constexpr int ComponentUnsignedInt = 5125;
+	constexpr int ComponentFloat = 5126;
+
+	template<typename T>
+	T& At(std::vector<T>& items, int index)
+	{
+		if (static_cast<size_t>(index) >= items.size())
+			items.resize(static_cast<size_t>(index) + 1);
+		return items[static_cast<size_t>(index)];
+	}
+
+	// ---- SAX handler: maps (path, value) events onto GltfDocument ----
+
+	class GltfHandler : public JsonHandler
+	{
+	private:
+		struct Segment
+		{
+			std::string key;	///< Object member name (empty for array elements)
+			int index = -1;		///< Array element index (-1 for object members)
+		};
+
+		struct Frame
+		{
+			Segment segment;	///< Position of this container in its parent
+			bool isArray = false;
+			int childCount = 0;
+		};
+
+		struct Value
+		{
+			double number = 0.0;
+			std::string_view string;
+			bool boolean = false;
+		};
+
+		GltfDocument& doc;
+		std::vector<Frame> frames;
+		std::string pendingKey;
+		std::vector<const Segment*> path;	///< Scratch: segments of the current value
+
+		// Segment of the value about to start (key in objects, index in arrays)
+		Segment NextSegment()
+		{
+			Segment segment;
+			if (!frames.empty())
+			{
+				if (frames.back().isArray)
+					segment.index = frames.back().childCount++;
+				else
+					segment.key = pendingKey;
+			}
+			return segment;
+		}
+
+		// Builds the path below the root object: frames[1..] + the current segment
+		void BuildPath(const Segment* current)
+		{
+			path.clear();
+			for (size_t i = 1; i < frames.size(); ++i)
+				path.push_back(&frames[i].segment);
+			if (current)
+				path.push_back(current);
+		}
+
+		bool Is(size_t i, const char* key) const { return i < path.size() && path[i]->key == key; }
+		int Index(size_t i) const { return i < path.size() ? path[i]->index : -1; }
+
+		static int ToInt(double value) { return static_cast<int>(value); }
+		static size_t ToSize(double value) { return value > 0.0 ? static_cast<size_t>(value) : 0; }
+
+		static int ComponentsOf(std::string_view type)
+		{
+			if (type == "SCALAR") return 1;
+			if (type == "VEC2") return 2;
+			if (type == "VEC3") return 3;
+			if (type == "VEC4" || type == "MAT2") return 4;
+			if (type == "MAT3") return 9;
+			if (type == "MAT4") return 16;
+			return 0;
+		}
+
+		// A container opens: make sure the element it describes exists
+		void OnContainer()
+		{
+			size_t n = path.size();
+			int i = Index(1);
+			if (n == 2 && i >= 0)
+			{
+				if (Is(0, "accessors")) At(doc.accessors, i);
+				else if (Is(0, "bufferViews")) At(doc.bufferViews, i);
+				else if (Is(0, "buffers")) At(doc.buffers, i);
+				else if (Is(0, "images")) At(doc.images, i);
+				else if (Is(0, "textures")) At(doc.textures, i) = -1;
+				else if (Is(0, "materials")) At(doc.materials, i);
+				else if (Is(0, "meshes")) At(doc.meshes, i);
+				else if (Is(0, "nodes")) At(doc.nodes, i);
+				else if (Is(0, "scenes")) At(doc.scenes, i);
+			}
+			else if (n == 3 && i >= 0 && Is(0, "accessors") && Is(2, "sparse"))
+			{
+				At(doc.accessors, i).sparse = true;
+			}
+			else if (n == 4 && i >= 0 && Is(0, "meshes") && Is(2, "primitives") && Index(3) >= 0)
+			{
+				At(At(doc.meshes, i).primitives, Index(3));
+			}
+		}
+
+		void OnNumber(double v)
+		{
+			size_t n = path.size();
+			if (n == 1 && Is(0, "scene")) { doc.scene = ToInt(v); return; }
+			if (n < 3 || Index(1) < 0) return;
+
+			int i = Index(1);
+			const std::string& field = path[2]->key;
+
+			if (Is(0, "accessors") && n == 3)
+			{
+				GltfAccessor& a = At(doc.accessors, i);
+				if (field == "bufferView") a.bufferView = ToInt(v);
+				else if (field == "byteOffset") a.byteOffset = ToSize(v);
+				else if (field == "componentType") a.componentType = ToInt(v);
+				else if (field == "count") a.count = ToSize(v);
+			}
+			else if (Is(0, "bufferViews") && n == 3)
+			{
+				GltfBufferView& view = At(doc.bufferViews, i);
+				if (field == "buffer") view.buffer = ToInt(v);
+				else if (field == "byteOffset") view.byteOffset = ToSize(v);
+				else if (field == "byteLength") view.byteLength = ToSize(v);
+				else if (field == "byteStride") view.byteStride = ToSize(v);
+			}
+			else if (Is(0, "images") && n == 3 && field == "bufferView")
+			{
+				At(doc.images, i).bufferView = ToInt(v);
+			}
+			else if (Is(0, "textures") && n == 3 && field == "source")
+			{
+				At(doc.textures, i) = ToInt(v);
+			}
+			else if (Is(0, "materials"))
+			{
+				GltfMaterial& m = At(doc.materials, i);
+				if (n == 4 && field == "emissiveFactor" && Index(3) >= 0 && Index(3) < 3)
+					m.emissive[Index(3)] = static_cast<float>(v);
+				else if (n == 4 && field == "normalTexture" && Is(3, "index"))
+					m.normalTexture = ToInt(v);
+				else if (n == 4 && field == "emissiveTexture" && Is(3, "index"))
+					m.emissiveTexture = ToInt(v);
+				else if (field == "pbrMetallicRoughness")
+				{
+					if (n == 4 && Is(3, "metallicFactor")) m.metallic = static_cast<float>(v);
+					else if (n == 4 && Is(3, "roughnessFactor")) m.roughness = static_cast<float>(v);
+					else if (n == 5 && Is(3, "baseColorFactor") && Index(4) >= 0 && Index(4) < 4)
+						m.baseColor[Index(4)] = static_cast<float>(v);
+					else if (n == 5 && Is(3, "baseColorTexture") && Is(4, "index"))
+						m.baseColorTexture = ToInt(v);
+				}
+			}
+			else if (Is(0, "meshes") && field == "primitives" && n >= 5 && Index(3) >= 0)
+			{
+				GltfPrimitive& p = At(At(doc.meshes, i).primitives, Index(3));
+				if (n == 5)
+				{
+					if (Is(4, "indices")) p.indices = ToInt(v);
+					else if (Is(4, "material")) p.material = ToInt(v);
+					else if (Is(4, "mode")) p.mode = ToInt(v);
+				}
+				else if (n == 6 && Is(4, "attributes"))
+				{
+					const std::string& attribute = path[5]->key;
+					if (attribute == "POSITION") p.position = ToInt(v);
+					else if (attribute == "NORMAL") p.normal = ToInt(v);
+					else if (attribute == "TEXCOORD_0") p.texCoord = ToInt(v);
+					else if (attribute == "TANGENT") p.tangent = ToInt(v);
+					else if (attribute == "COLOR_0") p.color = ToInt(v);
+				}
+			}
+			else if (Is(0, "nodes"))
+			{
+				GltfNode& node = At(doc.nodes, i);
+				int k = Index(3);
+				if (n == 3 && field == "mesh") node.mesh = ToInt(v);
+				else if (n == 4 && k >= 0)
+				{
+					if (field == "children") node.children.push_back(ToInt(v));
+					else if (field == "matrix" && k < 16) { node.matrix[k] = static_cast<float>(v); node.hasMatrix = true; }
+					else if (field == "translation" && k < 3) node.translation[k] = static_cast<float>(v);
+					else if (field == "rotation" && k < 4) node.rotation[k] = static_cast<float>(v);
+					else if (field == "scale" && k < 3) node.scale[k] = static_cast<float>(v);
+				}
+			}
+			else if (Is(0, "scenes") && n == 4 && field == "nodes" && Index(3) >= 0)
+			{
+				At(doc.scenes, i).push_back(ToInt(v));
+			}
+		}
+
+		void OnString(std::string_view v)
+		{
+			size_t n = path.size();
+			if (n == 2 && Is(0, "asset") && Is(1, "version")) { doc.version = v; return; }
+			if (n != 3 || Index(1) < 0) return;
+
+			int i = Index(1);
+			const std::string& field = path[2]->key;
+			if (Is(0, "accessors") && field == "type") At(doc.accessors, i).components = ComponentsOf(v);
+			else if (Is(0, "buffers") && field == "uri") At(doc.buffers, i).uri = v;
+			else if (Is(0, "images") && field == "uri") At(doc.images, i).uri = v;
+			else if (Is(0, "meshes") && field == "name") At(doc.meshes, i).name = v;
+			else if (Is(0, "nodes") && field == "name") At(doc.nodes, i).name = v;
+		}
+
+		void OnBool(bool v)
+		{
+			if (path.size() == 3 && Is(0, "accessors") && Index(1) >= 0 && Is(2, "normalized"))
+				At(doc.accessors, Index(1)).normalized = v;
+		}
+
+		bool Open(bool isArray)
+		{
+			Frame frame;
+			frame.segment = NextSegment();
+			frame.isArray = isArray;
+			frames.push_back(std::move(frame));
+
+			BuildPath(nullptr);
+			OnContainer();
+			return true;
+		}
+
+		bool Close()
+		{
+			frames.pop_back();
+			return true;
+		}
+
+	public:
+		explicit GltfHandler(GltfDocument& document) : doc(document) {}
+
+		bool StartObject() override { return Open(false); }
+		bool EndObject() override { return Close(); }
+		bool StartArray() override { return Open(true); }
+		bool EndArray() override { return Close(); }
+
+		bool Key(std::string_view key) override
+		{
+			pendingKey.assign(key.data(), key.size());
+			return true;
+		}
+
+		bool String(std::string_view value) override
+		{
+			Segment segment = NextSegment();
+			BuildPath(&segment);
+			OnString(value);
+			return true;
+		}
+
+		bool Number(double value) override
+		{
+			Segment segment = NextSegment();
+			BuildPath(&segment);
+			OnNumber(value);
+			return true;
+		}
+
+		bool Bool(bool value) override
+		{
+			Segment segment = NextSegment();
+			BuildPath(&segment);
+			OnBool(value);
+			return true;
+		}
+
+		bool Null() override
+		{
+			NextSegment();
+			return true;
+		}
+	};
+
+	// ---- Binary data access ----
+
+	bool DecodeBase64(std::string_view text, std::vector<uint8_t>& out)
+	{
+		auto Sextet = [](char c) -> int {
+			if (c >= 'A' && c <= 'Z') return c - 'A';
+			if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+			if (c >= '0' && c <= '9') return c - '0' + 52;
+			if (c == '+' || c == '-') return 62;
+			if (c == '/' || c == '_') return 63;
+			return -1;
+		};
+
+		out.clear();
+		out.reserve(text.size() / 4 * 3);
+		uint32_t accumulator = 0;
+		int bits = 0;
+		for (char c : text)
+		{
+			if (c == '=')
+				break;
+			int value = Sextet(c);
+			if (value < 0)
+				return false;
+			accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+			bits += 6;
+			if (bits >= 8)
+			{
+				bits -= 8;
+				out.push_back(static_cast<uint8_t>(accumulator >> bits));
+			}
+		}
+		return true;
+	}
+
+	// "data:<mime>;base64,<payload>" -> payload, or empty if not a base64 data URI
+	std::string_view DataUriPayload(const std::string& uri)
+	{
+		if (uri.compare(0, 5, "data:") != 0)
+			return {};
+		size_t marker = uri.find(";base64,");
+		if (marker == std::string::npos)
+			return {};
+		return std::string_view(uri).substr(marker + 8);
+	}
+
+	int HexDigit(char c)
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+
+	// Percent-decodes a relative URI. @return False for a '%' not followed by two hex digits.
+	bool DecodeUriPath(const std::string& uri, std::string& path)
+	{
+		path.clear();
+		path.reserve(uri.size());
+		for (size_t i = 0; i < uri.size(); ++i)
+		{
+			if (uri[i] != '%')
+			{
+				path += uri[i];
+				continue;
+			}
+
+			int high = i + 2 < uri.size() ? HexDigit(uri[i + 1]) : -1;
+			int low = high >= 0 ? HexDigit(uri[i + 2]) : -1;
+			if (low < 0)
+				return false;
+			path += static_cast<char>(high * 16 + low);
+			i += 2;
+		}
+		return true;
+	}
+
+	// True if [offset, offset + length) lies inside size bytes, without overflowing
+	bool RangeInside(size_t offset, size_t length, size_t size)
+	{
+		return offset <= size && length <= size - offset;
+	}
+
+	struct AccessorView
+	{
+		const uint8_t* data = nullptr;
+		size_t stride = 0;
+		size_t count = 0;
+		int componentType = 0;
+		int components = 0;
+		bool normalized = false;
+	};
+
+	size_t ComponentSize(int componentType)
+	{
+		switch (componentType)
+		{
+		case ComponentByte:
+		case ComponentUnsignedByte: return 1;
+		case ComponentShort:
+		case ComponentUnsignedShort: return 2;
+		case ComponentUnsignedInt:
+		case ComponentFloat: return 4;
+		default: return 0;
+		}
+	}
+
+	bool ResolveAccessor(const GltfDocument& doc, int index, AccessorView& view)
+	{
+		if (index < 0 || static_cast<size_t>(index) >= doc.accessors.size())
+			return false;
+
+		const GltfAccessor& accessor = doc.accessors[index];
+		if (accessor.sparse || accessor.bufferView < 0 || static_cast<size_t>(accessor.bufferView) >= doc.bufferViews.size())
+			return false;
+
+		const GltfBufferView& bufferView = doc.bufferViews[accessor.bufferView];
+		if (bufferView.buffer < 0 || static_cast<size_t>(bufferView.buffer) >= doc.buffers.size())
+			return false;
+
+		const GltfBuffer& buffer = doc.buffers[bufferView.buffer];
+		size_t elementSize = ComponentSize(accessor.componentType) * accessor.components;
+		if (elementSize == 0 || !buffer.data)
+			return false;
+
+		view.stride = bufferView.byteStride ? bufferView.byteStride : elementSize;
+		view.count = accessor.count;
+		view.componentType = accessor.componentType;
+		view.components = accessor.components;
+		view.normalized = accessor.normalized;
+
+		// Everything the accessor touches must lie inside the view, and the view inside the buffer.
+		// Offsets and counts come from the file, so the checks are written not to overflow
+		if (!RangeInside(bufferView.byteOffset, bufferView.byteLength, buffer.size))
+			return false;
+		if (accessor.count > 0)
+		{
+			if (!RangeInside(accessor.byteOffset, elementSize, bufferView.byteLength))
+				return false;
+			size_t spanAfterFirst = bufferView.byteLength - accessor.byteOffset - elementSize;
+			if (accessor.count - 1 > spanAfterFirst / view.stride)
+				return false;
+		}
+
+		view.data = buffer.data + bufferView.byteOffset + accessor.byteOffset;
+		return true;
+	}
+
+	// Reads up to `n` components of element i as floats (normalized integers mapped to [0,1] / [-1,1])
+	void ReadFloats(const AccessorView& view, size_t i, float* out, int n)
+	{
+		const uint8_t* element = view.data + i * view.stride;
+		int count = std::min(n, view.components);
+
+		if (view.componentType == ComponentFloat)
+		{
+			std::memcpy(out, element, count * sizeof(float));
+			return;
+		}
+
+		for (int c = 0; c < count; ++c)
+		{
+			float value = 0.0f;
+			switch (view.componentType)
+			{
+			case ComponentUnsignedByte:
+				value = element[c];
+				if (view.normalized) value /= 255.0f;
+				break;
+			case ComponentByte:
+				value = static_cast<int8_t>(element[c]);
+				if (view.normalized) value = std::max(value / 127.0f, -1.0f);
+				break;
+			case ComponentUnsignedShort:
+			{
+				uint16_t raw;
+				std::memcpy(&raw, element + c * 2, 2);
+				value = raw;
+				if (view.normalized) value /= 65535.0f;
+				break;
+			}
+			case ComponentShort:
+			{
+				int16_t raw;
+				std::memcpy(&raw, element + c * 2, 2);
+				value = raw;
+				if (view.normalized) value = std::max(value / 32767.0f, -1.0f);
+				break;
+			}
+			case ComponentUnsignedInt:
+			{
+				uint32_t raw;
+				std::memcpy(&raw, element + c * 4, 4);
+				value = static_cast<float>(raw);
+				break;
+			}
+			default:
+				break;
+			}
+			out[c] = value;
+		}
+	}
+
+	uint32_t ReadIndex(const AccessorView& view, size_t i)
+	{
+		const uint8_t* element = view.data + i * view.stride;
+		switch (view.componentType)
+		{
+		case ComponentUnsignedByte:
+			return element[0];
+		case ComponentUnsignedShort:
+		{
+			uint16_t value;
+			std::memcpy(&value, element, 2);
+			return value;
+		}
+		default:
+		{
+			uint32_t value;
+			std::memcpy(&value, element, 4);
+			return value;
+		}
+		}
+	}
+
+	// ---- Conversion ----
+
+	struct PrimitiveJob
+	{
+		int mesh = -1;
+		int primitive = -1;
+		glm::mat4 world = glm::mat4(1.0f);
+		std::string name;
+	};
+
+	struct PrimitiveResult
+	{
+		MeshData mesh;		// Clustered on the worker too, so the GL thread only uploads
+		const char* error = nullptr;
+	};
+
+	glm::mat4 LocalMatrix(const GltfNode& node)
+	{
+		if (node.hasMatrix)
+		{
+			// glTF matrices are column-major, like GLM
+			glm::mat4 m;
+			for (int c = 0; c < 4; ++c)
+				for (int r = 0; r < 4; ++r)
+					m[c][r] = node.matrix[c * 4 + r];
+			return m;
+		}
+
+		glm::mat4 T = glm::translate(glm::mat4(1.0f), glm::vec3(node.translation[0], node.translation[1], node.translation[2]));
+		glm::quat q(node.rotation[3], node.rotation[0], node.rotation[1], node.rotation[2]);
+		glm::mat4 R = glm::mat4_cast(q);
+		glm::mat4 S = glm::scale(glm::mat4(1.0f), glm::vec3(node.scale[0], node.scale[1], node.scale[2]));
+		return T * R * S;
+	}
+
+	void ConvertPrimitive(const GltfDocument& doc, const PrimitiveJob& job, PrimitiveResult& result)
+	{
+		const GltfPrimitive& primitive = doc.meshes[job.mesh].primitives[job.primitive];
+		if (primitive.mode != 4)
+		{
+			result.error = "not a triangle list";
+			return;
+		}
+
+		AccessorView positions;
+		if (!ResolveAccessor(doc, primitive.position, positions) || positions.count == 0)
+		{
+			result.error = "missing or invalid POSITION";
+			return;
+		}
+
+		AccessorView normals, texCoords, tangents, colors;
+		bool hasNormals = ResolveAccessor(doc, primitive.normal, normals) && normals.count == positions.count;
+		bool hasTexCoords = ResolveAccessor(doc, primitive.texCoord, texCoords) && texCoords.count == positions.count;
+		bool hasTangents = ResolveAccessor(doc, primitive.tangent, tangents) && tangents.count == positions.count;
+		bool hasColors = ResolveAccessor(doc, primitive.color, colors) && colors.count == positions.count;
+
+		glm::mat3 linear = glm::mat3(job.world);
+		glm::mat3 normalMatrix = glm::inverse(glm::transpose(linear));
+
+		size_t vertexCount = positions.count;
+		result.mesh.vertices.resize(vertexCount);
+		for (size_t i = 0; i < vertexCount; ++i)
+		{
+			Vertex& v = result.mesh.vertices[i];
+			float value[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+			ReadFloats(positions, i, value, 3);
+			v.position = glm::vec3(job.world * glm::vec4(value[0], value[1], value[2], 1.0f));
+
+			if (hasNormals) {
+				ReadFloats(normals, i, value, 3);
+				v.normal = glm::normalize(normalMatrix * glm::vec3(value[0], value[1], value[2]));
+			}
+			else {
+				v.normal = glm::vec3(0.0f);
+			}
+
+			if (hasTexCoords) {
+				ReadFloats(texCoords, i, value, 2);
+				// glTF UVs start at the top of the image; textures are uploaded bottom-up
+				v.texCoord = glm::vec2(value[0], 1.0f - value[1]);
+			}
+			else {
+				v.texCoord = glm::vec2(0.0f);
+			}
+
+			if (hasTangents) {
+				ReadFloats(tangents, i, value, 3);
+				v.tangent = glm::normalize(linear * glm::vec3(value[0], value[1], value[2]));
+			}
+			else {
+				v.tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+			}
+
+			if (hasColors) {
+				value[0] = value[1] = value[2] = 1.0f;
+				ReadFloats(colors, i, value, 3);
+				v.color = glm::vec3(value[0], value[1], value[2]);
+			}
+			else {
+				v.color = glm::vec3(1.0f);
+			}
+		}
+
+		AccessorView indices;
+		if (primitive.indices >= 0)
+		{
+			if (!ResolveAccessor(doc, primitive.indices, indices) || indices.components != 1 ||
+				(indices.componentType != ComponentUnsignedByte && indices.componentType != ComponentUnsignedShort &&
+				 indices.componentType != ComponentUnsignedInt))
+			{
+				result.error = "invalid index accessor";
+				return;
+			}
+
+			result.mesh.indices.resize(indices.count - indices.count % 3);
+			for (size_t i = 0; i < result.mesh.indices.size(); ++i)
+			{
+				uint32_t index = ReadIndex(indices, i);
+				if (index >= vertexCount)
+				{
+					result.error = "index out of range";
+					return;
+				}
+				result.mesh.indices[i] = index;
+			}
+		}
+		else
+		{
+			result.mesh.indices.resize(vertexCount - vertexCount % 3);
+			for (size_t i = 0; i < result.mesh.indices.size(); ++i)
+				result.mesh.indices[i] = static_cast<unsigned int>(i);
+		}
+
+		// Mirroring transforms flip the winding; restore counter-clockwise front faces
+		if (glm::determinant(linear) < 0.0f)
+			for (size_t i = 0; i + 2 < result.mesh.indices.size(); i += 3)
+				std::swap(result.mesh.indices[i + 1], result.mesh.indices[i + 2]);
+
+		// Smooth normals from area-weighted face normals
+		if (!hasNormals)
+		{
+			for (size_t i = 0; i + 2 < result.mesh.indices.size(); i += 3)
+			{
+				Vertex& a = result.mesh.vertices[result.mesh.indices[i]];
+				Vertex& b = result.mesh.vertices[result.mesh.indices[i + 1]];
+				Vertex& c = result.mesh.vertices[result.mesh.indices[i + 2]];
+				glm::vec3 faceNormal = glm::cross(b.position - a.position, c.position - a.position);
+				a.normal += faceNormal;
+				b.normal += faceNormal;
+				c.normal += faceNormal;
+			}
+			for (Vertex& v : result.mesh.vertices)
+			{
+				float length = glm::length(v.normal);
+				v.normal = length > 0.0f ? v.normal / length : glm::vec3(0.0f, 0.0f, 1.0f);
+			}
+		}
+
+		if (result.mesh.indices.empty())
+			result.error = "no triangles";
+		else
+			Mesh::BuildClusters(result.mesh);
+	}
+
+	std::string DirectoryOf(const std::string& path)
+	{
+		size_t slash = path.find_last_of("/\\");
+		return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+	}
+
+	uint32_t ReadU32(const uint8_t* bytes)
+	{
+		uint32_t value;
+		std::memcpy(&value, bytes, 4);
+		return value;
+	}
+}
+
+bool GltfImporter::Load(const std::string& path, ImportedModel& model, Stats* stats)
+{
+	MemoryTagScope tag(MemoryTag::Scene);	// Decode jobs on the workers are charged to General
+	using Clock = std::chrono::high_resolution_clock;
+	auto start = Clock::now();
+
+	MappedFile file;
+	if (!file.Open(path) || !file.IsOpen())
+	{
+		std::cerr << "[GltfImporter] Cannot read " << path << "\n";
+		return false;
+	}
+
+	// ---- Split GLB container / plain JSON ----
+	std::string_view json;
+	const uint8_t* binChunk = nullptr;
+	size_t binSize = 0;
+
+	const uint8_t* bytes = file.GetData();
+	size_t size = file.GetSize();
+	if (size >= 12 && ReadU32(bytes) == 0x46546C67)	// "glTF"
+	{
+		if (ReadU32(bytes + 4) != 2)
+		{
+			std::cerr << "[GltfImporter] " << path << ": unsupported GLB version\n";
+			return false;
+		}
+		size = std::min<size_t>(size, ReadU32(bytes + 8));
+
+		for (size_t offset = 12; offset + 8 <= size;)
+		{
+			size_t chunkLength = ReadU32(bytes + offset);
+			uint32_t chunkType = ReadU32(bytes + offset + 4);
+			const uint8_t* chunk = bytes + offset + 8;
+			if (chunkLength > size - offset - 8)
+				break;
+
+			if (chunkType == 0x4E4F534A && json.empty())	// "JSON"
+				json = std::string_view(reinterpret_cast<const char*>(chunk), chunkLength);
+			else if (chunkType == 0x004E4942 && !binChunk)	// "BIN\0"
+			{
+				binChunk = chunk;
+				binSize = chunkLength;
+			}
+			offset += 8 + ((chunkLength + 3) & ~size_t(3));
+		}
+
+		if (json.empty())
+		{
+			std::cerr << "[GltfImporter] " << path << ": GLB without JSON chunk\n";
+			return false;
+		}
+	}
+	else
+	{
+		json = std::string_view(reinterpret_cast<const char*>(bytes), size);
+	}
+
+	// ---- Parse ----
+	GltfDocument doc;
+	GltfHandler handler(doc);
+	std::string error;
+	if (!JsonReader::Parse(json, handler, &error))
+	{
+		std::cerr << "[GltfImporter] " << path << ": invalid JSON (" << error << ")\n";
+		return false;
+	}
+	if (doc.version.compare(0, 2, "2.") != 0)
+	{
+		std::cerr << "[GltfImporter] " << path << ": not a glTF 2.x asset\n";
+		return false;
+	}
+
+	// A malformed percent escape fails the load rather than opening some other file
+	std::string uriPath;
+	for (const GltfBuffer& buffer : doc.buffers)
+	{
+		if (!buffer.uri.empty() && DataUriPayload(buffer.uri).empty() && !DecodeUriPath(buffer.uri, uriPath))
+		{
+			std::cerr << "[GltfImporter] " << path << ": malformed buffer URI " << buffer.uri << "\n";
+			return false;
+		}
+	}
+	for (const GltfImage& image : doc.images)
+	{
+		if (!image.uri.empty() && DataUriPayload(image.uri).empty() && !DecodeUriPath(image.uri, uriPath))
+		{
+			std::cerr << "[GltfImporter] " << path << ": malformed image URI " << image.uri << "\n";
+			return false;
+		}
+	}
+
+	// ---- Resolve buffers (GLB chunk, external files, data URIs) ----
+	std::string directory = DirectoryOf(path);
+	std::vector<MappedFile> externalBuffers;
+	std::vector<std::vector<uint8_t>> embeddedBuffers;
+	externalBuffers.reserve(doc.buffers.size());
+	embeddedBuffers.reserve(doc.buffers.size());
+
+	for (size_t i = 0; i < doc.buffers.size(); ++i)
+	{
+		GltfBuffer& buffer = doc.buffers[i];
+		if (buffer.uri.empty())
+		{
+			buffer.data = binChunk;
+			buffer.size = binSize;
+		}
+		else if (!DataUriPayload(buffer.uri).empty())
+		{
+			embeddedBuffers.emplace_back();
+			if (DecodeBase64(DataUriPayload(buffer.uri), embeddedBuffers.back()))
+			{
+				buffer.data = embeddedBuffers.back().data();
+				buffer.size = embeddedBuffers.back().size();
+			}
+		}
+		else
+		{
+			externalBuffers.emplace_back();
+			DecodeUriPath(buffer.uri, uriPath);
+			if (externalBuffers.back().Open(directory + uriPath))
+			{
+				buffer.data = externalBuffers.back().GetData();
+				buffer.size = externalBuffers.back().GetSize();
+			}
+		}
+
+		if (!buffer.data)
+			std::cerr << "[GltfImporter] " << path << ": buffer " << i << " is unavailable\n";
+	}
+
+	// ---- Flatten the node hierarchy into conversion jobs ----
+	std::vector<PrimitiveJob> jobs;
+	auto AddMesh = [&](int meshIndex, const glm::mat4& world, const std::string& name) {
+		if (meshIndex < 0 || static_cast<size_t>(meshIndex) >= doc.meshes.size())
+			return;
+		const GltfMesh& mesh = doc.meshes[meshIndex];
+		for (size_t p = 0; p < mesh.primitives.size(); ++p)
+		{
+			PrimitiveJob job;
+			job.mesh = meshIndex;
+			job.primitive = static_cast<int>(p);
+			job.world = world;
+			job.name = (name.empty() ? mesh.name : name) + "/" + std::to_string(p);
+			jobs.push_back(std::move(job));
+		}
+	};
+
+	if (!doc.nodes.empty())
+	{
+		std::vector<int> roots;
+		int sceneIndex = doc.scene >= 0 ? doc.scene : 0;
+		if (static_cast<size_t>(sceneIndex) < doc.scenes.size())
+		{
+			roots = doc.scenes[sceneIndex];
+		}
+		else
+		{
+			// No scene: every node that is nobody's child is a root
+			std::vector<bool> isChild(doc.nodes.size(), false);
+			for (const GltfNode& node : doc.nodes)
+				for (int child : node.children)
+					if (child >= 0 && static_cast<size_t>(child) < isChild.size())
+						isChild[child] = true;
+			for (size_t i = 0; i < doc.nodes.size(); ++i)
+				if (!isChild[i])
+					roots.push_back(static_cast<int>(i));
+		}
+
+		// Depth-first with an explicit stack; the visit budget guards against cycles
+		std::vector<std::pair<int, glm::mat4>> stack;
+		for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+			stack.emplace_back(*it, glm::mat4(1.0f));
+
+		size_t visitBudget = doc.nodes.size() * 4 + 16;
+		while (!stack.empty() && visitBudget-- > 0)
+		{
+			auto [nodeIndex, parent] = stack.back();
+			stack.pop_back();
+			if (nodeIndex < 0 || static_cast<size_t>(nodeIndex) >= doc.nodes.size())
+				continue;
+
+			const GltfNode& node = doc.nodes[nodeIndex];
+			glm::mat4 world = parent * LocalMatrix(node);
+			AddMesh(node.mesh, world, node.name);
+
+			for (auto it = node.children.rbegin(); it != node.children.rend(); ++it)
+				stack.emplace_back(*it, world);
+		}
+	}
+	else
+	{
+		for (size_t m = 0; m < doc.meshes.size(); ++m)
+			AddMesh(static_cast<int>(m), glm::mat4(1.0f), std::string());
+	}
+
+	auto parsed = Clock::now();
+
+	// ---- Convert accessors in parallel (no GL calls here) ----
+	std::vector<PrimitiveResult> results(jobs.size());
+	JobSystem::Get().ParallelFor(jobs.size(), [&](size_t i) {
+		ConvertPrimitive(doc, jobs[i], results[i]);
+	});
+
+	auto converted = Clock::now();
+
+	// ---- Textures and materials ----
+	auto TextureFor = [&](int textureIndex) -> Texture* {
+		if (textureIndex < 0 || static_cast<size_t>(textureIndex) >= doc.textures.size())
+			return nullptr;
+		int imageIndex = doc.textures[textureIndex];
+		if (imageIndex < 0 || static_cast<size_t>(imageIndex) >= doc.images.size())
+			return nullptr;
+
+		const GltfImage& image = doc.images[imageIndex];
+		std::shared_ptr<Texture> texture;
+		std::string key = path + "#image" + std::to_string(imageIndex);
+
+		if (image.bufferView >= 0 && static_cast<size_t>(image.bufferView) < doc.bufferViews.size())
+		{
+			const GltfBufferView& view = doc.bufferViews[image.bufferView];
+			if (view.buffer >= 0 && static_cast<size_t>(view.buffer) < doc.buffers.size())
+			{
+				const GltfBuffer& buffer = doc.buffers[view.buffer];
+				if (buffer.data && RangeInside(view.byteOffset, view.byteLength, buffer.size))
+					texture = TextureCache::Get().LoadFromMemory(key, buffer.data + view.byteOffset, view.byteLength);
+			}
+		}
+		else if (!DataUriPayload(image.uri).empty())
+		{
+			std::vector<uint8_t> encoded;
+			if (DecodeBase64(DataUriPayload(image.uri), encoded))
+				texture = TextureCache::Get().LoadFromMemory(key, encoded.data(), encoded.size());
+		}
+		else if (!image.uri.empty())
+		{
+			std::string imagePath;
+			DecodeUriPath(image.uri, imagePath);
+			texture = TextureCache::Get().Load(directory + imagePath);
+		}
+
+		if (!texture)
+			return nullptr;
+		if (std::find(model.textures.begin(), model.textures.end(), texture) == model.textures.end())
+			model.textures.push_back(texture);
+		return texture.get();
+	};
+
+	model.materials.clear();
+	for (const GltfMaterial& source : doc.materials)
+	{
+		auto material = std::make_shared<Material>();
+		glm::vec3 baseColor(source.baseColor[0], source.baseColor[1], source.baseColor[2]);
+
+		// Metallic-roughness -> Phong: metals tint their highlight, dielectrics reflect ~4%;
+		// shininess follows the usual Blinn-Phong / GGX correspondence 2 / alpha^2 - 2
+		float alpha = std::max(source.roughness * source.roughness, 0.05f);
+		material->SetDiffuseColor(baseColor * (1.0f - source.metallic));
+		material->SetAmbientColor(baseColor * 0.2f);
+		material->SetSpecularColor(glm::mix(glm::vec3(0.04f), baseColor, source.metallic));
+		material->SetShininess(std::clamp(2.0f / (alpha * alpha) - 2.0f, 1.0f, 256.0f));
+		material->SetEmissiveColor(glm::vec3(source.emissive[0], source.emissive[1], source.emissive[2]));
+
+		material->SetTexture(Render::TextureType::Diffuse, TextureFor(source.baseColorTexture));
+		material->SetTexture(Render::TextureType::Normal, TextureFor(source.normalTexture));
+		material->SetTexture(Render::TextureType::Emissive, TextureFor(source.emissiveTexture));
+		model.materials.push_back(material);
+	}
+
+	// ---- Upload meshes ----
+	size_t totalVertices = 0, totalIndices = 0;
+	for (size_t i = 0; i < jobs.size(); ++i)
+	{
+		PrimitiveResult& result = results[i];
+		if (result.error)
+		{
+			std::cerr << "[GltfImporter] " << path << ": skipped primitive " << jobs[i].name << " (" << result.error << ")\n";
+			continue;
+		}
+
+		totalVertices += result.mesh.vertices.size();
+		totalIndices += result.mesh.indices.size();
+
+		ImportedModel::Part part;
+		part.name = jobs[i].name;
+		part.mesh = std::make_unique<Mesh>(std::move(result.mesh));
+
+		int materialIndex = doc.meshes[jobs[i].mesh].primitives[jobs[i].primitive].material;
+		if (materialIndex >= 0 && static_cast<size_t>(materialIndex) < model.materials.size())
+			part.material = model.materials[materialIndex];
+
+		model.parts.push_back(std::move(part));
+	}
+
+	auto uploaded = Clock::now();
+
+	Stats local;
+	local.parseSeconds = std::chrono::duration<double>(parsed - start).count();
+	local.convertSeconds = std::chrono::duration<double>(converted - parsed).count();
+	local.uploadSeconds = std::chrono::duration<double>(uploaded - converted).count();
+	local.vertices = totalVertices;
+	local.indices = totalIndices;
+	if (stats)
+		*stats = local;
+
+	std::cout << "[GltfImporter] Loaded " << path << ": " << model.parts.size() << " parts, "
+		<< totalVertices << " vertices, " << totalIndices / 3 << " triangles in "
+		<< (local.parseSeconds + local.convertSeconds + local.uploadSeconds) * 1000.0 << " ms (parse "
+		<< local.parseSeconds * 1000.0 << ", convert " << local.convertSeconds * 1000.0 << ", upload "
+		<< local.uploadSeconds * 1000.0 << ")\n";
+	return true;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file LabelLayout.cpp
+ * @brief Parallel label projection and greedy grid-based decluttering.
+ */
+#include <Scene/LabelLayout.h>
+#include <Core/JobSystem.h>
+#include <Renderer/SdfFont.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+bool LabelLayout::Overlaps(const Box& box, int cx0, int cy0, int cx1, int cy1, int columns) const
+{
+	for (int cy = cy0; cy <= cy1; ++cy)
+	{
+		for (int cx = cx0; cx <= cx1; ++cx)
+		{
+			for (int32_t n = cellHeads[cy * columns + cx]; n >= 0; n = nodes[n].next)
+			{
+				const Box& other = placedBoxes[nodes[n].box];
+				if (box.x0 < other.x1 && other.x0 < box.x1 && box.y0 < other.y1 && other.y0 < box.y1)
+					return true;
+			}
+		}
+	}
+	return false;
+}
+
+const std::vector<PlacedLabel>& LabelLayout::Run(const std::vector<LabelCandidate>& candidates,
+	const glm::mat4& viewProjection, const glm::vec2& viewportSize, const SdfFont& font)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	placed.clear();
+	stats = Stats{};
+	stats.candidates = candidates.size();
+	if (candidates.empty() || viewportSize.x <= 0.0f || viewportSize.y <= 0.0f)
+		return placed;
+
+	// ---- 1. Project and measure (parallel, one output vector per chunk) ----
+	size_t chunkCount = (candidates.size() + ChunkSize - 1) / ChunkSize;
+	if (chunkBoxes.size() < chunkCount)
+		chunkBoxes.resize(chunkCount);
+
+	JobSystem::Get().ParallelFor(chunkCount, [&](size_t chunk) {
+		std::vector<Box>& out = chunkBoxes[chunk];
+		out.clear();
+
+		size_t end = std::min(candidates.size(), (chunk + 1) * ChunkSize);
+		for (size_t i = chunk * ChunkSize; i < end; ++i)
+		{
+			const LabelCandidate& candidate = candidates[i];
+			glm::vec4 clip = viewProjection * glm::vec4(candidate.worldPosition, 1.0f);
+			if (clip.w <= 0.0f)
+				continue;	// Behind the camera
+
+			glm::vec3 ndc = glm::vec3(clip) / clip.w;
+			if (ndc.x < -1.0f || ndc.x > 1.0f || ndc.y < -1.0f || ndc.y > 1.0f || ndc.z < -1.0f || ndc.z > 1.0f)
+				continue;	// Anchor off screen or outside the depth range
+
+			glm::vec2 anchor((ndc.x * 0.5f + 0.5f) * viewportSize.x, (ndc.y * 0.5f + 0.5f) * viewportSize.y);
+			glm::vec2 size = font.Measure(candidate.text, settings.pixelSize);
+
+			Box box;
+			box.origin = anchor + settings.anchorOffset;
+			box.x0 = box.origin.x - settings.margin;
+			box.y0 = box.origin.y - settings.margin;
+			box.x1 = box.origin.x + size.x + settings.margin;
+			box.y1 = box.origin.y + size.y + settings.margin;
+			box.priority = candidate.priority;
+			box.candidate = static_cast<uint32_t>(i);
+			out.push_back(box);
+		}
+	});
+
+	boxes.clear();
+	for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+		boxes.insert(boxes.end(), chunkBoxes[chunk].begin(), chunkBoxes[chunk].end());
+	stats.visible = boxes.size();
+
+	// ---- 2. Priority order ----
+	// LSD radix sort on the priority bits (3 passes of 11 bits). It is stable, and
+	// boxes arrive in candidate order, so ties stay in candidate order and the
+	// layout does not flicker between frames.
+	size_t count = boxes.size();
+	sortKeys.resize(count);
+	sortScratch.resize(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &boxes[i].priority, sizeof(bits));
+		uint32_t ordered = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);	// Monotonic in the float value
+		sortKeys[i] = (static_cast<uint64_t>(~ordered) << 32) | static_cast<uint32_t>(i);	// Descending priority
+	}
+	for (int shift = 32; shift < 64; shift += 11)
+	{
+		uint32_t histogram[2048] = {};
+		for (uint64_t key : sortKeys)
+			histogram[(key >> shift) & 2047]++;
+		uint32_t sum = 0;
+		for (uint32_t& bucket : histogram)
+		{
+			uint32_t n = bucket;
+			bucket = sum;
+			sum += n;
+		}
+		for (uint64_t key : sortKeys)
+			sortScratch[histogram[(key >> shift) & 2047]++] = key;
+		sortKeys.swap(sortScratch);
+	}
+
+	// ---- 3. Greedy placement against the screen grid ----
+	float cellSize = std::max(settings.cellSize, 8.0f);
+	int columns = std::max(1, static_cast<int>(std::ceil(viewportSize.x / cellSize)));
+	int rows = std::max(1, static_cast<int>(std::ceil(viewportSize.y / cellSize)));
+	cellHeads.assign(static_cast<size_t>(columns) * rows, -1);
+	nodes.clear();
+	placedBoxes.clear();
+
+	auto CellX = [&](float x) { return std::clamp(static_cast<int>(x / cellSize), 0, columns - 1); };
+	auto CellY = [&](float y) { return std::clamp(static_cast<int>(y / cellSize), 0, rows - 1); };
+
+	for (uint64_t key : sortKeys)
+	{
+		if (placed.size() >= settings.maxLabels)
+			break;
+
+		const Box& box = boxes[static_cast<uint32_t>(key)];
+
+		int cx0 = CellX(box.x0), cx1 = CellX(box.x1);
+		int cy0 = CellY(box.y0), cy1 = CellY(box.y1);
+		if (Overlaps(box, cx0, cy0, cx1, cy1, columns))
+			continue;
+
+		uint32_t index = static_cast<uint32_t>(placedBoxes.size());
+		placedBoxes.push_back(box);
+		for (int cy = cy0; cy <= cy1; ++cy)
+		{
+			for (int cx = cx0; cx <= cx1; ++cx)
+			{
+				int32_t& head = cellHeads[cy * columns + cx];
+				nodes.push_back({ index, head });
+				head = static_cast<int32_t>(nodes.size() - 1);
+			}
+		}
+
+		PlacedLabel label;
+		label.candidate = box.candidate;
+		label.origin = box.origin;
+		placed.push_back(label);
+	}
+
+	stats.placed = placed.size();
+	stats.seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	return placed;
+}
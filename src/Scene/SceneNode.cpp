@@ -1,6 +1,7 @@
 #define GLM_ENABLE_EXPERIMENTAL
 
 #include "Scene/SceneNode.h"
+#include "Core/MemoryTracker.h"
 #include <glm/gtx/matrix_decompose.hpp>
 #include <iostream>
 
@@ -12,6 +13,7 @@ void SceneNode::SetParent(SceneNode* newParent) {
 
 SceneNode* SceneNode::CreateChild(const std::string& childName)
 {
+	MemoryTagScope tag(MemoryTag::Scene);
 	children.push_back(std::make_unique<SceneNode>(childName));
 	SceneNode* childPtr = children.back().get();
 	childPtr->SetParent(this);
@@ -0,0 +1,67 @@
+/**
+ * @file StarCatalog.cpp
+ * @brief Procedural star catalog generation.
+ */
+#include <Scene/StarCatalog.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace
+{
+	// Rough blackbody tint for a surface temperature (Kelvin), packed RGBA8
+	uint32_t TemperatureColor(float kelvin)
+	{
+		float t = std::clamp((kelvin - 3000.0f) / 9000.0f, 0.0f, 1.0f);	// 0 = red dwarf, 1 = blue giant
+		glm::vec3 cool(1.0f, 0.72f, 0.45f);
+		glm::vec3 hot(0.68f, 0.78f, 1.0f);
+		glm::vec3 color = cool + (hot - cool) * t;
+		if (t > 0.35f && t < 0.6f)
+			color = glm::vec3(1.0f, 0.97f, 0.92f);	// Sun-like stars look white
+		auto Channel = [](float value) { return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+		return Channel(color.x) | (Channel(color.y) << 8) | (Channel(color.z) << 16) | (255u << 24);
+	}
+}
+
+void StarCatalog::Generate(const Settings& settings)
+{
+	std::mt19937 rng(settings.seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::normal_distribution<float> band(0.0f, settings.bandWidth);
+
+	// Star counts grow roughly as 10^(0.5 m): invert that CDF to draw magnitudes
+	const float lo = std::pow(10.0f, 0.5f * settings.brightestMagnitude);
+	const float hi = std::pow(10.0f, 0.5f * settings.faintestMagnitude);
+	const float pi = 3.14159265358979f;
+
+	stars.clear();
+	stars.reserve(settings.count);
+	for (size_t i = 0; i < settings.count; ++i)
+	{
+		// Direction: uniform on the sphere, or squeezed toward the galactic plane (tilted like the real one)
+		float z = unit(rng) < settings.bandFraction ? std::clamp(band(rng), -1.0f, 1.0f) : unit(rng) * 2.0f - 1.0f;
+		float phi = unit(rng) * 2.0f * pi;
+		float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+		glm::vec3 galactic(r * std::cos(phi), z, r * std::sin(phi));
+		const float tilt = 1.05f;	// ~60 degrees between galactic plane and ecliptic
+		glm::vec3 direction(galactic.x, galactic.y * std::cos(tilt) - galactic.z * std::sin(tilt),
+			galactic.y * std::sin(tilt) + galactic.z * std::cos(tilt));
+
+		// Uniform in volume within the shell
+		float dMin3 = settings.minDistance * settings.minDistance * settings.minDistance;
+		float dMax3 = settings.maxDistance * settings.maxDistance * settings.maxDistance;
+		float distance = std::cbrt(dMin3 + unit(rng) * (dMax3 - dMin3));
+
+		Star star;
+		star.position = direction * distance;
+		star.magnitude = 2.0f * std::log10(lo + unit(rng) * (hi - lo));
+		star.color = TemperatureColor(3000.0f + 9000.0f * unit(rng) * unit(rng));	// Cool stars dominate
+		stars.push_back(star);
+	}
+
+	minDistance = settings.minDistance;
+	maxDistance = settings.maxDistance;
+	std::cout << "[StarCatalog] Generated " << stars.size() << " stars (magnitude "
+		<< settings.brightestMagnitude << " to " << settings.faintestMagnitude << ")\n";
+}
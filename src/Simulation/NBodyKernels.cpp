@@ -0,0 +1,204 @@
+/**
+ * @file NBodyKernels.cpp
+ * @brief Scalar, SSE4, AVX2/FMA and AVX-512 force kernels over the SoA body arrays.
+ *
+ * Each SIMD variant compares body i against 2, 4 or 8 bodies j at a time.
+ * The functions carry their own target attribute, so this file needs no
+ * special compiler flags and the baseline build still runs anywhere.
+ */
+#include <Simulation/NBodyKernels.h>
+#include <cmath>
+
+#ifdef CELESTIAL_X86
+#include <immintrin.h>
+#endif
+
+using NBodyKernels::ForceInput;
+
+namespace
+{
+	// Bodies [jBegin, jEnd) acting on body i
+	inline void AccumulateScalar(const ForceInput& in, size_t i, size_t jBegin, size_t jEnd, double& ax, double& ay, double& az)
+	{
+		for (size_t j = jBegin; j < jEnd; ++j)
+		{
+			double dx = in.positionX[j] - in.positionX[i];
+			double dy = in.positionY[j] - in.positionY[i];
+			double dz = in.positionZ[j] - in.positionZ[i];
+			double distance2 = dx * dx + dy * dy + dz * dz + in.softening2;
+			if (distance2 == 0.0)
+				continue;
+			double inverse = 1.0 / std::sqrt(distance2);
+			double scale = in.mass[j] * inverse * inverse * inverse;
+			ax += dx * scale;
+			ay += dy * scale;
+			az += dz * scale;
+		}
+	}
+
+	void ForcesScalar(const ForceInput& in, size_t begin, size_t end, double* outX, double* outY, double* outZ)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			double ax = 0.0, ay = 0.0, az = 0.0;
+			AccumulateScalar(in, i, 0, in.bodyCount, ax, ay, az);
+			outX[i] = ax * in.gravitationalConstant;
+			outY[i] = ay * in.gravitationalConstant;
+			outZ[i] = az * in.gravitationalConstant;
+		}
+	}
+
+#ifdef CELESTIAL_X86
+	CELESTIAL_TARGET("sse4.2")
+	void ForcesSse4(const ForceInput& in, size_t begin, size_t end, double* outX, double* outY, double* outZ)
+	{
+		const __m128d softening2 = _mm_set1_pd(in.softening2);
+		const __m128d one = _mm_set1_pd(1.0);
+		const __m128d zero = _mm_setzero_pd();
+		const size_t vectorEnd = in.bodyCount & ~size_t(1);
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			const __m128d xi = _mm_set1_pd(in.positionX[i]);
+			const __m128d yi = _mm_set1_pd(in.positionY[i]);
+			const __m128d zi = _mm_set1_pd(in.positionZ[i]);
+			__m128d sumX = zero, sumY = zero, sumZ = zero;
+
+			for (size_t j = 0; j < vectorEnd; j += 2)
+			{
+				__m128d dx = _mm_sub_pd(_mm_loadu_pd(in.positionX + j), xi);
+				__m128d dy = _mm_sub_pd(_mm_loadu_pd(in.positionY + j), yi);
+				__m128d dz = _mm_sub_pd(_mm_loadu_pd(in.positionZ + j), zi);
+				__m128d distance2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)),
+					_mm_add_pd(_mm_mul_pd(dz, dz), softening2));
+				__m128d inverse = _mm_div_pd(one, _mm_sqrt_pd(distance2));
+				__m128d scale = _mm_mul_pd(_mm_loadu_pd(in.mass + j), _mm_mul_pd(inverse, _mm_mul_pd(inverse, inverse)));
+				scale = _mm_andnot_pd(_mm_cmpeq_pd(distance2, zero), scale);
+				sumX = _mm_add_pd(sumX, _mm_mul_pd(dx, scale));
+				sumY = _mm_add_pd(sumY, _mm_mul_pd(dy, scale));
+				sumZ = _mm_add_pd(sumZ, _mm_mul_pd(dz, scale));
+			}
+
+			double ax = _mm_cvtsd_f64(_mm_add_pd(sumX, _mm_unpackhi_pd(sumX, sumX)));
+			double ay = _mm_cvtsd_f64(_mm_add_pd(sumY, _mm_unpackhi_pd(sumY, sumY)));
+			double az = _mm_cvtsd_f64(_mm_add_pd(sumZ, _mm_unpackhi_pd(sumZ, sumZ)));
+			AccumulateScalar(in, i, vectorEnd, in.bodyCount, ax, ay, az);
+			outX[i] = ax * in.gravitationalConstant;
+			outY[i] = ay * in.gravitationalConstant;
+			outZ[i] = az * in.gravitationalConstant;
+		}
+	}
+
+	CELESTIAL_TARGET("avx2,fma")
+	double HorizontalSum(__m256d v)
+	{
+		__m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+		return _mm_cvtsd_f64(_mm_add_pd(pair, _mm_unpackhi_pd(pair, pair)));
+	}
+
+	CELESTIAL_TARGET("avx2,fma")
+	void ForcesAvx2(const ForceInput& in, size_t begin, size_t end, double* outX, double* outY, double* outZ)
+	{
+		const __m256d softening2 = _mm256_set1_pd(in.softening2);
+		const __m256d one = _mm256_set1_pd(1.0);
+		const __m256d zero = _mm256_setzero_pd();
+		const size_t vectorEnd = in.bodyCount & ~size_t(3);
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			const __m256d xi = _mm256_set1_pd(in.positionX[i]);
+			const __m256d yi = _mm256_set1_pd(in.positionY[i]);
+			const __m256d zi = _mm256_set1_pd(in.positionZ[i]);
+			__m256d sumX = zero, sumY = zero, sumZ = zero;
+
+			for (size_t j = 0; j < vectorEnd; j += 4)
+			{
+				__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(in.positionX + j), xi);
+				__m256d dy = _mm256_sub_pd(_mm256_loadu_pd(in.positionY + j), yi);
+				__m256d dz = _mm256_sub_pd(_mm256_loadu_pd(in.positionZ + j), zi);
+				__m256d distance2 = _mm256_fmadd_pd(dx, dx, _mm256_fmadd_pd(dy, dy, _mm256_fmadd_pd(dz, dz, softening2)));
+				__m256d inverse = _mm256_div_pd(one, _mm256_sqrt_pd(distance2));
+				__m256d scale = _mm256_mul_pd(_mm256_loadu_pd(in.mass + j), _mm256_mul_pd(inverse, _mm256_mul_pd(inverse, inverse)));
+				scale = _mm256_andnot_pd(_mm256_cmp_pd(distance2, zero, _CMP_EQ_OQ), scale);
+				sumX = _mm256_fmadd_pd(dx, scale, sumX);
+				sumY = _mm256_fmadd_pd(dy, scale, sumY);
+				sumZ = _mm256_fmadd_pd(dz, scale, sumZ);
+			}
+
+			double ax = HorizontalSum(sumX);
+			double ay = HorizontalSum(sumY);
+			double az = HorizontalSum(sumZ);
+			AccumulateScalar(in, i, vectorEnd, in.bodyCount, ax, ay, az);
+			outX[i] = ax * in.gravitationalConstant;
+			outY[i] = ay * in.gravitationalConstant;
+			outZ[i] = az * in.gravitationalConstant;
+		}
+	}
+
+	// GCC's AVX-512 headers pass _mm256_undefined_pd() as the merge source of
+	// every 256-bit extract (castpd512_pd256 included), which -Wmaybe-uninitialized flags
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+	CELESTIAL_TARGET("avx512f,avx512dq,avx512bw,avx512vl")
+	double HorizontalSum(__m512d v)
+	{
+		return HorizontalSum(_mm256_add_pd(_mm512_castpd512_pd256(v), _mm512_extractf64x4_pd(v, 1)));
+	}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+	CELESTIAL_TARGET("avx512f,avx512dq,avx512bw,avx512vl")
+	void ForcesAvx512(const ForceInput& in, size_t begin, size_t end, double* outX, double* outY, double* outZ)
+	{
+		const __m512d softening2 = _mm512_set1_pd(in.softening2);
+		const __m512d one = _mm512_set1_pd(1.0);
+		const __m512d zero = _mm512_setzero_pd();
+
+		for (size_t i = begin; i < end; ++i)
+		{
+			const __m512d xi = _mm512_set1_pd(in.positionX[i]);
+			const __m512d yi = _mm512_set1_pd(in.positionY[i]);
+			const __m512d zi = _mm512_set1_pd(in.positionZ[i]);
+			__m512d sumX = zero, sumY = zero, sumZ = zero;
+
+			// The tail uses masked loads; its missing lanes have zero mass
+			for (size_t j = 0; j < in.bodyCount; j += 8)
+			{
+				size_t remaining = in.bodyCount - j;
+				__mmask8 lanes = remaining >= 8 ? __mmask8(0xFF) : __mmask8((1u << remaining) - 1);
+				__m512d dx = _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, in.positionX + j), xi);
+				__m512d dy = _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, in.positionY + j), yi);
+				__m512d dz = _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, in.positionZ + j), zi);
+				__m512d distance2 = _mm512_fmadd_pd(dx, dx, _mm512_fmadd_pd(dy, dy, _mm512_fmadd_pd(dz, dz, softening2)));
+				__mmask8 apart = _mm512_cmp_pd_mask(distance2, zero, _CMP_NEQ_UQ) & lanes;
+				__m512d inverse = _mm512_maskz_div_pd(apart, one, _mm512_maskz_sqrt_pd(apart, distance2));
+				__m512d scale = _mm512_mul_pd(_mm512_maskz_loadu_pd(lanes, in.mass + j), _mm512_mul_pd(inverse, _mm512_mul_pd(inverse, inverse)));
+				sumX = _mm512_fmadd_pd(dx, scale, sumX);
+				sumY = _mm512_fmadd_pd(dy, scale, sumY);
+				sumZ = _mm512_fmadd_pd(dz, scale, sumZ);
+			}
+
+			outX[i] = HorizontalSum(sumX) * in.gravitationalConstant;
+			outY[i] = HorizontalSum(sumY) * in.gravitationalConstant;
+			outZ[i] = HorizontalSum(sumZ) * in.gravitationalConstant;
+		}
+	}
+#endif
+}
+
+NBodyKernels::ForceFunction NBodyKernels::GetForceFunction(IsaLevel level)
+{
+#ifdef CELESTIAL_X86
+	switch (level)
+	{
+	case IsaLevel::Avx512: return ForcesAvx512;
+	case IsaLevel::Avx2: return ForcesAvx2;
+	case IsaLevel::Sse4: return ForcesSse4;
+	default: break;
+	}
+#endif
+	return ForcesScalar;
+}
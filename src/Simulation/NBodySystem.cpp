@@ -0,0 +1,141 @@
+/**
+ * @file NBodySystem.cpp
+ * @brief Leapfrog integration and pairwise gravity, optionally spread over the JobSystem.
+ */
+#include <Simulation/NBodySystem.h>
+#include <Simulation/NBodyKernels.h>
+#include <Core/CpuFeatures.h>
+#include <Core/JobSystem.h>
+#include <Core/Profiler.h>
+#include <algorithm>
+#include <cmath>
+
+NBodySystem::NBodySystem()
+	: NBodySystem(Settings())
+{
+}
+
+NBodySystem::NBodySystem(const Settings& initialSettings)
+	: settings(initialSettings)
+{
+}
+
+size_t NBodySystem::AddBody(const glm::dvec3& position, const glm::dvec3& velocity, double mass)
+{
+	AddBodies(1);
+	size_t body = GetBodyCount() - 1;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		fields[PositionX + axis][body] = position[axis];
+		fields[VelocityX + axis][body] = velocity[axis];
+	}
+	fields[Mass][body] = mass;
+	return body;
+}
+
+void NBodySystem::AddBodies(size_t count)
+{
+	for (auto& field : fields)
+		field.resize(field.size() + count, 0.0);
+	for (auto& axis : acceleration)
+		axis.resize(GetBodyCount(), 0.0);
+	accelerationValid = false;
+}
+
+void NBodySystem::AccumulateRange(size_t begin, size_t end)
+{
+	NBodyKernels::ForceInput input;
+	input.positionX = fields[PositionX].data();
+	input.positionY = fields[PositionY].data();
+	input.positionZ = fields[PositionZ].data();
+	input.mass = fields[Mass].data();
+	input.bodyCount = GetBodyCount();
+	input.softening2 = settings.softening * settings.softening;
+	input.gravitationalConstant = settings.gravitationalConstant;
+	ProfileScope scope("NBody.Forces", (end - begin) * input.bodyCount);	// Elements = pair interactions
+
+	// Each body sums over all others: no writes to shared data, so ranges run independently
+	NBodyKernels::ForceFunction forces = NBodyKernels::GetForceFunction(CpuFeatures::Get().GetActive());
+	forces(input, begin, end, acceleration[0].data(), acceleration[1].data(), acceleration[2].data());
+}
+
+void NBodySystem::ComputeAccelerations(bool allowParallel)
+{
+	size_t bodyCount = GetBodyCount();
+	if (!allowParallel || bodyCount < ParallelThreshold)
+	{
+		AccumulateRange(0, bodyCount);
+		return;
+	}
+
+	size_t jobCount = (bodyCount + BodiesPerJob - 1) / BodiesPerJob;
+	JobSystem::Get().ParallelFor(jobCount, [&](size_t job) {
+		size_t begin = job * BodiesPerJob;
+		AccumulateRange(begin, std::min(begin + BodiesPerJob, bodyCount));
+	});
+}
+
+void NBodySystem::Step(double dt, size_t count, bool allowParallel)
+{
+	size_t bodyCount = GetBodyCount();
+	if (!accelerationValid)
+	{
+		ComputeAccelerations(allowParallel);
+		accelerationValid = true;
+	}
+
+	for (size_t step = 0; step < count; ++step)
+	{
+		// Forces nest inside as their own scopes, one per job
+		ProfileScope scope("NBody.Step", bodyCount);
+
+		// Kick half a step, drift a full step, then kick again with the new accelerations
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			double* velocity = fields[VelocityX + axis].data();
+			double* position = fields[PositionX + axis].data();
+			const double* a = acceleration[axis].data();
+			for (size_t i = 0; i < bodyCount; ++i)
+			{
+				velocity[i] += 0.5 * dt * a[i];
+				position[i] += dt * velocity[i];
+			}
+		}
+
+		ComputeAccelerations(allowParallel);
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			double* velocity = fields[VelocityX + axis].data();
+			const double* a = acceleration[axis].data();
+			for (size_t i = 0; i < bodyCount; ++i)
+				velocity[i] += 0.5 * dt * a[i];
+		}
+
+		time += dt;
+		stepIndex++;
+	}
+}
+
+double NBodySystem::ComputeEnergy() const
+{
+	const double* px = fields[PositionX].data();
+	const double* py = fields[PositionY].data();
+	const double* pz = fields[PositionZ].data();
+	const double* mass = fields[Mass].data();
+	size_t bodyCount = GetBodyCount();
+	double softening2 = settings.softening * settings.softening;
+
+	double kinetic = 0.0, potential = 0.0;
+	for (size_t i = 0; i < bodyCount; ++i)
+	{
+		double vx = fields[VelocityX][i], vy = fields[VelocityY][i], vz = fields[VelocityZ][i];
+		kinetic += 0.5 * mass[i] * (vx * vx + vy * vy + vz * vz);
+		for (size_t j = i + 1; j < bodyCount; ++j)
+		{
+			double dx = px[j] - px[i], dy = py[j] - py[i], dz = pz[j] - pz[i];
+			potential -= settings.gravitationalConstant * mass[i] * mass[j] / std::sqrt(dx * dx + dy * dy + dz * dz + softening2);
+		}
+	}
+	return kinetic + potential;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file SharedStateExport.cpp
+ * @brief Shared-memory segment setup and seqlock-protected publishing.
+ */
+#include <Simulation/SharedStateExport.h>
+#include <Simulation/SharedStateLayout.h>
+#include <Simulation/Simulation.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static_assert(static_cast<int>(Simulation::FieldCount) == SIM_FIELD_COUNT, "Simulation fields and SharedStateLayout.h disagree");
+static_assert(static_cast<int>(Simulation::Spin) == SIM_SPIN, "Simulation fields and SharedStateLayout.h disagree");
+
+namespace
+{
+	constexpr std::uint64_t BlockAlignment = 64;	// Cache line: arrays never share a line with the header
+
+	std::uint64_t AlignBlock(std::uint64_t offset)
+	{
+		return (offset + BlockAlignment - 1) & ~(BlockAlignment - 1);
+	}
+}
+
+SharedStateExport::SharedStateExport(const std::string& segmentName, std::uint32_t bodyCapacity)
+	: name(segmentName), capacity(bodyCapacity)
+{
+	// Header, name table, then one double array per field
+	std::uint64_t namesOffset = AlignBlock(sizeof(SimSharedHeader));
+	std::uint64_t offset = AlignBlock(namesOffset + std::uint64_t(capacity) * SIM_SHARED_NAME_LENGTH);
+	std::uint64_t fieldOffsets[SIM_FIELD_COUNT];
+	for (int field = 0; field < SIM_FIELD_COUNT; ++field)
+	{
+		fieldOffsets[field] = offset;
+		offset = AlignBlock(offset + std::uint64_t(capacity) * sizeof(double));
+	}
+	segmentSize = static_cast<size_t>(offset);
+
+#ifdef _WIN32
+	// Windows mapping names have no leading slash
+	std::string mappingName = name.size() > 1 && name[0] == '/' ? name.substr(1) : name;
+	HANDLE fileMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(std::uint64_t(segmentSize) >> 32), static_cast<DWORD>(segmentSize), mappingName.c_str());
+	if (!fileMapping)
+		throw std::runtime_error("SharedStateExport: cannot create mapping " + mappingName);
+	mapping = MapViewOfFile(fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, segmentSize);
+	if (!mapping)
+	{
+		CloseHandle(fileMapping);
+		throw std::runtime_error("SharedStateExport: cannot map " + mappingName);
+	}
+	handle = reinterpret_cast<std::intptr_t>(fileMapping);
+#else
+	int descriptor = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+	if (descriptor < 0)
+		throw std::runtime_error("SharedStateExport: shm_open failed for " + name);
+	if (ftruncate(descriptor, static_cast<off_t>(segmentSize)) != 0)
+	{
+		close(descriptor);
+		shm_unlink(name.c_str());
+		throw std::runtime_error("SharedStateExport: cannot size " + name);
+	}
+	mapping = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	if (mapping == MAP_FAILED)
+	{
+		mapping = nullptr;
+		close(descriptor);
+		shm_unlink(name.c_str());
+		throw std::runtime_error("SharedStateExport: cannot map " + name);
+	}
+	handle = descriptor;
+#endif
+
+	// The layout is written once; readers check magic and version before trusting it
+	std::memset(mapping, 0, segmentSize);
+	header = static_cast<SimSharedHeader*>(mapping);
+	header->version = SIM_SHARED_VERSION;
+	header->capacity = capacity;
+	header->fieldCount = SIM_FIELD_COUNT;
+	header->segmentSize = segmentSize;
+	header->namesOffset = namesOffset;
+	std::memcpy(header->fieldOffsets, fieldOffsets, sizeof(fieldOffsets));
+	std::atomic_ref<std::uint32_t>(header->magic).store(SIM_SHARED_MAGIC, std::memory_order_release);
+
+	std::cout << "[SharedStateExport] Publishing up to " << capacity << " bodies in " << name
+		<< " (" << segmentSize << " bytes)\n";
+}
+
+SharedStateExport::~SharedStateExport()
+{
+#ifdef _WIN32
+	UnmapViewOfFile(mapping);
+	CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+	munmap(mapping, segmentSize);
+	close(static_cast<int>(handle));
+	shm_unlink(name.c_str());
+#endif
+}
+
+void SharedStateExport::Publish(const Simulation& simulation)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	size_t bodyCount = std::min<size_t>(simulation.GetBodyCount(), capacity);
+	unsigned char* base = static_cast<unsigned char*>(mapping);
+
+	// Odd sequence: readers that overlap this section will retry
+	std::atomic_ref<std::uint64_t> sequence(header->sequence);
+	std::uint64_t begin = sequence.load(std::memory_order_relaxed);
+	sequence.store(begin + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// Bodies are only ever appended, so only new names need writing
+	for (; namesPublished < bodyCount; ++namesPublished)
+	{
+		char* entry = reinterpret_cast<char*>(base + header->namesOffset) + namesPublished * SIM_SHARED_NAME_LENGTH;
+		const std::string& bodyName = simulation.GetName(namesPublished);
+		size_t length = std::min<size_t>(bodyName.size(), SIM_SHARED_NAME_LENGTH - 1);
+		std::memcpy(entry, bodyName.data(), length);
+		entry[length] = '\0';
+	}
+
+	for (int field = 0; field < SIM_FIELD_COUNT; ++field)
+		std::memcpy(base + header->fieldOffsets[field], simulation.GetField(static_cast<Simulation::Field>(field)),
+			bodyCount * sizeof(double));
+
+	header->bodyCount = bodyCount;
+	header->stepIndex = simulation.GetStepIndex();
+	header->simulationTime = simulation.GetTime();
+
+	// Even again: the snapshot is complete
+	sequence.store(begin + 2, std::memory_order_release);
+
+	stats.publishes++;
+	stats.lastPublishSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file Simulation.cpp
+ * @brief Closed-form circular orbits and spins over the SoA body state.
+ */
+#include <Simulation/Simulation.h>
+#include <Core/Profiler.h>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+	constexpr double DegreesToRadians = 3.14159265358979323846 / 180.0;
+}
+
+size_t Simulation::AddBody(const BodyDesc& desc)
+{
+	if (desc.parent >= static_cast<int>(names.size()))
+		throw std::runtime_error("Simulation: parent of " + desc.name + " must be added first");
+
+	names.push_back(desc.name);
+	parents.push_back(desc.parent);
+	orbitRadius.push_back(desc.orbitRadius);
+	orbitRate.push_back(desc.orbitRate);
+	orbitPhase.push_back(desc.orbitPhase);
+	spinRate.push_back(desc.spinRate);
+	for (auto& field : fields)
+		field.push_back(0.0);
+	fields[Radius].back() = desc.radius;
+	fields[Mass].back() = desc.mass;
+
+	size_t body = names.size() - 1;
+	Evaluate(body);
+	return body;
+}
+
+void Simulation::AddSolarSystem()
+{
+	AddBody({ "Sun", -1, 0.0, 0.0, 0.0, 0.0, 2.0, 333000.0 });
+	AddBody({ "Earth", 0, 6.0, 20.0, 0.0, 30.0, 1.0, 1.0 });
+	AddBody({ "Moon", 1, 2.0, 60.0, 0.0, 0.0, 0.5, 0.0123 });
+}
+
+void Simulation::Step(double dt)
+{
+	ProfileScope scope("Simulation.Step", names.size());
+	time += dt;
+	stepIndex++;
+
+	// Parents precede children, so one forward pass sees every parent's new state
+	for (size_t body = 0; body < names.size(); ++body)
+		Evaluate(body);
+}
+
+void Simulation::Evaluate(size_t body)
+{
+	double angle = (orbitPhase[body] + orbitRate[body] * time) * DegreesToRadians;
+	double angularRate = orbitRate[body] * DegreesToRadians;
+	double radius = orbitRadius[body];
+
+	double x = radius * std::cos(angle);
+	double z = radius * std::sin(angle);
+	double vx = -radius * angularRate * std::sin(angle);
+	double vz = radius * angularRate * std::cos(angle);
+
+	int parent = parents[body];
+	if (parent >= 0)
+	{
+		x += fields[PositionX][parent];
+		z += fields[PositionZ][parent];
+		vx += fields[VelocityX][parent];
+		vz += fields[VelocityZ][parent];
+	}
+
+	fields[PositionX][body] = x;
+	fields[PositionY][body] = parent >= 0 ? fields[PositionY][parent] : 0.0;
+	fields[PositionZ][body] = z;
+	fields[VelocityX][body] = vx;
+	fields[VelocityY][body] = parent >= 0 ? fields[VelocityY][parent] : 0.0;
+	fields[VelocityZ][body] = vz;
+
+	double spin = std::fmod(spinRate[body] * time, 360.0);
+	fields[Spin][body] = spin < 0.0 ? spin + 360.0 : spin;
+}
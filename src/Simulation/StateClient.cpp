@@ -0,0 +1,132 @@
+/**
+ * @file StateClient.cpp
+ * @brief Snapshot decoding and acknowledgement for viewers of a StateServer.
+ */
+#include <Simulation/StateClient.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+using namespace StateProtocol;
+
+StateClient::StateClient(const std::string& host, std::uint16_t port, float rate, float radius,
+	const glm::vec3& camera, double connectTimeoutSeconds)
+	: interestRadius(radius), updateRate(rate), lastCamera(camera)
+{
+	connection = TcpSocket::Connect(host, port, connectTimeoutSeconds);
+	if (!connection.IsValid())
+		throw std::runtime_error("StateClient: cannot reach simulation server " + host + ":" + std::to_string(port));
+
+	SendView(HelloMessage, camera);
+	std::cout << "[StateClient] Connected to " << host << ":" << port << " (" << rate << " Hz, interest radius "
+		<< radius << ")\n";
+}
+
+void StateClient::SendView(std::uint32_t type, const glm::vec3& camera)
+{
+	ViewPayload view = { { camera.x, camera.y, camera.z }, interestRadius, updateRate };
+	SendMessage(connection, type, &view, sizeof(view));
+	lastCamera = camera;
+}
+
+bool StateClient::Poll(const glm::vec3& camera)
+{
+	bool connected = ReceiveAvailable(connection, receiveBuffer);
+
+	bool valid = ForEachMessage(receiveBuffer, [&](std::uint32_t type, const unsigned char* payload, size_t size)
+	{
+		stats.bytesReceived += sizeof(MessageHeader) + size;
+		if (type == CatalogueMessage)
+			ApplyCatalogue(payload, size);
+		else if (type == SnapshotMessage)
+			ApplySnapshot(payload, size);
+	});
+	if (!valid)
+	{
+		std::cerr << "[StateClient] Server sent a message over " << MaxMessageBytes << " bytes\n";
+		return false;
+	}
+
+	// Interest follows the camera; small moves do not change which bodies are in range
+	if (connected && glm::length(camera - lastCamera) > interestRadius * 0.01f)
+		SendView(ViewMessage, camera);
+	return connected;
+}
+
+void StateClient::ApplyCatalogue(const unsigned char* payload, size_t size)
+{
+	CatalogueHeader header;
+	if (size < sizeof(header))
+		return;
+	std::memcpy(&header, payload, sizeof(header));
+	if (size != sizeof(header) + size_t(header.count) * sizeof(CatalogueEntry) || header.firstBody != names.size())
+	{
+		std::cerr << "[StateClient] Malformed body catalogue\n";
+		return;
+	}
+
+	for (std::uint32_t i = 0; i < header.count; ++i)
+	{
+		CatalogueEntry entry;
+		std::memcpy(&entry, payload + sizeof(header) + i * sizeof(entry), sizeof(entry));
+		entry.name[NameLength - 1] = '\0';
+		names.emplace_back(entry.name);
+		radii.push_back(entry.radius);
+	}
+	positions.resize(names.size(), glm::dvec3(0.0));
+	spins.resize(names.size(), 0.0);
+	tracked.resize(names.size(), false);
+}
+
+void StateClient::ApplySnapshot(const unsigned char* payload, size_t size)
+{
+	SnapshotHeader header;
+	if (size < sizeof(header))
+		return;
+	std::memcpy(&header, payload, sizeof(header));
+
+	// The baseline is a snapshot this viewer acknowledged; the server never refers to anything older
+	static const std::vector<QuantizedBody> Empty;
+	const std::vector<QuantizedBody>* baseline = &Empty;
+	if (header.baselineId != 0)
+	{
+		auto it = std::find_if(history.begin(), history.end(),
+			[&](const Snapshot& snapshot) { return snapshot.id == header.baselineId; });
+		if (it == history.end())
+		{
+			// Ask for a whole snapshot instead of a delta
+			std::uint32_t reset = 0;
+			SendMessage(connection, AckMessage, &reset, sizeof(reset));
+			stats.resyncs++;
+			return;
+		}
+		baseline = &it->bodies;
+	}
+
+	Snapshot snapshot;
+	snapshot.id = header.snapshotId;
+	if (!DecodeDelta(*baseline, payload + sizeof(header), size - sizeof(header), snapshot.bodies))
+	{
+		std::cerr << "[StateClient] Malformed snapshot " << header.snapshotId << "\n";
+		return;
+	}
+
+	std::fill(tracked.begin(), tracked.end(), false);
+	for (const QuantizedBody& body : snapshot.bodies)
+	{
+		if (body.id >= names.size())
+			continue;	// Catalogue always precedes the first snapshot naming a body
+		positions[body.id] = DequantizePosition(body);
+		spins[body.id] = DequantizeSpin(body);
+		tracked[body.id] = true;
+	}
+	stepIndex = header.stepIndex;
+	simulationTime = header.simulationTime;
+
+	SendMessage(connection, AckMessage, &snapshot.id, sizeof(snapshot.id));
+	history.push_back(std::move(snapshot));
+	if (history.size() > HistoryLength)
+		history.pop_front();
+	stats.snapshots++;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file StateProtocol.cpp
+ * @brief Quantization, delta records and message framing for StateServer/StateClient.
+ *
+ * Delta records: varint changed-body count, then per body the id gap from the
+ * previous changed id, a field mask byte (bits 0-2 position axes, bit 3 spin)
+ * and one zigzag varint per masked field; then varint removed-body count and
+ * the removed id gaps.
+ */
+#include <Simulation/StateProtocol.h>
+#include <algorithm>
+#include <cmath>
+
+namespace StateProtocol
+{
+	namespace
+	{
+		constexpr std::uint8_t SpinBit = 1u << 3;
+
+		void WriteVarint(std::vector<unsigned char>& out, std::uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				out.push_back(static_cast<unsigned char>(value | 0x80));
+				value >>= 7;
+			}
+			out.push_back(static_cast<unsigned char>(value));
+		}
+
+		bool ReadVarint(const unsigned char*& data, const unsigned char* end, std::uint64_t& value)
+		{
+			value = 0;
+			for (int shift = 0; shift < 64 && data < end; shift += 7)
+			{
+				unsigned char byte = *data++;
+				value |= std::uint64_t(byte & 0x7F) << shift;
+				if (!(byte & 0x80))
+					return true;
+			}
+			return false;
+		}
+
+		std::uint64_t ZigZag(std::int64_t value)
+		{
+			return (std::uint64_t(value) << 1) ^ std::uint64_t(value >> 63);
+		}
+
+		std::int64_t UnZigZag(std::uint64_t value)
+		{
+			return std::int64_t(value >> 1) ^ -std::int64_t(value & 1);
+		}
+
+		const QuantizedBody Zero = { 0, { 0, 0, 0 }, 0 };
+
+		// Body with this id in a sorted list, or Zero
+		const QuantizedBody& FindOrZero(const std::vector<QuantizedBody>& bodies, std::uint32_t id)
+		{
+			auto it = std::lower_bound(bodies.begin(), bodies.end(), id,
+				[](const QuantizedBody& body, std::uint32_t value) { return body.id < value; });
+			return it != bodies.end() && it->id == id ? *it : Zero;
+		}
+	}
+
+	QuantizedBody Quantize(std::uint32_t id, const glm::dvec3& position, double spinDegrees)
+	{
+		QuantizedBody body;
+		body.id = id;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			double steps = std::round(position[axis] / PositionStep);
+			body.position[axis] = static_cast<std::int32_t>(std::clamp(steps, -2147483647.0, 2147483647.0));
+		}
+		double turns = spinDegrees / 360.0;
+		body.spin = static_cast<std::uint16_t>(std::lround((turns - std::floor(turns)) * 65536.0) & 0xFFFF);
+		return body;
+	}
+
+	glm::dvec3 DequantizePosition(const QuantizedBody& body)
+	{
+		return glm::dvec3(body.position[0], body.position[1], body.position[2]) * PositionStep;
+	}
+
+	double DequantizeSpin(const QuantizedBody& body)
+	{
+		return body.spin * (360.0 / 65536.0);
+	}
+
+	void EncodeDelta(const std::vector<QuantizedBody>& baseline, const std::vector<QuantizedBody>& current,
+		std::vector<unsigned char>& out)
+	{
+		// Changed or new bodies; unchanged ones are implied by the baseline
+		std::vector<std::uint32_t> removed;
+		std::uint32_t changedCount = 0;
+		std::uint32_t previousId = 0;
+		std::vector<unsigned char> records;
+
+		size_t b = 0;
+		for (const QuantizedBody& body : current)
+		{
+			for (; b < baseline.size() && baseline[b].id < body.id; ++b)
+				removed.push_back(baseline[b].id);
+
+			bool inBaseline = b < baseline.size() && baseline[b].id == body.id;
+			const QuantizedBody& base = inBaseline ? baseline[b] : Zero;
+			if (inBaseline)
+			{
+				++b;
+				if (body == base)
+					continue;
+			}
+
+			std::uint8_t mask = 0;
+			for (int axis = 0; axis < 3; ++axis)
+				if (body.position[axis] != base.position[axis])
+					mask |= std::uint8_t(1u << axis);
+			if (body.spin != base.spin)
+				mask |= SpinBit;
+
+			WriteVarint(records, body.id - previousId);
+			records.push_back(mask);
+			for (int axis = 0; axis < 3; ++axis)
+				if (mask & (1u << axis))
+					WriteVarint(records, ZigZag(std::int64_t(body.position[axis]) - base.position[axis]));
+			if (mask & SpinBit)
+				WriteVarint(records, ZigZag(static_cast<std::int16_t>(static_cast<std::uint16_t>(body.spin - base.spin))));
+
+			previousId = body.id;
+			changedCount++;
+		}
+		for (; b < baseline.size(); ++b)
+			removed.push_back(baseline[b].id);
+
+		WriteVarint(out, changedCount);
+		out.insert(out.end(), records.begin(), records.end());
+
+		WriteVarint(out, removed.size());
+		previousId = 0;
+		for (std::uint32_t id : removed)
+		{
+			WriteVarint(out, id - previousId);
+			previousId = id;
+		}
+	}
+
+	bool DecodeDelta(const std::vector<QuantizedBody>& baseline, const unsigned char* data, size_t size,
+		std::vector<QuantizedBody>& current)
+	{
+		const unsigned char* end = data + size;
+		std::uint64_t count = 0;
+		if (!ReadVarint(data, end, count) || count > size)
+			return false;
+
+		std::vector<QuantizedBody> changed;
+		changed.reserve(static_cast<size_t>(count));
+		std::uint64_t id = 0;
+		for (std::uint64_t i = 0; i < count; ++i)
+		{
+			std::uint64_t gap = 0;
+			if (!ReadVarint(data, end, gap) || data >= end || (i > 0 && gap == 0))
+				return false;
+			id += gap;
+			std::uint8_t mask = *data++;
+
+			QuantizedBody body = FindOrZero(baseline, static_cast<std::uint32_t>(id));
+			body.id = static_cast<std::uint32_t>(id);
+			std::uint64_t value = 0;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				if (!(mask & (1u << axis)))
+					continue;
+				if (!ReadVarint(data, end, value))
+					return false;
+				body.position[axis] = static_cast<std::int32_t>(body.position[axis] + UnZigZag(value));
+			}
+			if (mask & SpinBit)
+			{
+				if (!ReadVarint(data, end, value))
+					return false;
+				body.spin = static_cast<std::uint16_t>(body.spin + UnZigZag(value));
+			}
+			changed.push_back(body);
+		}
+
+		std::vector<std::uint32_t> removed;
+		if (!ReadVarint(data, end, count) || count > size)
+			return false;
+		id = 0;
+		for (std::uint64_t i = 0; i < count; ++i)
+		{
+			std::uint64_t gap = 0;
+			if (!ReadVarint(data, end, gap))
+				return false;
+			id += gap;
+			removed.push_back(static_cast<std::uint32_t>(id));
+		}
+		if (data != end)
+			return false;
+
+		// Merge: baseline minus removed, with changed bodies replaced or inserted
+		current.clear();
+		size_t c = 0, r = 0;
+		for (const QuantizedBody& base : baseline)
+		{
+			for (; c < changed.size() && changed[c].id < base.id; ++c)
+				current.push_back(changed[c]);
+			if (c < changed.size() && changed[c].id == base.id)
+				current.push_back(changed[c++]);
+			else
+			{
+				for (; r < removed.size() && removed[r] < base.id; ++r) {}
+				if (r < removed.size() && removed[r] == base.id)
+					continue;
+				current.push_back(base);
+			}
+		}
+		current.insert(current.end(), changed.begin() + static_cast<std::ptrdiff_t>(c), changed.end());
+		return true;
+	}
+
+	bool SendMessage(const TcpSocket& socket, std::uint32_t type, const void* payload, std::uint32_t size)
+	{
+		MessageHeader header = { type, size };
+		return socket.SendAll(&header, sizeof(header)) && (size == 0 || socket.SendAll(payload, size));
+	}
+
+	bool ReceiveAvailable(const TcpSocket& socket, std::vector<unsigned char>& buffer)
+	{
+		unsigned char chunk[4096];
+		while (socket.WaitReadable(0.0))
+		{
+			std::ptrdiff_t received = socket.ReceiveSome(chunk, sizeof(chunk));
+			if (received <= 0)
+				return false;
+			buffer.insert(buffer.end(), chunk, chunk + received);
+		}
+		return true;
+	}
+}
@@ -0,0 +1,156 @@
+/**
+ * @file StateServer.cpp
+ * @brief Viewer bookkeeping, interest filtering and per-viewer delta snapshots.
+ */
+#include <Simulation/StateServer.h>
+#include <Simulation/Simulation.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace StateProtocol;
+
+StateServer::StateServer(std::uint16_t port)
+{
+	listener = TcpSocket::Listen(port, true);
+	std::cout << "[StateServer] Serving simulation state on port " << port << "\n";
+}
+
+void StateServer::Update(const Simulation& simulation)
+{
+	// Viewers may join at any time
+	for (;;)
+	{
+		TcpSocket connection = listener.Accept(0.0);
+		if (!connection.IsValid())
+			break;
+		viewers.emplace_back();
+		viewers.back().connection = std::move(connection);
+		std::cout << "[StateServer] Viewer connected (" << viewers.size() << " total)\n";
+	}
+
+	Clock::time_point now = Clock::now();
+	for (size_t i = viewers.size(); i-- > 0;)
+	{
+		Viewer& viewer = viewers[i];
+		bool connected = ReadMessages(viewer);
+		if (connected && viewer.greeted && now >= viewer.nextSend)
+		{
+			// A viewer that stopped acknowledging is not sent more until it catches up
+			if (viewer.unacknowledged.size() >= MaxUnacknowledged)
+			{
+				stats.skippedSends++;
+				continue;
+			}
+			connected = SendCatalogue(viewer, simulation) && SendSnapshot(viewer, simulation);
+			viewer.nextSend = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(viewer.updateInterval));
+		}
+
+		if (!connected)
+		{
+			viewers.erase(viewers.begin() + static_cast<std::ptrdiff_t>(i));
+			std::cout << "[StateServer] Viewer disconnected (" << viewers.size() << " left)\n";
+		}
+	}
+}
+
+bool StateServer::ReadMessages(Viewer& viewer)
+{
+	bool connected = ReceiveAvailable(viewer.connection, viewer.receiveBuffer);
+
+	bool valid = ForEachMessage(viewer.receiveBuffer, [&](std::uint32_t type, const unsigned char* payload, size_t size)
+	{
+		if ((type == HelloMessage || type == ViewMessage) && size == sizeof(ViewPayload))
+		{
+			ViewPayload view;
+			std::memcpy(&view, payload, sizeof(view));
+			viewer.camera = glm::vec3(view.camera[0], view.camera[1], view.camera[2]);
+			viewer.interestRadius = view.interestRadius;
+			viewer.updateInterval = view.updateRate > 0.0f ? 1.0 / view.updateRate : 0.0;
+			viewer.greeted = true;
+		}
+		else if (type == AckMessage && size == sizeof(std::uint32_t))
+		{
+			std::uint32_t id;
+			std::memcpy(&id, payload, sizeof(id));
+			if (id == 0)
+			{
+				// The viewer lost its copy of the baseline; the next snapshot is sent whole
+				viewer.baseline = Snapshot();
+				return;
+			}
+
+			// Acknowledged snapshot becomes the baseline; older ones are no longer needed
+			auto it = std::find_if(viewer.unacknowledged.begin(), viewer.unacknowledged.end(),
+				[id](const Snapshot& snapshot) { return snapshot.id == id; });
+			if (it == viewer.unacknowledged.end())
+				return;
+			viewer.baseline = std::move(*it);
+			viewer.unacknowledged.erase(viewer.unacknowledged.begin(), it + 1);
+		}
+	});
+
+	if (!valid)
+		std::cerr << "[StateServer] Viewer sent a message over " << MaxMessageBytes << " bytes, dropping it\n";
+	return connected && valid;
+}
+
+bool StateServer::SendCatalogue(Viewer& viewer, const Simulation& simulation)
+{
+	// Bodies are only ever appended, so only the new ones are described
+	std::uint32_t bodyCount = static_cast<std::uint32_t>(simulation.GetBodyCount());
+	if (viewer.knownBodies >= bodyCount)
+		return true;
+
+	CatalogueHeader header = { viewer.knownBodies, bodyCount - viewer.knownBodies };
+	sendBuffer.resize(sizeof(header) + header.count * sizeof(CatalogueEntry));
+	std::memcpy(sendBuffer.data(), &header, sizeof(header));
+	for (std::uint32_t i = 0; i < header.count; ++i)
+	{
+		CatalogueEntry entry = {};
+		const std::string& name = simulation.GetName(header.firstBody + i);
+		std::memcpy(entry.name, name.data(), std::min<size_t>(name.size(), NameLength - 1));
+		entry.radius = static_cast<float>(simulation.GetField(Simulation::Radius)[header.firstBody + i]);
+		std::memcpy(sendBuffer.data() + sizeof(header) + i * sizeof(entry), &entry, sizeof(entry));
+	}
+
+	std::uint32_t size = static_cast<std::uint32_t>(sendBuffer.size());
+	if (!SendMessage(viewer.connection, CatalogueMessage, sendBuffer.data(), size))
+		return false;
+	viewer.knownBodies = bodyCount;
+	stats.bytesSent += sizeof(MessageHeader) + size;
+	return true;
+}
+
+bool StateServer::SendSnapshot(Viewer& viewer, const Simulation& simulation)
+{
+	// Interest management: bodies whose surface is within the viewer's radius
+	Snapshot snapshot;
+	snapshot.id = viewer.nextSnapshotId++;
+	glm::dvec3 camera(viewer.camera);
+	const double* radius = simulation.GetField(Simulation::Radius);
+	const double* spin = simulation.GetField(Simulation::Spin);
+	for (size_t body = 0; body < simulation.GetBodyCount(); ++body)
+	{
+		glm::dvec3 position = simulation.GetPosition(body);
+		if (glm::length(position - camera) - radius[body] > viewer.interestRadius)
+			continue;
+		snapshot.bodies.push_back(Quantize(static_cast<std::uint32_t>(body), position, spin[body]));
+	}
+
+	SnapshotHeader header = { snapshot.id, viewer.baseline.id, simulation.GetStepIndex(), simulation.GetTime() };
+	sendBuffer.resize(sizeof(header));
+	std::memcpy(sendBuffer.data(), &header, sizeof(header));
+	EncodeDelta(viewer.baseline.bodies, snapshot.bodies, sendBuffer);
+
+	std::uint32_t size = static_cast<std::uint32_t>(sendBuffer.size());
+	if (!SendMessage(viewer.connection, SnapshotMessage, sendBuffer.data(), size))
+		return false;
+
+	stats.snapshotsSent++;
+	stats.bytesSent += sizeof(MessageHeader) + size;
+	stats.rawBytes += sizeof(MessageHeader) + sizeof(header)
+		+ simulation.GetBodyCount() * (sizeof(std::uint32_t) + 4 * sizeof(double));
+	viewer.unacknowledged.push_back(std::move(snapshot));
+	return true;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file example.c
+ * @brief Prints every body's position and its distance to body 0, ten times a second.
+ *
+ * Run the engine with --export-state, then: ./simreader_example [segment name]
+ */
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L	/* nanosleep under -std=c99 */
+#endif
+
+#include "simreader.h"
+
+#include <math.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+static void sleep_ms(unsigned milliseconds) { Sleep(milliseconds); }
+#else
+#include <time.h>
+static void sleep_ms(unsigned milliseconds)
+{
+	struct timespec delay;
+	delay.tv_sec = milliseconds / 1000u;
+	delay.tv_nsec = (long)(milliseconds % 1000u) * 1000000L;
+	nanosleep(&delay, NULL);
+}
+#endif
+
+#define MAX_BODIES 64
+
+int main(int argc, char** argv)
+{
+	const char* name = argc > 1 ? argv[1] : SIM_SHARED_DEFAULT_NAME;
+	SimReader* reader = simreader_open(name);
+	if (!reader)
+	{
+		fprintf(stderr, "Cannot open %s (is the engine running with --export-state?)\n", name);
+		return 1;
+	}
+
+	for (int sample = 0; sample < 10; ++sample)
+	{
+		const SimSharedHeader* header = simreader_header(reader);
+		char names[MAX_BODIES][SIM_SHARED_NAME_LENGTH];
+		double position[MAX_BODIES][3];
+		double time;
+		uint64_t step, count;
+		uint64_t sequence;
+
+		/* Read in place; keep the result only if no publish overlapped it */
+		do
+		{
+			const double* x = simreader_field(reader, SIM_POSITION_X);
+			const double* y = simreader_field(reader, SIM_POSITION_Y);
+			const double* z = simreader_field(reader, SIM_POSITION_Z);
+			uint64_t i;
+
+			sequence = simreader_begin(reader);
+			count = header->bodyCount < MAX_BODIES ? header->bodyCount : MAX_BODIES;
+			time = header->simulationTime;
+			step = header->stepIndex;
+			for (i = 0; i < count; ++i)
+			{
+				const char* bodyName = simreader_body_name(reader, i);
+				int c;
+				for (c = 0; c < SIM_SHARED_NAME_LENGTH - 1 && bodyName[c]; ++c)
+					names[i][c] = bodyName[c];
+				names[i][c] = '\0';
+				position[i][0] = x[i];
+				position[i][1] = y[i];
+				position[i][2] = z[i];
+			}
+		} while (simreader_retry(reader, sequence));
+
+		printf("step %llu, t = %.3f s\n", (unsigned long long)step, time);
+		for (uint64_t i = 0; i < count; ++i)
+		{
+			double dx = position[i][0] - position[0][0];
+			double dy = position[i][1] - position[0][1];
+			double dz = position[i][2] - position[0][2];
+			printf("  %-12s (%8.3f, %8.3f, %8.3f)  distance to %s: %.3f\n", names[i],
+				position[i][0], position[i][1], position[i][2], names[0], sqrt(dx * dx + dy * dy + dz * dz));
+		}
+		sleep_ms(100);
+	}
+
+	simreader_close(reader);
+	return 0;
+}
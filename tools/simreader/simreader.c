@@ -0,0 +1,175 @@
+/**
+ * @file simreader.c
+ * @brief Segment mapping and sequence-lock reads for simreader.h.
+ */
+#include "simreader.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct SimReader
+{
+	const unsigned char* base;
+	size_t size;
+#ifdef _WIN32
+	HANDLE mapping;
+#endif
+};
+
+/* Acquire load of the sequence and an acquire fence before the second load */
+#if defined(_MSC_VER)
+#include <intrin.h>
+static uint64_t load_acquire(const uint64_t* value)
+{
+	uint64_t result = *(const volatile uint64_t*)value;	/* x86/x64: loads are not reordered with later loads */
+	_ReadWriteBarrier();
+	return result;
+}
+static void fence_acquire(void) { _ReadWriteBarrier(); }
+static void pause_cpu(void) { YieldProcessor(); }
+#else
+static uint64_t load_acquire(const uint64_t* value) { return __atomic_load_n(value, __ATOMIC_ACQUIRE); }
+static void fence_acquire(void) { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+static void pause_cpu(void) { sched_yield(); }
+#endif
+
+SimReader* simreader_open(const char* name)
+{
+	SimReader* reader = (SimReader*)calloc(1, sizeof(SimReader));
+	if (!reader)
+		return NULL;
+
+#ifdef _WIN32
+	/* Windows mapping names have no leading slash */
+	if (name[0] == '/')
+		name++;
+	reader->mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+	if (!reader->mapping)
+	{
+		free(reader);
+		return NULL;
+	}
+	reader->base = (const unsigned char*)MapViewOfFile(reader->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (reader->base)
+	{
+		MEMORY_BASIC_INFORMATION info;
+		VirtualQuery(reader->base, &info, sizeof(info));
+		reader->size = info.RegionSize;
+	}
+#else
+	int descriptor = shm_open(name, O_RDONLY, 0);
+	struct stat status;
+	if (descriptor < 0)
+	{
+		free(reader);
+		return NULL;
+	}
+	if (fstat(descriptor, &status) == 0 && status.st_size >= (off_t)sizeof(SimSharedHeader))
+	{
+		void* mapped = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+		if (mapped != MAP_FAILED)
+		{
+			reader->base = (const unsigned char*)mapped;
+			reader->size = (size_t)status.st_size;
+		}
+	}
+	close(descriptor);
+#endif
+
+	if (!reader->base)
+	{
+		simreader_close(reader);
+		return NULL;
+	}
+
+	/* The layout must be complete and match what this library was built against */
+	{
+		const SimSharedHeader* header = simreader_header(reader);
+		if (header->magic != SIM_SHARED_MAGIC || header->version != SIM_SHARED_VERSION
+			|| header->fieldCount != SIM_FIELD_COUNT || header->segmentSize > reader->size)
+		{
+			simreader_close(reader);
+			return NULL;
+		}
+	}
+	return reader;
+}
+
+void simreader_close(SimReader* reader)
+{
+	if (!reader)
+		return;
+#ifdef _WIN32
+	if (reader->base)
+		UnmapViewOfFile(reader->base);
+	if (reader->mapping)
+		CloseHandle(reader->mapping);
+#else
+	if (reader->base)
+		munmap((void*)reader->base, reader->size);
+#endif
+	free(reader);
+}
+
+const SimSharedHeader* simreader_header(const SimReader* reader)
+{
+	return (const SimSharedHeader*)reader->base;
+}
+
+const double* simreader_field(const SimReader* reader, enum SimSharedField field)
+{
+	return (const double*)(reader->base + simreader_header(reader)->fieldOffsets[field]);
+}
+
+const char* simreader_body_name(const SimReader* reader, uint64_t body)
+{
+	return (const char*)(reader->base + simreader_header(reader)->namesOffset) + body * SIM_SHARED_NAME_LENGTH;
+}
+
+uint64_t simreader_begin(const SimReader* reader)
+{
+	const SimSharedHeader* header = simreader_header(reader);
+	uint64_t sequence;
+	while ((sequence = load_acquire(&header->sequence)) & 1u)
+		pause_cpu();	/* A publish is in progress; it is short */
+	return sequence;
+}
+
+int simreader_retry(const SimReader* reader, uint64_t sequence)
+{
+	fence_acquire();
+	return load_acquire(&simreader_header(reader)->sequence) != sequence;
+}
+
+uint64_t simreader_copy_field(const SimReader* reader, enum SimSharedField field, double* out,
+	uint64_t capacity, uint64_t* stepIndex)
+{
+	const SimSharedHeader* header = simreader_header(reader);
+	uint64_t count;
+	uint64_t step;
+	uint64_t sequence;
+	do
+	{
+		sequence = simreader_begin(reader);
+		count = header->bodyCount < capacity ? header->bodyCount : capacity;
+		if (count > header->capacity)
+			count = header->capacity;	/* Torn read of bodyCount; the retry check discards it */
+		memcpy(out, simreader_field(reader, field), (size_t)count * sizeof(double));
+		step = header->stepIndex;
+	} while (simreader_retry(reader, sequence));
+
+	if (stepIndex)
+		*stepIndex = step;
+	return count;
+}
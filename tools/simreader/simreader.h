@@ -0,0 +1,59 @@
+/**
+ * @file simreader.h
+ * @brief C reader for the engine's shared simulation state (see SharedStateLayout.h).
+ *
+ * Maps the segment read-only; arrays are used in place, never copied, and
+ * the engine is never blocked. Wrap every read in a sequence-lock loop:
+ *
+ * @code
+ * uint64_t seq;
+ * do {
+ *     seq = simreader_begin(reader);
+ *     ... read simreader_field(reader, SIM_POSITION_X)[i] etc. ...
+ * } while (simreader_retry(reader, seq));
+ * @endcode
+ *
+ * Build (Linux): cc -I../../Include simreader.c example.c -o simreader_example -lm
+ * (add -lrt on glibc older than 2.17).
+ */
+#ifndef CELESTIAL_SIMREADER_H
+#define CELESTIAL_SIMREADER_H
+
+#include <Simulation/SharedStateLayout.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SimReader SimReader;
+
+/* Opens a segment published by the engine; NULL if it does not exist or does not match this layout. */
+SimReader* simreader_open(const char* name);
+void simreader_close(SimReader* reader);
+
+const SimSharedHeader* simreader_header(const SimReader* reader);
+
+/* In-place array of one field; valid for header->bodyCount entries inside a begin/retry loop. */
+const double* simreader_field(const SimReader* reader, enum SimSharedField field);
+
+/* NUL-terminated body name; valid inside a begin/retry loop. */
+const char* simreader_body_name(const SimReader* reader, uint64_t body);
+
+/* Waits until no publish is in progress and returns the sequence to pass to simreader_retry(). */
+uint64_t simreader_begin(const SimReader* reader);
+
+/* Nonzero if a publish overlapped the reads since simreader_begin(); discard them and read again. */
+int simreader_retry(const SimReader* reader, uint64_t sequence);
+
+/*
+ * Convenience: copies a consistent snapshot of one field into out (at most capacity values).
+ * Returns the number of bodies copied; *stepIndex receives the snapshot's step if not NULL.
+ */
+uint64_t simreader_copy_field(const SimReader* reader, enum SimSharedField field, double* out,
+	uint64_t capacity, uint64_t* stepIndex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif